@@ -15,6 +15,7 @@ BufferPoolManager::BufferPoolManager(size_t pool_size, DiskManager *disk_manager
 }
 
 BufferPoolManager::~BufferPoolManager() {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   for (auto page : page_table_) {
     //DLOG(INFO)<<"page id : "<<page.first<<" isdirty"<<pages_[page.first].is_dirty_<<endl;
     FlushPage(page.first);
@@ -28,8 +29,10 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
   // 1.1    If P exists, pin it and return it immediately.
   // 1.2    If P does not exist, find a replacement page (R) from either the free list or the replacer.
   //        Note that pages are always found from the free list first.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   if (page_table_.find(page_id) != page_table_.end()) {
     replacer_->Pin(page_table_[page_id]);
+    pages_[page_table_[page_id]].pin_count_++;
     return &pages_[page_table_[page_id]];
   } else
   // 2.     If R is dirty, write it back to the disk.
@@ -46,6 +49,8 @@ Page *BufferPoolManager::FetchPage(page_id_t page_id) {
     page_table_[page_id] = frame_id;
     pages_[frame_id].ResetMemory();
     pages_[frame_id].page_id_ = page_id;
+    pages_[frame_id].is_dirty_ = false;
+    pages_[frame_id].pin_count_ = 1;
     disk_manager_->ReadPage(page_id, pages_[frame_id].GetData());
     return &pages_[frame_id];
   }
@@ -76,6 +81,7 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
   // 1. If all the pages in the buffer pool are pinned, return nullptr.
   // 2. Pick a victim page P from either the free list or the replacer.
   //    Always pick from the free list first.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   frame_id_t frame_id = TryToFindFreePage();
   if (frame_id == INVALID_PAGE_ID) {
     // DLOG(INFO) << "All pages in the buffer pool are pinned";
@@ -90,6 +96,7 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
   //    table.
   pages_[frame_id].ResetPage();
   pages_[frame_id].page_id_ = page_id;
+  pages_[frame_id].pin_count_ = 1;
   page_table_[page_id] = frame_id;
   // 4.   Set the page ID output parameter. Return a pointer to P.
   return &pages_[frame_id];
@@ -98,20 +105,20 @@ Page *BufferPoolManager::NewPage(page_id_t &page_id) {
 bool BufferPoolManager::DeletePage(page_id_t page_id) {
   // 0.   Make sure you call DeallocatePage!
   // 1.   Search the page table for the requested page (P).
+  // 1.   If P does not exist, return true.
+  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
+  // 3. Otherwise, P can be deleted. Remove P from the page table, reset
+  //    its metadata and return it to the free list.
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   if (page_table_.find(page_id) != page_table_.end()) {
     frame_id_t frame_id = page_table_[page_id];
     if (pages_[frame_id].GetPinCount() != 0) {
       return false;
     }
-  }
-  // 1.   If P does not exist, return true.
-  // 2.   If P exists, but has a non-zero pin-count, return false. Someone is using the page.
-  // 3. Otherwise, P can be deleted. Remove P from the page table, reset
-  //    its metadata and return it to the free list.
-  else {
-    //UnpinPage(page_id, false);
-    pages_[page_table_[page_id]].ResetPage();
-    free_list_.emplace_back(page_table_[page_id]);
+    // the frame must not be handed out by the replacer any more
+    replacer_->Pin(frame_id);
+    pages_[frame_id].ResetPage();
+    free_list_.emplace_back(frame_id);
     page_table_.erase(page_id);
   }
   disk_manager_->DeAllocatePage(page_id);
@@ -119,18 +126,27 @@ bool BufferPoolManager::DeletePage(page_id_t page_id) {
 }
 
 bool BufferPoolManager::UnpinPage(page_id_t page_id, bool is_dirty) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   if (page_table_.find(page_id) == page_table_.end()) {
     DLOG(ERROR) << "Page not found in page table";
     return false;
   }
   //DLOG(INFO)<<"unpin page id : "<<page_id<<" is dirty "<<is_dirty<<endl;
   frame_id_t frame_id = page_table_[page_id];
-  pages_[frame_id].is_dirty_ = is_dirty;
-  replacer_->Unpin(frame_id);
+  // a clean unpin must not hide the modifications of an earlier dirty one
+  pages_[frame_id].is_dirty_ = pages_[frame_id].is_dirty_ || is_dirty;
+  // the frame can only be replaced once every user has unpinned it
+  if (pages_[frame_id].pin_count_ > 0) {
+    pages_[frame_id].pin_count_--;
+  }
+  if (pages_[frame_id].pin_count_ == 0) {
+    replacer_->Unpin(frame_id);
+  }
   return true;
 }
 
 bool BufferPoolManager::FlushPage(page_id_t page_id) {
+  std::scoped_lock<std::recursive_mutex> lock(latch_);
   if (page_table_.find(page_id) == page_table_.end()) {
     DLOG(ERROR) << "Page not found in page table";
     return false;
@@ -8,19 +8,21 @@ bool LRUReplacer::Victim(frame_id_t *frame_id) {
   if (lru_list_.empty()) return false;
   *frame_id = lru_list_.back();
   lru_list_.pop_back();
-  lru_set_.erase(*frame_id);
+  lru_map_.erase(*frame_id);
   return true;
 }
 
 void LRUReplacer::Pin(frame_id_t frame_id) {
-  lru_list_.remove(frame_id);
-  lru_set_.erase(frame_id);
+  auto it = lru_map_.find(frame_id);
+  if (it == lru_map_.end()) return;
+  lru_list_.erase(it->second);
+  lru_map_.erase(it);
 }
 
 void LRUReplacer::Unpin(frame_id_t frame_id) {
-  if (lru_set_.find(frame_id) != lru_set_.end()) return;
+  if (lru_map_.find(frame_id) != lru_map_.end()) return;
   lru_list_.push_front(frame_id);
-  lru_set_.insert(frame_id);
+  lru_map_.emplace(frame_id, lru_list_.begin());
 }
 
 size_t LRUReplacer::Size() { return lru_list_.size(); }
\ No newline at end of file
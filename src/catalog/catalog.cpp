@@ -1,5 +1,10 @@
 #include "catalog/catalog.h"
 
+#include <algorithm>
+#include <thread>
+
+#include "common/arena.h"
+
 void CatalogMeta::SerializeTo(char *buf) const {
   ASSERT(GetSerializedSize() <= PAGE_SIZE, "Failed to serialize catalog metadata to disk.");
   MACH_WRITE_UINT32(buf, CATALOG_METADATA_MAGIC_NUM);
@@ -87,10 +92,11 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
       // 加载table_names <std::string, table_id_t>
       table_names_[table_meta->GetTableName()] = table_meta->GetTableId();
       // 加载tables <table_id_t, TableInfo *>
-      auto table_heap = TableHeap::Create(buffer_pool_manager, table_meta->GetFirstPageId(), table_meta->GetSchema(),
-                                          log_manager_, lock_manager_);
+      auto table_heap = OpenTableHeap(table_meta);
       TableInfo *table_info = TableInfo::Create();
       table_info->Init(table_meta, table_heap);
+      LoadTableStatistics(table_info);
+      UpgradeTupleFormat(table_info, it.second);
       tables_[table_meta->GetTableId()] = table_info;
       // 更新next_table_id
       if (table_meta->GetTableId() >= next_table_id_) {
@@ -125,6 +131,14 @@ CatalogManager::CatalogManager(BufferPoolManager *buffer_pool_manager, LockManag
 }
 
 CatalogManager::~CatalogManager() {
+  // keep the row counts of the persisted statistics up to date
+  for (auto iter : tables_) {
+    if (iter.second->GetTableStatistics() != nullptr) {
+      TableStatistics *table_stats;
+      GetTableStatistics(iter.second->GetTableName(), table_stats);
+      FlushTableStatistics(iter.second);
+    }
+  }
   FlushCatalogMetaPage();
   delete catalog_meta_;
   for (auto iter : tables_) {
@@ -138,13 +152,23 @@ CatalogManager::~CatalogManager() {
 /**
  * TODO: Student Implement
  */
-dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info) {
+dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info,
+                                    TableLayout layout, const std::vector<uint32_t> &cluster_key) {
   // table has existed
   if (table_names_.count(table_name) != 0) {
     return DB_TABLE_ALREADY_EXIST;
   }
+  // pax pages hold fixed width tuples, at least one of them must fit into a page
+  if (layout == TableLayout::kPax && PaxPage::ComputeCapacity(schema) == 0) {
+    return DB_FAILED;
+  }
+  // clustered tables are ordered by a primary key that fits into a B+ tree key
+  if (layout == TableLayout::kClustered && ClusteredTableHeap::ComputeKeySize(schema, cluster_key) == 0) {
+    return DB_FAILED;
+  }
 
   IndexSchema *dschema = Schema::DeepCopySchema(schema);
+  dschema->SetTupleFormat(TupleFormat::kV2);
   // create table
   // add to table_names <std::string, table_id_t>
   table_id_t table_id = next_table_id_;
@@ -153,8 +177,17 @@ dberr_t CatalogManager::CreateTable(const string &table_name, TableSchema *schem
   // get a new page for table_meta
   page_id_t page_id;
   auto table_meta_page = buffer_pool_manager_->NewPage(page_id);
-  auto table_heap = TableHeap::Create(buffer_pool_manager_, dschema, txn, log_manager_, lock_manager_);
-  auto table_meta = TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(), dschema);
+  TableHeap *table_heap;
+  if (layout == TableLayout::kPax) {
+    table_heap = PaxTableHeap::Create(buffer_pool_manager_, dschema, txn, log_manager_, lock_manager_);
+  } else if (layout == TableLayout::kClustered) {
+    table_heap =
+        ClusteredTableHeap::Create(buffer_pool_manager_, dschema, cluster_key, txn, log_manager_, lock_manager_);
+  } else {
+    table_heap = TableHeap::Create(buffer_pool_manager_, dschema, txn, log_manager_, lock_manager_);
+  }
+  auto table_meta =
+      TableMetadata::Create(table_id, table_name, table_heap->GetFirstPageId(), dschema, layout, cluster_key);
   table_meta->SerializeTo(table_meta_page->GetData());
   buffer_pool_manager_->UnpinPage(page_id, true);
 
@@ -202,12 +235,15 @@ dberr_t CatalogManager::GetTables(vector<TableInfo *> &tables) const {
  */
 dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string &index_name,
                                     const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info,
-                                    const string &index_type) {
+                                    const string &index_type, uint32_t build_workers) {
   // no such table
   auto table = table_names_.find(table_name);
   if (table == table_names_.end()) {
     return DB_TABLE_NOT_EXIST;
   }
+  if (!IndexMetadata::IsIndexType(index_type)) {
+    return DB_FAILED;
+  }
 
   // there has been a same index for the table
   auto index = index_names_.find(table_name);
@@ -218,6 +254,9 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   // give a index for every column
   std::vector<uint32_t> column_index_;
   auto table_info = tables_.find(table->second)->second;
+  if (table_info->GetLayout() == TableLayout::kClustered) {
+    return DB_FAILED;
+  }
   auto schema = table_info->GetSchema();
   for (auto &it : index_keys) {
     uint32_t column_index;
@@ -235,7 +274,7 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   // get a new page for index_meta
   page_id_t page_id;
   auto index_meta_page = buffer_pool_manager_->NewPage(page_id);
-  auto index_meta = IndexMetadata::Create(next_index_id_, index_name, table_names_[table_name], column_index_);
+  auto index_meta = IndexMetadata::Create(next_index_id_, index_name, table_names_[table_name], column_index_, index_type);
   index_meta->SerializeTo(index_meta_page->GetData());
 
   // update catalog_meta
@@ -247,17 +286,23 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   // may be meta page should reside in buffer pool? After Init the
   // key_map is then passed to KeyManager, can be unpinned
   // buffer_pool_manager_->UnpinPage(page_id, true);
-  // 呜呜，这里应当将表中的所有数据插入到索引中
-  Row key;
-  for (auto it = table_info->GetTableHeap()->Begin(nullptr); it != table_info->GetTableHeap()->End(); it++) {
-    auto row = *it;
-    // std::vector<Field> fields;
-    // for(auto &col : column_index_){
-    //   fields.push_back(*row.GetField(col));
-    // }
-    // Row key(fields);
-    row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key);
-    index_info->GetIndex()->InsertEntry(key, row.GetRowId(), txn);
+  // the keys of the rows are sorted and loaded bottom up, instead of inserting the rows one by one
+  auto tree_index = dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex());
+  KeySorter sorter(tree_index->GetKeyManager());
+  if (SortIndexKeys(table_info, index_info, column_index_, build_workers, &sorter, txn) != DB_SUCCESS ||
+      tree_index->BulkLoad(&sorter) != DB_SUCCESS) {
+    LOG(ERROR) << "Failed to build index " << index_name << " on " << table_name << "." << std::endl;
+    tree_index->Destroy();
+    delete index_info;
+    index_info = nullptr;
+    index_names_[table_name].erase(index_name);
+    if (index_names_[table_name].empty()) {
+      index_names_.erase(table_name);
+    }
+    catalog_meta_->index_meta_pages_.erase(next_index_id_);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    return DB_FAILED;
   }
   indexes_[next_index_id_] = index_info;
   next_index_id_++;
@@ -267,6 +312,83 @@ dberr_t CatalogManager::CreateIndex(const std::string &table_name, const string
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::SortIndexKeys(TableInfo *table_info, IndexInfo *index_info,
+                                      const std::vector<uint32_t> &key_map, uint32_t build_workers, KeySorter *sorter,
+                                      Txn *txn) {
+  auto table_heap = table_info->GetTableHeap();
+  auto key_schema = index_info->GetIndexKeySchema();
+  const auto &key_manager = dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex())->GetKeyManager();
+  // the values of the other columns stay in their overflow pages
+  std::vector<bool> referenced(table_info->GetSchema()->GetColumnCount(), false);
+  for (auto column : key_map) {
+    referenced[column] = true;
+  }
+  if (table_info->GetLayout() != TableLayout::kRow || build_workers <= 1 ||
+      table_heap->GetPageCount() < PARALLEL_SCAN_MIN_PAGES) {
+    KeyBuffer key_buf;
+    Row key;
+    for (auto it = table_heap->Begin(txn, &referenced); it != table_heap->End(); it++) {
+      auto row = *it;
+      row.GetKeyFromRow(table_info->GetSchema(), key_schema, key);
+      key_manager.SerializeFromKey(key_buf.Get(), key, key_schema);
+      if (sorter->Add(key_buf.Get(), row.GetRowId()) != DB_SUCCESS) {
+        return DB_FAILED;
+      }
+    }
+    return DB_SUCCESS;
+  }
+  std::vector<page_id_t> page_ids;
+  table_heap->GetPageIds(&page_ids);
+  size_t worker_count = std::min<size_t>(build_workers, page_ids.size() / PARALLEL_SCAN_MORSEL_PAGES);
+  // the memory limit is shared, the runs of all workers are held until they are merged
+  std::vector<std::unique_ptr<KeySorter>> sorters;
+  for (size_t i = 0; i < worker_count; i++) {
+    sorters.emplace_back(new KeySorter(key_manager, INDEX_SORT_MEMORY / worker_count));
+  }
+  // a worker stops at its first failed spill
+  std::vector<dberr_t> results(worker_count, DB_SUCCESS);
+  auto worker = [&](size_t worker_id) {
+    auto worker_sorter = sorters[worker_id].get();
+    size_t begin = page_ids.size() * worker_id / worker_count;
+    size_t end = page_ids.size() * (worker_id + 1) / worker_count;
+    Arena arena;
+    KeyBuffer key_buf;
+    std::vector<const Field *> key_fields(key_map.size());
+    TableHeap::TupleVisitor visit = [&](const TupleView &view) {
+      arena.Reset();
+      Row row(view.GetRowId(), &arena);
+      if (!view.Bind(referenced, &row)) {
+        return false;
+      }
+      for (size_t i = 0; i < key_map.size(); i++) {
+        key_fields[i] = row.GetField(key_map[i]);
+      }
+      key_manager.SerializeFromKey(key_buf.Get(), Row(key_fields), key_schema);
+      results[worker_id] = worker_sorter->Add(key_buf.Get(), view.GetRowId());
+      return results[worker_id] == DB_SUCCESS;
+    };
+    for (size_t i = begin; i < end && results[worker_id] == DB_SUCCESS; i++) {
+      table_heap->VisitPage(page_ids[i], visit, txn, nullptr, &referenced);
+    }
+    worker_sorter->Sort();
+  };
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < worker_count; i++) {
+    workers.emplace_back(worker, i);
+  }
+  worker(0);
+  for (auto &thread : workers) {
+    thread.join();
+  }
+  for (size_t i = 0; i < worker_count; i++) {
+    if (results[i] != DB_SUCCESS) {
+      return results[i];
+    }
+    sorter->Merge(sorters[i].get());
+  }
+  return DB_SUCCESS;
+}
+
 /**
  * TODO: Student Implement
  */
@@ -313,6 +435,10 @@ dberr_t CatalogManager::DropTable(const string &table_name) {
     return DB_TABLE_NOT_EXIST;
   }
   auto table_id = table->second;
+  auto stats_page_id = tables_[table_id]->GetTableMetadata()->GetStatsPageId();
+  if (stats_page_id != INVALID_PAGE_ID) {
+    buffer_pool_manager_->DeletePage(stats_page_id);
+  }
   table_names_.erase(table_name);
   tables_.erase(table_id);
 
@@ -349,6 +475,112 @@ dberr_t CatalogManager::DropIndex(const string &table_name, const string &index_
   return DB_SUCCESS;
 }
 
+dberr_t CatalogManager::VacuumTable(const string &table_name, Txn *txn, uint32_t &reclaimed_bytes) {
+  auto table = table_names_.find(table_name);
+  if (table == table_names_.end())  // no such table
+  {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_info = tables_[table->second];
+  std::vector<std::pair<RowId, RowId>> moved_rows;
+  reclaimed_bytes = table_info->GetTableHeap()->Vacuum(txn, &moved_rows);
+  if (moved_rows.empty()) {
+    return DB_SUCCESS;
+  }
+  // 被搬到其他数据页的行需要在索引中更新 rid
+  std::vector<IndexInfo *> indexes;
+  if (GetTableIndexes(table_name, indexes) != DB_SUCCESS) {
+    return DB_SUCCESS;
+  }
+  Row key;
+  for (auto &moved : moved_rows) {
+    Row row(moved.second);
+    table_info->GetTableHeap()->GetTuple(&row, txn);
+    for (auto index_info : indexes) {
+      row.GetKeyFromRow(table_info->GetSchema(), index_info->GetIndexKeySchema(), key);
+      index_info->GetIndex()->RemoveEntry(key, moved.first, txn);
+      index_info->GetIndex()->InsertEntry(key, moved.second, txn);
+    }
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::AnalyzeTable(const string &table_name, Txn *txn, TableStatistics *&table_stats) {
+  auto table = table_names_.find(table_name);
+  if (table == table_names_.end())  // no such table
+  {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_info = tables_[table->second];
+  table_stats = TableStatistics::Collect(table_info->GetTableHeap(), table_info->GetSchema(), txn);
+  if (table_stats == nullptr) {
+    return DB_FAILED;
+  }
+  table_info->SetTableStatistics(table_stats);
+  table_info->GetTableHeap()->ResetModifyCounters();
+  FlushTableStatistics(table_info);
+  return DB_SUCCESS;
+}
+
+dberr_t CatalogManager::GetTableStatistics(const string &table_name, TableStatistics *&table_stats) {
+  auto table = table_names_.find(table_name);
+  if (table == table_names_.end())  // no such table
+  {
+    return DB_TABLE_NOT_EXIST;
+  }
+  auto table_info = tables_[table->second];
+  table_stats = table_info->GetTableStatistics();
+  if (table_stats == nullptr) {
+    return DB_NOT_EXIST;
+  }
+  auto table_heap = table_info->GetTableHeap();
+  table_stats->ApplyModifications(table_heap->GetInsertedTuples(), table_heap->GetDeletedTuples());
+  table_heap->ResetModifyCounters();
+  return DB_SUCCESS;
+}
+
+void CatalogManager::LoadTableStatistics(TableInfo *table_info) {
+  auto stats_page_id = table_info->GetTableMetadata()->GetStatsPageId();
+  if (stats_page_id == INVALID_PAGE_ID) {
+    return;
+  }
+  auto stats_page = buffer_pool_manager_->FetchPage(stats_page_id);
+  TableStatistics *table_stats = nullptr;
+  TableStatistics::DeserializeFrom(stats_page->GetData(), table_info->GetSchema(), table_stats);
+  buffer_pool_manager_->UnpinPage(stats_page_id, false);
+  table_info->SetTableStatistics(table_stats);
+}
+
+void CatalogManager::FlushTableStatistics(TableInfo *table_info) {
+  auto table_meta = table_info->GetTableMetadata();
+  page_id_t stats_page_id = table_meta->GetStatsPageId();
+  Page *stats_page;
+  if (stats_page_id == INVALID_PAGE_ID) {
+    // first ANALYZE of the table, the metadata now references the new page
+    stats_page = buffer_pool_manager_->NewPage(stats_page_id);
+    table_meta->SetStatsPageId(stats_page_id);
+    page_id_t meta_page_id = catalog_meta_->table_meta_pages_[table_info->GetTableId()];
+    auto table_meta_page = buffer_pool_manager_->FetchPage(meta_page_id);
+    table_meta->SerializeTo(table_meta_page->GetData());
+    buffer_pool_manager_->UnpinPage(meta_page_id, true);
+  } else {
+    stats_page = buffer_pool_manager_->FetchPage(stats_page_id);
+  }
+  table_info->GetTableStatistics()->SerializeTo(stats_page->GetData());
+  buffer_pool_manager_->UnpinPage(stats_page_id, true);
+}
+
+void CatalogManager::UpgradeTupleFormat(TableInfo *table_info, page_id_t meta_page_id) {
+  auto table_meta = table_info->GetTableMetadata();
+  if (table_meta->GetLayout() != TableLayout::kRow || table_info->GetSchema()->GetTupleFormat() != TupleFormat::kV1) {
+    return;
+  }
+  table_info->GetTableHeap()->UpgradeTupleFormat(nullptr);
+  auto table_meta_page = buffer_pool_manager_->FetchPage(meta_page_id);
+  table_meta->SerializeTo(table_meta_page->GetData());
+  buffer_pool_manager_->UnpinPage(meta_page_id, true);
+}
+
 /**
  * TODO: Student Implement
  */
@@ -378,10 +610,11 @@ dberr_t CatalogManager::LoadTable(const table_id_t table_id, const page_id_t pag
   table_names_[table_name] = table_id;
 
   // add to tables
-  auto table_heap =
-      TableHeap::Create(buffer_pool_manager_, page_id, table_meta->GetSchema(), log_manager_, lock_manager_);
+  auto table_heap = OpenTableHeap(table_meta);
   auto table_info = TableInfo::Create();
   table_info->Init(table_meta, table_heap);
+  LoadTableStatistics(table_info);
+  UpgradeTupleFormat(table_info, page_id);
   tables_.emplace(table_id, table_info);
   // DLOG(INFO)<<"LoadTable pageid : "<<page_id<<endl;
   buffer_pool_manager_->UnpinPage(page_id, true);
@@ -425,4 +658,18 @@ dberr_t CatalogManager::GetTable(const table_id_t table_id, TableInfo *&table_in
   }
   table_info = table->second;
   return DB_SUCCESS;
-}
\ No newline at end of file
+}
+
+TableHeap *CatalogManager::OpenTableHeap(TableMetadata *table_meta) {
+  if (table_meta->GetLayout() == TableLayout::kPax) {
+    return PaxTableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(),
+                                log_manager_, lock_manager_);
+  }
+  if (table_meta->GetLayout() == TableLayout::kClustered) {
+    return ClusteredTableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(),
+                                      table_meta->GetClusterKey(), log_manager_, lock_manager_,
+                                      table_meta->GetKeyEncoding());
+  }
+  return TableHeap::Create(buffer_pool_manager_, table_meta->GetFirstPageId(), table_meta->GetSchema(), log_manager_,
+                           lock_manager_);
+}
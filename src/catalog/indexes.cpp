@@ -5,8 +5,10 @@ IndexMetadata::IndexMetadata(const index_id_t index_id, const std::string &index
     : index_id_(index_id), index_name_(index_name), table_id_(table_id), key_map_(key_map) {}
 
 IndexMetadata *IndexMetadata::Create(const index_id_t index_id, const string &index_name, const table_id_t table_id,
-                                     const vector<uint32_t> &key_map) {
-  return new IndexMetadata(index_id, index_name, table_id, key_map);
+                                     const vector<uint32_t> &key_map, const std::string &index_type) {
+  auto index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  index_meta->index_type_ = index_type;
+  return index_meta;
 }
 
 uint32_t IndexMetadata::SerializeTo(char *buf) const {
@@ -14,7 +16,7 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
   uint32_t ofs = GetSerializedSize();
   ASSERT(ofs <= PAGE_SIZE, "Failed to serialize index info.");
   // magic num
-  MACH_WRITE_UINT32(buf, INDEX_METADATA_MAGIC_NUM);
+  MACH_WRITE_UINT32(buf, INDEX_METADATA_TYPE_MAGIC_NUM);
   buf += 4;
   // index id
   MACH_WRITE_TO(index_id_t, buf, index_id_);
@@ -35,6 +37,14 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
     MACH_WRITE_UINT32(buf, col_index);
     buf += 4;
   }
+  // key encoding
+  MACH_WRITE_TO(KeyEncoding, buf, key_encoding_);
+  buf += 4;
+  // index type
+  MACH_WRITE_UINT32(buf, index_type_.length());
+  buf += 4;
+  MACH_WRITE_STRING(buf, index_type_);
+  buf += index_type_.length();
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
@@ -45,7 +55,7 @@ uint32_t IndexMetadata::SerializeTo(char *buf) const {
 uint32_t IndexMetadata::GetSerializedSize() const {
   return sizeof(INDEX_METADATA_MAGIC_NUM) + sizeof(index_id_t) + sizeof(index_name_.length())
          + index_name_.length() + sizeof(table_id_t) + sizeof(key_map_.size())
-         + key_map_.size() * sizeof(uint32_t) - 8;
+         + key_map_.size() * sizeof(uint32_t) - 8 + sizeof(KeyEncoding) + sizeof(uint32_t) + index_type_.length();
 }
 
 uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
@@ -56,7 +66,9 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
   // magic num
   uint32_t magic_num = MACH_READ_UINT32(buf);
   buf += 4;
-  ASSERT(magic_num == INDEX_METADATA_MAGIC_NUM, "Failed to deserialize index info.");
+  ASSERT(magic_num == INDEX_METADATA_MAGIC_NUM || magic_num == INDEX_METADATA_ENCODING_MAGIC_NUM ||
+             magic_num == INDEX_METADATA_TYPE_MAGIC_NUM,
+         "Failed to deserialize index info.");
   // index id
   index_id_t index_id = MACH_READ_FROM(index_id_t, buf);
   buf += 4;
@@ -78,26 +90,49 @@ uint32_t IndexMetadata::DeserializeFrom(char *buf, IndexMetadata *&index_meta) {
     buf += 4;
     key_map.push_back(key_index);
   }
+  // key encoding
+  KeyEncoding key_encoding = KeyEncoding::kRow;
+  if (magic_num != INDEX_METADATA_MAGIC_NUM) {
+    key_encoding = MACH_READ_FROM(KeyEncoding, buf);
+    buf += 4;
+  }
+  // index type
+  std::string index_type = "bptree";
+  if (magic_num == INDEX_METADATA_TYPE_MAGIC_NUM) {
+    uint32_t type_len = MACH_READ_UINT32(buf);
+    buf += 4;
+    index_type.assign(buf, type_len);
+    buf += type_len;
+  }
   // allocate space for index meta data
   index_meta = new IndexMetadata(index_id, index_name, table_id, key_map);
+  index_meta->key_encoding_ = key_encoding;
+  index_meta->index_type_ = index_type;
   return buf - p;
 }
 
 Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const string &index_type) {
   size_t max_size = 0;
-  uint32_t column_cnt = key_schema_->GetColumns().size();
-  size_t size_bitmap = (column_cnt % 8) ? column_cnt / 8 + 1 : column_cnt / 8;
-  // column_cnt + bitmap
-  max_size += 4 + sizeof(unsigned char) * size_bitmap;
-  for (auto col : key_schema_->GetColumns()) {
-    // length of char column
-    if(col->GetType() == TypeId::kTypeChar)
-      max_size += 4;
-    max_size += col->GetLength();
+  auto key_encoding = meta_data_->GetKeyEncoding();
+  if (key_encoding == KeyEncoding::kNormalized) {
+    max_size = KeyManager::GetNormalizedSize(key_schema_);
+  } else {
+    uint32_t column_cnt = key_schema_->GetColumns().size();
+    size_t size_bitmap = (column_cnt % 8) ? column_cnt / 8 + 1 : column_cnt / 8;
+    // column_cnt + bitmap
+    max_size += 4 + sizeof(unsigned char) * size_bitmap;
+    for (auto col : key_schema_->GetColumns()) {
+      // length of char column
+      if (col->GetType() == TypeId::kTypeChar) max_size += 4;
+      max_size += col->GetLength();
+    }
   }
 
-  if (index_type == "bptree") {
-    if (max_size <= 8)
+  if (IndexMetadata::IsIndexType(index_type)) {
+    // normalized keys of a single word are searched in SIMD lanes, see KeyManager::SearchWords
+    if (max_size <= 8 && key_encoding == KeyEncoding::kNormalized)
+      max_size = 8;
+    else if (max_size <= 8)
       max_size = 16;
     else if (max_size <= 24)
       max_size = 32;
@@ -114,5 +149,6 @@ Index *IndexInfo::CreateIndex(BufferPoolManager *buffer_pool_manager, const stri
   } else {
     return nullptr;
   }
-  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager);
+  return new BPlusTreeIndex(meta_data_->index_id_, key_schema_, max_size, buffer_pool_manager, key_encoding,
+                            index_type == "blinktree");
 }
@@ -5,7 +5,7 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   uint32_t ofs = GetSerializedSize();
   ASSERT(ofs <= PAGE_SIZE, "Failed to serialize table info.");
   // magic num
-  MACH_WRITE_UINT32(buf, TABLE_METADATA_MAGIC_NUM);
+  MACH_WRITE_UINT32(buf, TABLE_METADATA_KEY_MAGIC_NUM);
   buf += 4;
   // table id
   MACH_WRITE_TO(table_id_t, buf, table_id_);
@@ -18,8 +18,29 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
   // table heap root page id
   MACH_WRITE_TO(page_id_t, buf, root_page_id_);
   buf += 4;
+  // table layout
+  MACH_WRITE_TO(TableLayout, buf, layout_);
+  buf += 4;
   // table schema
   buf += schema_->SerializeTo(buf);
+  // cluster key, only written for clustered tables
+  if (layout_ == TableLayout::kClustered) {
+    MACH_WRITE_UINT32(buf, cluster_key_.size());
+    buf += 4;
+    for (auto column_index : cluster_key_) {
+      MACH_WRITE_UINT32(buf, column_index);
+      buf += 4;
+    }
+  }
+  // statistics page id
+  MACH_WRITE_TO(page_id_t, buf, stats_page_id_);
+  buf += 4;
+  // tuple format
+  MACH_WRITE_TO(TupleFormat, buf, schema_->GetTupleFormat());
+  buf += 4;
+  // key encoding
+  MACH_WRITE_TO(KeyEncoding, buf, key_encoding_);
+  buf += 4;
   ASSERT(buf - p == ofs, "Unexpected serialize size.");
   return ofs;
 }
@@ -29,7 +50,9 @@ uint32_t TableMetadata::SerializeTo(char *buf) const {
  */
 uint32_t TableMetadata::GetSerializedSize() const {
   return sizeof(TABLE_METADATA_MAGIC_NUM) + sizeof(table_id_t) + sizeof(table_name_.length()) - 4
-  + table_name_.length() + sizeof(page_id_t) + schema_->GetSerializedSize();
+  + table_name_.length() + sizeof(page_id_t) + sizeof(TableLayout) + schema_->GetSerializedSize()
+  + (layout_ == TableLayout::kClustered ? sizeof(uint32_t) * (cluster_key_.size() + 1) : 0) + sizeof(page_id_t)
+  + sizeof(TupleFormat) + sizeof(KeyEncoding);
 }
 
 /**
@@ -44,7 +67,10 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // magic num
   uint32_t magic_num = MACH_READ_UINT32(buf);
   buf += 4;
-  ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM, "Failed to deserialize table info.");
+  ASSERT(magic_num == TABLE_METADATA_MAGIC_NUM || magic_num == TABLE_METADATA_LAYOUT_MAGIC_NUM ||
+             magic_num == TABLE_METADATA_STATS_MAGIC_NUM || magic_num == TABLE_METADATA_FORMAT_MAGIC_NUM ||
+             magic_num == TABLE_METADATA_KEY_MAGIC_NUM,
+         "Failed to deserialize table info.");
   // table id
   table_id_t table_id = MACH_READ_FROM(table_id_t, buf);
   buf += 4;
@@ -56,11 +82,47 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
   // table heap root page id
   page_id_t root_page_id = MACH_READ_FROM(page_id_t, buf);
   buf += 4;
+  // table layout
+  TableLayout layout = TableLayout::kRow;
+  if (magic_num != TABLE_METADATA_MAGIC_NUM) {
+    layout = MACH_READ_FROM(TableLayout, buf);
+    buf += 4;
+  }
   // table schema
   TableSchema *schema = nullptr;
   buf += TableSchema::DeserializeFrom(buf, schema);
+  // cluster key
+  std::vector<uint32_t> cluster_key;
+  if (layout == TableLayout::kClustered) {
+    uint32_t key_count = MACH_READ_UINT32(buf);
+    buf += 4;
+    for (uint32_t i = 0; i < key_count; i++) {
+      cluster_key.push_back(MACH_READ_UINT32(buf));
+      buf += 4;
+    }
+  }
+  // statistics page id
+  page_id_t stats_page_id = INVALID_PAGE_ID;
+  if (magic_num == TABLE_METADATA_STATS_MAGIC_NUM || magic_num == TABLE_METADATA_FORMAT_MAGIC_NUM ||
+      magic_num == TABLE_METADATA_KEY_MAGIC_NUM) {
+    stats_page_id = MACH_READ_FROM(page_id_t, buf);
+    buf += 4;
+  }
+  // tuple format, the tuples of older tables are in the v1 format
+  if (magic_num == TABLE_METADATA_FORMAT_MAGIC_NUM || magic_num == TABLE_METADATA_KEY_MAGIC_NUM) {
+    schema->SetTupleFormat(MACH_READ_FROM(TupleFormat, buf));
+    buf += 4;
+  }
+  // key encoding
+  KeyEncoding key_encoding = KeyEncoding::kRow;
+  if (magic_num == TABLE_METADATA_KEY_MAGIC_NUM) {
+    key_encoding = MACH_READ_FROM(KeyEncoding, buf);
+    buf += 4;
+  }
   // allocate space for table metadata
-  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema);
+  table_meta = new TableMetadata(table_id, table_name, root_page_id, schema, layout, std::move(cluster_key));
+  table_meta->stats_page_id_ = stats_page_id;
+  table_meta->key_encoding_ = key_encoding;
   return buf - p;
 }
 
@@ -70,10 +132,17 @@ uint32_t TableMetadata::DeserializeFrom(char *buf, TableMetadata *&table_meta) {
  * @param heap Memory heap passed by TableInfo
  */
 TableMetadata *TableMetadata::Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
-                                     TableSchema *schema) {
+                                     TableSchema *schema, TableLayout layout,
+                                     const std::vector<uint32_t> &cluster_key) {
   // allocate space for table metadata
-  return new TableMetadata(table_id, table_name, root_page_id, schema);
+  return new TableMetadata(table_id, table_name, root_page_id, schema, layout, cluster_key);
 }
 
-TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema)
-    : table_id_(table_id), table_name_(table_name), root_page_id_(root_page_id), schema_(schema) {}
+TableMetadata::TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                             TableLayout layout, std::vector<uint32_t> cluster_key)
+    : table_id_(table_id),
+      table_name_(table_name),
+      root_page_id_(root_page_id),
+      schema_(schema),
+      layout_(layout),
+      cluster_key_(std::move(cluster_key)) {}
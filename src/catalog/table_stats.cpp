@@ -0,0 +1,250 @@
+#include "catalog/table_stats.h"
+
+#include <algorithm>
+#include <deque>
+
+TableStatistics *TableStatistics::Collect(TableHeap *table_heap, Schema *schema, Txn *txn) {
+  auto table_stats = new TableStatistics();
+  std::deque<Row> rows;
+  table_stats->page_count_ = table_heap->GetPageCount();
+  // the pages of every layout are read one at a time, only the sampled tuples are kept
+  std::vector<page_id_t> page_ids;
+  table_heap->GetPageIds(&page_ids);
+  size_t sample_pages = std::min<size_t>(STATS_SAMPLE_PAGES, page_ids.size());
+  std::vector<Row> page_rows;
+  for (size_t i = 0; i < sample_pages; i++) {
+    // the middle page of every stride of pages, or every page of a small table
+    auto page_id = sample_pages < page_ids.size() ? page_ids[(2 * i + 1) * page_ids.size() / (2 * sample_pages)]
+                                                  : page_ids[i];
+    table_heap->GetPageTuples(page_id, &page_rows, txn);
+    for (auto &row : page_rows) {
+      rows.push_back(std::move(row));
+    }
+  }
+  table_stats->row_count_ = sample_pages == 0 ? 0 : rows.size() * page_ids.size() / sample_pages;
+  table_stats->columns_.resize(schema->GetColumnCount());
+  std::vector<const Field *> values;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    values.clear();
+    for (auto &row : rows) {
+      auto field = row.GetField(i);
+      if (!field->IsNull()) {
+        values.push_back(field);
+      }
+    }
+    std::sort(values.begin(), values.end(),
+              [](const Field *a, const Field *b) { return a->CompareLessThan(*b) == CmpBool::kTrue; });
+    table_stats->BuildColumn(&table_stats->columns_[i], values, rows.size());
+  }
+  if (!table_stats->ShrinkToPage()) {
+    delete table_stats;
+    return nullptr;
+  }
+  return table_stats;
+}
+
+void TableStatistics::BuildColumn(ColumnStatistics *column, const std::vector<const Field *> &values,
+                                  uint64_t sample_size) {
+  column->histogram_bounds_.clear();
+  column->null_fraction_ = sample_size == 0 ? 0 : 1.0f * (sample_size - values.size()) / sample_size;
+  if (values.empty()) {
+    column->distinct_count_ = 0;
+    return;
+  }
+  // distinct values and values seen only once in the sample
+  uint64_t distinct = 0, singletons = 0;
+  for (size_t i = 0, j; i < values.size(); i = j) {
+    for (j = i + 1; j < values.size() && values[j]->CompareEquals(*values[i]) == CmpBool::kTrue; j++) {
+    }
+    distinct++;
+    singletons += (j - i == 1);
+  }
+  // scale up with the Haas-Stokes estimator D = n * d / (n - f1 + f1 * n / N) if only a part is sampled
+  double n = values.size();
+  double total = std::max(n, row_count_ * (1.0 - column->null_fraction_));
+  double estimate = n * distinct / (n - singletons + singletons * n / total);
+  column->distinct_count_ = std::max<uint64_t>(distinct, std::min<uint64_t>(estimate, total));
+  // equi-depth histogram
+  uint64_t bucket_count = std::min<uint64_t>(STATS_HISTOGRAM_BUCKETS, values.size());
+  for (uint64_t i = 0; i <= bucket_count; i++) {
+    auto value = values[i * (values.size() - 1) / bucket_count];
+    if (value->GetTypeId() == kTypeChar && value->GetLength() > STATS_MAX_BOUND_LEN) {
+      column->histogram_bounds_.emplace_back(kTypeChar, const_cast<char *>(value->GetData()), STATS_MAX_BOUND_LEN,
+                                             true);
+    } else {
+      column->histogram_bounds_.emplace_back(*value);
+    }
+  }
+}
+
+bool TableStatistics::ShrinkToPage() {
+  while (GetSerializedSize() > PAGE_SIZE) {
+    bool shrunk = false;
+    for (auto &column : columns_) {
+      auto &bounds = column.histogram_bounds_;
+      if (bounds.size() <= 2) {
+        continue;
+      }
+      std::vector<Field> kept;
+      for (size_t i = 0; i < bounds.size(); i += 2) {
+        kept.emplace_back(bounds[i]);
+      }
+      if ((bounds.size() - 1) % 2 != 0) {
+        kept.emplace_back(bounds.back());
+      }
+      bounds.swap(kept);
+      shrunk = true;
+    }
+    if (!shrunk) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t TableStatistics::SerializeTo(char *buf) const {
+  char *p = buf;
+  ASSERT(GetSerializedSize() <= PAGE_SIZE, "Failed to serialize table statistics.");
+  MACH_WRITE_UINT32(buf, TABLE_STATISTICS_MAGIC_NUM);
+  buf += 4;
+  MACH_WRITE_TO(uint64_t, buf, row_count_);
+  buf += 8;
+  MACH_WRITE_UINT32(buf, page_count_);
+  buf += 4;
+  MACH_WRITE_UINT32(buf, columns_.size());
+  buf += 4;
+  for (auto &column : columns_) {
+    MACH_WRITE_TO(uint64_t, buf, column.distinct_count_);
+    buf += 8;
+    MACH_WRITE_TO(float, buf, column.null_fraction_);
+    buf += 4;
+    MACH_WRITE_UINT32(buf, column.histogram_bounds_.size());
+    buf += 4;
+    for (auto &bound : column.histogram_bounds_) {
+      buf += bound.SerializeTo(buf);
+    }
+  }
+  return buf - p;
+}
+
+uint32_t TableStatistics::GetSerializedSize() const {
+  uint32_t size = 4 + 8 + 4 + 4;
+  for (auto &column : columns_) {
+    size += 8 + 4 + 4;
+    for (auto &bound : column.histogram_bounds_) {
+      size += bound.GetSerializedSize();
+    }
+  }
+  return size;
+}
+
+uint32_t TableStatistics::DeserializeFrom(char *buf, Schema *schema, TableStatistics *&table_stats) {
+  char *p = buf;
+  uint32_t magic_num = MACH_READ_UINT32(buf);
+  buf += 4;
+  ASSERT(magic_num == TABLE_STATISTICS_MAGIC_NUM, "Failed to deserialize table statistics.");
+  table_stats = new TableStatistics();
+  table_stats->row_count_ = MACH_READ_FROM(uint64_t, buf);
+  buf += 8;
+  table_stats->page_count_ = MACH_READ_UINT32(buf);
+  buf += 4;
+  uint32_t column_count = MACH_READ_UINT32(buf);
+  buf += 4;
+  ASSERT(column_count == schema->GetColumnCount(), "Table statistics do not match the schema.");
+  table_stats->columns_.resize(column_count);
+  for (uint32_t i = 0; i < column_count; i++) {
+    auto &column = table_stats->columns_[i];
+    column.distinct_count_ = MACH_READ_FROM(uint64_t, buf);
+    buf += 8;
+    column.null_fraction_ = MACH_READ_FROM(float, buf);
+    buf += 4;
+    uint32_t bound_count = MACH_READ_UINT32(buf);
+    buf += 4;
+    for (uint32_t j = 0; j < bound_count; j++) {
+      Field *bound = nullptr;
+      buf += Field::DeserializeFrom(buf, schema->GetColumn(i)->GetType(), &bound, false);
+      column.histogram_bounds_.emplace_back(*bound);
+      delete bound;
+    }
+  }
+  return buf - p;
+}
+
+void TableStatistics::ApplyModifications(uint64_t inserted_tuples, uint64_t deleted_tuples) {
+  row_count_ += inserted_tuples;
+  row_count_ = row_count_ > deleted_tuples ? row_count_ - deleted_tuples : 0;
+}
+
+double TableStatistics::EstimateSelectivity(uint32_t column_index, const std::string &comparison,
+                                            const Field &value) const {
+  auto &column = columns_[column_index];
+  // comparisons with null are never true
+  if (value.IsNull() || column.histogram_bounds_.empty()) {
+    return 0;
+  }
+  double not_null = 1.0 - column.null_fraction_;
+  auto &bounds = column.histogram_bounds_;
+  if (comparison == "=" || comparison == "<>") {
+    double equal = 0;
+    if (value.CompareGreaterThanEquals(bounds.front()) == CmpBool::kTrue &&
+        value.CompareLessThanEquals(bounds.back()) == CmpBool::kTrue) {
+      // a value repeated over several bounds fills the buckets between them
+      auto repeated = std::count_if(bounds.begin(), bounds.end(), [&value](const Field &bound) {
+        return bound.CompareEquals(value) == CmpBool::kTrue;
+      });
+      equal = std::max(1.0 / std::max<uint64_t>(column.distinct_count_, 1),
+                       (repeated - 1.0) / std::max<size_t>(bounds.size() - 1, 1));
+    }
+    equal = std::min(equal, 1.0);
+    return not_null * (comparison == "=" ? equal : 1.0 - equal);
+  }
+  if (comparison == "<") {
+    return not_null * EstimateLessThan(column, value, false);
+  }
+  if (comparison == "<=") {
+    return not_null * EstimateLessThan(column, value, true);
+  }
+  if (comparison == ">") {
+    return not_null * (1.0 - EstimateLessThan(column, value, true));
+  }
+  if (comparison == ">=") {
+    return not_null * (1.0 - EstimateLessThan(column, value, false));
+  }
+  return 1.0;
+}
+
+double TableStatistics::EstimateRangeSelectivity(uint32_t column_index, const Field *lower, bool lower_inclusive,
+                                                 const Field *upper, bool upper_inclusive) const {
+  if (lower != nullptr && upper != nullptr && lower_inclusive && upper_inclusive &&
+      lower->CompareEquals(*upper) == CmpBool::kTrue) {
+    return EstimateSelectivity(column_index, "=", *lower);
+  }
+  // null values are in no range, every bound cuts off the values beyond it
+  double not_null = 1.0 - columns_[column_index].null_fraction_;
+  double selectivity = not_null;
+  if (lower != nullptr) {
+    selectivity -= not_null - EstimateSelectivity(column_index, lower_inclusive ? ">=" : ">", *lower);
+  }
+  if (upper != nullptr) {
+    selectivity -= not_null - EstimateSelectivity(column_index, upper_inclusive ? "<=" : "<", *upper);
+  }
+  return std::max(selectivity, 0.0);
+}
+
+double TableStatistics::EstimateLessThan(const ColumnStatistics &column, const Field &value, bool inclusive) {
+  auto &bounds = column.histogram_bounds_;
+  auto before = [&value, inclusive](const Field &bound) {
+    return (inclusive ? bound.CompareLessThanEquals(value) : bound.CompareLessThan(value)) == CmpBool::kTrue;
+  };
+  if (bounds.size() == 1) {
+    return before(bounds[0]) ? 1.0 : 0.0;
+  }
+  // buckets entirely before value, plus half of the bucket value falls into
+  size_t bucket_count = bounds.size() - 1;
+  size_t full = 0;
+  while (full < bucket_count && before(bounds[full + 1])) {
+    full++;
+  }
+  double partial = (full < bucket_count && before(bounds[full])) ? 0.5 : 0.0;
+  return (full + partial) / bucket_count;
+}
@@ -0,0 +1,30 @@
+#include "common/arena.h"
+
+char *Arena::Allocate(size_t size) {
+  size = (size + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+  allocated_bytes_ += size;
+  if (size > ARENA_BLOCK_SIZE / 4) {
+    large_blocks_.push_back(std::make_unique<char[]>(size));
+    return large_blocks_.back().get();
+  }
+  if (size > remaining_) {
+    blocks_.push_back(std::make_unique<char[]>(ARENA_BLOCK_SIZE));
+    cursor_ = blocks_.back().get();
+    remaining_ = ARENA_BLOCK_SIZE;
+  }
+  auto data = cursor_;
+  cursor_ += size;
+  remaining_ -= size;
+  return data;
+}
+
+void Arena::Reset() {
+  allocated_bytes_ = 0;
+  large_blocks_.clear();
+  if (blocks_.empty()) {
+    return;
+  }
+  blocks_.resize(1);
+  cursor_ = blocks_.front().get();
+  remaining_ = ARENA_BLOCK_SIZE;
+}
@@ -88,7 +88,7 @@ dberr_t ExecuteEngine::ExecutePlan(const AbstractPlanNodeRef &plan, std::vector<
     Row row{};
     while (executor->Next(&row, &rid)) {
       if (result_set != nullptr) {
-        result_set->push_back(row);
+        result_set->push_back(std::move(row));
       }
     }
   } catch (const exception &ex) {
@@ -105,9 +105,13 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
   if (ast == nullptr) {
     return DB_FAILED;
   }
+  std::lock_guard<std::recursive_mutex> guard(latch_);
   auto start_time = std::chrono::system_clock::now();
   unique_ptr<ExecuteContext> context(nullptr);
-  if (!current_db_.empty()) context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+  if (!current_db_.empty()) {
+    context = dbs_[current_db_]->MakeExecuteContext(nullptr);
+    context->SetScanWorkers(scan_workers_);
+  }
   switch (ast->type_) {
     case kNodeCreateDB:
       return ExecuteCreateDatabase(ast, context.get());
@@ -139,6 +143,10 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
       return ExecuteExecfile(ast, context.get());
     case kNodeQuit:
       return ExecuteQuit(ast, context.get());
+    case kNodeVacuum:
+      return ExecuteVacuum(ast, context.get());
+    case kNodeAnalyze:
+      return ExecuteAnalyze(ast, context.get());
     default:
       break;
   }
@@ -149,6 +157,7 @@ dberr_t ExecuteEngine::Execute(pSyntaxNode ast) {
     planner.PlanQuery(ast);
     // Execute the query.
     ExecutePlan(planner.plan_, &result_set, nullptr, context.get());
+    parallel_scans_ += context->GetParallelScans();
   } catch (const exception &ex) {
     std::cout << "Error Encountered in Planner: " << ex.what() << std::endl;
     return DB_FAILED;
@@ -357,6 +366,20 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
   }
   auto definition = list->child_;
 
+  // page layout, row by default
+  TableLayout layout = TableLayout::kRow;
+  if (list->next_ != nullptr && list->next_->type_ == kNodeTableLayout) {
+    string layout_name(list->next_->child_->val_);
+    if (layout_name == "pax") {
+      layout = TableLayout::kPax;
+    } else if (layout_name == "clustered") {
+      layout = TableLayout::kClustered;
+    } else if (layout_name != "row") {
+      cout << "Unknown table layout " << layout_name << "." << endl;
+      return DB_FAILED;
+    }
+  }
+
   // isunique primary
   vector<string> uniques;
   vector<string> primarys;
@@ -378,34 +401,77 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
     bool isunique = false;
     string c_name = definition->child_->val_;
     string c_type = definition->child_->next_->val_;
-    if (definition->val_ != nullptr && string(definition->val_) == "unique") {
+    string constraint = definition->val_ != nullptr ? definition->val_ : "";
+    if (constraint == "unique" || constraint == "not null unique") {
       isunique = true;
       uniques.push_back(c_name);
     }
+    if (constraint == "not null" || constraint == "not null unique") {
+      nullable = false;
+    }
+    // a primary key column is never null
     auto it = find(primarys.begin(), primarys.end(), c_name);
     if (it != primarys.end()) {
       isunique = true;
+      nullable = false;
       uniques.push_back(c_name);
     }
     if (c_type == "int")
-      column = new Column(c_name, kTypeInt, index, true, isunique);
+      column = new Column(c_name, kTypeInt, index, nullable, isunique);
     else if (c_type == "float")
-      column = new Column(c_name, kTypeFloat, index, true, isunique);
+      column = new Column(c_name, kTypeFloat, index, nullable, isunique);
+    else if (c_type == "bigint")
+      column = new Column(c_name, kTypeBigInt, index, nullable, isunique);
+    else if (c_type == "double")
+      column = new Column(c_name, kTypeDouble, index, nullable, isunique);
+    else if (c_type == "timestamp")
+      column = new Column(c_name, kTypeTimestamp, index, nullable, isunique);
     else if (c_type == "char") {
       uint32_t length = stoi(definition->child_->next_->child_->val_);
-      column = new Column(c_name, kTypeChar, length, index, true, isunique);
+      column = new Column(c_name, kTypeChar, length, index, nullable, isunique);
     }
     columns.push_back(column);
     index++;
     definition = definition->next_;
   }
 
+  // a clustered table is ordered by its primary key and can not have secondary indexes
+  vector<uint32_t> cluster_key;
+  if (layout == TableLayout::kClustered) {
+    string error;
+    for (const auto &it : primarys) {
+      auto column = find_if(columns.begin(), columns.end(), [&it](Column *c) { return c->GetName() == it; });
+      if (column == columns.end()) {
+        error = "Unknown primary key column " + it + ".";
+        break;
+      }
+      cluster_key.push_back((*column)->GetTableInd());
+    }
+    if (error.empty() && cluster_key.empty()) {
+      error = "A clustered table needs a primary key.";
+    }
+    for (const auto &it : uniques) {
+      if (error.empty() && find(primarys.begin(), primarys.end(), it) == primarys.end()) {
+        error = "Unique column " + it + " is not supported in a clustered table.";
+      }
+    }
+    if (!error.empty()) {
+      cout << error << endl;
+      for (auto column : columns) delete column;
+      return DB_FAILED;
+    }
+  }
+
   // create table
   auto catalog = context->GetCatalog();
   Schema *schema = new Schema(columns);
   TableInfo *table_info;
-  auto result = catalog->CreateTable(table_name, schema, context->GetTransaction(), table_info);
+  auto result = catalog->CreateTable(table_name, schema, context->GetTransaction(), table_info, layout, cluster_key);
   if (result != DB_SUCCESS) return result;
+  if (layout == TableLayout::kClustered) {
+    // the table itself is the primary key index
+    return result;
+  }
 
   // unique index
   for (auto it : uniques) {
@@ -414,14 +480,14 @@ dberr_t ExecuteEngine::ExecuteCreateTable(pSyntaxNode ast, ExecuteContext *conte
     IndexInfo *index_info;
     std::vector<std::string> unique_index;
     unique_index.push_back(it);
-    catalog->CreateIndex(table_name, index_name, unique_index, context->GetTransaction(), index_info, "btree");
+    catalog->CreateIndex(table_name, index_name, unique_index, context->GetTransaction(), index_info, "bptree");
   }
   if (primarys.size() > 0) {
     string index_name = "AUTO_CREATED_INDEX_OF_";
     for (auto it : primarys) index_name += it + "_";
     index_name += "ON_" + table_name;
     IndexInfo *index_info;
-    catalog->CreateIndex(table_name, index_name, primarys, context->GetTransaction(), index_info, "btree");
+    catalog->CreateIndex(table_name, index_name, primarys, context->GetTransaction(), index_info, "bptree");
   }
 
   return result;
@@ -502,9 +568,25 @@ dberr_t ExecuteEngine::ExecuteCreateIndex(pSyntaxNode ast, ExecuteContext *conte
     keys.push_back(key->val_);
     key = key->next_;
   }
+  // create index ... using blinktree
+  string index_type = "bptree";
+  if (list->next_ != nullptr && list->next_->type_ == kNodeIndexType) {
+    index_type = list->next_->child_->val_;
+  }
   IndexInfo *index_info;
   auto catalog = context->GetCatalog();
-  auto result = catalog->CreateIndex(t_name, i_name, keys, context->GetTransaction(), index_info, "btree");
+#ifdef ENABLE_EXECUTE_DEBUG
+  auto start_time = std::chrono::steady_clock::now();
+#endif
+  auto result = catalog->CreateIndex(t_name, i_name, keys, context->GetTransaction(), index_info, index_type,
+                                     context->GetScanWorkers());
+#ifdef ENABLE_EXECUTE_DEBUG
+  auto build_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_time).count();
+  // tables smaller than PARALLEL_SCAN_MIN_PAGES are built by one thread whatever the worker count
+  LOG(INFO) << "CreateIndex " << i_name << " on " << t_name << ": " << build_ms << " ms with up to "
+            << context->GetScanWorkers() << " worker(s)" << std::endl;
+#endif
   return result;
 }
 
@@ -640,3 +722,89 @@ dberr_t ExecuteEngine::ExecuteQuit(pSyntaxNode ast, ExecuteContext *context) {
   current_db_ = "";
   return DB_QUIT;
 }
+
+dberr_t ExecuteEngine::ExecuteVacuum(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteVacuum" << std::endl;
+#endif
+  if (current_db_.empty()) return DB_FAILED;
+  auto catalog = context->GetCatalog();
+
+  // vacuum the given table, or all the tables if no table is given
+  vector<TableInfo *> tables;
+  if (ast->child_ != nullptr) {
+    TableInfo *table_info;
+    auto result = catalog->GetTable(ast->child_->val_, table_info);
+    if (result != DB_SUCCESS) return result;
+    tables.push_back(table_info);
+  } else {
+    catalog->GetTables(tables);
+  }
+  for (auto table : tables) {
+    auto pages_before = table->GetTableHeap()->GetPageCount();
+    uint32_t reclaimed_bytes = 0;
+    auto result = catalog->VacuumTable(table->GetTableName(), context->GetTransaction(), reclaimed_bytes);
+    if (result != DB_SUCCESS) return result;
+    auto pages_after = table->GetTableHeap()->GetPageCount();
+    cout << "Vacuum " << table->GetTableName() << ": " << reclaimed_bytes << " byte(s) reclaimed, "
+         << pages_before - pages_after << " page(s) freed." << endl;
+  }
+  return DB_SUCCESS;
+}
+
+dberr_t ExecuteEngine::ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context) {
+#ifdef ENABLE_EXECUTE_DEBUG
+  LOG(INFO) << "ExecuteAnalyze" << std::endl;
+#endif
+  if (current_db_.empty()) return DB_FAILED;
+  auto catalog = context->GetCatalog();
+
+  // analyze the given table, or all the tables if no table is given
+  vector<TableInfo *> tables;
+  if (ast->child_ != nullptr) {
+    TableInfo *table_info;
+    auto result = catalog->GetTable(ast->child_->val_, table_info);
+    if (result != DB_SUCCESS) return result;
+    tables.push_back(table_info);
+  } else {
+    catalog->GetTables(tables);
+  }
+  for (auto table : tables) {
+    TableStatistics *table_stats;
+    auto result = catalog->AnalyzeTable(table->GetTableName(), context->GetTransaction(), table_stats);
+    if (result != DB_SUCCESS) return result;
+    cout << "Analyze " << table->GetTableName() << ": " << table_stats->GetRowCount() << " row(s), "
+         << table_stats->GetPageCount() << " page(s)." << endl;
+  }
+  return DB_SUCCESS;
+}
+
+void ExecuteEngine::StartBackgroundVacuum(uint32_t interval_ms) {
+  if (vacuum_thread_.joinable()) return;
+  vacuum_stop_ = false;
+  vacuum_thread_ = std::thread([this, interval_ms] {
+    std::unique_lock<std::mutex> lock(vacuum_mutex_);
+    while (!vacuum_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms), [this] { return vacuum_stop_; })) {
+      std::lock_guard<std::recursive_mutex> guard(latch_);
+      for (auto &db : dbs_) {
+        auto catalog = db.second->catalog_mgr_;
+        vector<TableInfo *> tables;
+        catalog->GetTables(tables);
+        for (auto table : tables) {
+          uint32_t reclaimed_bytes = 0;
+          catalog->VacuumTable(table->GetTableName(), nullptr, reclaimed_bytes);
+        }
+      }
+    }
+  });
+}
+
+void ExecuteEngine::StopBackgroundVacuum() {
+  if (!vacuum_thread_.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(vacuum_mutex_);
+    vacuum_stop_ = true;
+  }
+  vacuum_cv_.notify_all();
+  vacuum_thread_.join();
+}
@@ -1,18 +1,44 @@
 #include "executor/executors/index_scan_executor.h"
 
-class RowidCompare {
- public:
-  bool operator()(RowId rid1, RowId rid2) { return rid1.Get() < rid2.Get(); }
-};
-
 IndexScanExecutor::IndexScanExecutor(ExecuteContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx), plan_(plan) {}
 
 void IndexScanExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
   auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  result_ = IndexScan(plan_->GetPredicate());
+  ranges_.clear();
+  range_pos_ = 0;
+  bitmap_ = RowIdBitmap();
+  page_rows_.clear();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), plan_->OutputSchema());
+  referenced_.assign(table_info_->GetSchema()->GetColumnCount(), false);
+  for (auto column : plan_->OutputSchema()->GetColumns()) {
+    referenced_[column->GetTableInd()] = true;
+  }
+  if (plan_->need_filter_) {
+    CollectColumns(plan_->GetPredicate(), &referenced_);
+  }
+  // contradictory ranges match no row
+  if (plan_->empty_range_) {
+    return;
+  }
+  if (!plan_->union_ranges_.empty()) {
+    bitmap_ = ScanUnion();
+  } else if (!OpenRanges(plan_->GetPredicate())) {
+    bitmap_ = plan_->key_ranges_.empty() ? IndexScan(plan_->GetPredicate()) : ScanKeyRanges(plan_->key_ranges_);
+  }
+}
+
+void IndexScanExecutor::CollectColumns(const AbstractExpressionRef &expr, std::vector<bool> *referenced) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetType() == ExpressionType::ColumnExpression) {
+    (*referenced)[std::dynamic_pointer_cast<ColumnValueExpression>(expr)->GetColIdx()] = true;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, referenced);
+  }
 }
 
 bool IndexScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
@@ -35,33 +61,30 @@ bool IndexScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *ou
 void IndexScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row,
                                       Row *output_row) {
   const auto &output_columns = output_schema->GetColumns();
-  std::vector<Field> dest_row;
-  dest_row.reserve(output_columns.size());
+  std::vector<const Field *> dest_fields;
+  dest_fields.reserve(output_columns.size());
   for (const auto column : output_columns) {
-    auto idx = column->GetTableInd();
-    dest_row.emplace_back(*row->GetField(idx));
+    dest_fields.push_back(row->GetField(column->GetTableInd()));
   }
-  *output_row = Row(dest_row);
+  Row dest_row(dest_fields);
+  *output_row = std::move(dest_row);
 }
 
-vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
+RowIdBitmap IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
   switch (predicate->GetType()) {
     case ExpressionType::LogicExpression: {
-      vector<RowId> lhs = IndexScan(predicate->GetChildAt(0));
-      vector<RowId> rhs = IndexScan(predicate->GetChildAt(1));
+      RowIdBitmap lhs = IndexScan(predicate->GetChildAt(0));
+      RowIdBitmap rhs = IndexScan(predicate->GetChildAt(1));
       // The function cannot differentiate between the case where the number of rows that
       // meet the criteria in the indexed column is zero and the case where the column is
       // not indexed. Writing it this way will ignore the filtering effect brought about
       // by having zero rows that meet the criteria in the indexed column.
       if (plan_->need_filter_) {
-        if (lhs.empty()) return rhs;
-        if (rhs.empty()) return lhs;
+        if (lhs.IsEmpty()) return rhs;
+        if (rhs.IsEmpty()) return lhs;
       }
-      sort(lhs.begin(), lhs.end(), RowidCompare());
-      sort(rhs.begin(), rhs.end(), RowidCompare());
-      vector<RowId> result;
-      set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), back_inserter(result), RowidCompare());
-      return result;
+      lhs.Intersect(rhs);
+      return lhs;
     }
     case ExpressionType::ComparisonExpression: {
       std::vector<RowId> ret;
@@ -75,35 +98,147 @@ vector<RowId> IndexScanExecutor::IndexScan(AbstractExpressionRef predicate) {
           break;
         }
       }
-      return ret;
+      RowIdBitmap result;
+      for (const auto &rid : ret) {
+        result.Add(rid);
+      }
+      return result;
     }
     default:
       break;
   }
+  return RowIdBitmap();
 }
 
-bool IndexScanExecutor::Next(Row *row, RowId *rid) {
+bool IndexScanExecutor::OpenRanges(const AbstractExpressionRef &predicate) {
+  if (plan_->key_ranges_.size() == 1) {
+    ranges_.push_back(ScanKeyRange(plan_->key_ranges_[0]));
+    return true;
+  }
+  if (!plan_->key_ranges_.empty() || predicate->GetType() != ExpressionType::ComparisonExpression ||
+      predicate->GetChildAt(0)->GetType() != ExpressionType::ColumnExpression) {
+    return false;
+  }
+  uint32_t col_idx = dynamic_pointer_cast<ColumnValueExpression>(predicate->GetChildAt(0))->GetColIdx();
+  BPlusTreeIndex *tree_index = nullptr;
+  for (auto index : plan_->indexes_) {
+    if (col_idx == index->GetIndexKeySchema()->GetColumn(0)->GetTableInd()) {
+      tree_index = dynamic_cast<BPlusTreeIndex *>(index->GetIndex());
+      break;
+    }
+  }
+  auto comparison_type = dynamic_pointer_cast<ComparisonExpression>(predicate)->GetComparisonType();
+  if (tree_index == nullptr || comparison_type == "=") {
+    // a point lookup reads a single leaf anyway
+    return false;
+  }
+  std::vector<Field> fields{predicate->GetChildAt(1)->Evaluate(nullptr)};
+  Row key(fields);
+  if (comparison_type == ">" || comparison_type == ">=") {
+    ranges_.push_back(tree_index->ScanRange(&key, comparison_type == ">=", nullptr, false));
+  } else if (comparison_type == "<" || comparison_type == "<=") {
+    ranges_.push_back(tree_index->ScanRange(nullptr, false, &key, comparison_type == "<="));
+  } else if (comparison_type == "<>") {
+    ranges_.push_back(tree_index->ScanRange(nullptr, false, &key, false));
+    ranges_.push_back(tree_index->ScanRange(&key, false, nullptr, false));
+  } else {
+    return false;
+  }
+  return true;
+}
+
+RowIdBitmap IndexScanExecutor::ScanKeyRanges(const std::vector<IndexKeyRange> &key_ranges) {
+  RowIdBitmap result;
+  for (size_t i = 0; i < key_ranges.size(); i++) {
+    RowIdBitmap rids;
+    auto range = ScanKeyRange(key_ranges[i]);
+    RowId rid;
+    while (range.Next(&rid)) {
+      rids.Add(rid);
+    }
+    if (i == 0) {
+      result = std::move(rids);
+    } else {
+      result.Intersect(rids);
+    }
+  }
+  return result;
+}
+
+RowIdBitmap IndexScanExecutor::ScanUnion() {
+  // a row matching several disjuncts is fetched once
+  RowIdBitmap result;
+  for (const auto &key_ranges : plan_->union_ranges_) {
+    result.Union(ScanKeyRanges(key_ranges));
+  }
+  return result;
+}
+
+BPlusTreeIndex::RangeIterator IndexScanExecutor::ScanKeyRange(const IndexKeyRange &range) {
+  auto tree_index = dynamic_cast<BPlusTreeIndex *>(range.index_->GetIndex());
+  std::vector<Field> lower_fields;
+  std::vector<Field> upper_fields;
+  if (range.lower_ != nullptr) {
+    lower_fields.emplace_back(*range.lower_);
+  }
+  if (range.upper_ != nullptr) {
+    upper_fields.emplace_back(*range.upper_);
+  }
+  Row lower(lower_fields);
+  Row upper(upper_fields);
+  return tree_index->ScanRange(range.lower_ != nullptr ? &lower : nullptr, range.lower_inclusive_,
+                               range.upper_ != nullptr ? &upper : nullptr, range.upper_inclusive_);
+}
+
+bool IndexScanExecutor::FillBitmap() {
+  uint32_t count = 0;
+  RowId rid;
+  while (range_pos_ < ranges_.size() && count < INDEX_SCAN_BATCH_ROWS) {
+    if (ranges_[range_pos_].Next(&rid)) {
+      bitmap_.Add(rid);
+      count++;
+    } else {
+      range_pos_++;
+    }
+  }
+  return count > 0;
+}
+
+bool IndexScanExecutor::ScanPage() {
+  page_id_t page_id;
+  if (!bitmap_.PopPage(&page_id, &slots_)) {
+    return false;
+  }
   auto predicate = plan_->GetPredicate();
   auto table_schema = table_info_->GetSchema();
-  while (cursor_ < result_.size()) {
-    auto p_row = new Row(result_[cursor_]);
-    table_info_->GetTableHeap()->GetTuple(p_row, nullptr);
-    if (plan_->need_filter_) {
-      if (!predicate->Evaluate(p_row).CompareEquals(Field(kTypeInt, 1))) {
-        cursor_++;
-        delete p_row;
-        continue;
-      }
+  // the tuples are read in place, only the ones passing the filter are copied out
+  TableHeap::TupleVisitor visit = [&](const TupleView &view) {
+    arena_.Reset();
+    Row p_row(view.GetRowId(), &arena_);
+    if (!view.Bind(referenced_, &p_row)) {
+      return false;
     }
-    *rid = result_[cursor_];
-    if (!is_schema_same_) {
-      TupleTransfer(table_schema, plan_->OutputSchema(), p_row, row);
-    } else {
-      *row = *p_row;
+    if (plan_->need_filter_ && !predicate->Evaluate(&p_row).CompareEquals(Field(kTypeInt, 1))) {
+      return true;
     }
-    delete p_row;
-    cursor_++;
+    page_rows_.emplace_back();
+    TupleTransfer(table_schema, plan_->OutputSchema(), &p_row, &page_rows_.back());
+    page_rows_.back().SetRowId(view.GetRowId());
     return true;
+  };
+  table_info_->GetTableHeap()->VisitSlots(page_id, slots_, visit, nullptr, &referenced_);
+  return true;
+}
+
+bool IndexScanExecutor::Next(Row *row, RowId *rid) {
+  while (page_rows_.empty()) {
+    if (bitmap_.IsEmpty() && !FillBitmap()) {
+      return false;
+    }
+    ScanPage();
   }
-  return false;
+  *rid = page_rows_.front().GetRowId();
+  *row = std::move(page_rows_.front());
+  page_rows_.pop_front();
+  return true;
 }
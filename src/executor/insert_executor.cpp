@@ -19,6 +19,12 @@ bool InsertExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
     Row insert_row;
     RowId insert_rid;
     if (child_executor_->Next(&insert_row, &insert_rid)) {
+        for (uint32_t i = 0; i < schema_->GetColumnCount(); i++) {
+            if (insert_row.GetField(i)->IsNull() && !schema_->GetColumn(i)->IsNullable()) {
+                std::cout << "column " << schema_->GetColumn(i)->GetName() << " can not be null" << std::endl;
+                return false;
+            }
+        }
         for (auto info: index_info_) {
             Row key_row;
             insert_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), key_row);
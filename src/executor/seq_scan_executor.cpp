@@ -3,12 +3,19 @@
 //
 #include "executor/executors/seq_scan_executor.h"
 
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
 SeqScanExecutor::SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       iterator_(nullptr, RowId(INVALID_PAGE_ID, 0), nullptr),
       is_schema_same_(false) {}
 
+SeqScanExecutor::~SeqScanExecutor() { StopParallelScan(); }
+
 bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *output_schema) {
   auto table_columns = table_schema->GetColumns();
   auto output_columns = output_schema->GetColumns();
@@ -29,39 +36,367 @@ bool SeqScanExecutor::SchemaEqual(const Schema *table_schema, const Schema *outp
 void SeqScanExecutor::TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row,
                                     Row *output_row) {
   const auto &output_columns = output_schema->GetColumns();
-  std::vector<Field> dest_row;
-  dest_row.reserve(output_columns.size());
+  std::vector<const Field *> dest_fields;
+  dest_fields.reserve(output_columns.size());
   for (const auto column : output_columns) {
-    auto idx = column->GetTableInd();
-    dest_row.emplace_back(*row->GetField(idx));
+    dest_fields.push_back(row->GetField(column->GetTableInd()));
   }
-  *output_row = Row(dest_row);
+  Row dest_row(dest_fields);
+  *output_row = std::move(dest_row);
 }
 
 void SeqScanExecutor::Init() {
+  StopParallelScan();
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
-  auto first_row = table_info_->GetTableHeap()->Begin(nullptr);
-  iterator_ = (table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction()));
   schema_ = plan_->OutputSchema();
   is_schema_same_ = SchemaEqual(table_info_->GetSchema(), schema_);
+  referenced_.assign(table_info_->GetSchema()->GetColumnCount(), false);
+  for (auto column : schema_->GetColumns()) {
+    referenced_[column->GetTableInd()] = true;
+  }
+  CollectColumns(plan_->GetPredicate(), &referenced_);
+  // only the overflow values of the projected and filtered columns are read
+  iterator_ = table_info_->GetTableHeap()->Begin(exec_ctx_->GetTransaction(), &referenced_);
+  next_page_id_ = INVALID_PAGE_ID;
+  page_rows_.clear();
+  if (table_info_->GetLayout() == TableLayout::kRow) {
+    next_page_id_ = table_info_->GetTableHeap()->GetFirstPageId();
+  }
+  if (table_info_->GetLayout() == TableLayout::kPax) {
+    pax_heap_ = static_cast<PaxTableHeap *>(table_info_->GetTableHeap());
+    scan_columns_.clear();
+    column_slots_.assign(referenced_.size(), -1);
+    for (uint32_t i = 0; i < referenced_.size(); i++) {
+      if (referenced_[i]) {
+        column_slots_[i] = static_cast<int>(scan_columns_.size());
+        scan_columns_.push_back(i);
+      }
+    }
+    null_fields_.clear();
+    for (auto column : table_info_->GetSchema()->GetColumns()) {
+      null_fields_.emplace_back(column->GetType());
+    }
+    batch_.rids_.clear();
+    batch_pos_ = 0;
+    next_page_id_ = pax_heap_->GetFirstPageId();
+  }
+  lower_bound_.reset();
+  upper_bound_.reset();
+  if (table_info_->GetLayout() == TableLayout::kClustered) {
+    auto clustered_heap = static_cast<ClusteredTableHeap *>(table_info_->GetTableHeap());
+    const auto &key_columns = clustered_heap->GetKeyColumns();
+    // a range on the leading column of a longer key needs the nulls of the other columns to sort first
+    if (key_columns.size() == 1 || clustered_heap->GetKeyEncoding() == KeyEncoding::kNormalized) {
+      // rows come in key order: start at the lower bound with one descent, stop past the upper bound
+      key_column_ = key_columns[0];
+      CollectKeyRange(plan_->GetPredicate(), key_column_);
+      if (lower_bound_ != nullptr) {
+        std::vector<Field> key_fields;
+        key_fields.emplace_back(*lower_bound_);
+        for (size_t i = 1; i < key_columns.size(); i++) {
+          key_fields.emplace_back(table_info_->GetSchema()->GetColumn(key_columns[i])->GetType());
+        }
+        RowId rid;
+        iterator_ = clustered_heap->LowerBound(Row(key_fields), &rid)
+                        ? TableIterator(clustered_heap, rid, exec_ctx_->GetTransaction(), &referenced_)
+                        : clustered_heap->End();
+      }
+    }
+  }
+  zone_predicates_.clear();
+  if (table_info_->GetLayout() == TableLayout::kRow) {
+    CollectZonePredicates(plan_->GetPredicate());
+  }
+  // only a scan the planner marked read-only is split, the child of an update or delete stays serial
+  if (plan_->parallel_ && table_info_->GetLayout() == TableLayout::kRow && exec_ctx_->GetScanWorkers() > 1) {
+    auto page_count = table_info_->GetTableHeap()->GetPageCount();
+    if (page_count >= PARALLEL_SCAN_MIN_PAGES) {
+      auto morsel_count = (page_count + PARALLEL_SCAN_MORSEL_PAGES - 1) / PARALLEL_SCAN_MORSEL_PAGES;
+      StartParallelScan(std::min<uint32_t>(exec_ctx_->GetScanWorkers(), morsel_count));
+    }
+  }
+}
+
+bool SeqScanExecutor::ScanPage(page_id_t page_id, Arena *arena, std::deque<Row> *output, page_id_t *next_page_id) {
+  auto table_schema = table_info_->GetSchema();
+  auto predicate = plan_->GetPredicate();
+  TableHeap::TupleVisitor visit = [&](const TupleView &view) {
+    arena->Reset();
+    Row p_row(view.GetRowId(), arena);
+    if (!view.Bind(referenced_, &p_row)) {
+      return false;
+    }
+    if (predicate != nullptr && !predicate->Evaluate(&p_row).CompareEquals(Field(kTypeInt, 1))) {
+      return true;
+    }
+    output->emplace_back();
+    TupleTransfer(table_schema, schema_, &p_row, &output->back());
+    output->back().SetRowId(view.GetRowId());
+    return true;
+  };
+  return table_info_->GetTableHeap()->VisitPage(page_id, visit, exec_ctx_->GetTransaction(), next_page_id,
+                                                &referenced_);
+}
+
+bool SeqScanExecutor::NextFromPages(Row *row, RowId *rid) {
+  auto table_heap = table_info_->GetTableHeap();
+  while (page_rows_.empty()) {
+    if (next_page_id_ == INVALID_PAGE_ID) {
+      return false;
+    }
+    auto page_id = next_page_id_;
+    if (!zone_predicates_.empty() &&
+        !table_heap->PageMayMatch(page_id, zone_predicates_, exec_ctx_->GetTransaction())) {
+      next_page_id_ = table_heap->GetNextPageId(page_id);
+      continue;
+    }
+    if (!ScanPage(page_id, &arena_, &page_rows_, &next_page_id_)) {
+      next_page_id_ = INVALID_PAGE_ID;
+    }
+  }
+  *rid = page_rows_.front().GetRowId();
+  *row = std::move(page_rows_.front());
+  page_rows_.pop_front();
+  return true;
+}
+
+void SeqScanExecutor::StartParallelScan(uint32_t worker_count) {
+  morsel_page_ids_.clear();
+  table_info_->GetTableHeap()->GetPageIds(&morsel_page_ids_);
+  morsel_count_ = (morsel_page_ids_.size() + PARALLEL_SCAN_MORSEL_PAGES - 1) / PARALLEL_SCAN_MORSEL_PAGES;
+  morsel_rows_.assign(2 * worker_count, std::deque<Row>());
+  morsel_done_.assign(2 * worker_count, false);
+  next_morsel_ = 0;
+  morsel_pos_ = 0;
+  stop_workers_ = false;
+  output_rows_.clear();
+  parallel_ = true;
+  exec_ctx_->AddParallelScan();
+  for (uint32_t i = 0; i < worker_count; i++) {
+    workers_.emplace_back(&SeqScanExecutor::ScanMorsels, this);
+  }
+}
+
+void SeqScanExecutor::ScanMorsels() {
+  auto table_heap = table_info_->GetTableHeap();
+  auto txn = exec_ctx_->GetTransaction();
+  Arena arena;
+  std::deque<Row> output;
+  while (true) {
+    size_t morsel;
+    {
+      // a morsel is claimed only when its slot is free, so the rows waiting to be returned stay bounded
+      std::unique_lock<std::mutex> lock(morsel_latch_);
+      morsel_cv_.wait(lock, [&] { return stop_workers_ || next_morsel_ < morsel_pos_ + morsel_rows_.size(); });
+      if (stop_workers_ || next_morsel_ >= morsel_count_) {
+        return;
+      }
+      morsel = next_morsel_++;
+    }
+    size_t end = std::min(morsel_page_ids_.size(), (morsel + 1) * PARALLEL_SCAN_MORSEL_PAGES);
+    for (size_t i = morsel * PARALLEL_SCAN_MORSEL_PAGES; i < end; i++) {
+      if (!zone_predicates_.empty() && !table_heap->PageMayMatch(morsel_page_ids_[i], zone_predicates_, txn)) {
+        continue;
+      }
+      ScanPage(morsel_page_ids_[i], &arena, &output, nullptr);
+    }
+    std::lock_guard<std::mutex> lock(morsel_latch_);
+    auto slot = morsel % morsel_rows_.size();
+    morsel_rows_[slot] = std::move(output);
+    morsel_done_[slot] = true;
+    output.clear();
+    morsel_cv_.notify_all();
+  }
+}
+
+bool SeqScanExecutor::NextFromMorsels(Row *row, RowId *rid) {
+  while (output_rows_.empty()) {
+    std::unique_lock<std::mutex> lock(morsel_latch_);
+    if (morsel_pos_ >= morsel_count_) {
+      return false;
+    }
+    auto slot = morsel_pos_ % morsel_rows_.size();
+    morsel_cv_.wait(lock, [&] { return static_cast<bool>(morsel_done_[slot]); });
+    output_rows_ = std::move(morsel_rows_[slot]);
+    morsel_rows_[slot].clear();
+    morsel_done_[slot] = false;
+    morsel_pos_++;
+    // the slot is free for the morsel one window ahead
+    morsel_cv_.notify_all();
+  }
+  *rid = output_rows_.front().GetRowId();
+  *row = std::move(output_rows_.front());
+  output_rows_.pop_front();
+  return true;
+}
+
+void SeqScanExecutor::StopParallelScan() {
+  {
+    std::lock_guard<std::mutex> lock(morsel_latch_);
+    stop_workers_ = true;
+  }
+  morsel_cv_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  parallel_ = false;
+}
+
+void SeqScanExecutor::CollectKeyRange(const AbstractExpressionRef &expr, uint32_t key_column) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetType() == ExpressionType::LogicExpression) {
+    if (std::dynamic_pointer_cast<LogicExpression>(expr)->logic_type_ == LogicType::And) {
+      CollectKeyRange(expr->GetChildAt(0), key_column);
+      CollectKeyRange(expr->GetChildAt(1), key_column);
+    }
+    return;
+  }
+  if (expr->GetType() != ExpressionType::ComparisonExpression ||
+      expr->GetChildAt(0)->GetType() != ExpressionType::ColumnExpression ||
+      expr->GetChildAt(1)->GetType() != ExpressionType::ConstantExpression) {
+    return;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(expr->GetChildAt(0));
+  const Field &value = std::dynamic_pointer_cast<ConstantValueExpression>(expr->GetChildAt(1))->val_;
+  // the bound is compared with the keys of the tree, so it must have the type of the key column
+  auto key_schema_column = table_info_->GetSchema()->GetColumn(key_column);
+  if (column->GetColIdx() != key_column || value.IsNull() || value.GetTypeId() != key_schema_column->GetType() ||
+      (value.GetTypeId() == TypeId::kTypeChar && value.GetLength() > key_schema_column->GetLength())) {
+    return;
+  }
+  auto comparison_type = std::dynamic_pointer_cast<ComparisonExpression>(expr)->GetComparisonType();
+  bool is_lower = comparison_type == "=" || comparison_type == ">" || comparison_type == ">=";
+  bool is_upper = comparison_type == "=" || comparison_type == "<" || comparison_type == "<=";
+  bool inclusive = comparison_type == "=" || comparison_type == ">=" || comparison_type == "<=";
+  // keep the tighter of two bounds on the same side
+  if (is_lower && (lower_bound_ == nullptr || value.CompareGreaterThan(*lower_bound_) == CmpBool::kTrue ||
+                   (value.CompareEquals(*lower_bound_) == CmpBool::kTrue && !inclusive))) {
+    lower_bound_ = std::make_unique<Field>(value);
+    lower_inclusive_ = inclusive;
+  }
+  if (is_upper && (upper_bound_ == nullptr || value.CompareLessThan(*upper_bound_) == CmpBool::kTrue ||
+                   (value.CompareEquals(*upper_bound_) == CmpBool::kTrue && !inclusive))) {
+    upper_bound_ = std::make_unique<Field>(value);
+    upper_inclusive_ = inclusive;
+  }
+}
+
+void SeqScanExecutor::CollectZonePredicates(const AbstractExpressionRef &expr) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetType() == ExpressionType::LogicExpression) {
+    if (std::dynamic_pointer_cast<LogicExpression>(expr)->logic_type_ == LogicType::And) {
+      CollectZonePredicates(expr->GetChildAt(0));
+      CollectZonePredicates(expr->GetChildAt(1));
+    }
+    return;
+  }
+  if (expr->GetType() != ExpressionType::ComparisonExpression ||
+      expr->GetChildAt(0)->GetType() != ExpressionType::ColumnExpression ||
+      expr->GetChildAt(1)->GetType() != ExpressionType::ConstantExpression) {
+    return;
+  }
+  auto comparison_type = std::dynamic_pointer_cast<ComparisonExpression>(expr)->GetComparisonType();
+  if (!ZoneMap::IsRangeComparison(comparison_type)) {
+    return;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(expr->GetChildAt(0));
+  const Field &value = std::dynamic_pointer_cast<ConstantValueExpression>(expr->GetChildAt(1))->val_;
+  zone_predicates_.push_back({column->GetColIdx(), comparison_type, &value});
+}
+
+bool SeqScanExecutor::PastUpperBound(const Row &row) const {
+  if (upper_bound_ == nullptr) {
+    return false;
+  }
+  auto key = row.GetField(key_column_);
+  return upper_inclusive_ ? key->CompareGreaterThan(*upper_bound_) == CmpBool::kTrue
+                          : key->CompareGreaterThanEquals(*upper_bound_) == CmpBool::kTrue;
+}
+
+void SeqScanExecutor::CollectColumns(const AbstractExpressionRef &expr, std::vector<bool> *referenced) {
+  if (expr == nullptr) {
+    return;
+  }
+  if (expr->GetType() == ExpressionType::ColumnExpression) {
+    (*referenced)[std::dynamic_pointer_cast<ColumnValueExpression>(expr)->GetColIdx()] = true;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, referenced);
+  }
+}
+
+bool SeqScanExecutor::NextFromColumns(Row *row, RowId *rid) {
+  auto predicate = plan_->GetPredicate();
+  auto table_schema = table_info_->GetSchema();
+  while (true) {
+    while (batch_pos_ < batch_.rids_.size()) {
+      auto pos = batch_pos_++;
+      if (predicate != nullptr) {
+        // columns not referenced by the scan are left null
+        batch_fields_.clear();
+        for (uint32_t i = 0; i < table_schema->GetColumnCount(); i++) {
+          batch_fields_.push_back(column_slots_[i] < 0 ? &null_fields_[i] : &batch_.columns_[column_slots_[i]][pos]);
+        }
+        Row p_row(batch_fields_);
+        if (!predicate->Evaluate(&p_row).CompareEquals(Field(kTypeInt, 1))) {
+          continue;
+        }
+      }
+      batch_fields_.clear();
+      for (auto column : schema_->GetColumns()) {
+        batch_fields_.push_back(&batch_.columns_[column_slots_[column->GetTableInd()]][pos]);
+      }
+      *row = Row(batch_fields_);
+      row->SetRowId(batch_.rids_[pos]);
+      *rid = batch_.rids_[pos];
+      return true;
+    }
+    if (next_page_id_ == INVALID_PAGE_ID ||
+        !pax_heap_->ScanColumns(next_page_id_, scan_columns_, &batch_, &next_page_id_)) {
+      return false;
+    }
+    batch_pos_ = 0;
+  }
 }
 
 bool SeqScanExecutor::Next(Row *row, RowId *rid) {
+  if (pax_heap_ != nullptr) {
+    return NextFromColumns(row, rid);
+  }
+  if (parallel_) {
+    return NextFromMorsels(row, rid);
+  }
+  if (table_info_->GetLayout() == TableLayout::kRow) {
+    return NextFromPages(row, rid);
+  }
   auto predicate = plan_->GetPredicate();
   auto table_schema = table_info_->GetSchema();
-  while (iterator_ != table_info_->GetTableHeap()->End()) {
-    auto p_row = *iterator_;
+  auto table_heap = table_info_->GetTableHeap();
+  while (iterator_ != table_heap->End()) {
+    // a row only read for the projection is scratch memory, there is at most one at a time
+    arena_.Reset();
+    Row p_row(iterator_.GetRowId(), is_schema_same_ ? nullptr : &arena_);
+    table_heap->GetTuple(&p_row, exec_ctx_->GetTransaction(), &referenced_);
+    if (PastUpperBound(p_row)) {
+      iterator_ = table_heap->End();
+      return false;
+    }
     if (predicate != nullptr) {
       if (!predicate->Evaluate(&p_row).CompareEquals(Field(kTypeInt, 1))) {
         iterator_++;
         continue;
       }
     }
-    *rid = iterator_->GetRowId();
+    *rid = iterator_.GetRowId();
     if (!is_schema_same_) {
       TupleTransfer(table_schema, schema_, &p_row, row);
     } else {
-      *row = p_row;
+      *row = std::move(p_row);
     }
     iterator_++;
     return true;
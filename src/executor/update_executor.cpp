@@ -13,23 +13,56 @@ void UpdateExecutor::Init() {
   exec_ctx_->GetCatalog()->GetTable(plan_->GetTableName(), table_info_);
   exec_ctx_->GetCatalog()->GetTableIndexes(table_info_->GetTableName(), index_info_);
   txn_ = exec_ctx_->GetTransaction();
+  clustered_heap_ = nullptr;
+  if (table_info_->GetLayout() == TableLayout::kClustered) {
+    // an update may move rows of a clustered table ahead of the scan and shift the row ids of others
+    clustered_heap_ = static_cast<ClusteredTableHeap *>(table_info_->GetTableHeap());
+    clustered_rows_.clear();
+    clustered_pos_ = 0;
+    Row src_row;
+    RowId src_rid;
+    while (child_executor_->Next(&src_row, &src_rid)) {
+      clustered_rows_.push_back(std::move(src_row));
+    }
+  }
 }
 
 bool UpdateExecutor::Next([[maybe_unused]] Row *row, RowId *rid) {
   Row src_row;
   RowId src_rid;
-  if (child_executor_->Next(&src_row, &src_rid)) {
+  bool has_next;
+  if (clustered_heap_ != nullptr) {
+    has_next = clustered_pos_ < clustered_rows_.size();
+    if (has_next) {
+      src_row = std::move(clustered_rows_[clustered_pos_++]);
+      has_next = clustered_heap_->FindTuple(src_row, &src_rid);
+    }
+  } else {
+    has_next = child_executor_->Next(&src_row, &src_rid);
+  }
+  if (has_next) {
     Row dest_row = GenerateUpdatedTuple(src_row);
+    auto schema = table_info_->GetSchema();
+    for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+      if (dest_row.GetField(i)->IsNull() && !schema->GetColumn(i)->IsNullable()) {
+        std::cout << "column " << schema->GetColumn(i)->GetName() << " can not be null" << std::endl;
+        return false;
+      }
+    }
     if (!table_info_->GetTableHeap()->UpdateTuple(dest_row, src_rid, txn_)) {
       return false;
     }
+    // The row id survives the update, only the indexes whose key is changed need new entries.
     Row src_key_row;
     Row dest_key_row;
     for (auto info : index_info_) {  // 更新索引
       src_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), src_key_row);
       dest_row.GetKeyFromRow(table_info_->GetSchema(), info->GetIndexKeySchema(), dest_key_row);
+      if (SameKey(src_key_row, dest_key_row)) {
+        continue;
+      }
       info->GetIndex()->RemoveEntry(src_key_row, src_rid, txn_);
-      info->GetIndex()->InsertEntry(dest_key_row, src_rid, txn_);
+      info->GetIndex()->InsertEntry(dest_key_row, dest_row.GetRowId(), txn_);
     }
     return true;
   }
@@ -50,4 +83,17 @@ Row UpdateExecutor::GenerateUpdatedTuple(const Row &src_row) {
     }
   }
   return Row{values};
-}
\ No newline at end of file
+}
+
+bool UpdateExecutor::SameKey(const Row &src_key_row, const Row &dest_key_row) {
+  for (uint32_t i = 0; i < src_key_row.GetFieldCount(); i++) {
+    auto src = src_key_row.GetField(i);
+    auto dest = dest_key_row.GetField(i);
+    if (src->IsNull() || dest->IsNull()) {
+      if (src->IsNull() != dest->IsNull()) return false;
+      continue;
+    }
+    if (src->CompareEquals(*dest) != CmpBool::kTrue) return false;
+  }
+  return true;
+}
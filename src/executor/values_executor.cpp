@@ -18,7 +18,8 @@ bool ValuesExecutor::Next(Row *row, RowId *rid) {
     for (auto expr : exprs) {
       values.emplace_back(expr->Evaluate(nullptr));
     }
-    *row = Row{values};
+    Row values_row(values);
+    *row = std::move(values_row);
     cursor_++;
     return true;
   }
@@ -3,7 +3,7 @@
 
 #include <list>
 #include <mutex>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
 #include "buffer/replacer.h"
@@ -38,7 +38,8 @@ class LRUReplacer : public Replacer {
 private:
   size_t num_pages_;
   list<frame_id_t> lru_list_;
-  unordered_set<frame_id_t> lru_set_;
+  // position of every frame in lru_list_, a frame is pinned in O(1)
+  unordered_map<frame_id_t, list<frame_id_t>::iterator> lru_map_;
 };
 
 #endif  // MINISQL_LRU_REPLACER_H
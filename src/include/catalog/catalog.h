@@ -12,6 +12,8 @@
 #include "common/dberr.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/txn.h"
+#include "storage/clustered_table_heap.h"
+#include "storage/pax_table_heap.h"
 #include "recovery/log_manager.h"
 
 class CatalogMeta {//记录和管理这些表和索引的元信息被存储在哪个数据页中
@@ -76,15 +78,24 @@ class CatalogManager {
 
   ~CatalogManager();
 
-  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info);
+  /**
+   * @param cluster_key indexes of the primary key columns, required by a clustered table
+   */
+  dberr_t CreateTable(const std::string &table_name, TableSchema *schema, Txn *txn, TableInfo *&table_info,
+                      TableLayout layout = TableLayout::kRow, const std::vector<uint32_t> &cluster_key = {});
 
   dberr_t GetTable(const std::string &table_name, TableInfo *&table_info);
 
   dberr_t GetTables(std::vector<TableInfo *> &tables) const;
 
+  /**
+   * Secondary indexes are not supported on clustered tables, whose row ids are not stable.
+   * @param index_type "bptree" or "blinktree", see IndexMetadata::Create
+   * @param build_workers threads extracting and sorting the keys of the existing rows
+   */
   dberr_t CreateIndex(const std::string &table_name, const std::string &index_name,
                       const std::vector<std::string> &index_keys, Txn *txn, IndexInfo *&index_info,
-                      const string &index_type);
+                      const string &index_type, uint32_t build_workers = 1);
 
   dberr_t GetIndex(const std::string &table_name, const std::string &index_name, IndexInfo *&index_info) const;
 
@@ -94,6 +105,23 @@ class CatalogManager {
 
   dberr_t DropIndex(const std::string &table_name, const std::string &index_name);
 
+  /**
+   * Vacuum the table heap and redirect the index entries of the rows moved to other pages.
+   * @param[out] reclaimed_bytes bytes given back to the free space of the table pages
+   */
+  dberr_t VacuumTable(const std::string &table_name, Txn *txn, uint32_t &reclaimed_bytes);
+
+  /**
+   * Collect the statistics of the table and store them in its statistics page.
+   */
+  dberr_t AnalyzeTable(const std::string &table_name, Txn *txn, TableStatistics *&table_stats);
+
+  /**
+   * Get the statistics of the table, updated with the tuples inserted and deleted since the last ANALYZE.
+   * @return DB_NOT_EXIST if the table was never analyzed
+   */
+  dberr_t GetTableStatistics(const std::string &table_name, TableStatistics *&table_stats);
+
  private:
   dberr_t DropTable(table_id_t table_id);
 
@@ -105,6 +133,37 @@ class CatalogManager {
 
   dberr_t GetTable(const table_id_t table_id, TableInfo *&table_info);
 
+  /**
+   * Add the keys of the rows of the table to sorter. A large row table is split into page ranges, each
+   * sorted into runs by its own thread, the runs are merged in the order of the page chain so the first row of a key
+   * still goes first.
+   * @param key_map indexes of the key columns in the table schema
+   * @return DB_FAILED if a sorted run could not be spilled
+   */
+  dberr_t SortIndexKeys(TableInfo *table_info, IndexInfo *index_info, const std::vector<uint32_t> &key_map,
+                        uint32_t build_workers, KeySorter *sorter, Txn *txn);
+
+  /**
+   * Open the existing table heap described by table_meta, in its page format.
+   */
+  TableHeap *OpenTableHeap(TableMetadata *table_meta);
+
+  /**
+   * Read the statistics of an analyzed table from its statistics page.
+   */
+  void LoadTableStatistics(TableInfo *table_info);
+
+  /**
+   * Write the statistics of the table to its statistics page, which is allocated on the first ANALYZE.
+   */
+  void FlushTableStatistics(TableInfo *table_info);
+
+  /**
+   * Rewrite the tuples of a row table written in the v1 tuple format into the v2 format and record
+   * the new format in its metadata. The other layouts keep reading the v1 format.
+   */
+  void UpgradeTupleFormat(TableInfo *table_info, page_id_t meta_page_id);
+
  private:
   [[maybe_unused]] BufferPoolManager *buffer_pool_manager_;
   [[maybe_unused]] LockManager *lock_manager_;
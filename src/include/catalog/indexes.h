@@ -14,8 +14,18 @@ class IndexMetadata {
   friend class IndexInfo;
 
  public:
+  /**
+   * @param index_type "bptree" for a B+ tree with latch crabbing, "blinktree" for a B-link tree whose readers and
+   * writers latch one page at a time, see BPlusTree. A B-link tree never merges the pages emptied by removals, it
+   * suits indexes that mostly grow.
+   */
   static IndexMetadata *Create(const index_id_t index_id, const std::string &index_name, const table_id_t table_id,
-                               const std::vector<uint32_t> &key_map);
+                               const std::vector<uint32_t> &key_map, const std::string &index_type = "bptree");
+
+  /** @return true if indexes of this type can be created */
+  static bool IsIndexType(const std::string &index_type) {
+    return index_type == "bptree" || index_type == "blinktree";
+  }
 
   uint32_t SerializeTo(char *buf) const;
 
@@ -33,6 +43,10 @@ class IndexMetadata {
 
   inline index_id_t GetIndexId() const { return index_id_; }
 
+  inline KeyEncoding GetKeyEncoding() const { return key_encoding_; }
+
+  inline const std::string &GetIndexType() const { return index_type_; }
+
  private:
   IndexMetadata() = delete;
 
@@ -41,10 +55,16 @@ class IndexMetadata {
 
  private:
   static constexpr uint32_t INDEX_METADATA_MAGIC_NUM = 344528;
+  // metadata written with the key encoding, the keys of older indexes are in the row encoding
+  static constexpr uint32_t INDEX_METADATA_ENCODING_MAGIC_NUM = 344534;
+  // metadata written with the key encoding and the index type, older indexes are B+ trees
+  static constexpr uint32_t INDEX_METADATA_TYPE_MAGIC_NUM = 344535;
   index_id_t index_id_;
   std::string index_name_;
   table_id_t table_id_;
   std::vector<uint32_t> key_map_; /** The mapping of index key to tuple key */
+  KeyEncoding key_encoding_{KeyEncoding::kNormalized};
+  std::string index_type_{"bptree"};
 };
 
 /**
@@ -69,13 +89,15 @@ class IndexInfo {
     // Step3: call CreateIndex to create the index
     meta_data_ = meta_data;
     key_schema_ = Schema::ShallowCopySchema(table_info->GetSchema(), meta_data->GetKeyMapping());
-    index_ = CreateIndex(buffer_pool_manager, "bptree");
+    index_ = CreateIndex(buffer_pool_manager, meta_data->GetIndexType());
   }
 
   inline Index *GetIndex() { return index_; }
 
   std::string GetIndexName() { return meta_data_->GetIndexName(); }
 
+  std::string GetIndexType() { return meta_data_->GetIndexType(); }
+
   IndexSchema *GetIndexKeySchema() { return key_schema_; }
 
  private:
@@ -2,8 +2,11 @@
 #define MINISQL_TABLE_H
 
 #include <memory>
+#include <vector>
 
+#include "catalog/table_stats.h"
 #include "glog/logging.h"
+#include "index/key_encoding.h"
 #include "record/schema.h"
 #include "storage/table_heap.h"
 
@@ -23,7 +26,8 @@ class TableMetadata {
    * will create new table schema and owned by mem heap
    */
   static TableMetadata *Create(table_id_t table_id, std::string table_name, page_id_t root_page_id,
-                               TableSchema *schema);
+                               TableSchema *schema, TableLayout layout = TableLayout::kRow,
+                               const std::vector<uint32_t> &cluster_key = {});
 
   inline table_id_t GetTableId() const { return table_id_; }
 
@@ -33,17 +37,43 @@ class TableMetadata {
 
   inline Schema *GetSchema() const { return schema_; }
 
+  inline TableLayout GetLayout() const { return layout_; }
+
+  inline const std::vector<uint32_t> &GetClusterKey() const { return cluster_key_; }
+
+  /** @return page of the statistics collected by ANALYZE, INVALID_PAGE_ID if the table was never analyzed */
+  inline page_id_t GetStatsPageId() const { return stats_page_id_; }
+
+  inline void SetStatsPageId(page_id_t stats_page_id) { stats_page_id_ = stats_page_id; }
+
+  /** @return encoding of the keys of a clustered table */
+  inline KeyEncoding GetKeyEncoding() const { return key_encoding_; }
+
  private:
   TableMetadata() = delete;
 
-  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema);
+  TableMetadata(table_id_t table_id, std::string table_name, page_id_t root_page_id, TableSchema *schema,
+                TableLayout layout, std::vector<uint32_t> cluster_key);
 
  private:
   static constexpr uint32_t TABLE_METADATA_MAGIC_NUM = 344528;
+  // metadata written with the table layout, tables of the old format are row tables
+  static constexpr uint32_t TABLE_METADATA_LAYOUT_MAGIC_NUM = 344529;
+  // metadata written with the statistics page id as well
+  static constexpr uint32_t TABLE_METADATA_STATS_MAGIC_NUM = 344530;
+  // metadata written with the tuple format as well
+  static constexpr uint32_t TABLE_METADATA_FORMAT_MAGIC_NUM = 344532;
+  // metadata written with the key encoding as well, older clustered tables have keys of the row encoding
+  static constexpr uint32_t TABLE_METADATA_KEY_MAGIC_NUM = 344533;
   table_id_t table_id_;
   std::string table_name_;
   page_id_t root_page_id_;
   Schema *schema_;
+  TableLayout layout_;
+  // indexes of the primary key columns a clustered table is ordered by, empty for other layouts
+  std::vector<uint32_t> cluster_key_;
+  page_id_t stats_page_id_{INVALID_PAGE_ID};
+  KeyEncoding key_encoding_{KeyEncoding::kNormalized};
 };
 
 /**
@@ -56,6 +86,7 @@ class TableInfo {
   ~TableInfo() {
     delete table_meta_;
     delete table_heap_;
+    delete table_stats_;
   }
 
   void Init(TableMetadata *table_meta, TableHeap *table_heap) {
@@ -73,12 +104,26 @@ class TableInfo {
 
   inline page_id_t GetRootPageId() const { return table_meta_->root_page_id_; }
 
+  inline TableLayout GetLayout() const { return table_meta_->layout_; }
+
+  inline TableMetadata *GetTableMetadata() const { return table_meta_; }
+
+  /** @return statistics collected by the last ANALYZE, nullptr if the table was never analyzed */
+  inline TableStatistics *GetTableStatistics() const { return table_stats_; }
+
+  /** Take the ownership of table_stats, the previous statistics are released */
+  void SetTableStatistics(TableStatistics *table_stats) {
+    delete table_stats_;
+    table_stats_ = table_stats;
+  }
+
  private:
   explicit TableInfo(){};
 
  private:
   TableMetadata *table_meta_;
   TableHeap *table_heap_;
+  TableStatistics *table_stats_{nullptr};
 };
 
 #endif  // MINISQL_TABLE_H
@@ -0,0 +1,115 @@
+#ifndef MINISQL_TABLE_STATS_H
+#define MINISQL_TABLE_STATS_H
+
+#include <string>
+#include <vector>
+
+#include "record/field.h"
+#include "record/schema.h"
+#include "storage/table_heap.h"
+
+/**
+ * Statistics of one column, computed over the sampled tuples.
+ */
+class ColumnStatistics {
+  friend class TableStatistics;
+
+ public:
+  /** @return estimated number of distinct non-null values in the table */
+  inline uint64_t GetDistinctCount() const { return distinct_count_; }
+
+  /** @return fraction of the tuples whose value is null */
+  inline float GetNullFraction() const { return null_fraction_; }
+
+  /**
+   * Equi-depth histogram of the non-null values: bucket i holds the values in [bounds[i], bounds[i + 1]],
+   * every bucket holds about the same number of values. Empty if the column has no non-null value.
+   */
+  inline const std::vector<Field> &GetHistogramBounds() const { return histogram_bounds_; }
+
+ private:
+  uint64_t distinct_count_{0};
+  float null_fraction_{0};
+  std::vector<Field> histogram_bounds_;
+};
+
+/**
+ * Statistics of a table collected by ANALYZE, stored in a page of their own referenced by the
+ * table metadata. Page layout:
+ *  -------------------------------------------------------------------------------------------
+ * | MagicNum (4) | RowCount (8) | PageCount (4) | ColumnCount (4) | ColumnStatistics(1) | ... |
+ *  -------------------------------------------------------------------------------------------
+ * ColumnStatistics: | DistinctCount (8) | NullFraction (4) | BoundCount (4) | Bound(1) | ... |
+ */
+class TableStatistics {
+ public:
+  /**
+   * Collect the statistics of a table. Tables larger than STATS_SAMPLE_PAGES pages are sampled page
+   * by page, the other tables are read entirely.
+   * @return the statistics, nullptr if they do not fit into a page
+   */
+  static TableStatistics *Collect(TableHeap *table_heap, Schema *schema, Txn *txn);
+
+  uint32_t SerializeTo(char *buf) const;
+
+  uint32_t GetSerializedSize() const;
+
+  static uint32_t DeserializeFrom(char *buf, Schema *schema, TableStatistics *&table_stats);
+
+  /** @return estimated number of live tuples */
+  inline uint64_t GetRowCount() const { return row_count_; }
+
+  /** @return number of pages of the table when it was analyzed */
+  inline uint32_t GetPageCount() const { return page_count_; }
+
+  inline const ColumnStatistics &GetColumnStatistics(uint32_t column_index) const { return columns_[column_index]; }
+
+  /**
+   * Account for the tuples inserted and deleted since the table was analyzed, the distributions of
+   * the columns are kept as they are.
+   */
+  void ApplyModifications(uint64_t inserted_tuples, uint64_t deleted_tuples);
+
+  /**
+   * Estimate the fraction of the tuples for which "column comparison value" holds.
+   * @param comparison one of =, <>, <, <=, >, >=
+   */
+  double EstimateSelectivity(uint32_t column_index, const std::string &comparison, const Field &value) const;
+
+  /**
+   * Estimate the fraction of the tuples whose value of the column lies between the bounds.
+   * @param lower lower bound, nullptr if there is none
+   * @param upper upper bound, nullptr if there is none
+   */
+  double EstimateRangeSelectivity(uint32_t column_index, const Field *lower, bool lower_inclusive, const Field *upper,
+                                  bool upper_inclusive) const;
+
+ private:
+  TableStatistics() = default;
+
+  /**
+   * Fill the statistics of a column from its sampled values.
+   * @param values sampled non-null values, sorted
+   * @param sample_size number of sampled tuples, null values included
+   */
+  void BuildColumn(ColumnStatistics *column, const std::vector<const Field *> &values, uint64_t sample_size);
+
+  /**
+   * Keep every other bound of the histograms, until the statistics fit into a page.
+   * @return false if they do not fit even without histograms
+   */
+  bool ShrinkToPage();
+
+  /**
+   * @return estimated fraction of the non-null values which are less than value, or not greater if inclusive
+   */
+  static double EstimateLessThan(const ColumnStatistics &column, const Field &value, bool inclusive);
+
+ private:
+  static constexpr uint32_t TABLE_STATISTICS_MAGIC_NUM = 344531;
+  uint64_t row_count_{0};
+  uint32_t page_count_{0};
+  std::vector<ColumnStatistics> columns_;
+};
+
+#endif  // MINISQL_TABLE_STATS_H
@@ -0,0 +1,44 @@
+#ifndef MINISQL_ARENA_H
+#define MINISQL_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+
+/**
+ * Bump allocator for short-lived memory such as the rows a scan reads and drops again. Memory is
+ * handed out from blocks of ARENA_BLOCK_SIZE bytes and released all at once by Reset. Not thread safe.
+ */
+class Arena {
+ public:
+  Arena() = default;
+
+  DISALLOW_COPY(Arena);
+
+  /**
+   * @return size bytes aligned for any type, valid until the next Reset
+   */
+  char *Allocate(size_t size);
+
+  /**
+   * Release everything allocated so far, the first block is kept for reuse.
+   */
+  void Reset();
+
+  /** @return number of bytes handed out since the last Reset */
+  inline size_t GetAllocatedBytes() const { return allocated_bytes_; }
+
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  // allocations larger than a quarter of a block, they get a block of their own
+  std::vector<std::unique_ptr<char[]>> large_blocks_;
+  // free part of the last block
+  char *cursor_{nullptr};
+  size_t remaining_{0};
+  size_t allocated_bytes_{0};
+};
+
+#endif  // MINISQL_ARENA_H
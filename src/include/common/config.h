@@ -1,6 +1,7 @@
 #ifndef MINISQL_CONFIG_H
 #define MINISQL_CONFIG_H
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
@@ -16,8 +17,23 @@ static constexpr int INDEX_ROOTS_PAGE_ID = 1;   // logical page id of the index
 static constexpr int PAGE_SIZE = 4096;                  // size of a data page in byte
 static constexpr int DEFAULT_BUFFER_POOL_SIZE = 20480;  // default size of buffer pool
 
+static constexpr uint32_t PARALLEL_SCAN_MIN_PAGES = 64;    // smaller tables are scanned by a single thread
+static constexpr uint32_t PARALLEL_SCAN_MORSEL_PAGES = 16;  // pages claimed at once by a parallel scan worker
+
+static constexpr uint32_t STATS_SAMPLE_PAGES = 128;      // pages read by ANALYZE on a larger table
+static constexpr uint32_t STATS_HISTOGRAM_BUCKETS = 32;  // buckets of the equi-depth histogram of a column
+static constexpr uint32_t STATS_MAX_BOUND_LEN = 32;      // longer char histogram bounds are truncated
+
+static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;  // memory an Arena takes from the heap at once
+
+static constexpr size_t INDEX_SORT_MEMORY = 64 * 1024 * 1024;  // keys CREATE INDEX sorts before it spills a run
+static constexpr double INDEX_FILL_FACTOR = 0.9;  // share of a page CREATE INDEX fills, the rest is for later inserts
+static constexpr uint32_t INDEX_SCAN_BATCH_ROWS = 1024;  // row ids of a range scan fetched in page order at once
+static constexpr double INDEX_SCAN_MAX_SELECTIVITY = 0.1;  // analyzed tables are scanned if more rows match
+
 static constexpr uint32_t FIELD_NULL_LEN = UINT32_MAX;
-static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE / 2;  // max length of varchar
+static constexpr uint32_t VARCHAR_MAX_LEN = PAGE_SIZE * 16;       // max length of varchar
+static constexpr uint32_t VARCHAR_INLINE_MAX_LEN = PAGE_SIZE / 8;  // longer varchar is stored in overflow pages
 
 // static std::string DB_META_FILE = "minisql.meta.db";
 
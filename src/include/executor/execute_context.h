@@ -5,6 +5,8 @@
 #ifndef MINISQL_EXECUTE_CONTEXT_H
 #define MINISQL_EXECUTE_CONTEXT_H
 
+#include <algorithm>
+
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/catalog.h"
 #include "common/macros.h"
@@ -19,7 +21,10 @@ class ExecuteContext {
    * @param bpm The buffer pool manager that the executor uses
    */
   ExecuteContext(Txn *transaction, CatalogManager *catalog, BufferPoolManager *bpm)
-      : transaction_(transaction), catalog_{catalog}, bpm_{bpm} {}
+      : transaction_(transaction),
+        catalog_{catalog},
+        bpm_{bpm},
+        scan_workers_(1) {}
 
   ~ExecuteContext() = default;
 
@@ -34,6 +39,16 @@ class ExecuteContext {
   /** @return the buffer pool manager */
   BufferPoolManager *GetBufferPoolManager() { return bpm_; }
 
+  /** @return the number of threads a read-only sequential scan or an index build may use, 1 by default */
+  uint32_t GetScanWorkers() const { return scan_workers_; }
+
+  void SetScanWorkers(uint32_t scan_workers) { scan_workers_ = std::max(1U, scan_workers); }
+
+  /** @return the number of sequential scans run with this context which were split across worker threads */
+  uint32_t GetParallelScans() const { return parallel_scans_; }
+
+  void AddParallelScan() { parallel_scans_++; }
+
  private:
   /** The recovery context associated with this executor context */
   Txn *transaction_;
@@ -41,6 +56,10 @@ class ExecuteContext {
   CatalogManager *catalog_;
   /** The buffer pool manager associated with this executor context */
   BufferPoolManager *bpm_;
+  /** Threads used by a sequential scan or an index build, the engine sets it for every statement */
+  uint32_t scan_workers_;
+  /** Sequential scans which were split across worker threads */
+  uint32_t parallel_scans_{0};
 };
 
 #endif  // MINISQL_EXECUTE_CONTEXT_H
@@ -1,8 +1,12 @@
 #ifndef MINISQL_EXECUTE_ENGINE_H
 #define MINISQL_EXECUTE_ENGINE_H
 
+#include <algorithm>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "common/dberr.h"
@@ -25,6 +29,7 @@ class ExecuteEngine {
   ExecuteEngine();
 
   ~ExecuteEngine() {
+    StopBackgroundVacuum();
     for (auto it : dbs_) {
       delete it.second;
     }
@@ -40,6 +45,24 @@ class ExecuteEngine {
 
   void ExecuteInformation(dberr_t result);
 
+  /**
+   * Start a background task which vacuums all the tables of the opened databases every interval_ms.
+   * It is never started implicitly, the shell runs it only with --vacuum-interval-ms.
+   */
+  void StartBackgroundVacuum(uint32_t interval_ms);
+
+  void StopBackgroundVacuum();
+
+  /**
+   * Set the number of threads a read-only sequential scan or CREATE INDEX may use, 1 runs them serially.
+   */
+  void SetScanWorkers(uint32_t scan_workers) { scan_workers_ = std::max(1U, scan_workers); }
+
+  uint32_t GetScanWorkers() const { return scan_workers_; }
+
+  /** @return the number of sequential scans of the executed statements which were split across worker threads */
+  uint32_t GetParallelScans() const { return parallel_scans_; }
+
  private:
   static std::unique_ptr<AbstractExecutor> CreateExecutor(ExecuteContext *exec_ctx, const AbstractPlanNodeRef &plan);
 
@@ -73,9 +96,20 @@ class ExecuteEngine {
 
   dberr_t ExecuteQuit(pSyntaxNode ast, ExecuteContext *context);
 
+  dberr_t ExecuteVacuum(pSyntaxNode ast, ExecuteContext *context);
+
+  dberr_t ExecuteAnalyze(pSyntaxNode ast, ExecuteContext *context);
+
  private:
   std::unordered_map<std::string, DBStorageEngine *> dbs_; /** all opened databases */
   std::string current_db_;                                 /** current database */
+  std::recursive_mutex latch_;                             /** serializes statements and background vacuum */
+  std::thread vacuum_thread_;                              /** background vacuum task */
+  std::mutex vacuum_mutex_;
+  std::condition_variable vacuum_cv_;
+  bool vacuum_stop_{false};
+  uint32_t scan_workers_{std::max(1U, std::thread::hardware_concurrency())}; /** threads of a scan or index build */
+  uint32_t parallel_scans_{0};                                            /** scans split across worker threads */
 };
 
 #endif  // MINISQL_EXECUTE_ENGINE_H
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include "executor/execute_context.h"
@@ -7,6 +8,7 @@
 #include "executor/plans/index_scan_plan.h"
 #include "planner/expressions/column_value_expression.h"
 #include "planner/expressions/comparison_expression.h"
+#include "storage/row_id_bitmap.h"
 
 /**
  * The IndexScanExecutor executor can over a table.
@@ -39,12 +41,58 @@ class IndexScanExecutor : public AbstractExecutor {
   void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
 
  private:
-  vector<RowId> IndexScan(AbstractExpressionRef predicate);
+  RowIdBitmap IndexScan(AbstractExpressionRef predicate);
+
+  /**
+   * Open lazy range scans for the single key range of the plan, or for a predicate that is a single
+   * comparison on an indexed column. Their row ids are fetched a batch at a time, so no more entries are
+   * read than the rows asked for need.
+   * @return false if the row ids are to be collected up front instead
+   */
+  bool OpenRanges(const AbstractExpressionRef &predicate);
+
+  /**
+   * @return the row ids in all of the key ranges, each range is scanned once
+   */
+  RowIdBitmap ScanKeyRanges(const std::vector<IndexKeyRange> &key_ranges);
+
+  /**
+   * @return the row ids in the key ranges of any disjunct of the plan
+   */
+  RowIdBitmap ScanUnion();
+
+  static BPlusTreeIndex::RangeIterator ScanKeyRange(const IndexKeyRange &range);
+
+  /**
+   * Move the next batch of row ids of the open range scans into the bitmap.
+   * @return false if the range scans have no row ids left
+   */
+  bool FillBitmap();
+
+  /**
+   * Take the row ids of the next page out of the bitmap and read the rows passing the filter into
+   * page_rows_, the page is pinned once for all of them.
+   * @return false if the bitmap is empty
+   */
+  bool ScanPage();
+
+  /** Collect the table columns referenced by the expression */
+  static void CollectColumns(const AbstractExpressionRef &expr, std::vector<bool> *referenced);
 
   /** The sequential scan plan node to be executed */
   const IndexScanPlanNode *plan_;
   TableInfo *table_info_{};
-  vector<RowId> result_;
-  size_t cursor_ = 0;
+  /** Range scans read in order into the bitmap a batch at a time */
+  std::vector<BPlusTreeIndex::RangeIterator> ranges_;
+  size_t range_pos_ = 0;
+  /** Row ids whose rows are not fetched yet, the rows are fetched in page order */
+  RowIdBitmap bitmap_;
+  std::vector<uint32_t> slots_;
+  /** Rows of the page fetched last not returned yet */
+  std::deque<Row> page_rows_;
   bool is_schema_same_;
+  /** Table columns referenced by the output schema or the filter, the only ones decoded */
+  std::vector<bool> referenced_;
+  /** Memory of the rows the filter is evaluated on */
+  Arena arena_;
 };
\ No newline at end of file
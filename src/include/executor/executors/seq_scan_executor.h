@@ -5,11 +5,18 @@
 #ifndef MINISQL_SEQ_SCAN_EXECUTOR_H
 #define MINISQL_SEQ_SCAN_EXECUTOR_H
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/seq_scan_plan.h"
+#include "storage/clustered_table_heap.h"
+#include "storage/pax_table_heap.h"
 
 /**
  * The SeqScanExecutor executor executes a sequential table scan.
@@ -23,6 +30,9 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   SeqScanExecutor(ExecuteContext *exec_ctx, const SeqScanPlanNode *plan);
 
+  /** Stops the workers of a parallel scan that was not read to the end */
+  ~SeqScanExecutor() override;
+
   /** Initialize the sequential scan */
   void Init() override;
 
@@ -41,6 +51,59 @@ class SeqScanExecutor : public AbstractExecutor {
 
   void TupleTransfer(const Schema *table_schema, const Schema *output_schema, const Row *row, Row *output_row);
 
+ private:
+  /**
+   * Scan a pax table page by page, only the columns in the output schema or the predicate are decoded.
+   */
+  bool NextFromColumns(Row *row, RowId *rid);
+
+  /**
+   * Scan a row table page by page in the order of the page chain.
+   */
+  bool NextFromPages(Row *row, RowId *rid);
+
+  /**
+   * Evaluate the predicate on the tuples of a row table page in place, only the referenced columns
+   * are decoded and only the output rows are copied out of the page.
+   * @param arena memory of the rows the predicate is evaluated on
+   * @param[out] next_page_id page following this one, if not nullptr
+   * @return false if the page could not be read
+   */
+  bool ScanPage(page_id_t page_id, Arena *arena, std::deque<Row> *output, page_id_t *next_page_id);
+
+  /**
+   * Start scanning a row table with several threads. The pages are split into morsels of consecutive
+   * pages which the workers claim one after another, every worker evaluates the predicate on its own
+   * morsels. The output rows are handed over per morsel, so they are returned in page order, and a
+   * worker only claims a morsel while fewer than 2 * worker_count morsels wait to be returned.
+   */
+  void StartParallelScan(uint32_t worker_count);
+
+  void ScanMorsels();
+
+  /** Return the rows of the morsels in page order, waiting for a morsel until its worker is done */
+  bool NextFromMorsels(Row *row, RowId *rid);
+
+  void StopParallelScan();
+
+  /** Collect the table columns referenced by the expression */
+  static void CollectColumns(const AbstractExpressionRef &expr, std::vector<bool> *referenced);
+
+  /**
+   * Narrow the key range with the comparisons of the key column against constants that are AND-ed
+   * together in the expression.
+   */
+  void CollectKeyRange(const AbstractExpressionRef &expr, uint32_t key_column);
+
+  /**
+   * Collect the comparisons of numeric columns against constants that are AND-ed together in the
+   * expression, pages whose zone map rules out one of them are skipped.
+   */
+  void CollectZonePredicates(const AbstractExpressionRef &expr);
+
+  /** @return true if the key of the row is beyond the upper bound of the key range */
+  bool PastUpperBound(const Row &row) const;
+
  private:
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
@@ -48,6 +111,53 @@ class SeqScanExecutor : public AbstractExecutor {
   TableIterator iterator_;
   const Schema *schema_{};
   bool is_schema_same_;
+  /** Set when the table is stored in pax pages */
+  PaxTableHeap *pax_heap_{nullptr};
+  /** Table columns referenced by the output schema or the predicate, the only ones decoded by the scan */
+  std::vector<bool> referenced_;
+  /** Positions of the referenced columns of a pax table */
+  std::vector<uint32_t> scan_columns_;
+  /** Position of every table column in scan_columns_, -1 if it is not decoded */
+  std::vector<int> column_slots_;
+  ColumnBatch batch_;
+  /** A null field of the type of every table column, stands in for the columns a pax scan skips */
+  std::vector<Field> null_fields_;
+  /** Fields of the batch position a row is built from, rows are flattened from them in one allocation */
+  std::vector<const Field *> batch_fields_;
+  size_t batch_pos_{0};
+  /** Next page to scan of a row or pax table */
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  /** Output rows of the last page scanned of a row table */
+  std::deque<Row> page_rows_;
+  /** Range of the leading key column of a scan on a clustered table, null if unbounded */
+  std::unique_ptr<Field> lower_bound_;
+  bool lower_inclusive_{true};
+  std::unique_ptr<Field> upper_bound_;
+  bool upper_inclusive_{true};
+  uint32_t key_column_{0};
+  /** Set when the rows are produced by the workers of a parallel scan */
+  bool parallel_{false};
+  std::vector<std::thread> workers_;
+  /** Pages of the table in the order of the page chain, PARALLEL_SCAN_MORSEL_PAGES of them make a morsel */
+  std::vector<page_id_t> morsel_page_ids_;
+  size_t morsel_count_{0};
+  /** Guards the fields below, which the workers and the consumer wait on with morsel_cv_ */
+  std::mutex morsel_latch_;
+  std::condition_variable morsel_cv_;
+  /** Output rows of the morsels in flight, morsel m is kept at m % size */
+  std::vector<std::deque<Row>> morsel_rows_;
+  std::vector<bool> morsel_done_;
+  /** Next morsel to claim by a worker */
+  size_t next_morsel_{0};
+  /** Next morsel to return, every morsel before it was handed over to output_rows_ */
+  size_t morsel_pos_{0};
+  bool stop_workers_{false};
+  /** Output rows of the morsel being returned */
+  std::deque<Row> output_rows_;
+  /** Memory of the rows the serial scan evaluates the predicate on or projects */
+  Arena arena_;
+  /** Predicates checked against the zone maps of a row table, empty if pages are never skipped */
+  std::vector<ZonePredicate> zone_predicates_;
 };
 
 #endif  // MINISQL_SEQ_SCAN_EXECUTOR_H
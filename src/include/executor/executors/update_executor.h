@@ -5,9 +5,12 @@
 #ifndef MINISQL_UPDATE_EXECUTOR_H
 #define MINISQL_UPDATE_EXECUTOR_H
 
+#include <vector>
+
 #include "executor/execute_context.h"
 #include "executor/executors/abstract_executor.h"
 #include "executor/plans/update_plan.h"
+#include "storage/clustered_table_heap.h"
 
 /**
  * UpdateExecutor executes an update on a table.
@@ -51,6 +54,11 @@ class UpdateExecutor : public AbstractExecutor {
    */
   Row GenerateUpdatedTuple(const Row &src_row);
 
+  /**
+   * @return true if the two index keys hold the same values, NULL equals NULL here
+   */
+  static bool SameKey(const Row &src_key_row, const Row &dest_key_row);
+
   /** The update plan node to be executed */
   const UpdatePlanNode *plan_;
   /** Metadata identifying the table that should be updated */
@@ -59,6 +67,10 @@ class UpdateExecutor : public AbstractExecutor {
   std::vector<IndexInfo *> index_info_;
   /** The child executor to obtain value from */
   std::unique_ptr<AbstractExecutor> child_executor_;
+  /** Set when the table is clustered, its rows are then collected before the first update */
+  ClusteredTableHeap *clustered_heap_{nullptr};
+  std::vector<Row> clustered_rows_;
+  size_t clustered_pos_{0};
 };
 
 #endif  // MINISQL_UPDATE_EXECUTOR_H
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -7,6 +8,31 @@
 #include "catalog/catalog.h"
 #include "planner/expressions/abstract_expression.h"
 
+/**
+ * Interval of the keys of a single column index that the comparisons of a conjunction on the column leave,
+ * folded by the planner. A null bound leaves its side open.
+ */
+struct IndexKeyRange {
+  IndexInfo *index_{nullptr};
+  /** Index of the key column in the table schema */
+  uint32_t column_{0};
+  std::unique_ptr<Field> lower_;
+  bool lower_inclusive_{false};
+  std::unique_ptr<Field> upper_;
+  bool upper_inclusive_{false};
+
+  /** @return true if the bounds contradict each other, no key lies within the range */
+  bool IsEmpty() const {
+    if (lower_ == nullptr || upper_ == nullptr) {
+      return false;
+    }
+    if (lower_->CompareGreaterThan(*upper_) == CmpBool::kTrue) {
+      return true;
+    }
+    return lower_->CompareEquals(*upper_) == CmpBool::kTrue && !(lower_inclusive_ && upper_inclusive_);
+  }
+};
+
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
  */
@@ -44,4 +70,22 @@ class IndexScanPlanNode : public AbstractPlanNode {
 
   /** The predicate to filter in IndexScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /**
+   * Key ranges of the indexed columns the predicate is a conjunction of comparisons on, at most one per
+   * column. The row ids are read from these ranges instead of one scan per comparison if there are any.
+   */
+  std::vector<IndexKeyRange> key_ranges_;
+
+  /**
+   * Key ranges of the disjuncts of a predicate that is an OR, each folded like key_ranges_. The row ids of
+   * the disjuncts are united, a disjunct whose ranges contradict each other is left out.
+   */
+  std::vector<std::vector<IndexKeyRange>> union_ranges_;
+
+  /**
+   * Whether the key ranges contradict each other, or those of every disjunct do. The scan then returns no
+   * rows without reading the index.
+   */
+  bool empty_range_ = false;
 };
\ No newline at end of file
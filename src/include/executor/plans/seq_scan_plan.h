@@ -34,6 +34,12 @@ class SeqScanPlanNode : public AbstractPlanNode {
 
   /** The predicate to filter in SeqScan.*/
   AbstractExpressionRef filter_predicate_;
+
+  /**
+   * Set for a scan whose rows are only read, e.g. not for the child of an UPDATE or DELETE. Its pages may be
+   * scanned by several threads if the execute context allows it.
+   */
+  bool parallel_{false};
 };
 
 #endif  // MINISQL_SEQ_SCAN_PLAN_H
@@ -1,10 +1,12 @@
 #ifndef MINISQL_B_PLUS_TREE_H
 #define MINISQL_B_PLUS_TREE_H
 
+#include <functional>
 #include <queue>
 #include <string>
 #include <vector>
 
+#include "common/rwlatch.h"
 #include "concurrency/txn.h"
 #include "index/index_iterator.h"
 #include "page/b_plus_tree_internal_page.h"
@@ -20,21 +22,50 @@
  * (2) support insert & remove
  * (3) The structure should shrink and grow dynamically
  * (4) Implement index iterator for range scan
+ *
+ * Insert, Remove, GetValue and the iterators may be used by several threads at once, pages are latched by
+ * latch crabbing. Reads latch one page after the other on the way down. Writes first go down the same way
+ * and write latch the leaf only, which is enough unless the leaf splits or underflows. Otherwise they start
+ * over and write latch the path, releasing the latches above every page that is safe for the write.
+ *
+ * A linked tree (a B-link tree) latches one page at a time instead. Every page has a high key bounding its
+ * keys and a link to its right sibling, so a page that split is still found by moving right from its left
+ * half. A full page is split and released before the separator goes into the parent, which is latched on
+ * its own. Pages are never merged or deleted, a removal only takes the key out of its leaf.
  */
 class BPlusTree {
   using InternalPage = BPlusTreeInternalPage;
   using LeafPage = BPlusTreeLeafPage;
+  friend class IndexIterator;
 
  public:
+  /**
+   * @param layout layout of the pages created by the tree, the pages already in the tree keep theirs
+   * @param linked whether a new tree is a linked tree, an existing tree stays what it was built as
+   */
   explicit BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &comparator,
-                     int leaf_max_size = UNDEFINED_SIZE, int internal_max_size = UNDEFINED_SIZE);
+                     int leaf_max_size = UNDEFINED_SIZE, int internal_max_size = UNDEFINED_SIZE,
+                     IndexPageLayout layout = IndexPageLayout::kColumns, bool linked = false);
 
   // Returns true if this B+ tree has no keys and values.
   bool IsEmpty() const;
 
+  // Returns true if this is a B-link tree.
+  inline bool IsLinked() const { return linked_; }
+
   // Insert a key-value pair into this B+ tree.
   bool Insert(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
 
+  /**
+   * Build the tree from entries in key order instead of descending from the root for every entry. The leaves
+   * are filled left to right up to fill_factor of their max size, then the levels above them. An entry with
+   * the key of the entry before it is left out.
+   * @param next puts the next entry into key and value, returns false after the last entry
+   * @param fill_factor at least 0.5, the last page of a level may hold less or more
+   * @return false if the tree is not empty
+   */
+  bool BulkLoad(const std::function<bool(GenericKey *key, RowId *value)> &next, double fill_factor = 1.0);
+
   // Remove a key and its value from this B+ tree.
   void Remove(const GenericKey *key, Txn *transaction = nullptr);
 
@@ -43,12 +74,18 @@ class BPlusTree {
 
   IndexIterator Begin();
 
-  IndexIterator Begin(const GenericKey *key);
+  /**
+   * @param inclusive start from the entry of key if there is one, otherwise after it
+   */
+  IndexIterator Begin(const GenericKey *key, bool inclusive = true);
 
   IndexIterator End();
 
-  // expose for test purpose
-  Page *FindLeafPage(const GenericKey *key, page_id_t page_id = INVALID_PAGE_ID, bool leftMost = false);
+  /**
+   * Find the leaf page for key, or the leftmost leaf page.
+   * @return the leaf page, pinned and read latched, nullptr if the tree is empty
+   */
+  Page *FindLeafPage(const GenericKey *key, bool left_most = false);
 
   // used to check whether all pages are unpinned
   bool Check();
@@ -68,9 +105,81 @@ class BPlusTree {
   }
 
  private:
+  enum class Operation { kInsert, kRemove };
+
+  /**
+   * Pages write latched by a write, outermost first, and pages to delete once they are released.
+   */
+  struct WriteSet {
+    bool root_latched_{false};
+    std::vector<Page *> pages_;
+    std::vector<page_id_t> deleted_;
+  };
+
+  /**
+   * Find the leaf page for key and write latch it, optimistically first and pessimistically if the leaf is
+   * not safe for the operation. The latched pages are added to write_set, the leaf last.
+   * @return the leaf page, nullptr if the tree is empty, the root latch is then held
+   */
+  LeafPage *FindLeafPageForWrite(const GenericKey *key, Operation op, WriteSet *write_set);
+
+  /**
+   * Find the first entry after key, or from key on if inclusive, or the first entry if key is nullptr.
+   * @param[out] index index of the entry in the leaf page
+   * @return the leaf page of the entry, pinned and read latched, nullptr if there is none
+   */
+  Page *FindLeafPageFrom(const GenericKey *key, bool inclusive, int *index);
+
+  /**
+   * @return true if the page neither splits nor underflows when a key is inserted or removed
+   */
+  static bool IsSafe(BPlusTreePage *node, Operation op);
+
+  void ReleaseWriteSet(WriteSet *write_set);
+
+  bool LinkedInsert(GenericKey *key, const RowId &value, Txn *transaction);
+
+  void LinkedRemove(const GenericKey *key);
+
+  /**
+   * Find the page of a linked tree on level that covers key, or the leftmost page of the level if key is
+   * nullptr. The pages on the way are added to path, if given.
+   * @return the page, pinned and latched, written if exclusive. nullptr if the tree is lower than level.
+   */
+  Page *FindLinkedPage(const GenericKey *key, int level, bool exclusive, std::vector<page_id_t> *path);
+
+  /**
+   * Follow the right links from a pinned and latched page of a linked tree to the page covering key.
+   * @return the page covering key, pinned and latched in the same mode
+   */
+  Page *MoveRight(Page *page, const GenericKey *key, bool exclusive);
+
+  /**
+   * Insert the separator of a page split in a linked tree into the level above, see LinkedInsert.
+   * @param page the page that split, pinned and write latched, it is released here
+   * @param new_node the new right sibling of page, pinned, it is unpinned here
+   * @param path the pages above page passed on the way down, the nearest last
+   */
+  void CompleteSplit(Page *page, BPlusTreePage *new_node, std::vector<page_id_t> *path, Txn *transaction);
+
+  /** @return the level of a linked page above the leaves, its right link and its high key */
+  static int Level(BPlusTreePage *node);
+
+  static page_id_t RightPageId(BPlusTreePage *node);
+
+  static GenericKey *HighKey(BPlusTreePage *node);
+
   void StartNewTree(GenericKey *key, const RowId &value);
 
-  bool InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transaction = nullptr);
+  /**
+   * Bring the last page of a level built by BulkLoad to the min size, by moving entries from the page before
+   * it or by merging it into that page.
+   * @param page_ids pages of the level in order, the last one is removed if it is merged
+   * @param keys first key of every page of the level
+   */
+  void BalanceLastPage(std::vector<page_id_t> *page_ids, std::vector<char> *keys);
+
+  bool InsertIntoLeaf(LeafPage *leaf, GenericKey *key, const RowId &value, Txn *transaction = nullptr);
 
   void InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlusTreePage *new_node, Txn *transaction = nullptr);
 
@@ -79,7 +188,7 @@ class BPlusTree {
   InternalPage *Split(InternalPage *node, Txn *transaction);
 
   template <typename N>
-  bool CoalesceOrRedistribute(N *&node, Txn *transaction = nullptr);
+  bool CoalesceOrRedistribute(N *&node, WriteSet *write_set, Txn *transaction = nullptr);
 
   bool Coalesce(InternalPage *&neighbor_node, InternalPage *&node, InternalPage *&parent, int index,
                 Txn *transaction = nullptr);
@@ -87,9 +196,9 @@ class BPlusTree {
   bool Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage *&parent, int index,
                 Txn *transaction = nullptr);
 
-  void Redistribute(LeafPage *neighbor_node, LeafPage *node, int index);
+  void Redistribute(LeafPage *neighbor_node, LeafPage *node, InternalPage *parent, int index);
 
-  void Redistribute(InternalPage *neighbor_node, InternalPage *node, int index);
+  void Redistribute(InternalPage *neighbor_node, InternalPage *node, InternalPage *parent, int index);
 
   bool AdjustRoot(BPlusTreePage *node);
 
@@ -103,10 +212,14 @@ class BPlusTree {
   // member variable
   index_id_t index_id_;
   page_id_t root_page_id_{INVALID_PAGE_ID};
+  // guards root_page_id_
+  mutable ReaderWriterLatch root_latch_;
   BufferPoolManager *buffer_pool_manager_;
   KeyManager processor_;
   int leaf_max_size_;
   int internal_max_size_;
+  IndexPageLayout layout_;
+  bool linked_;
 };
 
 #endif  // MINISQL_B_PLUS_TREE_H
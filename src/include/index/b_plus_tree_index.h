@@ -4,10 +4,45 @@
 #include "index/b_plus_tree.h"
 #include "index/generic_key.h"
 #include "index/index.h"
+#include "index/key_sorter.h"
 
 class BPlusTreeIndex : public Index {
  public:
-  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager);
+  /**
+   * Streams the row ids of the entries with keys in a range, in key order. The leaves are copied one at a
+   * time as the entries are read, no leaf after the one holding the upper bound is read. Keys whose first
+   * column is null match no comparison and are never part of a range, even an unbounded one.
+   */
+  class RangeIterator {
+   public:
+    /**
+     * @param lower first key of the range, nullptr to start from the first entry
+     * @param upper last key of the range, nullptr to end after the last entry
+     */
+    RangeIterator(BPlusTreeIndex *index, const Row *lower, bool lower_inclusive, const Row *upper,
+                  bool upper_inclusive);
+
+    /**
+     * @return false after the last entry of the range
+     */
+    bool Next(RowId *row_id);
+
+   private:
+    const KeyManager *processor_;
+    IndexIterator iter_;
+    KeyBuffer upper_;
+    bool has_upper_;
+    bool upper_inclusive_;
+    // the current entry of iter_ was returned, the iterator is moved on only when the next one is asked for
+    bool started_{false};
+    bool done_{false};
+  };
+
+  /**
+   * @param linked whether a new index is a B-link tree, see BPlusTree
+   */
+  BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size, BufferPoolManager *buffer_pool_manager,
+                 KeyEncoding key_encoding = KeyEncoding::kNormalized, bool linked = false);
 
   dberr_t InsertEntry(const Row &key, RowId row_id, Txn *txn) override;
 
@@ -17,6 +52,23 @@ class BPlusTreeIndex : public Index {
 
   dberr_t Destroy() override;
 
+  /**
+   * Scan the entries with keys from lower to upper lazily, see RangeIterator.
+   */
+  RangeIterator ScanRange(const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive);
+
+  /**
+   * Fill the empty index with the sorted entries of sorter, see BPlusTree::BulkLoad.
+   * @return DB_FAILED if the index is not empty or a spilled run of sorter could not be read
+   */
+  dberr_t BulkLoad(KeySorter *sorter, double fill_factor = INDEX_FILL_FACTOR);
+
+  /** @return the key manager the keys of this index are serialized with */
+  inline const KeyManager &GetKeyManager() const { return processor_; }
+
+  /** @return true if the index is a B-link tree */
+  inline bool IsLinked() const { return container_.IsLinked(); }
+
   IndexIterator GetBeginIterator();
 
   IndexIterator GetBeginIterator(GenericKey *key);
@@ -2,9 +2,12 @@
 #define MINISQL_GENERIC_KEY_H
 
 #include <cstring>
+#include <vector>
 
+#include "index/key_encoding.h"
 #include "record/field.h"
 #include "record/row.h"
+#include "record/type_kernels.h"
 
 class GenericKey {
   friend class KeyManager;
@@ -13,62 +16,180 @@ class GenericKey {
 
 class KeyManager {
  public: /**/
+  // largest key of an index or a clustered table
+  static constexpr uint32_t MAX_KEY_SIZE = 256;
+
   [[nodiscard]] inline GenericKey *InitKey() const {
     return (GenericKey *)malloc(key_size_);  // remember delete
   }
 
   inline void SerializeFromKey(GenericKey *key_buf, const Row &key, Schema *schema) const {
-    // initialize to 0
-    [[maybe_unused]] uint32_t size = key.GetSerializedSize(schema);
     ASSERT(key.GetFieldCount() == schema->GetColumnCount(), "field nums not match.");
-    ASSERT(size <= (uint32_t)key_size_, "Index key size exceed max key size.");
+    ASSERT(FitsKey(key, schema), "Index key size exceed max key size.");
+    // initialize to 0
     memset(key_buf->data, 0, key_size_);
-    key.SerializeTo(key_buf->data, schema);
+    if (encoding_ == KeyEncoding::kNormalized) {
+      EncodeKey(key_buf->data, key, schema);
+    } else {
+      key.SerializeTo(key_buf->data, schema);
+    }
   }
 
   inline void DeserializeToKey(const GenericKey *key_buf, Row &key, Schema *schema) const {
+    if (encoding_ == KeyEncoding::kNormalized) {
+      DecodeKey(key_buf->data, key, schema);
+      return;
+    }
     [[maybe_unused]] uint32_t ofs = key.DeserializeFrom(const_cast<char *>(key_buf->data), schema);
     ASSERT(ofs <= (uint32_t)key_size_, "Index key size exceed max key size.");
   }
 
+  /**
+   * @return false if the key cannot be stored in a key of this manager, a char value of the
+   * normalized encoding must not be longer than its column
+   */
+  bool FitsKey(const Row &key, Schema *schema) const;
+
   // compare
   [[nodiscard]] inline int CompareKeys(const GenericKey *lhs, const GenericKey *rhs) const {
-    //    ASSERT(malloc_usable_size((void *)&lhs) == malloc_usable_size((void *)&rhs), "key size not match.");
-    uint32_t column_count = key_schema_->GetColumnCount();
-    Row lhs_key(INVALID_ROWID);
-    Row rhs_key(INVALID_ROWID);
-    DeserializeToKey(lhs, lhs_key, key_schema_);
-    DeserializeToKey(rhs, rhs_key, key_schema_);
-
-    for (uint32_t i = 0; i < column_count; i++) {
-      Field *lhs_value = lhs_key.GetField(i);
-      Field *rhs_value = rhs_key.GetField(i);
-
-      if (lhs_value->CompareLessThan(*rhs_value) == CmpBool::kTrue) {
-        return -1;
-      }
-
-      if (lhs_value->CompareGreaterThan(*rhs_value) == CmpBool::kTrue) {
-        return 1;
+    if (encoding_ == KeyEncoding::kNormalized) {
+      if (word_shift_ < 64) {
+        uint64_t lhs_word = ReadBigEndian<uint64_t>(lhs->data) >> word_shift_;
+        uint64_t rhs_word = ReadBigEndian<uint64_t>(rhs->data) >> word_shift_;
+        return (lhs_word > rhs_word) - (lhs_word < rhs_word);
       }
+      return memcmp(lhs->data, rhs->data, normalized_size_);
     }
-    // equals
-    return 0;
+    return compare_(column_types_, lhs->data, rhs->data);
   }
 
+  /**
+   * @return true if the keys are compared as one 64-bit word, keys of 8 bytes are then searched with SearchWords
+   */
+  inline bool IsWordKey() const { return word_shift_ < 64; }
+
+  /**
+   * Search count contiguous keys of 8 bytes in order, by binary search down to a window which is
+   * scanned in SIMD lanes (AVX2 or SSE4.2, whichever the CPU has).
+   * @return number of keys less than key, or not greater than key if inclusive
+   */
+  int SearchWords(const char *keys, int count, const GenericKey *key, bool inclusive) const;
+
   inline int GetKeySize() const { return key_size_; }
 
-  KeyManager(const KeyManager &other) {
-    this->key_schema_ = other.key_schema_;
-    this->key_size_ = other.key_size_;
+  /**
+   * @return true if the first column of the key is null
+   */
+  inline bool IsLeadingNull(const GenericKey *key) const {
+    if (encoding_ == KeyEncoding::kNormalized) {
+      return key->data[0] == 0;
+    }
+    return (key->data[sizeof(RowId)] & 1) != 0;
   }
 
+  inline KeyEncoding GetEncoding() const { return encoding_; }
+
+  /**
+   * @return size of the normalized encoding of the keys of key_schema
+   */
+  static uint32_t GetNormalizedSize(const Schema *key_schema);
+
+  KeyManager(const KeyManager &other) = default;
+
   // constructor
-  KeyManager(Schema *key_schema, size_t key_size) : key_size_(key_size), key_schema_(key_schema) {}
+  KeyManager(Schema *key_schema, size_t key_size, KeyEncoding encoding = KeyEncoding::kNormalized)
+      : key_size_(key_size), key_schema_(key_schema), encoding_(encoding) {
+    for (auto column : key_schema_->GetColumns()) {
+      column_types_.push_back(column->GetType());
+    }
+    normalized_size_ = GetNormalizedSize(key_schema_);
+    ASSERT(encoding_ != KeyEncoding::kNormalized || normalized_size_ <= key_size_, "Key size is too small.");
+    // keys of at most 8 bytes are compared as one big-endian word, the bytes after the key are 0
+    if (encoding_ == KeyEncoding::kNormalized && normalized_size_ <= sizeof(uint64_t) &&
+        key_size_ >= sizeof(uint64_t)) {
+      word_shift_ = 8 * (sizeof(uint64_t) - normalized_size_);
+    }
+    // the comparison is picked once per key layout, single column keys get a loop free one
+    compare_ = CompareColumns;
+    if (column_types_.size() == 1) {
+      compare_ = DispatchType(column_types_[0], [](auto kernel) -> Comparator {
+        return CompareSingle<decltype(kernel)>;
+      });
+    }
+  }
 
  private:
-  int key_size_;
+  /**
+   * Compare two keys of the row encoding, see Row::SerializeTo: | RowId | NullBitmap | Value(1) | ... |
+   * A null value is neither less nor greater than any other value.
+   */
+  using Comparator = int (*)(const std::vector<TypeId> &, const char *, const char *);
+
+  template <typename Kernel>
+  static int CompareSingle(const std::vector<TypeId> &, const char *lhs, const char *rhs) {
+    const char *lhs_nulls = lhs + sizeof(RowId);
+    const char *rhs_nulls = rhs + sizeof(RowId);
+    if (((*lhs_nulls | *rhs_nulls) & 1) != 0) {
+      return 0;
+    }
+    return Kernel::CompareSerialized(lhs_nulls + 1, rhs_nulls + 1);
+  }
+
+  static int CompareColumns(const std::vector<TypeId> &column_types, const char *lhs, const char *rhs) {
+    uint32_t null_size = (column_types.size() + 7) / 8;
+    const char *lhs_nulls = lhs + sizeof(RowId);
+    const char *rhs_nulls = rhs + sizeof(RowId);
+    lhs = lhs_nulls + null_size;
+    rhs = rhs_nulls + null_size;
+    for (uint32_t i = 0; i < column_types.size(); i++) {
+      bool lhs_null = (lhs_nulls[i / 8] & (1 << (i % 8))) != 0;
+      bool rhs_null = (rhs_nulls[i / 8] & (1 << (i % 8))) != 0;
+      int ret = DispatchType(column_types[i], [&](auto kernel) {
+        using Kernel = decltype(kernel);
+        int cmp = 0;
+        if (!lhs_null && !rhs_null) {
+          cmp = Kernel::CompareSerialized(lhs, rhs);
+        }
+        lhs += lhs_null ? 0 : Kernel::GetSerializedSize(lhs);
+        rhs += rhs_null ? 0 : Kernel::GetSerializedSize(rhs);
+        return cmp;
+      });
+      if (ret != 0) {
+        return ret;
+      }
+    }
+    // equals
+    return 0;
+  }
+
+  /**
+   * Normalized encoding, every column is a null byte (0 if null, else 1) followed by the encoded
+   * value, all zeros if null. Null sorts before any value. See the WriteNormalized of the kernels.
+   */
+  static void EncodeKey(char *buf, const Row &key, const Schema *schema);
+
+  static void DecodeKey(const char *buf, Row &key, const Schema *schema);
+
+  uint32_t key_size_;
   Schema *key_schema_;
+  KeyEncoding encoding_;
+  std::vector<TypeId> column_types_;
+  // comparison of the row encoding
+  Comparator compare_;
+  uint32_t normalized_size_{0};
+  // 64 if the normalized keys are compared with memcmp
+  uint32_t word_shift_{64};
+};
+
+/**
+ * Key on the stack for the operations of a tree, large enough for any key manager.
+ */
+class KeyBuffer {
+ public:
+  inline GenericKey *Get() { return reinterpret_cast<GenericKey *>(data_); }
+
+ private:
+  alignas(8) char data_[KeyManager::MAX_KEY_SIZE];
 };
 
 #endif  // MINISQL_GENERIC_KEY_H
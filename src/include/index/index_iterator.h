@@ -1,8 +1,17 @@
 #ifndef MINISQL_INDEX_ITERATOR_H
 #define MINISQL_INDEX_ITERATOR_H
 
+#include <vector>
+
 #include "page/b_plus_tree_leaf_page.h"
 
+class BPlusTree;
+
+/**
+ * Iterator over the entries of a B+ tree in key order. The entries of a leaf are copied when the iterator
+ * gets to it, so the iterator holds no latch or pin between calls and the tree may change meanwhile. The
+ * next leaf is looked up from the root by the last key copied.
+ */
 class IndexIterator {
   using LeafPage = BPlusTreeLeafPage;
 
@@ -11,9 +20,13 @@ class IndexIterator {
   explicit IndexIterator();
   // do not accept default constructor
 
-  explicit IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index = 0);
+  /**
+   * @param page leaf page, pinned and read latched, it is released here. nullptr for the end iterator.
+   * @param index index of the first entry in the leaf
+   */
+  explicit IndexIterator(BPlusTree *tree, Page *page, int index = 0);
 
-  ~IndexIterator();
+  ~IndexIterator() = default;
 
   /** Return the key/value pair this iterator is currently pointing at. */
   std::pair<GenericKey *, RowId> operator*();
@@ -28,11 +41,20 @@ class IndexIterator {
   bool operator!=(const IndexIterator &itr) const;
 
  private:
-  page_id_t current_page_id{INVALID_PAGE_ID};
-  LeafPage *page{nullptr};
-  int item_index{0};
-  BufferPoolManager *buffer_pool_manager{nullptr};
-  // add your own private member variables here
+  /**
+   * Copy the entries of a leaf from index on, then release the leaf.
+   */
+  void Load(Page *page, int index);
+
+  BPlusTree *tree_{nullptr};
+  // leaf the entries are copied from and index of the current entry in it
+  page_id_t current_page_id_{INVALID_PAGE_ID};
+  int item_index_{0};
+  // leaf index of the first copied entry
+  int first_index_{0};
+  int key_size_{0};
+  std::vector<char> keys_;
+  std::vector<RowId> values_;
 };
 
 #endif  // MINISQL_INDEX_ITERATOR_H
@@ -0,0 +1,14 @@
+#ifndef MINISQL_KEY_ENCODING_H
+#define MINISQL_KEY_ENCODING_H
+
+#include <cstdint>
+
+/**
+ * Layout of the keys of a B+ tree, see KeyManager.
+ *  kRow: the key row serialized in the v1 tuple format, compared column by column
+ *  kNormalized: order preserving fixed-width encoding of the columns, compared with memcmp
+ * Trees built before the normalized encoding keep the row encoding.
+ */
+enum class KeyEncoding : uint32_t { kRow = 0, kNormalized };
+
+#endif  // MINISQL_KEY_ENCODING_H
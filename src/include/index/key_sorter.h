@@ -0,0 +1,111 @@
+#ifndef MINISQL_KEY_SORTER_H
+#define MINISQL_KEY_SORTER_H
+
+#include <cstdio>
+#include <vector>
+
+#include "common/config.h"
+#include "common/dberr.h"
+#include "index/generic_key.h"
+
+/**
+ * Sorts the entries of an index by key for BPlusTree::BulkLoad. The entries are collected in memory, when
+ * they take more than memory_limit bytes they are sorted and spilled to a temporary file as a run. The
+ * runs are merged while the entries are read back.
+ */
+class KeySorter {
+ public:
+  explicit KeySorter(const KeyManager &processor, size_t memory_limit = INDEX_SORT_MEMORY);
+
+  ~KeySorter();
+
+  KeySorter(const KeySorter &other) = delete;
+
+  KeySorter &operator=(const KeySorter &other) = delete;
+
+  /**
+   * @return DB_FAILED if the entries had to be spilled and the run could not be written
+   */
+  dberr_t Add(const GenericKey *key, const RowId &row_id);
+
+  /**
+   * Sort the entries added so far into a run kept in memory, e.g. by the thread that added them before
+   * the sorter is merged into another one.
+   */
+  void Sort();
+
+  /**
+   * Take over the runs of other, which is left empty. Entries with equal keys are read in the order of
+   * the sorters they were added to, the entries of this sorter first.
+   */
+  void Merge(KeySorter *other);
+
+  /**
+   * Read the entries in key order, entries with equal keys in the order they were added. No entry can be
+   * added after the first call.
+   * @return false after the last entry, or if a spilled run could not be read, see IsFailed
+   */
+  bool Next(GenericKey *key, RowId *row_id);
+
+  /**
+   * @return true if a spilled run could not be read back, the entries returned by Next are incomplete
+   */
+  inline bool IsFailed() const { return failed_; }
+
+  /**
+   * @return number of runs spilled to files so far
+   */
+  inline size_t GetSpilledRunCount() const { return spilled_runs_; }
+
+ private:
+  // entries of a spilled run are read from its file in blocks of this size
+  static constexpr size_t RUN_BLOCK_SIZE = 64 * 1024;
+
+  /**
+   * A sorted run, spilled to a file or kept in memory, with the block of entries read last.
+   */
+  struct Run {
+    FILE *file_{nullptr};
+    std::vector<char> entries_;
+    size_t next_{0};
+    size_t count_{0};
+  };
+
+  /**
+   * @return the entries collected in memory in key order, the collected entries are cleared
+   */
+  std::vector<char> SortEntries();
+
+  dberr_t Spill();
+
+  /**
+   * Sort the entries still in memory and set up the merge of the runs.
+   */
+  void Finish();
+
+  /**
+   * Read the next block of a spilled run once its entries are used up.
+   * @return false if the run has no entries left or could not be read
+   */
+  bool Refill(Run *run);
+
+  /**
+   * @return true if the current entry of run a goes after the one of run b
+   */
+  bool After(size_t a, size_t b) const;
+
+  KeyManager processor_;
+  size_t memory_limit_;
+  size_t key_size_;
+  size_t entry_size_;
+  // | KEY | ROW ID | of the entries not spilled yet, in the order they were added
+  std::vector<char> entries_;
+  std::vector<Run> runs_;
+  size_t spilled_runs_{0};
+  bool finished_{false};
+  bool failed_{false};
+  // heap of the runs with entries left, ordered by their current entry
+  std::vector<size_t> heap_;
+};
+
+#endif  // MINISQL_KEY_SORTER_H
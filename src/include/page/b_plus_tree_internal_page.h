@@ -20,12 +20,26 @@
  *  --------------------------------------------------------------------------
  * | HEADER | KEY(1)+PAGE_ID(1) | KEY(2)+PAGE_ID(2) | ... | KEY(n)+PAGE_ID(n) |
  *  --------------------------------------------------------------------------
+ * or with the keys apart from the page ids, see IndexPageLayout:
+ *  ----------------------------------------------------------------------------------
+ * | HEADER | KEY(1) | ... | KEY(max_size) | PAGE_ID(1) | ... | PAGE_ID(max_size) |
+ *  ----------------------------------------------------------------------------------
+ * A linked page keeps its level above the leaves, its right link and its high key in the last bytes:
+ *  ---------------------------------------------------------------
+ * | HEADER | ENTRIES | ... | LEVEL | RIGHT_PAGE_ID | HIGH KEY |
+ *  ---------------------------------------------------------------
  */
 class BPlusTreeInternalPage : public BPlusTreePage {
  public:
   static constexpr int INTERNAL_PAGE_HEADER_SIZE = 28;
   // must call initialize method after "create" a new node
-  void Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size);
+  void Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size,
+            IndexPageLayout layout = IndexPageLayout::kPairs, bool linked = false);
+
+  /**
+   * @return the largest max size of a page with keys of key_size
+   */
+  static int Capacity(int key_size, bool linked);
 
   GenericKey *KeyAt(int index);
 
@@ -37,11 +51,23 @@ class BPlusTreeInternalPage : public BPlusTreePage {
 
   void SetValueAt(int index, page_id_t value);
 
-  void *PairPtrAt(int index);
+  page_id_t Lookup(const GenericKey *key, const KeyManager &KP);
 
-  void PairCopy(void *dest, void *src, int pair_num = 1);
+  // helper methods of linked pages
+  int GetLevel() const;
 
-  page_id_t Lookup(const GenericKey *key, const KeyManager &KP);
+  void SetLevel(int level);
+
+  page_id_t GetRightPageId() const;
+
+  void SetRightPageId(page_id_t right_page_id);
+
+  /**
+   * Upper bound of the keys of the subtree, exclusive. Only valid if the page has a right page.
+   */
+  GenericKey *HighKey();
+
+  void SetHighKey(const GenericKey *key);
 
   void PopulateNewRoot(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value);
 
@@ -63,7 +89,22 @@ class BPlusTreeInternalPage : public BPlusTreePage {
                          BufferPoolManager *buffer_pool_manager);
 
  private:
-  void CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool_manager);
+  /** @return offsets of the key and of the page id at index in data_ */
+  int KeyOffset(int index) const;
+
+  int ValueOffset(int index) const;
+
+  int HighKeyOffset() const;
+
+  /**
+   * Move size entries from index src to index dest of the page, the ranges may overlap.
+   */
+  void MoveEntries(int dest, int src, int size);
+
+  /**
+   * Append size entries of src starting from index, the pages may have different layouts.
+   */
+  void CopyNFrom(BPlusTreeInternalPage *src, int index, int size, BufferPoolManager *buffer_pool_manager);
 
   void CopyLastFrom(GenericKey *key, page_id_t value, BufferPoolManager *buffer_pool_manager);
 
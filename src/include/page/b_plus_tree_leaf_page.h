@@ -12,6 +12,14 @@
  *  ----------------------------------------------------------------------
  * | HEADER | KEY(1) + RID(1) | KEY(2) + RID(2) | ... | KEY(n) + RID(n)
  *  ----------------------------------------------------------------------
+ * or with the keys apart from the record ids, see IndexPageLayout:
+ *  ----------------------------------------------------------------------------
+ * | HEADER | KEY(1) | ... | KEY(max_size) | RID(1) | ... | RID(max_size) |
+ *  ----------------------------------------------------------------------------
+ * A linked page keeps its high key in the last bytes of the page, the next page is its right link:
+ *  --------------------------------------
+ * | HEADER | ENTRIES | ... | HIGH KEY |
+ *  --------------------------------------
  *
  *  Header format (size in byte, 24 bytes in total):
  *  ---------------------------------------------------------------------
@@ -32,13 +40,26 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   static constexpr int LEAF_PAGE_HEADER_SIZE = 32;
   // After creating a new leaf page from buffer pool, must call initialize
   // method to set default values
-  void Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size);
+  void Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size,
+            IndexPageLayout layout = IndexPageLayout::kPairs, bool linked = false);
+
+  /**
+   * @return the largest max size of a page with keys of key_size
+   */
+  static int Capacity(int key_size, bool linked);
 
   // helper methods
   page_id_t GetNextPageId() const;
 
   void SetNextPageId(page_id_t next_page_id);
 
+  /**
+   * Upper bound of the keys of a linked page, exclusive. Only valid if the page has a next page.
+   */
+  GenericKey *HighKey();
+
+  void SetHighKey(const GenericKey *key);
+
   GenericKey *KeyAt(int index);
 
   void SetKeyAt(int index, GenericKey *key);
@@ -49,10 +70,6 @@ class BPlusTreeLeafPage : public BPlusTreePage {
 
   int KeyIndex(const GenericKey *key, const KeyManager &comparator);
 
-  void *PairPtrAt(int index);
-
-  void PairCopy(void *dest, void *src, int pair_num = 1);
-
   std::pair<GenericKey *, RowId> GetItem(int index);
 
   // insert and delete methods
@@ -72,7 +89,22 @@ class BPlusTreeLeafPage : public BPlusTreePage {
   void MoveLastToFrontOf(BPlusTreeLeafPage *recipient);
 
  private:
-  void CopyNFrom(void *src, int size);
+  /** @return offsets of the key and of the record id at index in data_ */
+  int KeyOffset(int index) const;
+
+  int ValueOffset(int index) const;
+
+  int HighKeyOffset() const;
+
+  /**
+   * Move size entries from index src to index dest of the page, the ranges may overlap.
+   */
+  void MoveEntries(int dest, int src, int size);
+
+  /**
+   * Append size entries of src starting from index, the pages may have different layouts.
+   */
+  void CopyNFrom(BPlusTreeLeafPage *src, int index, int size);
 
   void CopyLastFrom(GenericKey *key, const RowId value);
 
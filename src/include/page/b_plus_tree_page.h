@@ -11,6 +11,15 @@
 // define page type enum
 enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
 
+/**
+ * Layout of the entries of a leaf or an internal page.
+ *  kPairs:   | KEY(1)+VALUE(1) | KEY(2)+VALUE(2) | ... | KEY(n)+VALUE(n) |
+ *  kColumns: | KEY(1) | ... | KEY(max_size) | VALUE(1) | ... | VALUE(max_size) |
+ * The keys of the column layout are contiguous, a search touches fewer cache lines and keys of 8
+ * bytes are compared in SIMD lanes, see KeyManager::SearchWords.
+ */
+enum class IndexPageLayout { kPairs = 0, kColumns };
+
 #define UNDEFINED_SIZE 0
 /**
  * Both internal and leaf page are inherited from this page.
@@ -24,6 +33,8 @@ enum class IndexPageType { INVALID_INDEX_PAGE = 0, LEAF_PAGE, INTERNAL_PAGE };
  * ----------------------------------------------------------------------------
  * | ParentPageId (4) | PageId(4) |
  * ----------------------------------------------------------------------------
+ * The layout of the page is kept in the high bits of KeySize, pages written before the column
+ * layout are in the pair layout. So is whether the page is linked to its right sibling, see BPlusTree.
  */
 class BPlusTreePage {
  public:
@@ -36,6 +47,10 @@ class BPlusTreePage {
   int GetKeySize() const;
 
   void SetKeySize(int size);
+  IndexPageLayout GetLayout() const;
+  void SetLayout(IndexPageLayout layout);
+  bool IsLinked() const;
+  void SetLinked(bool linked);
 
   int GetSize() const;
 
@@ -60,6 +75,10 @@ class BPlusTreePage {
   void SetLSN(lsn_t lsn = INVALID_LSN);
 
  private:
+  static constexpr int LAYOUT_SHIFT = 24;
+  static constexpr int KEY_SIZE_MASK = (1 << LAYOUT_SHIFT) - 1;
+  static constexpr int LAYOUT_MASK = 0xf;
+  static constexpr int LINKED_FLAG = 1 << 28;
   // member variable, attributes that both internal and leaf page share
   [[maybe_unused]] IndexPageType page_type_;
   [[maybe_unused]] int key_size_;
@@ -0,0 +1,136 @@
+#ifndef MINISQL_CLUSTERED_LEAF_PAGE_H
+#define MINISQL_CLUSTERED_LEAF_PAGE_H
+
+/**
+ * clustered_leaf_page.h
+ *
+ * Leaf of the B+ tree of a clustered table, the rows themselves are stored in the leaf next to
+ * their keys. Slots are kept in key order, the serialized rows grow from the end of the page.
+ * Internal nodes of the tree are ordinary BPlusTreeInternalPages.
+ *
+ * Leaf page format:
+ *  -------------------------------------------------------------------------------------
+ * | HEADER | SLOT(1) | SLOT(2) | ... | SLOT(n) | FREE SPACE | ... | ROW(2) | ROW(1) |
+ *  -------------------------------------------------------------------------------------
+ *
+ *  Header format (size in byte, 36 bytes in total):
+ *  ----------------------------------------------------------------------------
+ * | BPlusTreePage header (28) | NextPageId (4) | FreeSpacePointer (4) |
+ *  ----------------------------------------------------------------------------
+ *  Slot format: | KEY (KeySize) | RowOffset (4) | RowSize (4) |
+ *  The highest bit of RowSize marks a row deleted but not yet removed.
+ */
+#include "index/generic_key.h"
+#include "page/b_plus_tree_page.h"
+#include "record/row.h"
+
+class ClusteredLeafPage : public BPlusTreePage {
+ public:
+  static constexpr int LEAF_PAGE_HEADER_SIZE = 36;
+
+  // After creating a new leaf page from buffer pool, must call initialize method to set default values
+  void Init(page_id_t page_id, page_id_t parent_id, int key_size);
+
+  page_id_t GetNextPageId() const { return next_page_id_; }
+
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  GenericKey *KeyAt(int index);
+
+  /**
+   * @return index of the first slot whose key is not less than key, GetSize() if there is none
+   */
+  int KeyIndex(const GenericKey *key, const KeyManager &KM);
+
+  bool IsDeleted(int index) const { return (GetSlotRowSize(index) & DELETE_MASK) != 0; }
+
+  /**
+   * Deserialize the row at index, the row id of the row is left untouched.
+   */
+  void GetRow(int index, Row *row, Schema *schema);
+
+  uint32_t GetFreeSpaceRemaining() const;
+
+  /**
+   * Insert key and row at index, the following slots are shifted right.
+   * @return false if the page does not have enough space
+   */
+  bool Insert(int index, GenericKey *key, const Row &row, Schema *schema);
+
+  /**
+   * Replace the row at index, its key is not changed.
+   * @return false if the page does not have enough space for the new row
+   */
+  bool Update(int index, const Row &row, Schema *schema);
+
+  void MarkDelete(int index) { SetSlotRowSize(index, GetSlotRowSize(index) | DELETE_MASK); }
+
+  void RollbackDelete(int index) { SetSlotRowSize(index, GetSlotRowSize(index) & ~DELETE_MASK); }
+
+  /**
+   * Remove the slot at index and release the space of its row, the following slots are shifted left.
+   */
+  void Remove(int index);
+
+  /**
+   * Remove all the rows marked as deleted.
+   * @return number of bytes given back to the free space of this page
+   */
+  uint32_t RemoveDeleted();
+
+  // Split utility methods
+  void MoveHalfTo(ClusteredLeafPage *recipient);
+
+  void MoveAllTo(ClusteredLeafPage *recipient);
+
+  /**
+   * @return size of the largest serialized row a leaf accepts, any two such rows fit into one leaf
+   */
+  static uint32_t GetMaxRowSize(int key_size);
+
+ private:
+  char *SlotAt(int index) { return data_ + index * GetSlotSize(); }
+
+  const char *SlotAt(int index) const { return data_ + index * GetSlotSize(); }
+
+  uint32_t GetSlotSize() const { return GetKeySize() + 2 * sizeof(uint32_t); }
+
+  uint32_t GetRowOffset(int index) const { return MACH_READ_UINT32(SlotAt(index) + GetKeySize()); }
+
+  void SetRowOffset(int index, uint32_t offset) { MACH_WRITE_UINT32(SlotAt(index) + GetKeySize(), offset); }
+
+  uint32_t GetSlotRowSize(int index) const {
+    return MACH_READ_UINT32(SlotAt(index) + GetKeySize() + sizeof(uint32_t));
+  }
+
+  void SetSlotRowSize(int index, uint32_t size) {
+    MACH_WRITE_UINT32(SlotAt(index) + GetKeySize() + sizeof(uint32_t), size);
+  }
+
+  uint32_t GetRowSize(int index) const { return GetSlotRowSize(index) & ~DELETE_MASK; }
+
+  /**
+   * Release the bytes of the row at index, the rows stored below it are moved up.
+   */
+  void FreeRowSpace(int index);
+
+  /**
+   * Append a slot with a copy of its row bytes, the page must have enough space.
+   */
+  void CopyLastFrom(GenericKey *key, const char *row, uint32_t slot_row_size);
+
+  /**
+   * Rewrite the rows of the remaining slots next to each other at the end of the page.
+   */
+  void Compact();
+
+ private:
+  static constexpr uint32_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
+
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  // offset in data_ of the lowest row
+  uint32_t free_space_pointer_;
+  char data_[PAGE_SIZE - LEAF_PAGE_HEADER_SIZE];
+};
+
+#endif  // MINISQL_CLUSTERED_LEAF_PAGE_H
@@ -0,0 +1,35 @@
+#ifndef MINISQL_OVERFLOW_PAGE_H
+#define MINISQL_OVERFLOW_PAGE_H
+
+/**
+ * Overflow page format, a long varchar value is split into a chain of overflow pages:
+ *  -------------------------------------------------------
+ *  | NextPageId (4) | DataSize (4) | ... VALUE BYTES ... |
+ *  -------------------------------------------------------
+ **/
+
+#include <cstring>
+
+#include "common/config.h"
+#include "page/page.h"
+
+class OverflowPage : public Page {
+ public:
+  void Init(page_id_t next_page_id, const char *data, uint32_t size);
+
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  uint32_t GetDataSize() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_DATA_SIZE); }
+
+  const char *GetValueData() { return GetData() + SIZE_OVERFLOW_PAGE_HEADER; }
+
+ private:
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 0;
+  static constexpr size_t OFFSET_DATA_SIZE = 4;
+  static constexpr size_t SIZE_OVERFLOW_PAGE_HEADER = 8;
+
+ public:
+  static constexpr size_t SIZE_MAX_DATA = PAGE_SIZE - SIZE_OVERFLOW_PAGE_HEADER;
+};
+
+#endif  // MINISQL_OVERFLOW_PAGE_H
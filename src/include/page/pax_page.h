@@ -0,0 +1,148 @@
+#ifndef MINISQL_PAX_PAGE_H
+#define MINISQL_PAX_PAGE_H
+/**
+ * PAX (Partition Attributes Across) page format, the values of each column are stored together
+ * in a minipage so that a scan touching few columns only reads a fraction of the page:
+ *  -----------------------------------------------------------------------------
+ *  | HEADER | SLOT STATES | MINIPAGE_1 | MINIPAGE_2 | ... | MINIPAGE_N | (unused) |
+ *  -----------------------------------------------------------------------------
+ *
+ *  Header format (size in bytes):
+ *  ------------------------------------------------------------------------------------------
+ *  | PageId (4)| LSN (4)| PrevPageId (4)| NextPageId (4)| TupleCount (4) | Capacity (4) |
+ *  ------------------------------------------------------------------------------------------
+ *  Slot states: one byte per slot (empty, live or marked as deleted).
+ *
+ *  Minipage format, every value takes the fixed width of its column (char values are stored as
+ *  length + bytes, padded to the declared length of the column):
+ *  --------------------------------------------------------------------
+ *  | Null bitmap (Capacity / 8) | Value_1 | Value_2 | ... | Value_Capacity |
+ *  --------------------------------------------------------------------
+ **/
+
+#include <cstring>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/rowid.h"
+#include "concurrency/lock_manager.h"
+#include "concurrency/txn.h"
+#include "page/page.h"
+#include "record/row.h"
+#include "recovery/log_manager.h"
+
+class PaxPage : public Page {
+ public:
+  void Init(page_id_t page_id, page_id_t prev_id, Schema *schema, LogManager *log_mgr, Txn *txn);
+
+  page_id_t GetTablePageId() { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  page_id_t GetPrevPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_PREV_PAGE_ID); }
+
+  page_id_t GetNextPageId() { return *reinterpret_cast<page_id_t *>(GetData() + OFFSET_NEXT_PAGE_ID); }
+
+  void SetPrevPageId(page_id_t prev_page_id) {
+    memcpy(GetData() + OFFSET_PREV_PAGE_ID, &prev_page_id, sizeof(page_id_t));
+  }
+
+  void SetNextPageId(page_id_t next_page_id) {
+    memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  }
+
+  /**
+   * @return number of occupied slots, including the tuples marked as deleted
+   */
+  uint32_t GetTupleCount() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_TUPLE_COUNT); }
+
+  uint32_t GetCapacity() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_CAPACITY); }
+
+  uint32_t GetFreeSlotCount() { return GetCapacity() - GetTupleCount(); }
+
+  bool InsertTuple(Row &row, Schema *schema, Txn *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  bool MarkDelete(const RowId &rid, Txn *txn, LockManager *lock_manager, LogManager *log_manager);
+
+  /**
+   * Values are fixed width, so an update always happens in place unless a char value exceeds the
+   * declared length of its column.
+   */
+  bool UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn, LockManager *lock_manager,
+                   LogManager *log_manager);
+
+  void ApplyDelete(const RowId &rid, Txn *txn, LogManager *log_manager);
+
+  void RollbackDelete(const RowId &rid, Txn *txn, LogManager *log_manager);
+
+  bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
+
+  bool GetFirstTupleRid(RowId *first_rid);
+
+  bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
+
+  /**
+   * Collect the slot numbers of the live tuples in this page.
+   */
+  void GetLiveSlots(std::vector<uint32_t> *slots);
+
+  /**
+   * Decode the values of one column for the given slots, only the minipage of the column is read.
+   * @param[out] values decoded values, appended in the order of slots
+   */
+  void GetColumn(Schema *schema, uint32_t column_index, const std::vector<uint32_t> &slots,
+                 std::vector<Field> *values);
+
+  /**
+   * Release the slots of the tuples marked as deleted.
+   * @return number of bytes given back to the free space of this page
+   */
+  uint32_t Vacuum(Schema *schema, Txn *txn, LogManager *log_manager);
+
+  /**
+   * @return bytes taken by one value of the column in its minipage
+   */
+  static uint32_t GetValueWidth(const Column *column);
+
+  /**
+   * @return number of tuples a pax page of the schema can hold, 0 if a tuple can not fit into a page
+   */
+  static uint32_t ComputeCapacity(const Schema *schema);
+
+ private:
+  enum SlotState : uint8_t { kSlotEmpty = 0, kSlotLive, kSlotDeleted };
+
+  void SetTupleCount(uint32_t tuple_count) { memcpy(GetData() + OFFSET_TUPLE_COUNT, &tuple_count, sizeof(uint32_t)); }
+
+  void SetCapacity(uint32_t capacity) { memcpy(GetData() + OFFSET_CAPACITY, &capacity, sizeof(uint32_t)); }
+
+  SlotState GetSlotState(uint32_t slot_num) {
+    return static_cast<SlotState>(*(GetData() + SIZE_PAX_PAGE_HEADER + slot_num));
+  }
+
+  void SetSlotState(uint32_t slot_num, SlotState state) {
+    *(GetData() + SIZE_PAX_PAGE_HEADER + slot_num) = static_cast<char>(state);
+  }
+
+  /**
+   * @return offset of the minipage of the column in this page
+   */
+  uint32_t GetMinipageOffset(Schema *schema, uint32_t column_index);
+
+  /**
+   * Check that all the values of the row fit into their minipages.
+   */
+  static bool FitsColumns(const Row &row, Schema *schema);
+
+  void WriteTuple(const Row &row, Schema *schema, uint32_t slot_num);
+
+  static uint32_t GetNullBitmapSize(uint32_t capacity) { return (capacity + 7) / 8; }
+
+ private:
+  static_assert(sizeof(page_id_t) == 4);
+  static constexpr size_t SIZE_PAX_PAGE_HEADER = 24;
+  static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
+  static constexpr size_t OFFSET_NEXT_PAGE_ID = 12;
+  static constexpr size_t OFFSET_TUPLE_COUNT = 16;
+  static constexpr size_t OFFSET_CAPACITY = 20;
+};
+
+#endif  // MINISQL_PAX_PAGE_H
@@ -15,6 +15,11 @@
  *  ----------------------------------------------------------------
  *  | TupleCount (4) | Tuple_1 offset (4) | Tuple_1 size (4) | ... |
  *  ----------------------------------------------------------------
+ *
+ *  Besides the delete mark, the tuple size carries two more flags:
+ *  FORWARD: the slot holds an 8-byte RowId of the tuple instead of the tuple, it is left behind
+ *           when an updated tuple does not fit into its page any more, so its RowId stays valid.
+ *  MOVED:   the tuple is the target of a forwarding slot, it is only reached through that slot.
  **/
 
 #include <cstring>
@@ -58,10 +63,35 @@ class TablePage : public Page {
 
   bool GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_manager);
 
+  /**
+   * @return the serialized tuple at slot_num, nullptr if the slot is deleted or a forwarding slot
+   */
+  char *GetTupleData(uint32_t slot_num);
+
   bool GetFirstTupleRid(RowId *first_rid);
 
   bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
 
+  /**
+   * Physically remove all the tuples marked as deleted, pack the live tuples towards the end of
+   * the page and trim the empty slots at the tail of the slot array.
+   * @return number of bytes given back to the free space of this page
+   */
+  uint32_t Vacuum(Txn *txn, LogManager *log_manager);
+
+  /**
+   * Rewrite every tuple of the page from the encoding of one schema into that of another, e.g. from
+   * the v1 into the v2 tuple format. The tuples must not grow, they stay in their slots.
+   * @return number of bytes given back to the free space of this page
+   */
+  uint32_t ConvertTuples(Schema *from, Schema *to);
+
+  /**
+   * @param[out] target location of the tuple if the slot at rid is a forwarding slot
+   * @return false if the slot holds the tuple itself
+   */
+  bool GetForward(const RowId &rid, RowId *target);
+
  private:
   uint32_t GetFreeSpacePointer() { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
 
@@ -99,9 +129,50 @@ class TablePage : public Page {
 
   static uint32_t UnsetDeletedFlag(uint32_t tuple_size) { return static_cast<uint32_t>(tuple_size & (~DELETE_MASK)); }
 
+  static bool IsForward(uint32_t tuple_size) { return static_cast<bool>(tuple_size & FORWARD_MASK); }
+
+  static bool IsMoved(uint32_t tuple_size) { return static_cast<bool>(tuple_size & MOVED_MASK); }
+
+  /**
+   * @return number of bytes of the tuple, without the flags
+   */
+  static uint32_t GetTupleLength(uint32_t tuple_size) {
+    return static_cast<uint32_t>(tuple_size & ~(DELETE_MASK | FORWARD_MASK | MOVED_MASK));
+  }
+
+  /**
+   * Replace the tuple at slot_num with a forwarding slot to target, the old value is copied out.
+   * The tuple must not be a forwarding slot already.
+   */
+  void SetForward(uint32_t slot_num, const RowId &target, Row *old_row, Schema *schema);
+
+  /**
+   * Point the forwarding slot at slot_num to target.
+   */
+  void ResetForward(uint32_t slot_num, const RowId &target);
+
+  /**
+   * Flag the tuple at slot_num as the target of a forwarding slot.
+   */
+  void SetMoved(uint32_t slot_num) { SetTupleSize(slot_num, GetTupleSize(slot_num) | MOVED_MASK); }
+
+  /**
+   * Copy the tuple at slot_num of page with its flags, the page must have enough space.
+   * @param[out] rid row id of the copy
+   */
+  void CopyTupleFrom(TablePage *page, uint32_t slot_num, RowId *rid);
+
+  /**
+   * Shrink or grow the tuple at slot_num in place, the tuples stored below it are moved.
+   */
+  void ResizeTuple(uint32_t slot_num, uint32_t new_length);
+
  private:
   static_assert(sizeof(page_id_t) == 4);
   static constexpr uint64_t DELETE_MASK = (1U << (8 * sizeof(uint32_t) - 1));
+  static constexpr uint32_t FORWARD_MASK = (1U << (8 * sizeof(uint32_t) - 2));
+  static constexpr uint32_t MOVED_MASK = (1U << (8 * sizeof(uint32_t) - 3));
+  static constexpr uint32_t SIZE_FORWARD = sizeof(int64_t);
   static constexpr size_t SIZE_TABLE_PAGE_HEADER = 24;
   static constexpr size_t SIZE_TUPLE = 8;
   static constexpr size_t OFFSET_PREV_PAGE_ID = 8;
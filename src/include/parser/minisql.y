@@ -12,10 +12,10 @@
 }
 
 %token <syntax_node> CREATE DROP SELECT INSERT DELETE UPDATE
-%token <syntax_node> TRXBEGIN TRXCOMMIT TRXROLLBACK QUIT EXECFILE SHOW USE USING
+%token <syntax_node> TRXBEGIN TRXCOMMIT TRXROLLBACK QUIT EXECFILE SHOW USE USING VACUUM ANALYZE
 %token <syntax_node> DATABASE DATABASES TABLE TABLES INDEX INDEXES
 %token <syntax_node> ON FROM WHERE INTO SET VALUES PRIMARY KEY UNIQUE
-%token <syntax_node> CHAR INT FLOAT AND OR NOT IS FLAGNULL
+%token <syntax_node> CHAR INT FLOAT BIGINT DOUBLE TIMESTAMP AND OR NOT IS FLAGNULL
 %token <syntax_node> IDENTIFIER STRING NUMBER EQ NE LE GE
 
 %type <syntax_node> start sql
@@ -27,7 +27,7 @@
 %type <syntax_node> sql_select select_columns column_values column_value operator
 %type <syntax_node> connector where_conditions where_condition
 %type <syntax_node> sql_insert sql_delete sql_update update_values update_value
-%type <syntax_node> sql_quit sql_exec_file
+%type <syntax_node> sql_quit sql_exec_file sql_vacuum sql_analyze
 
 %%
 
@@ -58,6 +58,8 @@ sql:
   | sql_trx_rollback { $$ = $1; }
   | sql_quit { $$ = $1; }
   | sql_exec_file { $$ = $1; }
+  | sql_vacuum { $$ = $1; }
+  | sql_analyze { $$ = $1; }
   ;
 
 sql_create_database:
@@ -101,6 +103,16 @@ sql_create_table:
     SyntaxNodeAddChildren($$, $3);
     SyntaxNodeAddChildren($$, list_node);
   }
+  | CREATE TABLE IDENTIFIER '(' column_definition_list ')' USING IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeCreateTable, NULL);
+    pSyntaxNode list_node = CreateSyntaxNode(kNodeColumnDefinitionList, NULL);
+    SyntaxNodeAddChildren(list_node, $5);
+    SyntaxNodeAddChildren($$, $3);
+    SyntaxNodeAddChildren($$, list_node);
+    pSyntaxNode layout_node = CreateSyntaxNode(kNodeTableLayout, "table layout");
+    SyntaxNodeAddChildren(layout_node, $8);
+    SyntaxNodeAddChildren($$, layout_node);
+  }
   ;
 
 column_list:
@@ -133,6 +145,21 @@ column_definition:
     SyntaxNodeAddChildren($$, $1);
     SyntaxNodeAddChildren($$, $2);
   }
+  | IDENTIFIER column_type NOT FLAGNULL UNIQUE {
+    $$ = CreateSyntaxNode(kNodeColumnDefinition, "not null unique");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | IDENTIFIER column_type UNIQUE NOT FLAGNULL {
+    $$ = CreateSyntaxNode(kNodeColumnDefinition, "not null unique");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | IDENTIFIER column_type NOT FLAGNULL {
+    $$ = CreateSyntaxNode(kNodeColumnDefinition, "not null");
+    SyntaxNodeAddChildren($$, $1);
+    SyntaxNodeAddChildren($$, $2);
+  }
   | IDENTIFIER column_type {
     $$ = CreateSyntaxNode(kNodeColumnDefinition, NULL);
     SyntaxNodeAddChildren($$, $1);
@@ -147,6 +174,15 @@ column_type:
   | FLOAT {
     $$ = CreateSyntaxNode(kNodeColumnType, "float");
   }
+  | BIGINT {
+    $$ = CreateSyntaxNode(kNodeColumnType, "bigint");
+  }
+  | DOUBLE {
+    $$ = CreateSyntaxNode(kNodeColumnType, "double");
+  }
+  | TIMESTAMP {
+    $$ = CreateSyntaxNode(kNodeColumnType, "timestamp");
+  }
   | CHAR '(' NUMBER ')' {
     $$ = CreateSyntaxNode(kNodeColumnType, "char");
     SyntaxNodeAddChildren($$, $3);
@@ -393,6 +429,26 @@ sql_exec_file:
   }
   ;
 
+sql_vacuum:
+  VACUUM IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeVacuum, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | VACUUM {
+    $$ = CreateSyntaxNode(kNodeVacuum, NULL);
+  }
+  ;
+
+sql_analyze:
+  ANALYZE IDENTIFIER {
+    $$ = CreateSyntaxNode(kNodeAnalyze, NULL);
+    SyntaxNodeAddChildren($$, $2);
+  }
+  | ANALYZE {
+    $$ = CreateSyntaxNode(kNodeAnalyze, NULL);
+  }
+  ;
+
 %%
 int yyerror(char* error) {
 	MinisqlParserSetError(error);
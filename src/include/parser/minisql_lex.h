@@ -309,7 +309,7 @@ extern int yylex(void);
 #undef YY_DECL
 #endif
 
-#line 296 "minisql.l"
+#line 321 "minisql.l"
 
 #line 318 "./minisql_lex.h"
 #undef yyIN_HEADER
@@ -43,7 +43,10 @@ typedef enum {
   kNodeIndexType,            /** type of index */
   kNodeTrxBegin,             /** begin recovery command */
   kNodeTrxCommit,            /** commit recovery command */
-  kNodeTrxRollback           /** rollback recovery command */
+  kNodeTrxRollback,          /** rollback recovery command */
+  kNodeVacuum,               /** vacuum command */
+  kNodeTableLayout,          /** page layout of table */
+  kNodeAnalyze               /** analyze command */
 } SyntaxNodeType;
 
 /**
@@ -34,6 +34,25 @@ class Planner {
 
   AbstractPlanNodeRef PlanSelect(std::shared_ptr<SelectStatement> statement);
 
+  /**
+   * Split a predicate at its top level ORs.
+   */
+  static void CollectDisjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *disjuncts);
+
+  /**
+   * Fold the comparisons of a conjunction on columns with an index into one key range per column.
+   * @param[out] key_ranges ranges of the columns restricted so far
+   * @param[out] folded_all set to false if a part of the predicate is not a range of an indexed column
+   */
+  static void FoldKeyRanges(const AbstractExpressionRef &expr, const std::vector<IndexInfo *> &indexes,
+                            std::vector<IndexKeyRange> *key_ranges, bool *folded_all);
+
+  /**
+   * Estimate the fraction of the rows within all the key ranges of a conjunction, the columns are taken
+   * as independent.
+   */
+  static double EstimateSelectivity(const TableStatistics *table_stats, const std::vector<IndexKeyRange> &key_ranges);
+
   AbstractPlanNodeRef PlanInsert(std::shared_ptr<InsertStatement> statement);
 
   AbstractPlanNodeRef PlanDelete(std::shared_ptr<DeleteStatement> statement);
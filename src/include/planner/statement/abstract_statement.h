@@ -82,6 +82,26 @@ class AbstractStatement {
           f = new Field(kTypeChar, value->val_, strlen(value->val_), true);
           break;
         }
+        case kTypeBigInt: {
+          if (value->type_ != kNodeNumber)
+            throw std::logic_error("The value of the predicate does not match the type of column");
+          f = new Field(kTypeBigInt, static_cast<int64_t>(stoll(value->val_)));
+          break;
+        }
+        case kTypeDouble: {
+          if (value->type_ != kNodeNumber)
+            throw std::logic_error("The value of the predicate does not match the type of column");
+          f = new Field(kTypeDouble, stod(value->val_));
+          break;
+        }
+        case kTypeTimestamp: {
+          // the string is parsed once here, the predicate compares the integers
+          int64_t micros;
+          if (value->type_ != kNodeString || !TypeTimestamp::Parse(value->val_, &micros))
+            throw std::logic_error("The value of the predicate is not a timestamp");
+          f = new Field(kTypeTimestamp, micros);
+          break;
+        }
         default:
           throw std::logic_error("The type of the column is kTypeInvalid");
       }
@@ -101,8 +121,8 @@ class AbstractStatement {
                                       vector<uint32_t> *column_in_condition = nullptr, bool *has_or = nullptr) {
     switch (ast->type_) {
       case kNodeConnector: {
-        auto left = MakePredicate(ast->child_, table_name, column_in_condition);
-        auto right = MakePredicate(ast->child_->next_, table_name, column_in_condition);
+        auto left = MakePredicate(ast->child_, table_name, column_in_condition, has_or);
+        auto right = MakePredicate(ast->child_->next_, table_name, column_in_condition, has_or);
         if (has_or && !strcmp(ast->val_, "or")) {
           *has_or = true;
         }
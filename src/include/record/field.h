@@ -2,11 +2,14 @@
 #define MINISQL_FIELD_H
 
 #include <cstring>
+#include <new>
 #include <string>
 
 #include "common/config.h"
 #include "common/macros.h"
 #include "record/type_id.h"
+#include "record/tuple_format.h"
+#include "record/type_kernels.h"
 #include "record/types.h"
 
 class Field {
@@ -18,6 +21,12 @@ class Field {
 
   friend class TypeFloat;
 
+  friend class TypeBigInt;
+
+  friend class TypeDouble;
+
+  friend class ZoneMap;
+
  public:
   explicit Field(const TypeId type) : type_id_(type), len_(FIELD_NULL_LEN), is_null_(true) {}
 
@@ -41,6 +50,20 @@ class Field {
     len_ = Type::GetTypeSize(type);
   }
 
+  // bigint or timestamp
+  explicit Field(TypeId type, int64_t i) : type_id_(type) {
+    ASSERT(type == TypeId::kTypeBigInt || type == TypeId::kTypeTimestamp, "Invalid type.");
+    value_.bigint_ = i;
+    len_ = Type::GetTypeSize(type);
+  }
+
+  // double
+  explicit Field(TypeId type, double d) : type_id_(type) {
+    ASSERT(type == TypeId::kTypeDouble, "Invalid type.");
+    value_.double_ = d;
+    len_ = Type::GetTypeSize(type);
+  }
+
   // char
   explicit Field(TypeId type, char *data, uint32_t len, bool manage_data) : type_id_(type), manage_data_(manage_data) {
     ASSERT(type == TypeId::kTypeChar, "Invalid type.");
@@ -67,7 +90,10 @@ class Field {
     len_ = other.len_;
     is_null_ = other.is_null_;
     manage_data_ = other.manage_data_;
-    if (type_id_ == TypeId::kTypeChar && !is_null_ && manage_data_) {
+    is_external_ = other.is_external_;
+    if (type_id_ == TypeId::kTypeChar && !is_null_) {
+      // the copy owns its data, other may only borrow it, e.g. from the flat buffer of a row
+      manage_data_ = true;
       value_.chars_ = new char[len_];
       memcpy(value_.chars_, other.value_.chars_, len_);
     } else {
@@ -75,8 +101,32 @@ class Field {
     }
   }
 
-  // copy
-  Field &operator=(Field &other) {
+  // move constructor, other is left null and does not free the data any more
+  Field(Field &&other) noexcept
+      : value_(other.value_),
+        type_id_(other.type_id_),
+        len_(other.len_),
+        is_null_(other.is_null_),
+        manage_data_(other.manage_data_),
+        is_external_(other.is_external_) {
+    other.value_.chars_ = nullptr;
+    other.len_ = FIELD_NULL_LEN;
+    other.is_null_ = true;
+    other.manage_data_ = false;
+    other.is_external_ = false;
+  }
+
+  // copy, deep copy like the copy constructor
+  Field &operator=(const Field &other) {
+    if (this != &other) {
+      Field copy(other);
+      Swap(*this, copy);
+    }
+    return *this;
+  }
+
+  // move, the data of this field is freed along with other
+  Field &operator=(Field &&other) noexcept {
     Swap(*this, other);
     return *this;
   }
@@ -87,46 +137,160 @@ class Field {
 
   inline TypeId GetTypeId() const { return type_id_; }
 
+  /**
+   * External varchar field only holds the location of the value in overflow pages, see TableHeap
+   */
+  inline bool IsExternal() const { return is_external_; }
+
+  inline void SetExternal(bool is_external) { is_external_ = is_external; }
+
   inline const char *GetData() const { return Type::GetInstance(type_id_)->GetData(*this); }
 
-  inline uint32_t SerializeTo(char *buf) const { return Type::GetInstance(type_id_)->SerializeTo(*this, buf); }
+  /**
+   * Serialize the value, only char values are encoded differently in the v2 tuple format
+   */
+  inline uint32_t SerializeTo(char *buf, TupleFormat format = TupleFormat::kV1) const {
+    if (is_null_) {
+      return 0;
+    }
+    switch (type_id_) {
+      case TypeId::kTypeInt:
+        return TypeKernel<TypeId::kTypeInt>::Write(buf, value_.integer_);
+      case TypeId::kTypeFloat:
+        return TypeKernel<TypeId::kTypeFloat>::Write(buf, value_.float_);
+      case TypeId::kTypeBigInt:
+      case TypeId::kTypeTimestamp:
+        return TypeKernel<TypeId::kTypeBigInt>::Write(buf, value_.bigint_);
+      case TypeId::kTypeDouble:
+        return TypeKernel<TypeId::kTypeDouble>::Write(buf, value_.double_);
+      case TypeId::kTypeChar:
+        if (format == TupleFormat::kV2) {
+          return TypeKernel<TypeId::kTypeChar>::WriteCompact(buf, value_.chars_, len_, is_external_);
+        }
+        return TypeKernel<TypeId::kTypeChar>::Write(buf, value_.chars_, len_, is_external_);
+      default:
+        break;
+    }
+    return Type::GetInstance(type_id_)->SerializeTo(*this, buf);
+  }
 
   inline static uint32_t DeserializeFrom(char *buf, const TypeId type_id, Field **field, bool is_null) {
     return Type::GetInstance(type_id)->DeserializeFrom(buf, field, is_null);
   }
 
-  inline uint32_t GetSerializedSize() const { return Type::GetInstance(type_id_)->GetSerializedSize(*this, is_null_); }
+  /**
+   * Deserialize into the memory at field without allocating, a char value is not copied and points into buf.
+   */
+  inline static uint32_t DeserializeInPlace(char *buf, const TypeId type_id, Field *field, bool is_null,
+                                            TupleFormat format = TupleFormat::kV1) {
+    if (is_null) {
+      new (field) Field(type_id);
+      return 0;
+    }
+    switch (type_id) {
+      case TypeId::kTypeInt:
+        new (field) Field(type_id, TypeKernel<TypeId::kTypeInt>::Read(buf));
+        return sizeof(int32_t);
+      case TypeId::kTypeFloat:
+        new (field) Field(type_id, TypeKernel<TypeId::kTypeFloat>::Read(buf));
+        return sizeof(float);
+      case TypeId::kTypeBigInt:
+      case TypeId::kTypeTimestamp:
+        new (field) Field(type_id, TypeKernel<TypeId::kTypeBigInt>::Read(buf));
+        return sizeof(int64_t);
+      case TypeId::kTypeDouble:
+        new (field) Field(type_id, TypeKernel<TypeId::kTypeDouble>::Read(buf));
+        return sizeof(double);
+      case TypeId::kTypeChar: {
+        uint32_t header = sizeof(uint32_t);
+        uint32_t len;
+        bool is_external;
+        if (format == TupleFormat::kV2) {
+          header = TypeKernel<TypeId::kTypeChar>::ReadCompactHeader(buf, &len, &is_external);
+        } else {
+          len = TypeKernel<TypeId::kTypeChar>::ReadLength(buf);
+          is_external = (MACH_READ_UINT32(buf) & TypeKernel<TypeId::kTypeChar>::EXTERNAL_FLAG) != 0;
+        }
+        new (field) Field(type_id, buf + header, len, false);
+        field->is_external_ = is_external;
+        return header + len;
+      }
+      default:
+        break;
+    }
+    return Type::GetInstance(type_id)->DeserializeInPlace(buf, field, is_null);
+  }
+
+  inline uint32_t GetSerializedSize(TupleFormat format = TupleFormat::kV1) const {
+    if (is_null_) {
+      return 0;
+    }
+    if (type_id_ != TypeId::kTypeChar) {
+      return Type::GetTypeSize(type_id_);
+    }
+    if (format == TupleFormat::kV2) {
+      return TypeKernel<TypeId::kTypeChar>::GetCompactHeaderSize(len_) + len_;
+    }
+    return sizeof(uint32_t) + len_;
+  }
 
   inline bool CheckComparable(const Field &o) const { return type_id_ == o.type_id_; }
 
-  inline CmpBool CompareEquals(const Field &o) const { return Type::GetInstance(type_id_)->CompareEquals(*this, o); }
+  inline CmpBool CompareEquals(const Field &o) const {
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) == 0);
+  }
 
   inline CmpBool CompareNotEquals(const Field &o) const {
-    return Type::GetInstance(type_id_)->CompareNotEquals(*this, o);
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) != 0);
   }
 
   inline CmpBool CompareLessThan(const Field &o) const {
-    return Type::GetInstance(type_id_)->CompareLessThan(*this, o);
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) < 0);
   }
 
   inline CmpBool CompareLessThanEquals(const Field &o) const {
-    return Type::GetInstance(type_id_)->CompareLessThanEquals(*this, o);
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) <= 0);
   }
 
   inline CmpBool CompareGreaterThan(const Field &o) const {
-    return Type::GetInstance(type_id_)->CompareGreaterThan(*this, o);
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) > 0);
   }
 
   inline CmpBool CompareGreaterThanEquals(const Field &o) const {
-    return Type::GetInstance(type_id_)->CompareGreaterThanEquals(*this, o);
+    return IsComparedToNull(o) ? CmpBool::kNull : GetCmpBool(CompareValues(o) >= 0);
+  }
+
+  /**
+   * Three-way comparison of two non-null values of the same type, with the kernel of the type
+   * instead of the virtual methods of Type.
+   */
+  inline int CompareValues(const Field &o) const {
+    switch (type_id_) {
+      case TypeId::kTypeInt:
+        return TypeKernel<TypeId::kTypeInt>::Compare(value_.integer_, o.value_.integer_);
+      case TypeId::kTypeFloat:
+        return TypeKernel<TypeId::kTypeFloat>::Compare(value_.float_, o.value_.float_);
+      case TypeId::kTypeBigInt:
+      case TypeId::kTypeTimestamp:
+        return TypeKernel<TypeId::kTypeBigInt>::Compare(value_.bigint_, o.value_.bigint_);
+      case TypeId::kTypeDouble:
+        return TypeKernel<TypeId::kTypeDouble>::Compare(value_.double_, o.value_.double_);
+      case TypeId::kTypeChar:
+        return TypeKernel<TypeId::kTypeChar>::Compare(value_.chars_, len_, o.value_.chars_, o.len_);
+      default:
+        break;
+    }
+    ASSERT(false, "Unknown field type.");
+    return 0;
   }
 
-  friend void Swap(Field &first, Field &second) {
+  friend void Swap(Field &first, Field &second) noexcept {
     std::swap(first.value_, second.value_);
     std::swap(first.type_id_, second.type_id_);
     std::swap(first.len_, second.len_);
     std::swap(first.is_null_, second.is_null_);
     std::swap(first.manage_data_, second.manage_data_);
+    std::swap(first.is_external_, second.is_external_);
   }
 
   std::string toString() {
@@ -136,6 +300,12 @@ class Field {
       return std::to_string(value_.integer_);
     else if (type_id_ == kTypeFloat)
       return std::to_string(value_.float_);
+    else if (type_id_ == kTypeBigInt)
+      return std::to_string(value_.bigint_);
+    else if (type_id_ == kTypeDouble)
+      return std::to_string(value_.double_);
+    else if (type_id_ == kTypeTimestamp)
+      return TypeTimestamp::Format(value_.bigint_);
     else {
       char temp[len_ + 1];
       memcpy(temp, value_.chars_, len_);
@@ -144,16 +314,25 @@ class Field {
     }
   }
 
+ private:
+  inline bool IsComparedToNull(const Field &o) const {
+    ASSERT(CheckComparable(o), "Not comparable.");
+    return is_null_ || o.is_null_;
+  }
+
  protected:
   union Val {
     int32_t integer_;
     float float_;
     char *chars_;
+    int64_t bigint_;
+    double double_;
   } value_;
   TypeId type_id_;
   uint32_t len_;
   bool is_null_{false};
   bool manage_data_{false};
+  bool is_external_{false};
 };
 
 #endif  // MINISQL_FIELD_H
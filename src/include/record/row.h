@@ -2,8 +2,10 @@
 #define MINISQL_ROW_H
 
 #include <memory>
+#include <new>
 #include <vector>
 
+#include "common/arena.h"
 #include "common/macros.h"
 #include "common/rowid.h"
 #include "record/field.h"
@@ -18,29 +20,50 @@
  * --------------------------------------------
  * | Field Nums | Null bitmap |
  * -------------------------------------------
+ *  The exact encoding depends on the tuple format of the schema, see TupleFormat.
  *
- *
+ *  In memory the fields of a row are kept flat in a single buffer, allocated from the heap or from an
+ *  Arena, so reading or copying a row costs no allocation per field:
+ * ---------------------------------------------------------
+ * | Field-1 | ... | Field-N | Char data-1 | ... | Char data-M |
+ * ---------------------------------------------------------
+ *  Every Field holds the null flag and a fixed-width value inline, a char field points at its data
+ *  behind the fields. Fields added later through GetFields() are allocated one by one and are owned by
+ *  the row as well.
  */
 class Row {
+  friend class TupleView;
+
  public:
   /**
    * Row used for insert
    * Field integrity should check by upper level
    */
   Row(std::vector<Field> &fields) {
-    // deep copy
-    for (auto &field : fields) {
-      fields_.push_back(new Field(field));
-    }
+    Flatten(fields.size(), [&fields](size_t i) { return &fields[i]; });
+  }
+
+  /**
+   * Row made of copies of other fields, e.g. a projection of another row
+   */
+  explicit Row(const std::vector<const Field *> &fields) {
+    Flatten(fields.size(), [&fields](size_t i) { return fields[i]; });
   }
 
   void destroy() {
-    if (!fields_.empty()) {
-      for (auto field : fields_) {
+    for (auto field : fields_) {
+      if (IsFlat(field)) {
+        field->~Field();
+      } else {
         delete field;
       }
-      fields_.clear();
     }
+    fields_.clear();
+    if (arena_ == nullptr) {
+      delete[] flat_;
+    }
+    flat_ = nullptr;
+    flat_count_ = 0;
   }
 
   ~Row() { destroy(); };
@@ -55,29 +78,73 @@ class Row {
    */
   Row(RowId rid) : rid_(rid) {}
 
+  /**
+   * Row used for deserialize, the buffer of the fields is allocated from arena. The row must not be
+   * used after the arena is reset, a copy of it is allocated from the heap.
+   */
+  Row(RowId rid, Arena *arena) : rid_(rid), arena_(arena) {}
+
   /**
    * Row copy function, deep copy
    */
   Row(const Row &other) {
-    destroy();
     rid_ = other.rid_;
-    for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
-    }
+    Flatten(other.fields_.size(), [&other](size_t i) { return other.fields_[i]; });
   }
 
   /**
    * Assign operator, deep copy
    */
   Row &operator=(const Row &other) {
+    if (this == &other) {
+      return *this;
+    }
     destroy();
     rid_ = other.rid_;
-    for (auto &field : other.fields_) {
-      fields_.push_back(new Field(*field));
+    Flatten(other.fields_.size(), [&other](size_t i) { return other.fields_[i]; });
+    return *this;
+  }
+
+  /**
+   * Move constructor, takes over the fields of other and leaves it empty
+   */
+  Row(Row &&other) noexcept
+      : rid_(other.rid_),
+        fields_(std::move(other.fields_)),
+        flat_(other.flat_),
+        flat_count_(other.flat_count_),
+        arena_(other.arena_) {
+    other.fields_.clear();
+    other.flat_ = nullptr;
+    other.flat_count_ = 0;
+  }
+
+  /**
+   * Move assign operator, the fields of this row are freed and other is left empty
+   */
+  Row &operator=(Row &&other) noexcept {
+    if (this != &other) {
+      destroy();
+      rid_ = other.rid_;
+      std::swap(fields_, other.fields_);
+      std::swap(flat_, other.flat_);
+      std::swap(flat_count_, other.flat_count_);
+      arena_ = other.arena_;
     }
     return *this;
   }
 
+  /**
+   * Exchange the contents of two rows without copying the fields.
+   */
+  friend void Swap(Row &first, Row &second) noexcept {
+    std::swap(first.rid_, second.rid_);
+    std::swap(first.fields_, second.fields_);
+    std::swap(first.flat_, second.flat_);
+    std::swap(first.flat_count_, second.flat_count_);
+    std::swap(first.arena_, second.arena_);
+  }
+
   /**
    * Note: Make sure that bytes write to buf is equal to GetSerializedSize()
    */
@@ -98,6 +165,10 @@ class Row {
 
   inline void SetRowId(RowId rid) { rid_ = rid; }
 
+  /**
+   * Fields may be appended or replaced, the vector must not be swapped with the one of another row,
+   * use Swap on the rows instead.
+   */
   inline std::vector<Field *> &GetFields() { return fields_; }
 
   inline Field *GetField(uint32_t idx) const {
@@ -108,8 +179,76 @@ class Row {
   inline size_t GetFieldCount() const { return fields_.size(); }
 
  private:
+  /**
+   * @return size of the rid and the null bitmap in front of the values of a serialized tuple
+   */
+  static uint32_t GetHeaderSize(const Schema *schema);
+
+  /**
+   * @return null bitmap of a serialized tuple, nullptr if the tuple has none
+   */
+  static char *GetNullBitmap(char *tuple, const Schema *schema);
+
+  static inline bool IsNullAt(const char *null_bitmap, uint32_t column_index) {
+    return null_bitmap != nullptr && (null_bitmap[column_index / 8] & (1 << (column_index % 8))) != 0;
+  }
+
+  /**
+   * @return number of leading fixed-width columns which are not null in a tuple with this null
+   * bitmap, the values of these columns and of the one behind them are at Schema::GetColumnOffset
+   */
+  static uint32_t CountFixedValues(const char *null_bitmap, const Schema *schema);
+
+  /**
+   * Allocate the flat buffer for field_count fields followed by data_size bytes of char data.
+   * @return where the char data goes
+   */
+  char *AllocateFlat(uint32_t field_count, uint32_t data_size);
+
+  /**
+   * Copy count fields into the flat buffer, field_at(i) gives the i-th field.
+   */
+  template <typename FieldAt>
+  void Flatten(size_t count, FieldAt field_at) {
+    uint32_t data_size = 0;
+    for (size_t i = 0; i < count; i++) {
+      auto field = field_at(i);
+      if (field->GetTypeId() == TypeId::kTypeChar && !field->IsNull()) {
+        data_size += field->GetLength();
+      }
+    }
+    char *data = AllocateFlat(count, data_size);
+    for (size_t i = 0; i < count; i++) {
+      auto field = field_at(i);
+      auto slot = reinterpret_cast<Field *>(flat_) + i;
+      if (field->GetTypeId() == TypeId::kTypeChar && !field->IsNull()) {
+        auto len = field->GetLength();
+        memcpy(data, field->GetData(), len);
+        new (slot) Field(TypeId::kTypeChar, data, len, false);
+        slot->SetExternal(field->IsExternal());
+        data += len;
+      } else {
+        new (slot) Field(*field);
+      }
+      fields_.push_back(slot);
+    }
+  }
+
+  /** @return true if the field lives in the flat buffer */
+  inline bool IsFlat(const Field *field) const {
+    auto first = reinterpret_cast<const Field *>(flat_);
+    return flat_ != nullptr && field >= first && field < first + flat_count_;
+  }
+
+  // a v2 tuple is padded to this size, so that it can be replaced with a forwarding RowId in place
+  static constexpr uint32_t MIN_COMPACT_TUPLE_SIZE = sizeof(RowId);
   RowId rid_{};
   std::vector<Field *> fields_; /** Make sure that all field ptr are destructed*/
+  /** Flat buffer of the fields, see the row format above */
+  char *flat_{nullptr};
+  uint32_t flat_count_{0};
+  /** Set if the flat buffer is allocated from an arena, it is not freed by the row then */
+  Arena *arena_{nullptr};
 };
 
 #endif  // MINISQL_ROW_H
@@ -6,6 +6,7 @@
 #include "common/macros.h"
 #include "glog/logging.h"
 #include "record/column.h"
+#include "record/tuple_format.h"
 
 #ifndef MINISQL_SCHEMA_H
 #define MINISQL_SCHEMA_H
@@ -13,7 +14,9 @@
 class Schema {
  public:
   explicit Schema(const std::vector<Column *> columns, bool is_manage_ = true)
-      : columns_(std::move(columns)), is_manage_(is_manage_) {}
+      : columns_(std::move(columns)), is_manage_(is_manage_) {
+    InitLayout();
+  }
 
   ~Schema() {
     if (is_manage_) {
@@ -39,6 +42,39 @@ class Schema {
 
   inline uint32_t GetColumnCount() const { return static_cast<uint32_t>(columns_.size()); }
 
+  /**
+   * @return number of leading fixed-width columns, in a serialized tuple their values and the one
+   * behind them start at fixed offsets as long as none of them is null
+   */
+  inline uint32_t GetFixedColumnCount() const { return static_cast<uint32_t>(column_offsets_.size()) - 1; }
+
+  /**
+   * @return true if no column is a char column
+   */
+  inline bool IsFixedWidth() const { return GetFixedColumnCount() == GetColumnCount(); }
+
+  /**
+   * @return encoding of the tuples stored with this schema, v1 unless set
+   */
+  inline TupleFormat GetTupleFormat() const { return tuple_format_; }
+
+  inline void SetTupleFormat(TupleFormat tuple_format) { tuple_format_ = tuple_format; }
+
+  /**
+   * @return false if the tuples have no null bitmap, i.e. the v2 format with all columns not null
+   */
+  inline bool HasNullBitmap() const { return tuple_format_ == TupleFormat::kV1 || has_nullable_; }
+
+  /**
+   * @return offset of the value of a column from the first value, column_index <= GetFixedColumnCount()
+   */
+  inline uint32_t GetColumnOffset(const uint32_t column_index) const { return column_offsets_[column_index]; }
+
+  /**
+   * @return size of the values of the leading fixed-width columns
+   */
+  inline uint32_t GetFixedSize() const { return column_offsets_.back(); }
+
   /**
    * Shallow copy schema, only used in index
    *
@@ -55,14 +91,16 @@ class Schema {
   }
 
   /**
-   * Deep copy schema
+   * Deep copy schema, with the tuple format
    */
   static Schema *DeepCopySchema(const Schema *from) {
     std::vector<Column *> cols;
     for (uint32_t i = 0; i < from->GetColumnCount(); i++) {
       cols.push_back(new Column(from->GetColumn(i)));
     }
-    return new Schema(cols, true);
+    auto schema = new Schema(cols, true);
+    schema->tuple_format_ = from->tuple_format_;
+    return schema;
   }
 
   /**
@@ -80,9 +118,17 @@ class Schema {
    */
   static uint32_t DeserializeFrom(char *buf, Schema *&schema);
 
+ private:
+  void InitLayout();
+
  private:
   static constexpr uint32_t SCHEMA_MAGIC_NUM = 200715;
   std::vector<Column *> columns_;
+  // offsets of the values of the leading fixed-width columns, and the end of the last one
+  std::vector<uint32_t> column_offsets_;
+  bool has_nullable_{false};
+  // not serialized with the schema, kept in the table metadata
+  TupleFormat tuple_format_{TupleFormat::kV1};
   bool is_manage_ = false; /** if false, don't need to delete pointer to column */
 };
 
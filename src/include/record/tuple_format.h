@@ -0,0 +1,15 @@
+#ifndef MINISQL_TUPLE_FORMAT_H
+#define MINISQL_TUPLE_FORMAT_H
+
+#include <cstdint>
+
+/**
+ * Encoding of a serialized tuple, see Row.
+ *  kV1: | RowId (8) | Null bitmap | Field-1 | ... | Field-N |, char values with a 4-byte length
+ *  kV2: | Null bitmap | Field-1 | ... | Field-N |, char values with a varint length, no bitmap if
+ *       all columns are not null, padded to at least 8 bytes
+ * Index keys of the row encoding are kept in the v1 format, see KeyEncoding.
+ */
+enum class TupleFormat : uint32_t { kV1 = 0, kV2 };
+
+#endif  // MINISQL_TUPLE_FORMAT_H
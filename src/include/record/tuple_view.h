@@ -0,0 +1,44 @@
+#ifndef MINISQL_TUPLE_VIEW_H
+#define MINISQL_TUPLE_VIEW_H
+
+#include <vector>
+
+#include "common/rowid.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+/**
+ * Read-only view of a serialized tuple, usually in a pinned and latched TablePage, see Row for the
+ * format. Nothing is decoded up front and char values are never copied, so the view and the rows
+ * bound to it are only valid as long as the viewed bytes are.
+ */
+class TupleView {
+ public:
+  TupleView(char *data, Schema *schema, RowId rid) : data_(data), schema_(schema), rid_(rid) {}
+
+  inline RowId GetRowId() const { return rid_; }
+
+  inline Schema *GetSchema() const { return schema_; }
+
+  /**
+   * Decode the referenced columns into an empty row, the other columns are left null. Char values
+   * point into the viewed bytes.
+   * @param referenced flag per column of the schema
+   * @return false if a referenced value is stored in overflow pages, the row is left empty then
+   */
+  bool Bind(const std::vector<bool> &referenced, Row *row) const;
+
+  /**
+   * Decode a single column into the uninitialized memory at field, a char value points into the viewed
+   * bytes. The value is read at its offset without a decode loop if the columns before it are int or
+   * float and not null.
+   */
+  void DecodeColumn(uint32_t column_index, Field *field) const;
+
+ private:
+  char *data_;
+  Schema *schema_;
+  RowId rid_;
+};
+
+#endif  // MINISQL_TUPLE_VIEW_H
@@ -1,6 +1,16 @@
 #ifndef MINISQL_TYPE_ID_H
 #define MINISQL_TYPE_ID_H
 
-enum TypeId { kTypeInvalid = 0, kTypeInt, kTypeFloat, kTypeChar, KMaxTypeId = kTypeChar };
+// The ids are stored with the columns of a table, new types are only ever appended.
+enum TypeId {
+  kTypeInvalid = 0,
+  kTypeInt,
+  kTypeFloat,
+  kTypeChar,
+  kTypeBigInt,
+  kTypeDouble,
+  kTypeTimestamp,
+  KMaxTypeId = kTypeTimestamp
+};
 
 #endif  // MINISQL_TYPE_ID_H
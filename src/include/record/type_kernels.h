@@ -0,0 +1,294 @@
+#ifndef MINISQL_TYPE_KERNELS_H
+#define MINISQL_TYPE_KERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "common/macros.h"
+#include "record/type_id.h"
+
+/**
+ * Comparison and serialization of the values of one type, resolved at compile time. The hot loops
+ * (B+ tree search, predicate evaluation, sorting, tuple encoding) use these instead of the virtual
+ * methods of Type. The serialized formats are the ones of the Type subclasses.
+ */
+template <TypeId type>
+struct TypeKernel;
+
+/**
+ * Order preserving encodings of the normalized keys, see KeyManager: the encoded values compare
+ * byte-wise with memcmp as the values do.
+ */
+template <typename Bits>
+inline void WriteBigEndian(char *buf, Bits value) {
+  for (int i = sizeof(Bits) - 1; i >= 0; i--) {
+    buf[i] = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+template <typename Bits>
+inline Bits ReadBigEndian(const char *buf) {
+  Bits value = 0;
+  for (size_t i = 0; i < sizeof(Bits); i++) {
+    value = (value << 8) | static_cast<uint8_t>(buf[i]);
+  }
+  return value;
+}
+
+/** Two's complement integers are written big-endian with the sign bit flipped */
+template <typename Int>
+struct OrderedInteger {
+  using Bits = std::make_unsigned_t<Int>;
+  static constexpr Bits SIGN = Bits(1) << (8 * sizeof(Int) - 1);
+
+  static inline void Write(char *buf, Int value) { WriteBigEndian<Bits>(buf, static_cast<Bits>(value) ^ SIGN); }
+
+  static inline Int Read(const char *buf) { return static_cast<Int>(ReadBigEndian<Bits>(buf) ^ SIGN); }
+};
+
+/**
+ * IEEE 754 values are written big-endian with all bits flipped if negative, else with the sign bit
+ * set. -0 is written as 0 so that the two compare equal.
+ */
+template <typename Float, typename Bits>
+struct OrderedFloat {
+  static_assert(sizeof(Float) == sizeof(Bits), "Float and Bits differ in size.");
+  static constexpr Bits SIGN = Bits(1) << (8 * sizeof(Bits) - 1);
+
+  static inline void Write(char *buf, Float value) {
+    Bits bits;
+    value = value == 0 ? 0 : value;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteBigEndian<Bits>(buf, (bits & SIGN) != 0 ? ~bits : bits | SIGN);
+  }
+
+  static inline Float Read(const char *buf) {
+    Bits bits = ReadBigEndian<Bits>(buf);
+    bits = (bits & SIGN) != 0 ? bits & ~SIGN : ~bits;
+    Float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+};
+
+template <>
+struct TypeKernel<TypeId::kTypeInt> {
+  using ValueType = int32_t;
+
+  static inline int Compare(ValueType lhs, ValueType rhs) { return (lhs > rhs) - (lhs < rhs); }
+
+  static inline ValueType Read(const char *buf) { return MACH_READ_FROM(ValueType, buf); }
+
+  static inline uint32_t Write(char *buf, ValueType value) {
+    MACH_WRITE_TO(ValueType, buf, value);
+    return sizeof(ValueType);
+  }
+
+  /** @return size of the serialized value at buf */
+  static inline uint32_t GetSerializedSize(const char *) { return sizeof(ValueType); }
+
+  /** Three-way comparison of two serialized values */
+  static inline int CompareSerialized(const char *lhs, const char *rhs) { return Compare(Read(lhs), Read(rhs)); }
+
+  /** Normalized key encoding, see OrderedInteger */
+  static inline void WriteNormalized(char *buf, ValueType value) { OrderedInteger<ValueType>::Write(buf, value); }
+
+  static inline ValueType ReadNormalized(const char *buf) { return OrderedInteger<ValueType>::Read(buf); }
+};
+
+template <>
+struct TypeKernel<TypeId::kTypeFloat> {
+  using ValueType = float;
+
+  static inline int Compare(ValueType lhs, ValueType rhs) { return (lhs > rhs) - (lhs < rhs); }
+
+  static inline ValueType Read(const char *buf) { return MACH_READ_FROM(ValueType, buf); }
+
+  static inline uint32_t Write(char *buf, ValueType value) {
+    MACH_WRITE_TO(ValueType, buf, value);
+    return sizeof(ValueType);
+  }
+
+  static inline uint32_t GetSerializedSize(const char *) { return sizeof(ValueType); }
+
+  static inline int CompareSerialized(const char *lhs, const char *rhs) { return Compare(Read(lhs), Read(rhs)); }
+
+  /** Normalized key encoding, see OrderedFloat */
+  static inline void WriteNormalized(char *buf, ValueType value) {
+    OrderedFloat<ValueType, uint32_t>::Write(buf, value);
+  }
+
+  static inline ValueType ReadNormalized(const char *buf) { return OrderedFloat<ValueType, uint32_t>::Read(buf); }
+};
+
+template <>
+struct TypeKernel<TypeId::kTypeBigInt> {
+  using ValueType = int64_t;
+
+  static inline int Compare(ValueType lhs, ValueType rhs) { return (lhs > rhs) - (lhs < rhs); }
+
+  static inline ValueType Read(const char *buf) { return MACH_READ_FROM(ValueType, buf); }
+
+  static inline uint32_t Write(char *buf, ValueType value) {
+    MACH_WRITE_TO(ValueType, buf, value);
+    return sizeof(ValueType);
+  }
+
+  static inline uint32_t GetSerializedSize(const char *) { return sizeof(ValueType); }
+
+  static inline int CompareSerialized(const char *lhs, const char *rhs) { return Compare(Read(lhs), Read(rhs)); }
+
+  /** Normalized key encoding, see OrderedInteger */
+  static inline void WriteNormalized(char *buf, ValueType value) { OrderedInteger<ValueType>::Write(buf, value); }
+
+  static inline ValueType ReadNormalized(const char *buf) { return OrderedInteger<ValueType>::Read(buf); }
+};
+
+template <>
+struct TypeKernel<TypeId::kTypeDouble> {
+  using ValueType = double;
+
+  static inline int Compare(ValueType lhs, ValueType rhs) { return (lhs > rhs) - (lhs < rhs); }
+
+  static inline ValueType Read(const char *buf) { return MACH_READ_FROM(ValueType, buf); }
+
+  static inline uint32_t Write(char *buf, ValueType value) {
+    MACH_WRITE_TO(ValueType, buf, value);
+    return sizeof(ValueType);
+  }
+
+  static inline uint32_t GetSerializedSize(const char *) { return sizeof(ValueType); }
+
+  static inline int CompareSerialized(const char *lhs, const char *rhs) { return Compare(Read(lhs), Read(rhs)); }
+
+  /** Normalized key encoding, see OrderedFloat */
+  static inline void WriteNormalized(char *buf, ValueType value) {
+    OrderedFloat<ValueType, uint64_t>::Write(buf, value);
+  }
+
+  static inline ValueType ReadNormalized(const char *buf) { return OrderedFloat<ValueType, uint64_t>::Read(buf); }
+};
+
+// a timestamp is a count of microseconds, see TypeTimestamp
+template <>
+struct TypeKernel<TypeId::kTypeTimestamp> : TypeKernel<TypeId::kTypeBigInt> {};
+
+template <>
+struct TypeKernel<TypeId::kTypeChar> {
+  // set in the serialized length of a value stored in overflow pages, see TypeChar
+  static constexpr uint32_t EXTERNAL_FLAG = (1U << (8 * sizeof(uint32_t) - 1));
+
+  /** Byte-wise comparison, a prefix is less than the longer string */
+  static inline int Compare(const char *lhs, uint32_t lhs_len, const char *rhs, uint32_t rhs_len) {
+    int ret = memcmp(lhs, rhs, std::min(lhs_len, rhs_len));
+    if (ret == 0 && lhs_len != rhs_len) {
+      ret = lhs_len < rhs_len ? -1 : 1;
+    }
+    return ret;
+  }
+
+  static inline uint32_t ReadLength(const char *buf) { return MACH_READ_UINT32(buf) & ~EXTERNAL_FLAG; }
+
+  static inline uint32_t Write(char *buf, const char *data, uint32_t len, bool is_external) {
+    MACH_WRITE_UINT32(buf, is_external ? (len | EXTERNAL_FLAG) : len);
+    memcpy(buf + sizeof(uint32_t), data, len);
+    return sizeof(uint32_t) + len;
+  }
+
+  static inline uint32_t GetSerializedSize(const char *buf) { return sizeof(uint32_t) + ReadLength(buf); }
+
+  static inline int CompareSerialized(const char *lhs, const char *rhs) {
+    return Compare(lhs + sizeof(uint32_t), ReadLength(lhs), rhs + sizeof(uint32_t), ReadLength(rhs));
+  }
+
+  /**
+   * Normalized key encoding of a value of a char(max_len) column: the bytes padded with zeros to
+   * max_len, then the length big-endian. A prefix sorts before the longer string as in Compare.
+   */
+  static inline uint32_t GetNormalizedSize(uint32_t max_len) { return max_len + sizeof(uint32_t); }
+
+  static inline void WriteNormalized(char *buf, const char *data, uint32_t len, uint32_t max_len) {
+    memcpy(buf, data, len);
+    memset(buf + len, 0, max_len - len);
+    WriteBigEndian<uint32_t>(buf + max_len, len);
+  }
+
+  static inline uint32_t ReadNormalizedLength(const char *buf, uint32_t max_len) {
+    return ReadBigEndian<uint32_t>(buf + max_len);
+  }
+
+  /**
+   * Compact encoding of the v2 tuple format: a varint of (length << 1 | external), 7 bits per byte
+   * with the high bit set on all but the last byte, followed by the bytes.
+   */
+  static inline uint32_t GetCompactHeaderSize(uint32_t len) {
+    uint64_t header = static_cast<uint64_t>(len) << 1;
+    uint32_t size = 1;
+    while (header >= 0x80) {
+      header >>= 7;
+      size++;
+    }
+    return size;
+  }
+
+  static inline uint32_t WriteCompact(char *buf, const char *data, uint32_t len, bool is_external) {
+    uint64_t header = (static_cast<uint64_t>(len) << 1) | (is_external ? 1 : 0);
+    uint32_t size = 0;
+    while (header >= 0x80) {
+      buf[size++] = static_cast<char>((header & 0x7f) | 0x80);
+      header >>= 7;
+    }
+    buf[size++] = static_cast<char>(header);
+    memcpy(buf + size, data, len);
+    return size + len;
+  }
+
+  /**
+   * @return size of the varint header at buf
+   */
+  static inline uint32_t ReadCompactHeader(const char *buf, uint32_t *len, bool *is_external) {
+    uint64_t header = 0;
+    uint32_t size = 0;
+    uint8_t byte;
+    do {
+      byte = static_cast<uint8_t>(buf[size]);
+      header |= static_cast<uint64_t>(byte & 0x7f) << (7 * size);
+      size++;
+    } while ((byte & 0x80) != 0);
+    *len = static_cast<uint32_t>(header >> 1);
+    *is_external = (header & 1) != 0;
+    return size;
+  }
+};
+
+/**
+ * Call func with the TypeKernel of type, e.g.
+ *   DispatchType(type, [&](auto kernel) { return decltype(kernel)::CompareSerialized(lhs, rhs); });
+ * The switch is the only branch on the type, the body of func is compiled once per type.
+ */
+template <typename Func>
+inline auto DispatchType(TypeId type, Func &&func) {
+  switch (type) {
+    case TypeId::kTypeInt:
+      return func(TypeKernel<TypeId::kTypeInt>());
+    case TypeId::kTypeFloat:
+      return func(TypeKernel<TypeId::kTypeFloat>());
+    case TypeId::kTypeChar:
+      return func(TypeKernel<TypeId::kTypeChar>());
+    case TypeId::kTypeBigInt:
+      return func(TypeKernel<TypeId::kTypeBigInt>());
+    case TypeId::kTypeDouble:
+      return func(TypeKernel<TypeId::kTypeDouble>());
+    case TypeId::kTypeTimestamp:
+      return func(TypeKernel<TypeId::kTypeTimestamp>());
+    default:
+      break;
+  }
+  ASSERT(false, "Unknown field type.");
+  return func(TypeKernel<TypeId::kTypeInt>());
+}
+
+#endif  // MINISQL_TYPE_KERNELS_H
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstdint>
 #include <exception>
+#include <string>
 
 #include "common/config.h"
 #include "record/type_id.h"
@@ -30,6 +31,11 @@ class Type {
         return sizeof(float);
       case kTypeChar:
         return 0;
+      case kTypeBigInt:
+      case kTypeTimestamp:
+        return sizeof(int64_t);
+      case kTypeDouble:
+        return sizeof(double);
       default:
         break;
     }
@@ -46,6 +52,9 @@ class Type {
   // Deserialize a field of the given type from the given storage space.
   virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const;
 
+  // Deserialize a field of the given type into the given memory, variable length data stays in storage.
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const;
+
   // Get serialize size of a field
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const;
 
@@ -80,6 +89,8 @@ class TypeInt : public Type {
 
   virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
 
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const override;
+
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
   virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
@@ -103,6 +114,8 @@ class TypeChar : public Type {
 
   virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
 
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const override;
+
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
   virtual const char *GetData(const Field &val) const override;
@@ -120,6 +133,9 @@ class TypeChar : public Type {
   virtual CmpBool CompareGreaterThan(const Field &left, const Field &right) const override;
 
   virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
+
+  // set in the serialized length of an external field
+  static constexpr uint32_t EXTERNAL_FLAG = (1U << (8 * sizeof(uint32_t) - 1));
 };
 
 class TypeFloat : public Type {
@@ -130,6 +146,62 @@ class TypeFloat : public Type {
 
   virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
 
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const override;
+
+  virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
+
+  virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareNotEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareLessThan(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareLessThanEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareGreaterThan(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
+};
+
+class TypeBigInt : public Type {
+ public:
+  explicit TypeBigInt() : Type(TypeId::kTypeBigInt) {}
+
+  virtual uint32_t SerializeTo(const Field &field, char *buf) const override;
+
+  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
+
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const override;
+
+  virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
+
+  virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareNotEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareLessThan(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareLessThanEquals(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareGreaterThan(const Field &left, const Field &right) const override;
+
+  virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
+
+ protected:
+  // types stored as a 64-bit integer
+  explicit TypeBigInt(TypeId type_id) : Type(type_id) {}
+};
+
+class TypeDouble : public Type {
+ public:
+  explicit TypeDouble() : Type(TypeId::kTypeDouble) {}
+
+  virtual uint32_t SerializeTo(const Field &field, char *buf) const override;
+
+  virtual uint32_t DeserializeFrom(char *storage, Field **field, bool is_null) const override;
+
+  virtual uint32_t DeserializeInPlace(char *storage, Field *field, bool is_null) const override;
+
   virtual uint32_t GetSerializedSize(const Field &field, bool is_null) const override;
 
   virtual CmpBool CompareEquals(const Field &left, const Field &right) const override;
@@ -145,4 +217,23 @@ class TypeFloat : public Type {
   virtual CmpBool CompareGreaterThanEquals(const Field &left, const Field &right) const override;
 };
 
+/**
+ * Microseconds since 1970-01-01 00:00:00 UTC, stored and compared like a BIGINT.
+ */
+class TypeTimestamp : public TypeBigInt {
+ public:
+  explicit TypeTimestamp() : TypeBigInt(TypeId::kTypeTimestamp) {}
+
+  /**
+   * Parse "YYYY-MM-DD", "YYYY-MM-DD HH:MM:SS" or "YYYY-MM-DD HH:MM:SS.ffffff".
+   * @return false if str is not a valid timestamp
+   */
+  static bool Parse(const char *str, int64_t *micros);
+
+  /**
+   * @return the timestamp as "YYYY-MM-DD HH:MM:SS", followed by the microseconds if there are any
+   */
+  static std::string Format(int64_t micros);
+};
+
 #endif  // MINISQL_TYPES_H
@@ -0,0 +1,171 @@
+#ifndef MINISQL_CLUSTERED_TABLE_HEAP_H
+#define MINISQL_CLUSTERED_TABLE_HEAP_H
+
+#include <vector>
+
+#include "index/generic_key.h"
+#include "page/b_plus_tree_internal_page.h"
+#include "page/clustered_leaf_page.h"
+#include "storage/table_heap.h"
+
+/**
+ * Index-organized table, the rows are stored in the leaves of a B+ tree on the primary key, so a
+ * point lookup or a key range scan is a single descent followed by a walk along the leaves, and a
+ * full scan returns the rows in key order.
+ *
+ * The root of the tree never moves, it is the first page of the table: when the root is split its
+ * content is pushed down into a new child first. Leaves are never merged, empty leaves are kept.
+ *
+ * A row id is (leaf page id, slot number). Unlike the other layouts it is only stable while the
+ * leaf is not modified: inserting, removing or moving rows to a new leaf shifts the slots.
+ */
+class ClusteredTableHeap : public TableHeap {
+ public:
+  static ClusteredTableHeap *Create(BufferPoolManager *buffer_pool_manager, Schema *schema,
+                                    const std::vector<uint32_t> &key_columns, Txn *txn, LogManager *log_manager,
+                                    LockManager *lock_manager) {
+    return new ClusteredTableHeap(buffer_pool_manager, schema, key_columns, txn, log_manager, lock_manager);
+  }
+
+  static ClusteredTableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
+                                    const std::vector<uint32_t> &key_columns, LogManager *log_manager,
+                                    LockManager *lock_manager, KeyEncoding key_encoding = KeyEncoding::kNormalized) {
+    return new ClusteredTableHeap(buffer_pool_manager, first_page_id, schema, key_columns, log_manager, lock_manager,
+                                  key_encoding);
+  }
+
+  ~ClusteredTableHeap() override { delete key_schema_; }
+
+  TableLayout GetLayout() const override { return TableLayout::kClustered; }
+
+  /**
+   * Insert a tuple at the position of its key, return false if the key is already in the table.
+   * A deleted tuple with the same key that is not applied yet is replaced.
+   */
+  bool InsertTuple(Row &row, Txn *txn) override;
+
+  bool MarkDelete(const RowId &rid, Txn *txn) override;
+
+  /**
+   * The update happens in place if the key is not changed and the leaf has enough space, otherwise
+   * the tuple is moved. Return false if the new key is already taken by another tuple.
+   */
+  bool UpdateTuple(Row &row, const RowId &rid, Txn *txn) override;
+
+  /**
+   * Remove the tuple from its leaf, the tuples after it in the same leaf get new row ids.
+   */
+  void ApplyDelete(const RowId &rid, Txn *txn) override;
+
+  void RollbackDelete(const RowId &rid, Txn *txn) override;
+
+  bool GetTuple(Row *row, Txn *txn, const std::vector<bool> *referenced = nullptr) override;
+
+  /**
+   * Remove the tuples marked as deleted from every leaf, the remaining tuples of a leaf are compacted.
+   */
+  uint32_t Vacuum(Txn *txn, std::vector<std::pair<RowId, RowId>> *moved_rows = nullptr) override;
+
+  void FreeTableHeap() override;
+
+  void DeleteTable(page_id_t page_id = INVALID_PAGE_ID) override;
+
+  /**
+   * Read the live tuples of one leaf, in key order.
+   */
+  bool GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *txn) override;
+
+  /**
+   * @param[out] page_ids ids of the leaves, in key order; the internal pages hold no tuples
+   */
+  void GetPageIds(std::vector<page_id_t> *page_ids) override;
+
+  /**
+   * Find the first live tuple whose key is not less than key_row.
+   * @param[in] key_row values of the key columns
+   * @param[out] rid row id of the tuple
+   * @return false if every key of the table is less than key_row
+   */
+  bool LowerBound(const Row &key_row, RowId *rid);
+
+  /**
+   * Find the live tuple with the key of row.
+   * @param[in] row tuple of the table, only its key columns are used
+   * @param[out] rid current row id of the tuple
+   * @return false if there is no such tuple
+   */
+  bool FindTuple(const Row &row, RowId *rid);
+
+  /**
+   * @return indexes of the key columns in the table schema
+   */
+  inline const std::vector<uint32_t> &GetKeyColumns() const { return key_columns_; }
+
+  inline KeyEncoding GetKeyEncoding() const { return processor_.GetEncoding(); }
+
+  /**
+   * @return size of the key of the schema, 0 if the key columns are too large to be a key
+   */
+  static uint32_t ComputeKeySize(const Schema *schema, const std::vector<uint32_t> &key_columns,
+                                 KeyEncoding key_encoding = KeyEncoding::kNormalized);
+
+ protected:
+  bool GetFirstTupleRid(page_id_t page_id, RowId *first_rid) override;
+
+  bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) override;
+
+ private:
+  explicit ClusteredTableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema,
+                              const std::vector<uint32_t> &key_columns, Txn *txn, LogManager *log_manager,
+                              LockManager *lock_manager);
+
+  explicit ClusteredTableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
+                              const std::vector<uint32_t> &key_columns, LogManager *log_manager,
+                              LockManager *lock_manager, KeyEncoding key_encoding);
+
+  void SerializeKey(const Row &row, GenericKey *key);
+
+  /**
+   * Descend from the root to the leaf which may contain key, the leftmost leaf if key is nullptr.
+   * @return the leaf, pinned
+   */
+  ClusteredLeafPage *FindLeaf(const GenericKey *key);
+
+  /**
+   * Insert a tuple in its stored form, the key must not be taken by a live tuple.
+   */
+  bool InsertStoredTuple(const GenericKey *key, Row &row);
+
+  /**
+   * Insert into the pinned leaf at index, splitting it until the tuple fits. The leaf is unpinned.
+   */
+  void InsertIntoLeaf(ClusteredLeafPage *leaf, int index, const GenericKey *key, Row &row);
+
+  void InsertIntoParent(page_id_t left_page_id, GenericKey *key, page_id_t right_page_id, page_id_t parent_page_id);
+
+  /**
+   * Move the content of the pinned root into a new child, the root becomes an internal page with
+   * this child only.
+   * @return the new child, pinned; the root is unpinned
+   */
+  BPlusTreePage *PushDownRoot(BPlusTreePage *root);
+
+  /**
+   * @return true if a live tuple has the key
+   */
+  bool ContainsKey(const GenericKey *key);
+
+  void FreeLeafOverflow(ClusteredLeafPage *leaf, int index);
+
+  void DeleteSubtree(page_id_t page_id);
+
+ private:
+  std::vector<uint32_t> key_columns_;
+  Schema *key_schema_;
+  int key_size_;
+  KeyManager processor_;
+  int internal_max_size_;
+  uint32_t max_row_size_;
+};
+
+#endif  // MINISQL_CLUSTERED_TABLE_HEAP_H
@@ -0,0 +1,100 @@
+#ifndef MINISQL_PAX_TABLE_HEAP_H
+#define MINISQL_PAX_TABLE_HEAP_H
+
+#include <vector>
+
+#include "page/pax_page.h"
+#include "storage/table_heap.h"
+
+/**
+ * Values of some columns of the live tuples in one pax page, every column is decoded into its own
+ * contiguous array, columns_[i][j] belongs to the tuple rids_[j].
+ */
+struct ColumnBatch {
+  std::vector<RowId> rids_;
+  std::vector<std::vector<Field>> columns_;
+};
+
+/**
+ * Table heap made of PaxPages. Tuples never move once inserted, so the pages are not compacted or
+ * merged, vacuum only releases deleted slots and empty pages.
+ */
+class PaxTableHeap : public TableHeap {
+ public:
+  static PaxTableHeap *Create(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn,
+                              LogManager *log_manager, LockManager *lock_manager) {
+    return new PaxTableHeap(buffer_pool_manager, schema, txn, log_manager, lock_manager);
+  }
+
+  static PaxTableHeap *Create(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
+                              LogManager *log_manager, LockManager *lock_manager) {
+    return new PaxTableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
+  }
+
+  TableLayout GetLayout() const override { return TableLayout::kPax; }
+
+  /**
+   * Insert a tuple into the table, return false if a char value is longer than its column allows.
+   */
+  bool InsertTuple(Row &row, Txn *txn) override;
+
+  bool MarkDelete(const RowId &rid, Txn *txn) override;
+
+  /**
+   * Tuples are fixed width, the update always happens in place.
+   */
+  bool UpdateTuple(Row &row, const RowId &rid, Txn *txn) override;
+
+  void ApplyDelete(const RowId &rid, Txn *txn) override;
+
+  void RollbackDelete(const RowId &rid, Txn *txn) override;
+
+  bool GetTuple(Row *row, Txn *txn, const std::vector<bool> *referenced = nullptr) override;
+
+  /**
+   * Release the slots of deleted tuples and the pages left empty, no tuple is moved.
+   */
+  uint32_t Vacuum(Txn *txn, std::vector<std::pair<RowId, RowId>> *moved_rows = nullptr) override;
+
+  void FreeTableHeap() override;
+
+  void DeleteTable(page_id_t page_id = INVALID_PAGE_ID) override;
+
+  bool GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *txn) override;
+
+  void GetPageIds(std::vector<page_id_t> *page_ids) override;
+
+  /**
+   * Decode the given columns of the live tuples in one page, the other minipages are not read.
+   * @param[in] page_id page to scan
+   * @param[in] column_ids indexes of the columns to decode, in table schema
+   * @param[out] batch decoded values, cleared first
+   * @param[out] next_page_id the page following page_id
+   * @return false if the page could not be fetched
+   */
+  bool ScanColumns(page_id_t page_id, const std::vector<uint32_t> &column_ids, ColumnBatch *batch,
+                   page_id_t *next_page_id);
+
+ protected:
+  bool GetFirstTupleRid(page_id_t page_id, RowId *first_rid) override;
+
+  bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) override;
+
+ private:
+  explicit PaxTableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn, LogManager *log_manager,
+                        LockManager *lock_manager);
+
+  explicit PaxTableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
+                        LogManager *log_manager, LockManager *lock_manager);
+
+  /**
+   * Unlink an empty page from the page chain and release it, the first page is always kept.
+   */
+  void ReleasePage(PaxPage *page);
+
+ private:
+  // new pages are linked after the last page
+  page_id_t last_page_id_{INVALID_PAGE_ID};
+};
+
+#endif  // MINISQL_PAX_TABLE_HEAP_H
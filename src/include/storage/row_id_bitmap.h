@@ -0,0 +1,50 @@
+#ifndef MINISQL_ROW_ID_BITMAP_H
+#define MINISQL_ROW_ID_BITMAP_H
+
+#include <map>
+#include <vector>
+
+#include "common/rowid.h"
+
+/**
+ * Set of row ids kept as a bitmap of slots per page, so the rows an index scan finds are fetched in page
+ * order and every page is pinned once. The pages are ordered by id, the slots of a page by number.
+ */
+class RowIdBitmap {
+ public:
+  void Add(const RowId &rid);
+
+  bool Contains(const RowId &rid) const;
+
+  /**
+   * Keep only the row ids that other holds as well.
+   */
+  void Intersect(const RowIdBitmap &other);
+
+  /**
+   * Add the row ids of other.
+   */
+  void Union(const RowIdBitmap &other);
+
+  inline bool IsEmpty() const { return pages_.empty(); }
+
+  /**
+   * @return number of row ids in the set
+   */
+  size_t GetSize() const;
+
+  /**
+   * Take the row ids of the page with the smallest id out of the set.
+   * @param[out] slots slot numbers of the row ids in the page, ascending
+   * @return false if the set is empty
+   */
+  bool PopPage(page_id_t *page_id, std::vector<uint32_t> *slots);
+
+ private:
+  static constexpr uint32_t WORD_BITS = 64;
+
+  // bit s of word s / 64 is set if slot s of the page is in the set, no page has all words zero
+  std::map<page_id_t, std::vector<uint64_t>> pages_;
+};
+
+#endif  // MINISQL_ROW_ID_BITMAP_H
@@ -1,12 +1,26 @@
 #ifndef MINISQL_TABLE_HEAP_H
 #define MINISQL_TABLE_HEAP_H
 
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 #include "buffer/buffer_pool_manager.h"
 #include "concurrency/lock_manager.h"
 #include "page/header_page.h"
+#include "page/overflow_page.h"
 #include "page/table_page.h"
+#include "record/tuple_view.h"
 #include "recovery/log_manager.h"
 #include "storage/table_iterator.h"
+#include "storage/zone_map.h"
+
+/**
+ * Page format of a table, chosen at CREATE TABLE.
+ * kRow: slotted TablePage, kPax: column minipages in PaxPage, see PaxTableHeap
+ * kClustered: rows stored in the leaves of a B+ tree on the primary key, see ClusteredTableHeap
+ */
+enum class TableLayout : uint32_t { kRow = 0, kPax, kClustered };
 
 class TableHeap {
   friend class TableIterator;
@@ -22,15 +36,18 @@ class TableHeap {
     return new TableHeap(buffer_pool_manager, first_page_id, schema, log_manager, lock_manager);
   }
 
-  ~TableHeap() {}
+  virtual ~TableHeap() {}
+
+  virtual TableLayout GetLayout() const { return TableLayout::kRow; }
 
   /**
-   * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
+   * Insert a tuple into the table. Long varchar values are moved to overflow pages, if the tuple is still
+   * too large (>= page_size), return false.
    * @param[in/out] row Tuple Row to insert, the rid of the inserted tuple is wrapped in object row
    * @param[in] txn The recovery performing the insert
    * @return true iff the insert is successful
    */
-  bool InsertTuple(Row &row, Txn *txn);
+  virtual bool InsertTuple(Row &row, Txn *txn);
 
   /**
    * Mark the tuple as deleted. The actual delete will occur when ApplyDelete is called.
@@ -38,45 +55,67 @@ class TableHeap {
    * @param[in] txn Txn performing the delete
    * @return true iff the delete is successful (i.e the tuple exists)
    */
-  bool MarkDelete(const RowId &rid, Txn *txn);
+  virtual bool MarkDelete(const RowId &rid, Txn *txn);
 
   /**
-   * if the new tuple is too large to fit in the old page, return false (will delete and insert)
+   * Update the tuple in place. If the new tuple is too large to fit in its page, it is stored in
+   * another page and the slot at rid forwards to it, so rid stays the row id of the tuple.
    * @param[in] row Tuple of new row
    * @param[in] rid Rid of the old tuple
    * @param[in] txn Txn performing the update
    * @return true is update is successful.
    */
-  bool UpdateTuple(Row &row, const RowId &rid, Txn *txn);
+  virtual bool UpdateTuple(Row &row, const RowId &rid, Txn *txn);
 
   /**
    * Called on Commit/Abort to actually delete a tuple or rollback an insert.
    * @param rid Rid of the tuple to delete
    * @param txn Txn performing the delete.
    */
-  void ApplyDelete(const RowId &rid, Txn *txn);
+  virtual void ApplyDelete(const RowId &rid, Txn *txn);
 
   /**
    * Called on abort to rollback a delete.
    * @param[in] rid Rid of the deleted tuple.
    * @param[in] txn Txn performing the rollback
    */
-  void RollbackDelete(const RowId &rid, Txn *txn);
+  virtual void RollbackDelete(const RowId &rid, Txn *txn);
 
   /**
    * Read a tuple from the table.
    * @param[in/out] row Output variable for the tuple, row id of the tuple is wrapped in row
    * @param[in] txn recovery performing the read
+   * @param[in] referenced flag per column, only the values of the referenced columns are read from overflow
+   * pages, the others are left external; nullptr reads all of them
    * @return true if the read was successful (i.e. the tuple exists)
    */
-  bool GetTuple(Row *row, Txn *txn);
+  virtual bool GetTuple(Row *row, Txn *txn, const std::vector<bool> *referenced = nullptr);
+
+  /**
+   * Reclaim the space of deleted tuples. Every page is compacted in place, then a page whose live
+   * tuples fit into the free space of its previous page is merged into it and released.
+   * @param[in] txn Txn performing the vacuum
+   * @param[out] moved_rows (old rid, new rid) of every tuple moved to another page, can be nullptr
+   * @return number of bytes given back to the free space of the remaining pages
+   */
+  virtual uint32_t Vacuum(Txn *txn, std::vector<std::pair<RowId, RowId>> *moved_rows = nullptr);
 
-  void FreeTableHeap() {
+  /**
+   * Rewrite the tuples of the table from the v1 into the v2 tuple format, page by page. A tuple never
+   * grows, so it stays in its slot and all RowIds stay valid. Only for the row layout.
+   * @return number of bytes given back to the free space of the pages
+   */
+  uint32_t UpgradeTupleFormat(Txn *txn);
+
+  virtual void FreeTableHeap() {
     auto next_page_id = first_page_id_;
     while (next_page_id != INVALID_PAGE_ID) {
       auto old_page_id = next_page_id;
       auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(old_page_id));
       assert(page != nullptr);
+      for (uint32_t i = 0; i < page->GetTupleCount(); i++) {
+        FreeOverflow(page, i);
+      }
       next_page_id = page->GetNextPageId();
       buffer_pool_manager_->UnpinPage(old_page_id, false);
       buffer_pool_manager_->DeletePage(old_page_id);
@@ -86,12 +125,74 @@ class TableHeap {
   /**
    * Free table heap and release storage in disk file
    */
-  void DeleteTable(page_id_t page_id = INVALID_PAGE_ID);
+  virtual void DeleteTable(page_id_t page_id = INVALID_PAGE_ID);
+
+  /**
+   * Read all the tuples of one page at once, a forwarded tuple is read from where it is stored.
+   * The tuples moved into this page by a forward are skipped, they belong to their forwarding slot.
+   * @param[in] page_id page of this table, one of GetPageIds
+   * @param[out] rows tuples of the page in slot order, with their row ids
+   * @return false if the page could not be fetched
+   */
+  virtual bool GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *txn);
+
+  /**
+   * Ids of freed pages are reused, so the order of the page chain is not the order of the page ids.
+   * @param[out] page_ids ids of the pages holding the tuples of this table, in the order of the page chain
+   */
+  virtual void GetPageIds(std::vector<page_id_t> *page_ids);
+
+  /**
+   * Called with a view of every visited tuple.
+   * @return false to visit the tuple again through a view of a copy, e.g. if a value is stored in overflow pages
+   */
+  using TupleVisitor = std::function<bool(const TupleView &)>;
+
+  /**
+   * Visit the tuples of one page in slot order without copying them out of the page, the visitor runs
+   * while the page is latched and must not keep the view. A forwarded tuple and a tuple turned down by
+   * the visitor are read with GetTuple and visited through a view of a copy.
+   * Only for the row layout.
+   * @param[out] next_page_id page following this one, if not nullptr
+   * @param[in] referenced columns whose overflow values a copy needs, see GetTuple
+   * @return false if the page could not be fetched
+   */
+  bool VisitPage(page_id_t page_id, const TupleVisitor &visit, Txn *txn, page_id_t *next_page_id = nullptr,
+                 const std::vector<bool> *referenced = nullptr);
+
+  /**
+   * Visit the tuple at rid the way VisitPage does, the tuples of the other layouts are always copied.
+   * @return false if there is no tuple at rid
+   */
+  bool VisitTuple(const RowId &rid, const TupleVisitor &visit, Txn *txn,
+                  const std::vector<bool> *referenced = nullptr);
+
+  /**
+   * Visit the tuples at some slots of one page the way VisitPage does, with the page pinned and latched
+   * once for all of them. A slot without a tuple is skipped, the tuples of the other layouts are copied.
+   * @param slots slot numbers in ascending order
+   * @return false if the page could not be fetched
+   */
+  bool VisitSlots(page_id_t page_id, const std::vector<uint32_t> &slots, const TupleVisitor &visit, Txn *txn,
+                  const std::vector<bool> *referenced = nullptr);
+
+  /**
+   * Check the predicates against the zone map of a page, the zone map is built in one pass over the
+   * tuples of the page if the page was not written since the table was opened or vacuumed.
+   * Only for the row layout.
+   * @return false if no tuple of the page can satisfy all the predicates
+   */
+  bool PageMayMatch(page_id_t page_id, const std::vector<ZonePredicate> &predicates, Txn *txn);
+
+  /**
+   * @return the page following page_id in the page chain, INVALID_PAGE_ID for the last page
+   */
+  page_id_t GetNextPageId(page_id_t page_id);
 
   /**
    * @return the begin iterator of this table
    */
-  TableIterator Begin(Txn *txn);
+  TableIterator Begin(Txn *txn, const std::vector<bool> *referenced = nullptr);
 
   /**
    * @return the end iterator of this table
@@ -103,7 +204,102 @@ class TableHeap {
    */
   inline page_id_t GetFirstPageId() const { return first_page_id_; }
 
+  /**
+   * @return the number of pages in this table
+   */
+  inline size_t GetPageCount() const { return page_free_space_.size(); }
+
+  /**
+   * @return number of tuples inserted since the modify counters were last reset
+   */
+  inline uint64_t GetInsertedTuples() const { return inserted_tuples_; }
+
+  /**
+   * @return number of tuples marked as deleted, minus the rolled back ones, since the modify counters were last reset
+   */
+  inline uint64_t GetDeletedTuples() const { return deleted_tuples_; }
+
+  /**
+   * Called once the modifications are accounted for in the statistics of the table.
+   */
+  inline void ResetModifyCounters() {
+    inserted_tuples_ = 0;
+    deleted_tuples_ = 0;
+  }
+
+ protected:
+  /**
+   * Find the first tuple in the page chain starting from page_id.
+   * @return false if there is no tuple left
+   */
+  virtual bool GetFirstTupleRid(page_id_t page_id, RowId *first_rid);
+
+  /**
+   * Find the tuple following cur_rid, moving on to the next pages if needed.
+   * @return false if cur_rid is the last tuple of the table
+   */
+  virtual bool GetNextTupleRid(const RowId &cur_rid, RowId *next_rid);
+
+  /**
+   * Used by table heaps with another page format, the pages are set up by the derived class.
+   */
+  explicit TableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, LogManager *log_manager,
+                     LockManager *lock_manager)
+      : buffer_pool_manager_(buffer_pool_manager),
+        first_page_id_(INVALID_PAGE_ID),
+        schema_(schema),
+        log_manager_(log_manager),
+        lock_manager_(lock_manager) {}
+
+  /**
+   * Build the stored form of a row. Varchar values longer than VARCHAR_INLINE_MAX_LEN are written to
+   * overflow pages, so are the longest remaining ones while the row is larger than max_row_size.
+   * @param[out] stored stored form of row, left empty if no value is moved out
+   * @return DB_FAILED if a value is null although the tuples of the table have no null bitmap
+   */
+  dberr_t StoreOverflow(const Row &row, Row &stored, uint32_t max_row_size = TablePage::SIZE_MAX_ROW);
+
+  /**
+   * Replace the external fields of a stored row with the values read from the overflow pages.
+   * @param referenced flag per column, the external fields of the other columns are kept; nullptr loads all
+   */
+  void LoadOverflow(Row &row, const std::vector<bool> *referenced = nullptr);
+
+  void FreeOverflow(const Row &row);
+
  private:
+  /**
+   * Insert a tuple in its stored form, i.e. with long varchar values already moved to overflow pages.
+   * @param[in] moved true if the tuple is the target of a forwarding slot, it is skipped by the iterator
+   */
+  bool InsertStoredTuple(Row &row, Txn *txn, bool moved = false);
+
+  /**
+   * @param[out] target location of the tuple if the slot at rid is a forwarding slot
+   * @return false if the slot holds the tuple itself
+   */
+  bool GetForward(const RowId &rid, RowId *target);
+
+  /**
+   * Release the overflow pages referenced by the tuple at slot_num, the tuple may be marked as deleted.
+   */
+  void FreeOverflow(TablePage *page, uint32_t slot_num);
+
+  page_id_t WriteOverflowChain(const char *data, uint32_t len);
+
+  /**
+   * Read the tuple at rid with GetTuple and visit a view of its serialized copy.
+   * @return false if there is no tuple at rid
+   */
+  bool VisitCopy(const RowId &rid, const TupleVisitor &visit, Txn *txn, const std::vector<bool> *referenced);
+
+  /**
+   * Widen the zone map of a page with a tuple stored in it, if the page has a zone map.
+   */
+  void UpdateZoneMap(page_id_t page_id, const Row &row);
+
+  void FreeOverflowChain(page_id_t page_id);
+
   /**
    * create table heap and initialize first page
    */
@@ -116,6 +312,7 @@ class TableHeap {
     auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(first_page_id_));
     page->Init(first_page_id_, INVALID_PAGE_ID, log_manager_, txn);
     page_free_space_[first_page_id_] = page->GetFreeSpaceRemaining();
+    zone_maps_[first_page_id_] = ZoneMap(schema_);
     buffer_pool_manager_->UnpinPage(first_page_id_, true);
   };
 
@@ -136,12 +333,13 @@ class TableHeap {
       page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
       assert(page != nullptr);
       page_free_space_[next_page_id] = page->GetFreeSpaceRemaining();
+      auto page_id = next_page_id;
       next_page_id = page->GetNextPageId();
-      buffer_pool_manager_->UnpinPage(next_page_id, false);
+      buffer_pool_manager_->UnpinPage(page_id, false);
     }
   }
 
- private:
+ protected:
   BufferPoolManager *buffer_pool_manager_;
   page_id_t first_page_id_;
   Schema *schema_;
@@ -149,6 +347,16 @@ class TableHeap {
   [[maybe_unused]] LockManager *lock_manager_;
   // used to find the page to insert tuple
   std::map<page_id_t, uint32_t> page_free_space_;
+  // modifications not accounted for in the statistics of the table yet
+  uint64_t inserted_tuples_{0};
+  uint64_t deleted_tuples_{0};
+
+ private:
+  // first overflow page id and value length
+  static constexpr uint32_t OVERFLOW_POINTER_SIZE = sizeof(page_id_t) + sizeof(uint32_t);
+  // min/max of the numeric columns per page, a page without an entry has not been summarized yet
+  std::unordered_map<page_id_t, ZoneMap> zone_maps_;
+  std::mutex zone_map_latch_;
 };
 
 #endif  // MINISQL_TABLE_HEAP_H
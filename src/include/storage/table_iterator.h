@@ -1,6 +1,8 @@
 #ifndef MINISQL_TABLE_ITERATOR_H
 #define MINISQL_TABLE_ITERATOR_H
 
+#include <vector>
+
 #include "common/rowid.h"
 #include "concurrency/txn.h"
 #include "record/row.h"
@@ -10,7 +12,8 @@ class TableHeap;
 class TableIterator {
 public:
  // you may define your own constructor based on your member variables
- TableIterator(TableHeap *table_heap, RowId rid, Txn *txn);
+ // only the overflow values of the referenced columns are read, see TableHeap::GetTuple
+ TableIterator(TableHeap *table_heap, RowId rid, Txn *txn, const std::vector<bool> *referenced = nullptr);
 
  TableIterator(const TableIterator &other);
 
@@ -20,7 +23,7 @@ public:
 
   bool operator!=(const TableIterator &itr) const;
 
-  const Row operator*();
+  Row operator*();
 
   Row *operator->();
 
@@ -30,10 +33,14 @@ public:
 
   TableIterator operator++(int);
 
+  /** @return row id of the current tuple, without reading it */
+  inline const RowId &GetRowId() const { return rid_; }
+
 private:
   TableHeap *table_heap_;
   RowId rid_;
   Txn *txn_;
+  const std::vector<bool> *referenced_;
 };
 
 #endif  // MINISQL_TABLE_ITERATOR_H
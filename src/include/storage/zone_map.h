@@ -0,0 +1,91 @@
+#ifndef MINISQL_ZONE_MAP_H
+#define MINISQL_ZONE_MAP_H
+
+#include <string>
+#include <vector>
+
+#include "record/row.h"
+#include "record/schema.h"
+#include "record/tuple_view.h"
+
+/**
+ * A comparison of a column with a constant, "column comparison value".
+ */
+struct ZonePredicate {
+  uint32_t column_;
+  std::string comparison_;
+  // owned by the plan the predicate comes from
+  const Field *value_;
+};
+
+/**
+ * Smallest and largest values of the fixed-width columns over the tuples of one page, null values
+ * are not counted. The range is only ever widened, so it stays valid when tuples are deleted.
+ */
+class ZoneMap {
+ public:
+  ZoneMap() = default;
+
+  explicit ZoneMap(const Schema *schema);
+
+  /**
+   * Widen the ranges with the values of a tuple added to the page.
+   */
+  void Update(const Row &row);
+
+  /**
+   * Widen the ranges with the values of a serialized tuple of the page, only the tracked columns are decoded.
+   */
+  void Update(const TupleView &tuple);
+
+  /**
+   * A partial zone map does not cover all tuples of its page yet and matches every predicate.
+   */
+  inline void SetPartial(bool partial) { partial_ = partial; }
+
+  /**
+   * @return false if no tuple of the page can satisfy the predicate
+   */
+  bool MayMatch(const ZonePredicate &predicate) const;
+
+  /**
+   * @return true for the comparisons a zone map can decide: =, <>, <, <=, >, >=
+   */
+  static bool IsRangeComparison(const std::string &comparison);
+
+ private:
+  // int, bigint and timestamp values are kept as integer_, float and double values as real_
+  union Bound {
+    int64_t integer_;
+    double real_;
+  };
+
+  struct ColumnRange {
+    TypeId type_{TypeId::kTypeInvalid};
+    bool tracked_{false};
+    // false while the column has no non-null value in the page
+    bool has_values_{false};
+    Bound min_{};
+    Bound max_{};
+  };
+
+  /**
+   * Widen a range with a non-null value of its column.
+   */
+  static void Widen(ColumnRange *range, const Field &field);
+
+  /**
+   * Three-way comparison of two bounds of the type of a range.
+   */
+  static int Compare(const ColumnRange &range, const Bound &lhs, const Bound &rhs);
+
+  /**
+   * @return the value of a non-null field of a tracked type
+   */
+  static Bound ToBound(const Field &field);
+
+  std::vector<ColumnRange> columns_;
+  bool partial_{false};
+};
+
+#endif  // MINISQL_ZONE_MAP_H
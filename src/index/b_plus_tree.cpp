@@ -1,6 +1,8 @@
 #include "index/b_plus_tree.h"
 
+#include <algorithm>
 #include <string>
+#include <thread>
 
 #include "glog/logging.h"
 #include "index/basic_comparator.h"
@@ -8,14 +10,17 @@
 #include "page/index_roots_page.h"
 
 BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager, const KeyManager &KM,
-                     int leaf_max_size, int internal_max_size)
+                     int leaf_max_size, int internal_max_size, IndexPageLayout layout, bool linked)
     : index_id_(index_id),
       buffer_pool_manager_(buffer_pool_manager),
       processor_(KM),
       leaf_max_size_(leaf_max_size),
-      internal_max_size_(internal_max_size) {
-  auto header_page =
-      reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+      internal_max_size_(internal_max_size),
+      layout_(layout),
+      linked_(linked) {
+  auto page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  page->WLatch();
+  auto header_page = reinterpret_cast<IndexRootsPage *>(page->GetData());
   page_id_t root_page_id;
   // check if the index already exists
   if (header_page->GetRootId(index_id, &root_page_id)) {
@@ -24,13 +29,17 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
     root_page_id_ = INVALID_PAGE_ID;
     header_page->Insert(index_id, root_page_id_);
   }
+  page->WUnlatch();
   buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
+  if (root_page_id_ != INVALID_PAGE_ID) {
+    linked_ = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(root_page_id_)->GetData())->IsLinked();
+    buffer_pool_manager_->UnpinPage(root_page_id_, false);
+  }
   //DLOG(INFO) << "BPlusTree Init, root page id: " << root_page_id_;
   // calculate node size
   if (leaf_max_size_ == UNDEFINED_SIZE || internal_max_size_ == UNDEFINED_SIZE) {
-    leaf_max_size_ = (PAGE_SIZE - BPlusTreeLeafPage::LEAF_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(RowId));
-    internal_max_size_ =
-        (PAGE_SIZE - BPlusTreeInternalPage::INTERNAL_PAGE_HEADER_SIZE) / (processor_.GetKeySize() + sizeof(page_id_t));
+    leaf_max_size_ = BPlusTreeLeafPage::Capacity(processor_.GetKeySize(), linked_);
+    internal_max_size_ = BPlusTreeInternalPage::Capacity(processor_.GetKeySize(), linked_);
     int min_size = std::min(leaf_max_size_, internal_max_size_);
     leaf_max_size_ = internal_max_size_ = min_size;
   }
@@ -38,17 +47,41 @@ BPlusTree::BPlusTree(index_id_t index_id, BufferPoolManager *buffer_pool_manager
 }
 
 void BPlusTree::Destroy(page_id_t current_page_id) {
+  if (linked_) {
+    // a page whose split is not complete is only reachable by its right link, every level is walked along them
+    auto first_page_id = root_page_id_;
+    while (first_page_id != INVALID_PAGE_ID) {
+      auto node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(first_page_id)->GetData());
+      auto next_first_page_id =
+          node->IsLeafPage() ? INVALID_PAGE_ID : reinterpret_cast<InternalPage *>(node)->ValueAt(0);
+      buffer_pool_manager_->UnpinPage(first_page_id, false);
+      for (auto page_id = first_page_id; page_id != INVALID_PAGE_ID;) {
+        auto right_page_id =
+            RightPageId(reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData()));
+        buffer_pool_manager_->UnpinPage(page_id, false);
+        buffer_pool_manager_->DeletePage(page_id);
+        page_id = right_page_id;
+      }
+      first_page_id = next_first_page_id;
+    }
+    return;
+  }
   if (current_page_id == INVALID_PAGE_ID) {
     current_page_id = root_page_id_;
   }
+  if (current_page_id == INVALID_PAGE_ID) {
+    return;
+  }
   BPlusTreePage *node = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(current_page_id)->GetData());
   if (node->IsLeafPage()) {
+    buffer_pool_manager_->UnpinPage(current_page_id, false);
     buffer_pool_manager_->DeletePage(current_page_id);
   } else {
     auto *internal_node = reinterpret_cast<InternalPage *>(node);
     for (int i = 0; i < internal_node->GetSize(); i++) {
       Destroy(internal_node->ValueAt(i));
     }
+    buffer_pool_manager_->UnpinPage(current_page_id, false);
     buffer_pool_manager_->DeletePage(current_page_id);
   }
 }
@@ -56,7 +89,12 @@ void BPlusTree::Destroy(page_id_t current_page_id) {
 /*
  * Helper function to decide whether current b+tree is empty
  */
-bool BPlusTree::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
+bool BPlusTree::IsEmpty() const {
+  root_latch_.RLock();
+  auto empty = root_page_id_ == INVALID_PAGE_ID;
+  root_latch_.RUnlock();
+  return empty;
+}
 
 /*****************************************************************************
  * SEARCH
@@ -67,17 +105,18 @@ bool BPlusTree::IsEmpty() const { return root_page_id_ == INVALID_PAGE_ID; }
  * @return : true means key exists
  */
 bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn *transaction) {
-  if(root_page_id_==INVALID_PAGE_ID)return false;
-  BPlusTreeLeafPage *leaf = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(key, root_page_id_, false));
-  if (leaf == nullptr) {
+  auto page = FindLeafPage(key);
+  if (page == nullptr) {
     return false;
   }
+  auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
   RowId value;
   auto res = leaf->Lookup(key, value, processor_);
   if (res) {
     result.push_back(value);
   }
-  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+  page->RUnlatch();
   return res;
 }
 
@@ -92,11 +131,19 @@ bool BPlusTree::GetValue(const GenericKey *key, std::vector<RowId> &result, Txn
  * keys return false, otherwise return true.
  */
 bool BPlusTree::Insert(GenericKey *key, const RowId &value, Txn *transaction) {
-  if (IsEmpty()) {
+  if (linked_) {
+    return LinkedInsert(key, value, transaction);
+  }
+  WriteSet write_set;
+  auto leaf = FindLeafPageForWrite(key, Operation::kInsert, &write_set);
+  bool inserted = true;
+  if (leaf == nullptr) {
     StartNewTree(key, value);
-    return true;
+  } else {
+    inserted = InsertIntoLeaf(leaf, key, value, transaction);
   }
-  return InsertIntoLeaf(key, value, transaction);
+  ReleaseWriteSet(&write_set);
+  return inserted;
 }
 /*
  * Insert constant key & value pair into an empty tree
@@ -111,7 +158,7 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
     DLOG(ERROR) << "out of memory";
     throw "out of memory";
   }
-  leaf->Init(page_id, INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_);
+  leaf->Init(page_id, INVALID_PAGE_ID, processor_.GetKeySize(), leaf_max_size_, layout_, linked_);
   leaf->Insert(key, value, processor_);
   root_page_id_ = page_id;
   UpdateRootPageId();
@@ -126,21 +173,17 @@ void BPlusTree::StartNewTree(GenericKey *key, const RowId &value) {
  * @return: since we only support unique key, if user try to insert duplicate
  * keys return false, otherwise return true.
  */
-bool BPlusTree::InsertIntoLeaf(GenericKey *key, const RowId &value, Txn *transaction) {
-  auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(key, root_page_id_, false));
+bool BPlusTree::InsertIntoLeaf(LeafPage *leaf, GenericKey *key, const RowId &value, Txn *transaction) {
   RowId fakeValue;
   if (leaf->Lookup(key, fakeValue, processor_)) {
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
     return false;
   }
   leaf->Insert(key, value, processor_);
   if (leaf->GetSize() < leaf->GetMaxSize()) {
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
     return true;
   }
   auto new_leaf = Split(leaf, transaction);
   InsertIntoParent(leaf, new_leaf->KeyAt(0), new_leaf, transaction);
-  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
   buffer_pool_manager_->UnpinPage(new_leaf->GetPageId(), true);
   return true;
 }
@@ -160,8 +203,19 @@ BPlusTreeInternalPage *BPlusTree::Split(InternalPage *node, Txn *transaction) {
     DLOG(ERROR) << "out of memory";
     throw "out of memory";
   }
-  new_internal->Init(page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_);
-  node->MoveHalfTo(new_internal, buffer_pool_manager_);
+  new_internal->Init(page_id, node->GetParentPageId(), processor_.GetKeySize(), internal_max_size_, layout_,
+                     linked_);
+  node->MoveHalfTo(new_internal, linked_ ? nullptr : buffer_pool_manager_);
+  if (linked_) {
+    // the new page takes over the upper part of the key range of node
+    new_internal->SetLevel(node->GetLevel());
+    if (node->GetRightPageId() != INVALID_PAGE_ID) {
+      new_internal->SetHighKey(node->HighKey());
+    }
+    new_internal->SetRightPageId(node->GetRightPageId());
+    node->SetHighKey(new_internal->KeyAt(0));
+    node->SetRightPageId(page_id);
+  }
   return new_internal;
 }
 
@@ -173,8 +227,14 @@ BPlusTreeLeafPage *BPlusTree::Split(LeafPage *node, Txn *transaction) {
     DLOG(ERROR) << "out of memory";
     throw "out of memory";
   }
-  new_leaf->Init(page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_);
+  new_leaf->Init(page_id, node->GetParentPageId(), processor_.GetKeySize(), leaf_max_size_, layout_, linked_);
   node->MoveHalfTo(new_leaf);
+  if (linked_) {
+    if (node->GetNextPageId() != INVALID_PAGE_ID) {
+      new_leaf->SetHighKey(node->HighKey());
+    }
+    node->SetHighKey(new_leaf->KeyAt(0));
+  }
   new_leaf->SetNextPageId(node->GetNextPageId());
   node->SetNextPageId(new_leaf->GetPageId());
   return new_leaf;
@@ -197,7 +257,7 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
       DLOG(ERROR) << "out of memory";
       throw "out of memory";
     }
-    new_root->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_);
+    new_root->Init(root_page_id_, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_, layout_);
     new_root->PopulateNewRoot(old_node->GetPageId(), key, new_node->GetPageId());
     UpdateRootPageId();
     reinterpret_cast<BPlusTreePage *>(old_node)->SetParentPageId(root_page_id_);
@@ -205,23 +265,171 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
     buffer_pool_manager_->UnpinPage(root_page_id_, true);
     return;
   }
+  // the parent is write latched by the caller, it is unsafe
   auto parent =
       reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(old_node->GetParentPageId())->GetData());
   parent->InsertNodeAfter(old_node->GetPageId(), key, new_node->GetPageId());
-  parent->SetKeyAt(parent->ValueIndex(old_node->GetPageId()),
-                   reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, old_node->GetPageId(), true))->KeyAt(0));
   if (parent->GetSize() < parent->GetMaxSize()) {
     buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
     return;
   }
   auto new_parent = Split(parent, transaction);
-  InsertIntoParent(
-      parent, reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, new_parent->GetPageId(), true))->KeyAt(0),
-      new_parent, transaction);
+  // the key moved along with the first child of the new parent separates the two halves
+  InsertIntoParent(parent, new_parent->KeyAt(0), new_parent, transaction);
   buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
   buffer_pool_manager_->UnpinPage(new_parent->GetPageId(), true);
 }
 
+/*****************************************************************************
+ * BULK LOADING
+ *****************************************************************************/
+/*
+ * The pages of a level are built left to right and only the page being filled is pinned. The first key and
+ * the page id of every page are kept to build the level above, until a level has a single page, the root.
+ */
+bool BPlusTree::BulkLoad(const std::function<bool(GenericKey *key, RowId *value)> &next, double fill_factor) {
+  root_latch_.WLock();
+  if (root_page_id_ != INVALID_PAGE_ID) {
+    root_latch_.WUnlock();
+    return false;
+  }
+  // a page at rest holds less than its max size, a page before the last one at least its min size
+  auto fill = [fill_factor](int max_size) {
+    return std::max(std::max(max_size / 2, 1), std::min(max_size - 1, static_cast<int>(max_size * fill_factor)));
+  };
+  auto key_size = processor_.GetKeySize();
+  std::vector<page_id_t> page_ids;
+  std::vector<char> keys;
+  KeyBuffer key;
+  RowId value;
+  LeafPage *leaf = nullptr;
+  int leaf_fill = fill(leaf_max_size_);
+  while (next(key.Get(), &value)) {
+    if (leaf != nullptr && leaf->GetSize() > 0 &&
+        processor_.CompareKeys(leaf->KeyAt(leaf->GetSize() - 1), key.Get()) == 0) {
+      continue;
+    }
+    if (leaf == nullptr || leaf->GetSize() == leaf_fill) {
+      page_id_t page_id;
+      auto new_leaf = reinterpret_cast<LeafPage *>(buffer_pool_manager_->NewPage(page_id)->GetData());
+      new_leaf->Init(page_id, INVALID_PAGE_ID, key_size, leaf_max_size_, layout_, linked_);
+      if (leaf != nullptr) {
+        leaf->SetNextPageId(page_id);
+        if (linked_) {
+          leaf->SetHighKey(key.Get());
+        }
+        buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+      }
+      leaf = new_leaf;
+      page_ids.push_back(page_id);
+      keys.insert(keys.end(), reinterpret_cast<char *>(key.Get()), reinterpret_cast<char *>(key.Get()) + key_size);
+    }
+    leaf->SetKeyAt(leaf->GetSize(), key.Get());
+    leaf->SetValueAt(leaf->GetSize(), value);
+    leaf->IncreaseSize(1);
+  }
+  if (leaf == nullptr) {
+    root_latch_.WUnlock();
+    return true;
+  }
+  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+  BalanceLastPage(&page_ids, &keys);
+  int internal_fill = std::max(2, fill(internal_max_size_));
+  for (int level = 1; page_ids.size() > 1; level++) {
+    std::vector<page_id_t> parent_ids;
+    std::vector<char> parent_keys;
+    InternalPage *internal = nullptr;
+    for (size_t i = 0; i < page_ids.size(); i++) {
+      auto child_key = reinterpret_cast<GenericKey *>(keys.data() + i * key_size);
+      if (internal == nullptr || internal->GetSize() == internal_fill) {
+        page_id_t page_id;
+        auto new_internal = reinterpret_cast<InternalPage *>(buffer_pool_manager_->NewPage(page_id)->GetData());
+        new_internal->Init(page_id, INVALID_PAGE_ID, key_size, internal_max_size_, layout_, linked_);
+        if (linked_) {
+          new_internal->SetLevel(level);
+        }
+        if (internal != nullptr) {
+          if (linked_) {
+            internal->SetRightPageId(page_id);
+            internal->SetHighKey(child_key);
+          }
+          buffer_pool_manager_->UnpinPage(internal->GetPageId(), true);
+        }
+        internal = new_internal;
+        parent_ids.push_back(page_id);
+        parent_keys.insert(parent_keys.end(), keys.data() + i * key_size, keys.data() + (i + 1) * key_size);
+      }
+      internal->SetKeyAt(internal->GetSize(), child_key);
+      internal->SetValueAt(internal->GetSize(), page_ids[i]);
+      internal->IncreaseSize(1);
+      auto child = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_ids[i])->GetData());
+      child->SetParentPageId(internal->GetPageId());
+      buffer_pool_manager_->UnpinPage(page_ids[i], true);
+    }
+    buffer_pool_manager_->UnpinPage(internal->GetPageId(), true);
+    BalanceLastPage(&parent_ids, &parent_keys);
+    page_ids.swap(parent_ids);
+    keys.swap(parent_keys);
+  }
+  root_page_id_ = page_ids[0];
+  UpdateRootPageId();
+  root_latch_.WUnlock();
+  return true;
+}
+
+void BPlusTree::BalanceLastPage(std::vector<page_id_t> *page_ids, std::vector<char> *keys) {
+  if (page_ids->size() < 2) {
+    return;
+  }
+  auto key_size = processor_.GetKeySize();
+  auto last_page_id = page_ids->back();
+  auto prev_page_id = (*page_ids)[page_ids->size() - 2];
+  auto last = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(last_page_id)->GetData());
+  auto prev = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(prev_page_id)->GetData());
+  auto last_key = reinterpret_cast<GenericKey *>(keys->data() + keys->size() - key_size);
+  int min_size = last->GetMaxSize() / 2;
+  bool merge = last->GetSize() < min_size && prev->GetSize() + last->GetSize() < last->GetMaxSize();
+  if (merge) {
+    if (last->IsLeafPage()) {
+      reinterpret_cast<LeafPage *>(last)->MoveAllTo(reinterpret_cast<LeafPage *>(prev));
+    } else {
+      reinterpret_cast<InternalPage *>(last)->MoveAllTo(reinterpret_cast<InternalPage *>(prev), last_key,
+                                                        buffer_pool_manager_);
+      if (linked_) {
+        reinterpret_cast<InternalPage *>(prev)->SetRightPageId(INVALID_PAGE_ID);
+      }
+    }
+  }
+  while (!merge && last->GetSize() < min_size) {
+    // the separator of the two pages moves down by one entry
+    if (last->IsLeafPage()) {
+      reinterpret_cast<LeafPage *>(prev)->MoveLastToFrontOf(reinterpret_cast<LeafPage *>(last));
+      memcpy(last_key, reinterpret_cast<LeafPage *>(last)->KeyAt(0), key_size);
+    } else {
+      auto prev_internal = reinterpret_cast<InternalPage *>(prev);
+      KeyBuffer moved_key;
+      memcpy(moved_key.Get(), prev_internal->KeyAt(prev_internal->GetSize() - 1), key_size);
+      prev_internal->MoveLastToFrontOf(reinterpret_cast<InternalPage *>(last), last_key, buffer_pool_manager_);
+      memcpy(last_key, moved_key.Get(), key_size);
+      reinterpret_cast<InternalPage *>(last)->SetKeyAt(0, last_key);
+    }
+    if (linked_) {
+      if (prev->IsLeafPage()) {
+        reinterpret_cast<LeafPage *>(prev)->SetHighKey(last_key);
+      } else {
+        reinterpret_cast<InternalPage *>(prev)->SetHighKey(last_key);
+      }
+    }
+  }
+  buffer_pool_manager_->UnpinPage(prev_page_id, true);
+  buffer_pool_manager_->UnpinPage(last_page_id, true);
+  if (merge) {
+    buffer_pool_manager_->DeletePage(last_page_id);
+    page_ids->pop_back();
+    keys->resize(keys->size() - key_size);
+  }
+}
+
 /*****************************************************************************
  * REMOVE
  *****************************************************************************/
@@ -233,38 +441,34 @@ void BPlusTree::InsertIntoParent(BPlusTreePage *old_node, GenericKey *key, BPlus
  * necessary.
  */
 void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
-  if (IsEmpty()) {
+  if (linked_) {
+    LinkedRemove(key);
     return;
   }
-  auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(key, root_page_id_, false));
+  WriteSet write_set;
+  auto leaf = FindLeafPageForWrite(key, Operation::kRemove, &write_set);
   RowId fakeValue;
-  if (!leaf->Lookup(key, fakeValue, processor_)) {
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+  if (leaf == nullptr || !leaf->Lookup(key, fakeValue, processor_)) {
+    ReleaseWriteSet(&write_set);
     return;
   }
   leaf->RemoveAndDeleteRecord(key, processor_);
-  page_id_t children_id = leaf->GetPageId();
-  page_id_t parent_id = leaf->GetParentPageId();
-  // may need update parent key
-  while (parent_id != INVALID_PAGE_ID) {
-    // DLOG(INFO) << "adjusting parent " << parent_id << " " << children_id;
-    // fetch parent
-    auto parent = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(parent_id)->GetData());
-    // update parent key
-    parent->SetKeyAt(parent->ValueIndex(children_id),
-                     reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, children_id, true))->KeyAt(0));
-    if (parent->IsRootPage()) break;
-    children_id = parent_id;
-    parent_id = parent->GetParentPageId();
-    buffer_pool_manager_->UnpinPage(parent_id, true);
-  }
-  if (leaf->GetSize() >= leaf->GetMinSize()) {
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+  // the keys of the parents stay valid separators, a safe leaf is done
+  if (write_set.pages_.size() == 1 && !write_set.root_latched_) {
+    ReleaseWriteSet(&write_set);
     return;
   }
-  CoalesceOrRedistribute(leaf, transaction);
-  // leaf will be adjusted in CoalesceOrRedistribute
-  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+  auto leaf_page_id = leaf->GetPageId();
+  if (leaf->IsRootPage()) {
+    // a root leaf has no sibling, it only goes away with its last key
+    if (leaf->GetSize() == 0 && AdjustRoot(leaf)) {
+      write_set.deleted_.push_back(leaf_page_id);
+    }
+  } else if (leaf->GetSize() < leaf->GetMinSize() && CoalesceOrRedistribute(leaf, &write_set, transaction)) {
+    // leaf is adjusted in CoalesceOrRedistribute
+    write_set.deleted_.push_back(leaf_page_id);
+  }
+  ReleaseWriteSet(&write_set);
 }
 
 /* todo
@@ -272,52 +476,51 @@ void BPlusTree::Remove(const GenericKey *key, Txn *transaction) {
  * page's size > page's max size, then redistribute. Otherwise, merge.
  * Using template N to represent either internal page or leaf page.
  * @return: true means target leaf page should be deleted, false means no
- * deletion happens
+ * deletion happens. The page of node stays latched, it is deleted by the caller.
  */
 template <typename N>
-bool BPlusTree::CoalesceOrRedistribute(N *&node, Txn *transaction) {
+bool BPlusTree::CoalesceOrRedistribute(N *&node, WriteSet *write_set, Txn *transaction) {
+  // the parent is write latched by the caller, the sibling is latched here
   auto parent = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(node->GetParentPageId())->GetData());
   int index = parent->ValueIndex(node->GetPageId());
   // index = 0: node | neighbor
   // index = 1: neighbor | node
-  N *neighbor_node;
-  if (index == 0) {
-    neighbor_node = reinterpret_cast<N *>(buffer_pool_manager_->FetchPage(parent->ValueAt(1))->GetData());
-  } else {
-    neighbor_node = reinterpret_cast<N *>(buffer_pool_manager_->FetchPage(parent->ValueAt(index - 1))->GetData());
-  }
+  auto neighbor_page = buffer_pool_manager_->FetchPage(parent->ValueAt(index == 0 ? 1 : index - 1));
+  neighbor_page->WLatch();
+  auto neighbor_node = reinterpret_cast<N *>(neighbor_page->GetData());
+  auto neighbor_page_id = neighbor_node->GetPageId();
   if (neighbor_node->GetSize() + node->GetSize() >= node->GetMaxSize()) {
-    Redistribute(neighbor_node, node, index);
-    if (index) {  // need update node's key
-      parent->SetKeyAt(index,
-                       reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, node->GetPageId(), true))->KeyAt(0));
-    } else {  // need update neighbor's key
-      parent->SetKeyAt(
-          index + 1,
-          reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(nullptr, neighbor_node->GetPageId(), true))->KeyAt(0));
-    }
-    buffer_pool_manager_->UnpinPage(neighbor_node->GetPageId(), true);
+    Redistribute(neighbor_node, node, parent, index);
+    buffer_pool_manager_->UnpinPage(neighbor_page_id, true);
+    neighbor_page->WUnlatch();
     buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
     return false;
-  } else {
-    auto parent_need_adjust = Coalesce(neighbor_node, node, parent, index, transaction);
-    if (parent_need_adjust) {
-      if (parent->IsRootPage()) {
-        auto delete_root = AdjustRoot(parent);
-        if (delete_root) {
-          Destroy(parent->GetPageId());
-        }
-      } else {
-        CoalesceOrRedistribute(parent, transaction);
-      }
-      return true;  // deletion happened to node or neighbor
+  }
+  auto parent_need_adjust = Coalesce(neighbor_node, node, parent, index, transaction);
+  // the right page of the pair is merged into the left one, node is deleted by the caller
+  buffer_pool_manager_->UnpinPage(neighbor_page_id, true);
+  neighbor_page->WUnlatch();
+  if (index == 0) {
+    write_set->deleted_.push_back(neighbor_page_id);
+  }
+  if (parent_need_adjust) {
+    bool delete_parent;
+    if (parent->IsRootPage()) {
+      delete_parent = AdjustRoot(parent);
+    } else {
+      delete_parent = CoalesceOrRedistribute(parent, write_set, transaction);
+    }
+    if (delete_parent) {
+      write_set->deleted_.push_back(parent->GetPageId());
     }
   }
+  buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
+  return index != 0;
 }
 
 /*
- * Move all the key & value pairs from one page to its sibling page, and notify
- * buffer pool manager to delete this page. Parent page must be adjusted to
+ * Move all the key & value pairs from one page to its sibling page, the emptied
+ * page is unpinned and deleted by coalesceOrRedistribute(). Parent page must be adjusted to
  * take info of deletion into account. Remember to deal with coalesce or
  * redistribute recursively if necessary.
  * Using template N to represent either internal page or leaf page.
@@ -331,13 +534,9 @@ bool BPlusTree::Coalesce(LeafPage *&neighbor_node, LeafPage *&node, InternalPage
   if (index)  // nei | node
   {
     node->MoveAllTo(neighbor_node);
-    Destroy(node->GetPageId());
-    buffer_pool_manager_->UnpinPage(neighbor_node->GetPageId(), false);
     parent->Remove(index);
   } else {  // node | nei
     neighbor_node->MoveAllTo(node);
-    Destroy(neighbor_node->GetPageId());
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     parent->Remove(index + 1);
   }
   return parent->GetSize() < parent->GetMinSize();
@@ -348,13 +547,9 @@ bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, Inte
                          Txn *transaction) {
   if (index) {  // nei | node
     node->MoveAllTo(neighbor_node, parent->KeyAt(index), buffer_pool_manager_);
-    Destroy(node->GetPageId());
-    buffer_pool_manager_->UnpinPage(neighbor_node->GetPageId(), false);
     parent->Remove(index);
   } else {  // node | nei
     neighbor_node->MoveAllTo(node, parent->KeyAt(index + 1), buffer_pool_manager_);
-    Destroy(neighbor_node->GetPageId());
-    buffer_pool_manager_->UnpinPage(node->GetPageId(), false);
     parent->Remove(index + 1);
   }
   return parent->GetSize() < parent->GetMinSize();
@@ -364,28 +559,30 @@ bool BPlusTree::Coalesce(InternalPage *&neighbor_node, InternalPage *&node, Inte
  * Redistribute key & value pairs from one page to its sibling page. If index ==
  * 0, move sibling page's first key & value pair into end of input "node",
  * otherwise move sibling page's last key & value pair into head of input
- * "node".
+ * "node". The key of the right page in parent is updated.
  * Using template N to represent either internal page or leaf page.
  * @param   neighbor_node      sibling page of input "node"
  * @param   node               input from method coalesceOrRedistribute()
  */
-void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, int index) {
+void BPlusTree::Redistribute(LeafPage *neighbor_node, LeafPage *node, InternalPage *parent, int index) {
   if (index == 0) {
     neighbor_node->MoveFirstToEndOf(node);
+    parent->SetKeyAt(1, neighbor_node->KeyAt(0));
   } else {
     neighbor_node->MoveLastToFrontOf(node);
+    parent->SetKeyAt(index, node->KeyAt(0));
   }
 }
-void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, int index) {
+void BPlusTree::Redistribute(InternalPage *neighbor_node, InternalPage *node, InternalPage *parent, int index) {
   if (index == 0) {  // node | nei
-    auto parent =
-        reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(neighbor_node->GetParentPageId())->GetData());
-    auto middle_key = parent->KeyAt(parent->ValueIndex(neighbor_node->GetPageId()));
-    neighbor_node->MoveFirstToEndOf(node, middle_key, buffer_pool_manager_);
+    neighbor_node->MoveFirstToEndOf(node, parent->KeyAt(1), buffer_pool_manager_);
+    // the key of the second child moves up
+    parent->SetKeyAt(1, neighbor_node->KeyAt(0));
   } else {  // nei | node
-    auto parent = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(node->GetParentPageId())->GetData());
-    auto middle_key = parent->KeyAt(parent->ValueIndex(node->GetPageId()));
-    neighbor_node->MoveLastToFrontOf(node, middle_key, buffer_pool_manager_);
+    KeyBuffer last_key;
+    memcpy(last_key.Get(), neighbor_node->KeyAt(neighbor_node->GetSize() - 1), processor_.GetKeySize());
+    neighbor_node->MoveLastToFrontOf(node, parent->KeyAt(index), buffer_pool_manager_);
+    parent->SetKeyAt(index, last_key.Get());
   }
 }
 /*
@@ -406,14 +603,15 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
       UpdateRootPageId();
       return true;
     }
+    return false;
   } else {
     // case 1: the root should be deleted
-    auto old_root_page_id = old_root_node->GetPageId();
     auto new_root_page_id = reinterpret_cast<InternalPage *>(old_root_node)->RemoveAndReturnOnlyChild();
     root_page_id_ = new_root_page_id;
     auto new_root_page =
         reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(new_root_page_id)->GetData());
     new_root_page->SetParentPageId(INVALID_PAGE_ID);
+    buffer_pool_manager_->UnpinPage(new_root_page_id, true);
     UpdateRootPageId();
     return true;
   }
@@ -428,7 +626,9 @@ bool BPlusTree::AdjustRoot(BPlusTreePage *old_root_node) {
  * @return : index iterator
  */
 IndexIterator BPlusTree::Begin() {
-  return IndexIterator(FindLeafPage(nullptr, root_page_id_, true)->GetPageId(), buffer_pool_manager_, 0);
+  int index;
+  auto page = FindLeafPageFrom(nullptr, true, &index);
+  return IndexIterator(this, page, index);
 }
 
 /*
@@ -436,14 +636,10 @@ IndexIterator BPlusTree::Begin() {
  * first, then construct index iterator
  * @return : index iterator
  */
-IndexIterator BPlusTree::Begin(const GenericKey *key) { 
-  auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(FindLeafPage(key, root_page_id_, false));
-  int index = leaf->KeyIndex(key, processor_);
-  if(index == leaf->GetSize()) {
-    buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
-    return IndexIterator();
-  }
-  return IndexIterator(leaf->GetPageId(), buffer_pool_manager_, index); 
+IndexIterator BPlusTree::Begin(const GenericKey *key, bool inclusive) {
+  int index;
+  auto page = FindLeafPageFrom(key, inclusive, &index);
+  return IndexIterator(this, page, index);
 }
 
 /*
@@ -454,24 +650,359 @@ IndexIterator BPlusTree::Begin(const GenericKey *key) {
 IndexIterator BPlusTree::End() { return IndexIterator(); }
 
 /*****************************************************************************
- * UTILITIES AND DEBUG
+ * LATCHING
  *****************************************************************************/
 /*
- * Find leaf page containing particular key, if leftMost flag == true, find
- * the left most leaf page
- * Note: the leaf page is pinned, you need to unpin it after use.
+ * Find leaf page containing particular key, if left_most flag == true, find
+ * the left most leaf page. Every page is read latched before the latch of its
+ * parent is released.
+ * Note: the leaf page is pinned and read latched, you need to unpin and unlatch it after use.
  */
-Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool leftMost) {
-  auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
-  if (page->IsLeafPage()) {
-    return reinterpret_cast<Page *>(page);
+Page *BPlusTree::FindLeafPage(const GenericKey *key, bool left_most) {
+  if (linked_) {
+    return FindLinkedPage(left_most ? nullptr : key, 0, false, nullptr);
+  }
+  root_latch_.RLock();
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    root_latch_.RUnlock();
+    return nullptr;
+  }
+  auto page = buffer_pool_manager_->FetchPage(root_page_id_);
+  page->RLatch();
+  root_latch_.RUnlock();
+  auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  while (!node->IsLeafPage()) {
+    auto internal_page = reinterpret_cast<InternalPage *>(node);
+    auto child = buffer_pool_manager_->FetchPage(left_most ? internal_page->ValueAt(0)
+                                                           : internal_page->Lookup(key, processor_));
+    child->RLatch();
+    // unpinned before it is unlatched, a writer never finds a page it deletes still pinned
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page->RUnlatch();
+    page = child;
+    node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  }
+  return page;
+}
+
+BPlusTreeLeafPage *BPlusTree::FindLeafPageForWrite(const GenericKey *key, Operation op, WriteSet *write_set) {
+  // optimistic: read latch the internal pages, write latch the leaf. The type of a page never changes.
+  auto latch = [](Page *page, BPlusTreePage *node) {
+    if (node->IsLeafPage()) {
+      page->WLatch();
+    } else {
+      page->RLatch();
+    }
+  };
+  root_latch_.RLock();
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    root_latch_.RUnlock();
+  } else {
+    auto page = buffer_pool_manager_->FetchPage(root_page_id_);
+    auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    latch(page, node);
+    // the leaf is checked before the latch above it is released, its parent page id may change afterwards
+    bool safe = !node->IsLeafPage() || IsSafe(node, op);
+    root_latch_.RUnlock();
+    while (safe && !node->IsLeafPage()) {
+      auto child = buffer_pool_manager_->FetchPage(reinterpret_cast<InternalPage *>(node)->Lookup(key, processor_));
+      auto child_node = reinterpret_cast<BPlusTreePage *>(child->GetData());
+      latch(child, child_node);
+      safe = !child_node->IsLeafPage() || IsSafe(child_node, op);
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      page->RUnlatch();
+      page = child;
+      node = child_node;
+    }
+    if (safe) {
+      write_set->pages_.push_back(page);
+      return reinterpret_cast<LeafPage *>(node);
+    }
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page->WUnlatch();
+  }
+  // pessimistic: write latch the path, release the latches above a safe page
+  root_latch_.WLock();
+  write_set->root_latched_ = true;
+  if (root_page_id_ == INVALID_PAGE_ID) {
+    return nullptr;
   }
-  auto internal_page = reinterpret_cast<InternalPage *>(page);
-  auto next_page_id = leftMost ? internal_page->ValueAt(0) : internal_page->Lookup(key, processor_);
-  buffer_pool_manager_->UnpinPage(internal_page->GetPageId(), false);
-  return FindLeafPage(key, next_page_id, leftMost);
+  auto page_id = root_page_id_;
+  while (true) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    page->WLatch();
+    auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    if (IsSafe(node, op)) {
+      ReleaseWriteSet(write_set);
+    }
+    write_set->pages_.push_back(page);
+    if (node->IsLeafPage()) {
+      return reinterpret_cast<LeafPage *>(node);
+    }
+    page_id = reinterpret_cast<InternalPage *>(node)->Lookup(key, processor_);
+  }
+}
+
+Page *BPlusTree::FindLeafPageFrom(const GenericKey *key, bool inclusive, int *index) {
+  while (true) {
+    auto page = FindLeafPage(key, key == nullptr);
+    if (page == nullptr) {
+      return nullptr;
+    }
+    auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
+    *index = key == nullptr ? 0 : leaf->KeyIndex(key, processor_);
+    if (!inclusive && key != nullptr && *index < leaf->GetSize() && processor_.CompareKeys(leaf->KeyAt(*index), key) == 0) {
+      (*index)++;
+    }
+    // the entry may be in the following leaves, the leaves of a linked tree may be empty
+    while (*index == leaf->GetSize()) {
+      auto next_page_id = leaf->GetNextPageId();
+      Page *next_page = nullptr;
+      if (next_page_id != INVALID_PAGE_ID) {
+        next_page = buffer_pool_manager_->FetchPage(next_page_id);
+        // a writer merging the next leaf into this one latches them from right to left, give way to it
+        if (!next_page->TryRLatch()) {
+          buffer_pool_manager_->UnpinPage(next_page_id, false);
+          buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+          page->RUnlatch();
+          page = nullptr;
+          std::this_thread::yield();
+          break;
+        }
+      }
+      buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+      page->RUnlatch();
+      if (next_page == nullptr) {
+        return nullptr;
+      }
+      page = next_page;
+      leaf = reinterpret_cast<LeafPage *>(page->GetData());
+      *index = 0;
+    }
+    if (page != nullptr) {
+      return page;
+    }
+  }
+}
+
+bool BPlusTree::IsSafe(BPlusTreePage *node, Operation op) {
+  if (op == Operation::kInsert) {
+    return node->GetSize() + 1 < node->GetMaxSize();
+  }
+  if (node->IsRootPage() && node->IsLeafPage()) {
+    return node->GetSize() > 1;
+  }
+  return node->GetSize() > node->GetMinSize();
+}
+
+/*
+ * Release the root latch and the latched pages, then delete the pages removed from the tree. Nobody can
+ * reach a page removed from the tree, so it is unpinned once its latch is released.
+ */
+void BPlusTree::ReleaseWriteSet(WriteSet *write_set) {
+  if (write_set->root_latched_) {
+    root_latch_.WUnlock();
+    write_set->root_latched_ = false;
+  }
+  for (auto page : write_set->pages_) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    page->WUnlatch();
+  }
+  write_set->pages_.clear();
+  for (auto page_id : write_set->deleted_) {
+    buffer_pool_manager_->DeletePage(page_id);
+  }
+  write_set->deleted_.clear();
+}
+
+/*****************************************************************************
+ * LINKED TREE
+ *****************************************************************************/
+/*
+ * Insert into a linked tree. Only the leaf is write latched, a full leaf is split and released before its
+ * separator goes into the level above.
+ */
+bool BPlusTree::LinkedInsert(GenericKey *key, const RowId &value, Txn *transaction) {
+  std::vector<page_id_t> path;
+  auto page = FindLinkedPage(key, 0, true, &path);
+  if (page == nullptr) {
+    root_latch_.WLock();
+    bool empty = root_page_id_ == INVALID_PAGE_ID;
+    if (empty) {
+      StartNewTree(key, value);
+    }
+    root_latch_.WUnlock();
+    // another insert may have started the tree meanwhile
+    return empty || LinkedInsert(key, value, transaction);
+  }
+  auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  RowId fake_value;
+  if (leaf->Lookup(key, fake_value, processor_)) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page->WUnlatch();
+    return false;
+  }
+  leaf->Insert(key, value, processor_);
+  if (leaf->GetSize() < leaf->GetMaxSize()) {
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+    page->WUnlatch();
+    return true;
+  }
+  CompleteSplit(page, Split(leaf, transaction), &path, transaction);
+  return true;
 }
 
+/*
+ * Remove from a linked tree, the leaf is left in place even if it gets empty.
+ */
+void BPlusTree::LinkedRemove(const GenericKey *key) {
+  auto page = FindLinkedPage(key, 0, true, nullptr);
+  if (page == nullptr) {
+    return;
+  }
+  reinterpret_cast<LeafPage *>(page->GetData())->RemoveAndDeleteRecord(key, processor_);
+  buffer_pool_manager_->UnpinPage(page->GetPageId(), true);
+  page->WUnlatch();
+}
+
+Page *BPlusTree::FindLinkedPage(const GenericKey *key, int level, bool exclusive, std::vector<page_id_t> *path) {
+  root_latch_.RLock();
+  auto page_id = root_page_id_;
+  root_latch_.RUnlock();
+  if (page_id == INVALID_PAGE_ID) {
+    return nullptr;
+  }
+  while (true) {
+    auto page = buffer_pool_manager_->FetchPage(page_id);
+    // the level of a page never changes
+    auto page_level = Level(reinterpret_cast<BPlusTreePage *>(page->GetData()));
+    if (page_level < level) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      return nullptr;
+    }
+    bool write = exclusive && page_level == level;
+    if (write) {
+      page->WLatch();
+    } else {
+      page->RLatch();
+    }
+    page = MoveRight(page, key, write);
+    if (page_level == level) {
+      return page;
+    }
+    if (path != nullptr) {
+      path->push_back(page->GetPageId());
+    }
+    auto internal = reinterpret_cast<InternalPage *>(page->GetData());
+    page_id = key == nullptr ? internal->ValueAt(0) : internal->Lookup(key, processor_);
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    page->RUnlatch();
+  }
+}
+
+Page *BPlusTree::MoveRight(Page *page, const GenericKey *key, bool exclusive) {
+  while (key != nullptr) {
+    auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+    auto right_page_id = RightPageId(node);
+    if (right_page_id == INVALID_PAGE_ID || processor_.CompareKeys(key, HighKey(node)) < 0) {
+      return page;
+    }
+    // pages of a linked tree are never deleted, the right page is latched once page is released
+    buffer_pool_manager_->UnpinPage(page->GetPageId(), false);
+    if (exclusive) {
+      page->WUnlatch();
+    } else {
+      page->RUnlatch();
+    }
+    page = buffer_pool_manager_->FetchPage(right_page_id);
+    if (exclusive) {
+      page->WLatch();
+    } else {
+      page->RLatch();
+    }
+  }
+  return page;
+}
+
+/*
+ * Until the separator is in the level above, readers get to new_node by the right link of page. The page
+ * on the level above may have split since the descent, then it is found by moving right. If the descent
+ * started at the level of page, page is the root and the tree grows, unless another split grew it already.
+ */
+void BPlusTree::CompleteSplit(Page *page, BPlusTreePage *new_node, std::vector<page_id_t> *path, Txn *transaction) {
+  auto node = reinterpret_cast<BPlusTreePage *>(page->GetData());
+  auto page_id = page->GetPageId();
+  auto new_page_id = new_node->GetPageId();
+  auto level = Level(node);
+  // the high key of page is the separator
+  KeyBuffer key;
+  memcpy(key.Get(), HighKey(node), processor_.GetKeySize());
+  buffer_pool_manager_->UnpinPage(new_page_id, true);
+  buffer_pool_manager_->UnpinPage(page_id, true);
+  page->WUnlatch();
+  Page *parent_page = nullptr;
+  if (!path->empty()) {
+    parent_page = buffer_pool_manager_->FetchPage(path->back());
+    path->pop_back();
+    parent_page->WLatch();
+    parent_page = MoveRight(parent_page, key.Get(), true);
+  }
+  while (parent_page == nullptr) {
+    root_latch_.WLock();
+    if (root_page_id_ == page_id) {
+      page_id_t root_page_id;
+      auto new_root = reinterpret_cast<InternalPage *>(buffer_pool_manager_->NewPage(root_page_id)->GetData());
+      if (new_root == nullptr) {
+        DLOG(ERROR) << "out of memory";
+        throw "out of memory";
+      }
+      new_root->Init(root_page_id, INVALID_PAGE_ID, processor_.GetKeySize(), internal_max_size_, layout_, true);
+      new_root->SetLevel(level + 1);
+      new_root->PopulateNewRoot(page_id, key.Get(), new_page_id);
+      root_page_id_ = root_page_id;
+      UpdateRootPageId();
+      root_latch_.WUnlock();
+      buffer_pool_manager_->UnpinPage(root_page_id, true);
+      return;
+    }
+    root_latch_.WUnlock();
+    // the root is on the level of page as long as the split of the root is not complete
+    parent_page = FindLinkedPage(key.Get(), level + 1, true, path);
+    if (parent_page == nullptr) {
+      std::this_thread::yield();
+    }
+  }
+  auto parent = reinterpret_cast<InternalPage *>(parent_page->GetData());
+  parent->InsertNodeAfter(parent->Lookup(key.Get(), processor_), key.Get(), new_page_id);
+  if (parent->GetSize() < parent->GetMaxSize()) {
+    buffer_pool_manager_->UnpinPage(parent_page->GetPageId(), true);
+    parent_page->WUnlatch();
+    return;
+  }
+  CompleteSplit(parent_page, Split(parent, transaction), path, transaction);
+}
+
+int BPlusTree::Level(BPlusTreePage *node) {
+  return node->IsLeafPage() ? 0 : reinterpret_cast<InternalPage *>(node)->GetLevel();
+}
+
+page_id_t BPlusTree::RightPageId(BPlusTreePage *node) {
+  if (node->IsLeafPage()) {
+    return reinterpret_cast<LeafPage *>(node)->GetNextPageId();
+  }
+  return reinterpret_cast<InternalPage *>(node)->GetRightPageId();
+}
+
+GenericKey *BPlusTree::HighKey(BPlusTreePage *node) {
+  if (node->IsLeafPage()) {
+    return reinterpret_cast<LeafPage *>(node)->HighKey();
+  }
+  return reinterpret_cast<InternalPage *>(node)->HighKey();
+}
+
+/*****************************************************************************
+ * UTILITIES AND DEBUG
+ *****************************************************************************/
 /*
  * Update/Insert root page id in header page(where page_id = INDEX_ROOTS_PAGE_ID,
  * header_page isdefined under include/page/header_page.h)
@@ -481,14 +1012,18 @@ Page *BPlusTree::FindLeafPage(const GenericKey *key, page_id_t page_id, bool lef
  * updating it.
  */
 void BPlusTree::UpdateRootPageId(int insert_record) {
-  auto header_page =
-      reinterpret_cast<IndexRootsPage *>(buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID)->GetData());
+  auto page = buffer_pool_manager_->FetchPage(INDEX_ROOTS_PAGE_ID);
+  // the header page is shared by all indexes
+  page->WLatch();
+  auto header_page = reinterpret_cast<IndexRootsPage *>(page->GetData());
   bool res;
   if (insert_record) {
     res = header_page->Insert(index_id_, root_page_id_);
   } else {
     res = header_page->Update(index_id_, root_page_id_);
   }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(INDEX_ROOTS_PAGE_ID, true);
   if (!res) {
     DLOG(INFO) << "Fatal error";
     throw "Fatal error";
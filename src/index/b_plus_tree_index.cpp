@@ -3,18 +3,19 @@
 #include "index/generic_key.h"
 #include "utils/tree_file_mgr.h"
 BPlusTreeIndex::BPlusTreeIndex(index_id_t index_id, IndexSchema *key_schema, size_t key_size,
-                               BufferPoolManager *buffer_pool_manager)
+                               BufferPoolManager *buffer_pool_manager, KeyEncoding key_encoding, bool linked)
     : Index(index_id, key_schema),
-      processor_(key_schema_, key_size),
-      container_(index_id, buffer_pool_manager, processor_) {}
+      processor_(key_schema_, key_size, key_encoding),
+      container_(index_id, buffer_pool_manager, processor_, UNDEFINED_SIZE, UNDEFINED_SIZE, IndexPageLayout::kColumns,
+                 linked) {}
 
 dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
   // ASSERT(row_id.Get() != INVALID_ROWID.Get(), "Invalid row id for index insert.");
-  GenericKey *index_key = processor_.InitKey();
+  KeyBuffer key_buf;
+  GenericKey *index_key = key_buf.Get();
   processor_.SerializeFromKey(index_key, key, key_schema_);
 
   bool status = container_.Insert(index_key, row_id, txn);
-  free(index_key);
   //  TreeFileManagers mgr("tree_");
   //  static int i = 0;
   //  if (i % 10 == 0) container_.PrintTree(mgr[i]);
@@ -27,56 +28,103 @@ dberr_t BPlusTreeIndex::InsertEntry(const Row &key, RowId row_id, Txn *txn) {
 }
 
 dberr_t BPlusTreeIndex::RemoveEntry(const Row &key, RowId row_id, Txn *txn) {
-  GenericKey *index_key = processor_.InitKey();
+  KeyBuffer key_buf;
+  GenericKey *index_key = key_buf.Get();
   processor_.SerializeFromKey(index_key, key, key_schema_);
 
   container_.Remove(index_key, txn);
-  free(index_key);
   return DB_SUCCESS;
 }
 
 dberr_t BPlusTreeIndex::ScanKey(const Row &key, vector<RowId> &result, Txn *txn, string compare_operator) {
-  GenericKey *index_key = processor_.InitKey();
-  processor_.SerializeFromKey(index_key, key, key_schema_);
-  auto end_iter = GetEndIterator();
+  std::vector<RangeIterator> ranges;
   if (compare_operator == "=") {
+    KeyBuffer key_buf;
+    GenericKey *index_key = key_buf.Get();
+    processor_.SerializeFromKey(index_key, key, key_schema_);
     container_.GetValue(index_key, result, txn);
-  } else if (compare_operator == ">") {
-    auto iter = GetBeginIterator(index_key);
-    if (container_.GetValue(index_key, result, txn)) ++iter;
-    result.clear();
-    for (; iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-  } else if (compare_operator == ">=") {
-    for (auto iter = GetBeginIterator(index_key); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-  } else if (compare_operator == "<") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-  } else if (compare_operator == "<=") {
-    auto stop_iter = GetBeginIterator(index_key);
-    for (auto iter = GetBeginIterator(); iter != stop_iter; ++iter) {
-      result.emplace_back((*iter).second);
-    }
-    container_.GetValue(index_key, result, txn);
+  } else if (compare_operator == ">" || compare_operator == ">=") {
+    ranges.push_back(ScanRange(&key, compare_operator == ">=", nullptr, false));
+  } else if (compare_operator == "<" || compare_operator == "<=") {
+    ranges.push_back(ScanRange(nullptr, false, &key, compare_operator == "<="));
   } else if (compare_operator == "<>") {
-    for (auto iter = GetBeginIterator(); iter != end_iter; ++iter) {
-      result.emplace_back((*iter).second);
+    ranges.push_back(ScanRange(nullptr, false, &key, false));
+    ranges.push_back(ScanRange(&key, false, nullptr, false));
+  }
+  RowId row_id;
+  for (auto &range : ranges) {
+    while (range.Next(&row_id)) {
+      result.push_back(row_id);
     }
-    vector<RowId> temp;
-    if (container_.GetValue(index_key, temp, txn)) result.erase(find(result.begin(), result.end(), temp[0]));
   }
-  free(index_key);
   if (!result.empty())
     return DB_SUCCESS;
   else
     return DB_KEY_NOT_FOUND;
 }
 
+BPlusTreeIndex::RangeIterator BPlusTreeIndex::ScanRange(const Row *lower, bool lower_inclusive, const Row *upper,
+                                                        bool upper_inclusive) {
+  return RangeIterator(this, lower, lower_inclusive, upper, upper_inclusive);
+}
+
+BPlusTreeIndex::RangeIterator::RangeIterator(BPlusTreeIndex *index, const Row *lower, bool lower_inclusive,
+                                             const Row *upper, bool upper_inclusive)
+    : processor_(&index->processor_), has_upper_(upper != nullptr), upper_inclusive_(upper_inclusive) {
+  if (has_upper_) {
+    processor_->SerializeFromKey(upper_.Get(), *upper, index->key_schema_);
+  }
+  KeyBuffer key_buf;
+  if (lower == nullptr) {
+    if (processor_->GetEncoding() != KeyEncoding::kNormalized) {
+      iter_ = index->container_.Begin();
+      return;
+    }
+    // null sorts before any value, start behind the keys whose columns are all null
+    std::vector<Field> null_fields;
+    for (auto column : index->key_schema_->GetColumns()) {
+      null_fields.emplace_back(column->GetType());
+    }
+    processor_->SerializeFromKey(key_buf.Get(), Row(null_fields), index->key_schema_);
+    iter_ = index->container_.Begin(key_buf.Get(), false);
+    return;
+  }
+  processor_->SerializeFromKey(key_buf.Get(), *lower, index->key_schema_);
+  iter_ = index->container_.Begin(key_buf.Get(), lower_inclusive);
+}
+
+bool BPlusTreeIndex::RangeIterator::Next(RowId *row_id) {
+  if (done_) {
+    return false;
+  }
+  if (started_) {
+    ++iter_;
+  }
+  started_ = true;
+  while (iter_ != IndexIterator() && processor_->IsLeadingNull((*iter_).first)) {
+    ++iter_;
+  }
+  if (iter_ == IndexIterator()) {
+    done_ = true;
+    return false;
+  }
+  auto entry = *iter_;
+  if (has_upper_) {
+    int cmp = processor_->CompareKeys(entry.first, upper_.Get());
+    if (cmp > 0 || (cmp == 0 && !upper_inclusive_)) {
+      done_ = true;
+      return false;
+    }
+  }
+  *row_id = entry.second;
+  return true;
+}
+
+dberr_t BPlusTreeIndex::BulkLoad(KeySorter *sorter, double fill_factor) {
+  auto next = [sorter](GenericKey *key, RowId *row_id) { return sorter->Next(key, row_id); };
+  return container_.BulkLoad(next, fill_factor) && !sorter->IsFailed() ? DB_SUCCESS : DB_FAILED;
+}
+
 dberr_t BPlusTreeIndex::Destroy() {
   container_.Destroy();
   return DB_SUCCESS;
@@ -0,0 +1,189 @@
+#include "index/generic_key.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace {
+// windows of at most this many keys are scanned instead of halved further
+constexpr int SCAN_WINDOW_KEYS = 32;
+
+inline uint64_t ReadWord(const char *keys, int index, uint32_t shift) {
+  return ReadBigEndian<uint64_t>(keys + index * sizeof(uint64_t)) >> shift;
+}
+
+/**
+ * Count the keys of a window less than word, or not greater if inclusive. The keys are in order,
+ * so that the count is the position of word in the window.
+ */
+using ScanWords = int (*)(const char *keys, int count, uint64_t word, uint32_t shift, bool inclusive);
+
+int ScanWordsScalar(const char *keys, int count, uint64_t word, uint32_t shift, bool inclusive) {
+  int index = 0;
+  while (index < count && (inclusive ? ReadWord(keys, index, shift) <= word : ReadWord(keys, index, shift) < word)) {
+    index++;
+  }
+  return index;
+}
+
+#if defined(__x86_64__)
+/*
+ * The lanes hold the keys byte-swapped to integers, with the sign bit flipped so that the signed
+ * 64-bit comparisons of SSE4.2 and AVX2 order them as unsigned words.
+ */
+__attribute__((target("avx2"))) int ScanWordsAvx2(const char *keys, int count, uint64_t word, uint32_t shift,
+                                                  bool inclusive) {
+  const __m256i swap = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,
+                                        0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  const __m128i count_shift = _mm_cvtsi32_si128(static_cast<int>(shift));
+  const __m256i target = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(word)), sign);
+  int index = 0, found = 0;
+  for (; index + 4 <= count; index += 4) {
+    __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + index * sizeof(uint64_t)));
+    lanes = _mm256_xor_si256(_mm256_srl_epi64(_mm256_shuffle_epi8(lanes, swap), count_shift), sign);
+    // keys less than word, or else keys greater than word
+    __m256i mask = inclusive ? _mm256_cmpgt_epi64(lanes, target) : _mm256_cmpgt_epi64(target, lanes);
+    int bits = __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    found += inclusive ? 4 - bits : bits;
+  }
+  return found + ScanWordsScalar(keys + index * sizeof(uint64_t), count - index, word, shift, inclusive);
+}
+
+__attribute__((target("sse4.2"))) int ScanWordsSse42(const char *keys, int count, uint64_t word, uint32_t shift,
+                                                     bool inclusive) {
+  const __m128i swap = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  const __m128i sign = _mm_set1_epi64x(INT64_MIN);
+  const __m128i count_shift = _mm_cvtsi32_si128(static_cast<int>(shift));
+  const __m128i target = _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(word)), sign);
+  int index = 0, found = 0;
+  for (; index + 2 <= count; index += 2) {
+    __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + index * sizeof(uint64_t)));
+    lanes = _mm_xor_si128(_mm_srl_epi64(_mm_shuffle_epi8(lanes, swap), count_shift), sign);
+    __m128i mask = inclusive ? _mm_cmpgt_epi64(lanes, target) : _mm_cmpgt_epi64(target, lanes);
+    int bits = __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+    found += inclusive ? 2 - bits : bits;
+  }
+  return found + ScanWordsScalar(keys + index * sizeof(uint64_t), count - index, word, shift, inclusive);
+}
+#endif
+
+ScanWords PickScanWords() {
+#if defined(__x86_64__)
+  // may run before the constructor which fills the cpu features
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return ScanWordsAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return ScanWordsSse42;
+  }
+#endif
+  return ScanWordsScalar;
+}
+
+const ScanWords scan_words = PickScanWords();
+}  // namespace
+
+int KeyManager::SearchWords(const char *keys, int count, const GenericKey *key, bool inclusive) const {
+  ASSERT(IsWordKey(), "Keys are not compared as words.");
+  uint64_t word = ReadBigEndian<uint64_t>(key->data) >> word_shift_;
+  int l = 0, r = count;
+  while (r - l > SCAN_WINDOW_KEYS) {
+    int mid = (l + r) / 2;
+    uint64_t mid_word = ReadWord(keys, mid, word_shift_);
+    if (inclusive ? mid_word <= word : mid_word < word) {
+      l = mid + 1;
+    } else {
+      r = mid;
+    }
+  }
+  return l + scan_words(keys + l * sizeof(uint64_t), r - l, word, word_shift_, inclusive);
+}
+
+uint32_t KeyManager::GetNormalizedSize(const Schema *key_schema) {
+  uint32_t size = 0;
+  for (auto column : key_schema->GetColumns()) {
+    size += 1;
+    if (column->GetType() == TypeId::kTypeChar) {
+      size += TypeKernel<TypeId::kTypeChar>::GetNormalizedSize(column->GetLength());
+    } else {
+      size += Type::GetTypeSize(column->GetType());
+    }
+  }
+  return size;
+}
+
+bool KeyManager::FitsKey(const Row &key, Schema *schema) const {
+  if (encoding_ == KeyEncoding::kRow) {
+    return key.GetSerializedSize(schema) <= key_size_;
+  }
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto field = key.GetField(i);
+    if (!field->IsNull() && field->GetTypeId() == TypeId::kTypeChar &&
+        field->GetLength() > schema->GetColumn(i)->GetLength()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void KeyManager::EncodeKey(char *buf, const Row &key, const Schema *schema) {
+  char value[sizeof(uint64_t)];
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto column = schema->GetColumn(i);
+    auto field = key.GetField(i);
+    *buf++ = field->IsNull() ? 0 : 1;
+    if (column->GetType() == TypeId::kTypeChar) {
+      if (!field->IsNull()) {
+        TypeKernel<TypeId::kTypeChar>::WriteNormalized(buf, field->GetData(), field->GetLength(), column->GetLength());
+      }
+      buf += TypeKernel<TypeId::kTypeChar>::GetNormalizedSize(column->GetLength());
+      continue;
+    }
+    DispatchType(column->GetType(), [&](auto kernel) {
+      using Kernel = decltype(kernel);
+      if constexpr (!std::is_same_v<Kernel, TypeKernel<TypeId::kTypeChar>>) {
+        if (!field->IsNull()) {
+          field->SerializeTo(value);
+          Kernel::WriteNormalized(buf, Kernel::Read(value));
+        }
+        buf += sizeof(typename Kernel::ValueType);
+      }
+      return 0;
+    });
+  }
+}
+
+void KeyManager::DecodeKey(const char *buf, Row &key, const Schema *schema) {
+  std::vector<Field> fields;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto column = schema->GetColumn(i);
+    bool is_null = *buf++ == 0;
+    if (column->GetType() == TypeId::kTypeChar) {
+      if (is_null) {
+        fields.emplace_back(TypeId::kTypeChar);
+      } else {
+        uint32_t len = TypeKernel<TypeId::kTypeChar>::ReadNormalizedLength(buf, column->GetLength());
+        fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(buf), len, true);
+      }
+      buf += TypeKernel<TypeId::kTypeChar>::GetNormalizedSize(column->GetLength());
+      continue;
+    }
+    DispatchType(column->GetType(), [&](auto kernel) {
+      using Kernel = decltype(kernel);
+      if constexpr (!std::is_same_v<Kernel, TypeKernel<TypeId::kTypeChar>>) {
+        if (is_null) {
+          fields.emplace_back(column->GetType());
+        } else {
+          fields.emplace_back(column->GetType(), Kernel::ReadNormalized(buf));
+        }
+        buf += sizeof(typename Kernel::ValueType);
+      }
+      return 0;
+    });
+  }
+  RowId rid = key.GetRowId();
+  key = Row(fields);
+  key.SetRowId(rid);
+}
@@ -1,52 +1,57 @@
 #include "index/index_iterator.h"
 
+#include "index/b_plus_tree.h"
 #include "index/basic_comparator.h"
 #include "index/generic_key.h"
 
-IndexIterator::IndexIterator(): current_page_id(INVALID_PAGE_ID), item_index(0), buffer_pool_manager(nullptr) {}
+IndexIterator::IndexIterator() = default;
 
-IndexIterator::IndexIterator(page_id_t page_id, BufferPoolManager *bpm, int index)
-    : current_page_id(page_id), item_index(index), buffer_pool_manager(bpm) {
-  page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
-}
-
-IndexIterator::~IndexIterator() {
-  if (current_page_id != INVALID_PAGE_ID)
-    buffer_pool_manager->UnpinPage(current_page_id, false);
-}
+IndexIterator::IndexIterator(BPlusTree *tree, Page *page, int index) : tree_(tree) { Load(page, index); }
 
-/**
- * TODO: Student Implement
- */
 std::pair<GenericKey *, RowId> IndexIterator::operator*() {
-  if(current_page_id == INVALID_PAGE_ID) {
+  if (current_page_id_ == INVALID_PAGE_ID) {
     throw std::out_of_range("IndexIterator out of range");
   }
-  return std::make_pair(page->KeyAt(item_index), page->ValueAt(item_index));
+  auto offset = item_index_ - first_index_;
+  return std::make_pair(reinterpret_cast<GenericKey *>(keys_.data() + offset * key_size_), values_[offset]);
 }
 
-/**
- * TODO: Student Implement
- */
 IndexIterator &IndexIterator::operator++() {
-  if (item_index + 1 < page->GetSize()) {
-    item_index++;
-  } else {
-    page_id_t next_page_id = page->GetNextPageId();
-    buffer_pool_manager->UnpinPage(current_page_id, false);
-    current_page_id = next_page_id;
-    item_index = 0;
-    if (current_page_id != INVALID_PAGE_ID) {
-      page = reinterpret_cast<LeafPage *>(buffer_pool_manager->FetchPage(current_page_id)->GetData());
-    }
+  item_index_++;
+  if (item_index_ - first_index_ < static_cast<int>(values_.size())) {
+    return *this;
   }
+  // the copied entries are used up, continue after the last of them
+  int index;
+  auto page = tree_->FindLeafPageFrom(reinterpret_cast<GenericKey *>(keys_.data() + keys_.size() - key_size_), false,
+                                      &index);
+  Load(page, index);
   return *this;
 }
 
 bool IndexIterator::operator==(const IndexIterator &itr) const {
-  return current_page_id == itr.current_page_id && item_index == itr.item_index;
+  return current_page_id_ == itr.current_page_id_ && item_index_ == itr.item_index_;
 }
 
-bool IndexIterator::operator!=(const IndexIterator &itr) const {
-  return !(*this == itr);
-}
\ No newline at end of file
+bool IndexIterator::operator!=(const IndexIterator &itr) const { return !(*this == itr); }
+
+void IndexIterator::Load(Page *page, int index) {
+  keys_.clear();
+  values_.clear();
+  if (page == nullptr) {
+    current_page_id_ = INVALID_PAGE_ID;
+    item_index_ = first_index_ = 0;
+    return;
+  }
+  auto leaf = reinterpret_cast<LeafPage *>(page->GetData());
+  key_size_ = leaf->GetKeySize();
+  current_page_id_ = leaf->GetPageId();
+  item_index_ = first_index_ = index;
+  keys_.resize((leaf->GetSize() - index) * key_size_);
+  for (int i = index; i < leaf->GetSize(); i++) {
+    memcpy(keys_.data() + (i - index) * key_size_, leaf->KeyAt(i), key_size_);
+    values_.push_back(leaf->ValueAt(i));
+  }
+  tree_->buffer_pool_manager_->UnpinPage(current_page_id_, false);
+  page->RUnlatch();
+}
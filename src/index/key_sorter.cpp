@@ -0,0 +1,156 @@
+#include "index/key_sorter.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "glog/logging.h"
+
+KeySorter::KeySorter(const KeyManager &processor, size_t memory_limit)
+    : processor_(processor),
+      memory_limit_(memory_limit),
+      key_size_(processor.GetKeySize()),
+      entry_size_(key_size_ + sizeof(RowId)) {}
+
+KeySorter::~KeySorter() {
+  for (auto &run : runs_) {
+    if (run.file_ != nullptr) {
+      fclose(run.file_);
+    }
+  }
+}
+
+dberr_t KeySorter::Add(const GenericKey *key, const RowId &row_id) {
+  ASSERT(!finished_, "Entry added after the entries were read.");
+  auto offset = entries_.size();
+  entries_.resize(offset + entry_size_);
+  memcpy(entries_.data() + offset, key, key_size_);
+  memcpy(entries_.data() + offset + key_size_, &row_id, sizeof(RowId));
+  if (entries_.size() >= memory_limit_) {
+    return Spill();
+  }
+  return DB_SUCCESS;
+}
+
+void KeySorter::Sort() {
+  ASSERT(!finished_, "Entries sorted after the entries were read.");
+  if (entries_.empty()) {
+    return;
+  }
+  Run run;
+  run.entries_ = SortEntries();
+  run.count_ = run.entries_.size() / entry_size_;
+  runs_.push_back(std::move(run));
+}
+
+void KeySorter::Merge(KeySorter *other) {
+  ASSERT(!finished_ && !other->finished_, "Sorter merged after the entries were read.");
+  ASSERT(key_size_ == other->key_size_, "Sorters of different keys merged.");
+  // the entries of both sorters must be in runs to keep the order of equal keys
+  Sort();
+  other->Sort();
+  for (auto &run : other->runs_) {
+    runs_.push_back(std::move(run));
+  }
+  other->runs_.clear();
+  spilled_runs_ += other->spilled_runs_;
+  other->spilled_runs_ = 0;
+}
+
+bool KeySorter::Next(GenericKey *key, RowId *row_id) {
+  if (!finished_) {
+    Finish();
+  }
+  if (failed_ || heap_.empty()) {
+    return false;
+  }
+  auto after = [this](size_t a, size_t b) { return After(a, b); };
+  std::pop_heap(heap_.begin(), heap_.end(), after);
+  auto &run = runs_[heap_.back()];
+  auto entry = run.entries_.data() + run.next_ * entry_size_;
+  memcpy(key, entry, key_size_);
+  memcpy(row_id, entry + key_size_, sizeof(RowId));
+  run.next_++;
+  if (Refill(&run)) {
+    std::push_heap(heap_.begin(), heap_.end(), after);
+  } else {
+    heap_.pop_back();
+  }
+  return true;
+}
+
+std::vector<char> KeySorter::SortEntries() {
+  size_t count = entries_.size() / entry_size_;
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+    return processor_.CompareKeys(reinterpret_cast<const GenericKey *>(entries_.data() + a * entry_size_),
+                                  reinterpret_cast<const GenericKey *>(entries_.data() + b * entry_size_)) < 0;
+  });
+  std::vector<char> sorted(entries_.size());
+  for (size_t i = 0; i < count; i++) {
+    memcpy(sorted.data() + i * entry_size_, entries_.data() + order[i] * entry_size_, entry_size_);
+  }
+  std::vector<char>().swap(entries_);
+  return sorted;
+}
+
+dberr_t KeySorter::Spill() {
+  auto sorted = SortEntries();
+  Run run;
+  run.file_ = std::tmpfile();
+  if (run.file_ == nullptr || fwrite(sorted.data(), 1, sorted.size(), run.file_) != sorted.size()) {
+    LOG(ERROR) << "Failed to spill a sorted run of " << sorted.size() << " bytes." << std::endl;
+    if (run.file_ != nullptr) {
+      fclose(run.file_);
+    }
+    return DB_FAILED;
+  }
+  runs_.push_back(std::move(run));
+  spilled_runs_++;
+  return DB_SUCCESS;
+}
+
+void KeySorter::Finish() {
+  // the runs spilled earlier hold the entries added earlier
+  Sort();
+  finished_ = true;
+  for (size_t i = 0; i < runs_.size(); i++) {
+    if (runs_[i].file_ != nullptr) {
+      rewind(runs_[i].file_);
+      runs_[i].entries_.resize(std::max<size_t>(1, RUN_BLOCK_SIZE / entry_size_) * entry_size_);
+    }
+    if (Refill(&runs_[i])) {
+      heap_.push_back(i);
+    }
+  }
+  std::make_heap(heap_.begin(), heap_.end(), [this](size_t a, size_t b) { return After(a, b); });
+}
+
+bool KeySorter::Refill(Run *run) {
+  if (run->next_ < run->count_) {
+    return true;
+  }
+  if (run->file_ == nullptr) {
+    return false;
+  }
+  run->next_ = 0;
+  run->count_ = fread(run->entries_.data(), entry_size_, run->entries_.size() / entry_size_, run->file_);
+  if (ferror(run->file_)) {
+    LOG(ERROR) << "Failed to read back a spilled run." << std::endl;
+    failed_ = true;
+    run->count_ = 0;
+  }
+  if (run->count_ == 0) {
+    fclose(run->file_);
+    run->file_ = nullptr;
+    return false;
+  }
+  return true;
+}
+
+bool KeySorter::After(size_t a, size_t b) const {
+  auto cmp = processor_.CompareKeys(
+      reinterpret_cast<const GenericKey *>(runs_[a].entries_.data() + runs_[a].next_ * entry_size_),
+      reinterpret_cast<const GenericKey *>(runs_[b].entries_.data() + runs_[b].next_ * entry_size_));
+  return cmp > 0 || (cmp == 0 && a > b);
+}
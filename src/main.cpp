@@ -1,4 +1,6 @@
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 #include "executor/execute_engine.h"
 #include "glog/logging.h"
@@ -55,6 +57,17 @@ int main(int argc, char **argv) {
   char cmd[buf_size];
   // executor engine
   ExecuteEngine engine;
+  // --scan-workers N sets the threads of a select scan or an index build, 1 runs them serially
+  // --vacuum-interval-ms N vacuums all the tables every N ms in the background, off by default since it moves rows
+  for (int i = 1; i + 1 < argc; i++) {
+    if (strcmp(argv[i], "--scan-workers") == 0) {
+      engine.SetScanWorkers(static_cast<uint32_t>(atoi(argv[++i])));
+    } else if (strcmp(argv[i], "--vacuum-interval-ms") == 0) {
+      auto interval_ms = atoi(argv[++i]);
+      // the task is stopped when the engine is destroyed
+      if (interval_ms > 0) engine.StartBackgroundVacuum(static_cast<uint32_t>(interval_ms));
+    }
+  }
   // for print syntax tree
   // TreeFileManagers syntax_tree_file_mgr("syntax_tree_");
   uint32_t syntax_tree_id = 0;
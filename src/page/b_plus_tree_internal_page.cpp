@@ -2,10 +2,7 @@
 
 #include "index/generic_key.h"
 
-#define pairs_off (data_)
 #define pair_size (GetKeySize() + sizeof(page_id_t))
-#define key_off 0
-#define val_off GetKeySize()
 
 /*****************************************************************************
  * HELPER METHODS AND UTILITIES
@@ -15,33 +12,68 @@
  * Including set page type, set current size, set page id, set parent id and set
  * max page size
  */
-void InternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void InternalPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size,
+                        IndexPageLayout layout, bool linked) {
   SetPageType(IndexPageType::INTERNAL_PAGE);
   SetSize(0);
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetMaxSize(max_size);
   SetKeySize(key_size);
+  SetLayout(layout);
+  SetLinked(linked);
+  if (linked) {
+    SetLevel(1);
+    SetRightPageId(INVALID_PAGE_ID);
+  }
   SetLSN(INVALID_LSN);
 }
+
+int InternalPage::Capacity(int key_size, bool linked) {
+  return (PAGE_SIZE - INTERNAL_PAGE_HEADER_SIZE - (linked ? key_size + 2 * sizeof(int) : 0)) /
+         (key_size + sizeof(page_id_t));
+}
+
 /*
- * Helper method to get/set the key associated with input "index"(a.k.a
- * array offset)
+ * Helper methods to get/set the level, the right link and the high key of a linked page, the entries never
+ * reach them
  */
-GenericKey *InternalPage::KeyAt(int index) {
-  return reinterpret_cast<GenericKey *>(pairs_off + index * pair_size + key_off);
+int InternalPage::GetLevel() const {
+  return *reinterpret_cast<const int *>(data_ + HighKeyOffset() - sizeof(page_id_t) - sizeof(int));
+}
+
+void InternalPage::SetLevel(int level) {
+  *reinterpret_cast<int *>(data_ + HighKeyOffset() - sizeof(page_id_t) - sizeof(int)) = level;
 }
 
-void InternalPage::SetKeyAt(int index, GenericKey *key) {
-  memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
+page_id_t InternalPage::GetRightPageId() const {
+  return *reinterpret_cast<const page_id_t *>(data_ + HighKeyOffset() - sizeof(page_id_t));
 }
 
+void InternalPage::SetRightPageId(page_id_t right_page_id) {
+  *reinterpret_cast<page_id_t *>(data_ + HighKeyOffset() - sizeof(page_id_t)) = right_page_id;
+}
+
+GenericKey *InternalPage::HighKey() { return reinterpret_cast<GenericKey *>(data_ + HighKeyOffset()); }
+
+void InternalPage::SetHighKey(const GenericKey *key) { memcpy(data_ + HighKeyOffset(), key, GetKeySize()); }
+
+int InternalPage::HighKeyOffset() const { return sizeof(data_) - GetKeySize(); }
+
+/*
+ * Helper method to get/set the key associated with input "index"(a.k.a
+ * array offset)
+ */
+GenericKey *InternalPage::KeyAt(int index) { return reinterpret_cast<GenericKey *>(data_ + KeyOffset(index)); }
+
+void InternalPage::SetKeyAt(int index, GenericKey *key) { memcpy(data_ + KeyOffset(index), key, GetKeySize()); }
+
 page_id_t InternalPage::ValueAt(int index) const {
-  return *reinterpret_cast<const page_id_t *>(pairs_off + index * pair_size + val_off);
+  return *reinterpret_cast<const page_id_t *>(data_ + ValueOffset(index));
 }
 
 void InternalPage::SetValueAt(int index, page_id_t value) {
-  *reinterpret_cast<page_id_t *>(pairs_off + index * pair_size + val_off) = value;
+  *reinterpret_cast<page_id_t *>(data_ + ValueOffset(index)) = value;
 }
 
 int InternalPage::ValueIndex(const page_id_t &value) const {
@@ -52,12 +84,24 @@ int InternalPage::ValueIndex(const page_id_t &value) const {
   return -1;
 }
 
-void *InternalPage::PairPtrAt(int index) {
-  return KeyAt(index);
+int InternalPage::KeyOffset(int index) const {
+  return GetLayout() == IndexPageLayout::kColumns ? index * GetKeySize() : index * pair_size;
 }
 
-void InternalPage::PairCopy(void *dest, void *src, int pair_num) {
-  memmove(dest, src, pair_num * (GetKeySize() + sizeof(page_id_t)));
+int InternalPage::ValueOffset(int index) const {
+  if (GetLayout() == IndexPageLayout::kColumns) {
+    return GetMaxSize() * GetKeySize() + index * sizeof(page_id_t);
+  }
+  return index * pair_size + GetKeySize();
+}
+
+void InternalPage::MoveEntries(int dest, int src, int size) {
+  if (GetLayout() == IndexPageLayout::kColumns) {
+    memmove(data_ + KeyOffset(dest), data_ + KeyOffset(src), size * GetKeySize());
+    memmove(data_ + ValueOffset(dest), data_ + ValueOffset(src), size * sizeof(page_id_t));
+  } else {
+    memmove(data_ + KeyOffset(dest), data_ + KeyOffset(src), size * pair_size);
+  }
 }
 /*****************************************************************************
  * LOOKUP
@@ -69,6 +113,9 @@ void InternalPage::PairCopy(void *dest, void *src, int pair_num) {
  * 用了二分查找
  */
 page_id_t InternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
+  if (GetLayout() == IndexPageLayout::kColumns && GetKeySize() == sizeof(uint64_t) && KM.IsWordKey()) {
+    return ValueAt(KM.SearchWords(data_ + KeyOffset(1), GetSize() - 1, key, true));
+  }
   int l = 1, r = GetSize();
   while (l < r) {
     int mid = (l + r) / 2;
@@ -79,13 +126,6 @@ page_id_t InternalPage::Lookup(const GenericKey *key, const KeyManager &KM) {
     }
   }
   return ValueAt(l - 1);
-  /*
-  int index = 1;
-  while(index < GetSize() && KM.CompareKeys(KeyAt(index), key) <= 0) {
-    index++;
-  }
-  DLOG(INFO) << "Lookup: " << index - 1;
-  return ValueAt(index - 1);*/
 }
 
 /*****************************************************************************
@@ -112,7 +152,7 @@ void InternalPage::PopulateNewRoot(const page_id_t &old_value, GenericKey *new_k
 int InternalPage::InsertNodeAfter(const page_id_t &old_value, GenericKey *new_key, const page_id_t &new_value) {
   auto size = GetSize();
   int index = ValueIndex(old_value);
-  PairCopy(pairs_off + (index + 2) * pair_size, pairs_off + (index + 1) * pair_size, size - index - 1);
+  MoveEntries(index + 2, index + 1, size - index - 1);
   SetKeyAt(index + 1, new_key);
   SetValueAt(index + 1, new_value);
   SetSize(size + 1);
@@ -129,7 +169,7 @@ int InternalPage::InsertNodeAfter(const page_id_t &old_value, GenericKey *new_ke
 void InternalPage::MoveHalfTo(InternalPage *recipient, BufferPoolManager *buffer_pool_manager) {
   auto size = GetSize();
   auto mid = size / 2;
-  recipient->CopyNFrom(pairs_off + mid * pair_size, size - mid, buffer_pool_manager);
+  recipient->CopyNFrom(this, mid, size - mid, buffer_pool_manager);
   SetSize(mid);
 }
 
@@ -139,10 +179,24 @@ void InternalPage::MoveHalfTo(InternalPage *recipient, BufferPoolManager *buffer
  *
  */
 // copy to end
-void InternalPage::CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool_manager) {
+void InternalPage::CopyNFrom(InternalPage *src, int index, int size, BufferPoolManager *buffer_pool_manager) {
   auto old_size = GetSize();
-  PairCopy(pairs_off + old_size * pair_size, src, size);
+  if (src->GetLayout() == GetLayout() && GetLayout() == IndexPageLayout::kPairs) {
+    memcpy(data_ + KeyOffset(old_size), src->data_ + src->KeyOffset(index), size * pair_size);
+  } else if (src->GetLayout() == GetLayout()) {
+    memcpy(data_ + KeyOffset(old_size), src->data_ + src->KeyOffset(index), size * GetKeySize());
+    memcpy(data_ + ValueOffset(old_size), src->data_ + src->ValueOffset(index), size * sizeof(page_id_t));
+  } else {
+    for (int i = 0; i < size; i++) {
+      SetKeyAt(old_size + i, src->KeyAt(index + i));
+      SetValueAt(old_size + i, src->ValueAt(index + i));
+    }
+  }
   SetSize(old_size + size);
+  // linked pages keep no parent page ids
+  if (buffer_pool_manager == nullptr) {
+    return;
+  }
   for (int i = old_size; i < GetSize(); ++i) {
     reinterpret_cast<BPlusTreePage *>(buffer_pool_manager->FetchPage(ValueAt(i))->GetData())->SetParentPageId(GetPageId());
     buffer_pool_manager->UnpinPage(ValueAt(i), true);
@@ -159,7 +213,7 @@ void InternalPage::CopyNFrom(void *src, int size, BufferPoolManager *buffer_pool
  */
 void InternalPage::Remove(int index) {
   auto size = GetSize();
-  PairCopy(pairs_off + index * pair_size, pairs_off + (index + 1) * pair_size, size - index - 1);
+  MoveEntries(index, index + 1, size - index - 1);
   SetSize(size - 1);
 }
 
@@ -168,7 +222,9 @@ void InternalPage::Remove(int index) {
  * NOTE: only call this method within AdjustRoot()(in b_plus_tree.cpp)
  */
 page_id_t InternalPage::RemoveAndReturnOnlyChild() {
-  return ValueAt(0);
+  auto only_child = ValueAt(0);
+  SetSize(0);
+  return only_child;
 }
 
 /*****************************************************************************
@@ -185,7 +241,7 @@ page_id_t InternalPage::RemoveAndReturnOnlyChild() {
 void InternalPage::MoveAllTo(InternalPage *recipient, GenericKey *middle_key, BufferPoolManager *buffer_pool_manager) {
   auto size = GetSize();
   auto reci_size = recipient->GetSize();
-  recipient->CopyNFrom(pairs_off, size, buffer_pool_manager);
+  recipient->CopyNFrom(this, 0, size, buffer_pool_manager);
   recipient->SetKeyAt(reci_size, middle_key);
   SetSize(0);
 }
@@ -240,7 +296,8 @@ void InternalPage::MoveLastToFrontOf(InternalPage *recipient, GenericKey *middle
 void InternalPage::CopyFirstFrom(const page_id_t value, BufferPoolManager *buffer_pool_manager) {
   // modify parent page id
   reinterpret_cast<BPlusTreePage *>(buffer_pool_manager->FetchPage(value)->GetData())->SetParentPageId(GetPageId());
-  PairCopy(pairs_off + pair_size, pairs_off, GetSize());
+  buffer_pool_manager->UnpinPage(value, true);
+  MoveEntries(1, 0, GetSize());
   SetSize(GetSize() + 1);
   SetValueAt(0, value);
 }
\ No newline at end of file
@@ -4,10 +4,7 @@
 
 #include "index/generic_key.h"
 
-#define pairs_off (data_)
 #define pair_size (GetKeySize() + sizeof(RowId))
-#define key_off 0
-#define val_off GetKeySize()
 /*****************************************************************************
  * HELPER METHODS AND UTILITIES
  *****************************************************************************/
@@ -18,17 +15,24 @@
  * next page id and set max size
  * 未初始化next_page_id
  */
-void LeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size) {
+void LeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size, int max_size, IndexPageLayout layout,
+                    bool linked) {
   SetPageId(page_id);
   SetParentPageId(parent_id);
   SetPageType(IndexPageType::LEAF_PAGE);
   SetSize(0);
   SetMaxSize(max_size);
   SetKeySize(key_size);
+  SetLayout(layout);
+  SetLinked(linked);
   SetNextPageId(INVALID_PAGE_ID);
   SetLSN(INVALID_LSN);
 }
 
+int LeafPage::Capacity(int key_size, bool linked) {
+  return (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE - (linked ? key_size : 0)) / (key_size + sizeof(RowId));
+}
+
 /**
  * Helper methods to set/get next page id
  */
@@ -41,60 +45,68 @@ void LeafPage::SetNextPageId(page_id_t next_page_id) {
   }
 }
 
+/*
+ * Helper methods to get/set the high key of a linked page, the entries never reach it
+ */
+GenericKey *LeafPage::HighKey() { return reinterpret_cast<GenericKey *>(data_ + HighKeyOffset()); }
+
+void LeafPage::SetHighKey(const GenericKey *key) { memcpy(data_ + HighKeyOffset(), key, GetKeySize()); }
+
+int LeafPage::HighKeyOffset() const { return sizeof(data_) - GetKeySize(); }
+
 /**
  * Helper method to find the first index i so that pairs_[i].first >= key
  * NOTE: This method is only used when generating index iterator
  * 二分查找
  */
 int LeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
-  /*
-  if (GetSize() == 1) {
-    return KM.CompareKeys(KeyAt(0), key) < 0 ? 1 : 0;
+  if (GetLayout() == IndexPageLayout::kColumns && GetKeySize() == sizeof(uint64_t) && KM.IsWordKey()) {
+    return KM.SearchWords(data_, GetSize(), key, false);
   }
-  int l = 0, r = GetSize() - 1, mid = (l + r) / 2;
-  while (l <= r) {
-    if (KM.CompareKeys(KeyAt(mid), key) == 0) {
-      return mid;
-    } else if (KM.CompareKeys(KeyAt(mid), key) < 0) {
+  int l = 0, r = GetSize();
+  while (l < r) {
+    int mid = (l + r) / 2;
+    if (KM.CompareKeys(KeyAt(mid), key) < 0) {
       l = mid + 1;
     } else {
-      r = mid - 1;
+      r = mid;
     }
-    mid = (l + r) / 2;
   }
-  return KM.CompareKeys(KeyAt(mid), key) < 0 ? mid + 1 : mid;*/
-  int index = 0;
-  while (index < GetSize() && KM.CompareKeys(KeyAt(index), key) < 0) {
-    index++;
+  return l;
+}
+
+int LeafPage::KeyOffset(int index) const {
+  return GetLayout() == IndexPageLayout::kColumns ? index * GetKeySize() : index * pair_size;
+}
+
+int LeafPage::ValueOffset(int index) const {
+  if (GetLayout() == IndexPageLayout::kColumns) {
+    return GetMaxSize() * GetKeySize() + index * sizeof(RowId);
   }
-  return index;
+  return index * pair_size + GetKeySize();
 }
 
 /*
  * Helper method to find and return the key associated with input "index"(a.k.a
  * array offset)
  */
-GenericKey *LeafPage::KeyAt(int index) {
-  return reinterpret_cast<GenericKey *>(pairs_off + index * pair_size + key_off);
-}
+GenericKey *LeafPage::KeyAt(int index) { return reinterpret_cast<GenericKey *>(data_ + KeyOffset(index)); }
 
-void LeafPage::SetKeyAt(int index, GenericKey *key) {
-  memcpy(pairs_off + index * pair_size + key_off, key, GetKeySize());
-}
-
-RowId LeafPage::ValueAt(int index) const {
-  return *reinterpret_cast<const RowId *>(pairs_off + index * pair_size + val_off);
-}
+void LeafPage::SetKeyAt(int index, GenericKey *key) { memcpy(data_ + KeyOffset(index), key, GetKeySize()); }
 
-void LeafPage::SetValueAt(int index, RowId value) {
-  *reinterpret_cast<RowId *>(pairs_off + index * pair_size + val_off) = value;
-}
+RowId LeafPage::ValueAt(int index) const { return *reinterpret_cast<const RowId *>(data_ + ValueOffset(index)); }
 
-void *LeafPage::PairPtrAt(int index) { return KeyAt(index); }
+void LeafPage::SetValueAt(int index, RowId value) { *reinterpret_cast<RowId *>(data_ + ValueOffset(index)) = value; }
 
-void LeafPage::PairCopy(void *dest, void *src, int pair_num) {
-  memcpy(dest, src, pair_num * (GetKeySize() + sizeof(RowId)));
+void LeafPage::MoveEntries(int dest, int src, int size) {
+  if (GetLayout() == IndexPageLayout::kColumns) {
+    memmove(data_ + KeyOffset(dest), data_ + KeyOffset(src), size * GetKeySize());
+    memmove(data_ + ValueOffset(dest), data_ + ValueOffset(src), size * sizeof(RowId));
+  } else {
+    memmove(data_ + KeyOffset(dest), data_ + KeyOffset(src), size * pair_size);
+  }
 }
+
 /*
  * Helper method to find and return the key & value pair associated with input
  * "index"(a.k.a. array offset)
@@ -110,7 +122,7 @@ std::pair<GenericKey *, RowId> LeafPage::GetItem(int index) { return {KeyAt(inde
  */
 int LeafPage::Insert(GenericKey *key, const RowId &value, const KeyManager &KM) {
   int index = KeyIndex(key, KM);
-  memmove(pairs_off + (index + 1) * pair_size, pairs_off + index * pair_size, (GetSize() - index) * pair_size);
+  MoveEntries(index + 1, index, GetSize() - index);
   SetKeyAt(index, key);
   SetValueAt(index, value);
   IncreaseSize(1);
@@ -126,7 +138,7 @@ int LeafPage::Insert(GenericKey *key, const RowId &value, const KeyManager &KM)
 void LeafPage::MoveHalfTo(LeafPage *recipient) {
   int size = GetSize();
   int mid = size / 2;
-  recipient->CopyNFrom(pairs_off + mid * pair_size, size - mid);
+  recipient->CopyNFrom(this, mid, size - mid);
   SetSize(mid);
 }
 
@@ -134,8 +146,18 @@ void LeafPage::MoveHalfTo(LeafPage *recipient) {
  * Copy starting from items, and copy {size} number of elements into me.
  */
 // copy to the end, used by movehalfto(split) and moveallto(merge)
-void LeafPage::CopyNFrom(void *src, int size) {
-  memcpy(pairs_off + GetSize() * pair_size, src, size * pair_size);
+void LeafPage::CopyNFrom(LeafPage *src, int index, int size) {
+  if (src->GetLayout() == GetLayout() && GetLayout() == IndexPageLayout::kPairs) {
+    memcpy(data_ + KeyOffset(GetSize()), src->data_ + src->KeyOffset(index), size * pair_size);
+  } else if (src->GetLayout() == GetLayout()) {
+    memcpy(data_ + KeyOffset(GetSize()), src->data_ + src->KeyOffset(index), size * GetKeySize());
+    memcpy(data_ + ValueOffset(GetSize()), src->data_ + src->ValueOffset(index), size * sizeof(RowId));
+  } else {
+    for (int i = 0; i < size; i++) {
+      SetKeyAt(GetSize() + i, src->KeyAt(index + i));
+      SetValueAt(GetSize() + i, src->ValueAt(index + i));
+    }
+  }
   IncreaseSize(size);
 }
 
@@ -168,7 +190,7 @@ bool LeafPage::Lookup(const GenericKey *key, RowId &value, const KeyManager &KM)
 int LeafPage::RemoveAndDeleteRecord(const GenericKey *key, const KeyManager &KM) {
   int index = KeyIndex(key, KM);
   if (index < GetSize() && KM.CompareKeys(KeyAt(index), key) == 0) {
-    memmove(pairs_off + index * pair_size, pairs_off + (index + 1) * pair_size, (GetSize() - index - 1) * pair_size);
+    MoveEntries(index, index + 1, GetSize() - index - 1);
     IncreaseSize(-1);
   }
   return GetSize();
@@ -183,7 +205,7 @@ int LeafPage::RemoveAndDeleteRecord(const GenericKey *key, const KeyManager &KM)
  */
 // recipient | node -> recipient
 void LeafPage::MoveAllTo(LeafPage *recipient) {
-  recipient->CopyNFrom(pairs_off, GetSize());
+  recipient->CopyNFrom(this, 0, GetSize());
   recipient->SetNextPageId(GetNextPageId());
   SetSize(0);
   SetNextPageId(INVALID_PAGE_ID);
@@ -198,7 +220,7 @@ void LeafPage::MoveAllTo(LeafPage *recipient) {
  */
 void LeafPage::MoveFirstToEndOf(LeafPage *recipient) {
   recipient->CopyLastFrom(KeyAt(0), ValueAt(0));
-  memmove(pairs_off, pairs_off + pair_size, (GetSize() - 1) * pair_size);
+  MoveEntries(0, 1, GetSize() - 1);
   IncreaseSize(-1);
 }
 
@@ -224,7 +246,7 @@ void LeafPage::MoveLastToFrontOf(LeafPage *recipient) {
  *
  */
 void LeafPage::CopyFirstFrom(GenericKey *key, const RowId value) {
-  memmove(pairs_off + pair_size, pairs_off, GetSize() * pair_size);
+  MoveEntries(1, 0, GetSize());
   SetKeyAt(0, key);
   SetValueAt(0, value);
   IncreaseSize(1);
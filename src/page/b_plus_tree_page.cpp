@@ -10,10 +10,30 @@ bool BPlusTreePage::IsRootPage() const { return parent_page_id_ == INVALID_PAGE_
 
 void BPlusTreePage::SetPageType(IndexPageType page_type) { page_type_ = page_type; }
 
-int BPlusTreePage::GetKeySize() const { return key_size_; }
+int BPlusTreePage::GetKeySize() const { return key_size_ & KEY_SIZE_MASK; }
 
+// the layout is reset to kPairs, the page to unlinked
 void BPlusTreePage::SetKeySize(int size) { key_size_ = size; }
 
+/*
+ * Helper methods to get/set the layout of the entries, kept in the high bits of the key size
+ */
+IndexPageLayout BPlusTreePage::GetLayout() const {
+  return static_cast<IndexPageLayout>((key_size_ >> LAYOUT_SHIFT) & LAYOUT_MASK);
+}
+
+void BPlusTreePage::SetLayout(IndexPageLayout layout) {
+  key_size_ = (key_size_ & ~(LAYOUT_MASK << LAYOUT_SHIFT)) | (static_cast<int>(layout) << LAYOUT_SHIFT);
+}
+
+/*
+ * Helper methods to get/set whether the page carries a high key and a right link, kept in the high bits of the
+ * key size as well
+ */
+bool BPlusTreePage::IsLinked() const { return (key_size_ & LINKED_FLAG) != 0; }
+
+void BPlusTreePage::SetLinked(bool linked) { key_size_ = linked ? key_size_ | LINKED_FLAG : key_size_ & ~LINKED_FLAG; }
+
 /*
  * Helper methods to get/set size (number of key/value pairs stored in that
  * page)
@@ -0,0 +1,149 @@
+#include "page/clustered_leaf_page.h"
+
+void ClusteredLeafPage::Init(page_id_t page_id, page_id_t parent_id, int key_size) {
+  SetPageType(IndexPageType::LEAF_PAGE);
+  SetSize(0);
+  SetPageId(page_id);
+  SetParentPageId(parent_id);
+  SetMaxSize(UNDEFINED_SIZE);
+  SetKeySize(key_size);
+  SetLSN(INVALID_LSN);
+  next_page_id_ = INVALID_PAGE_ID;
+  free_space_pointer_ = sizeof(data_);
+}
+
+uint32_t ClusteredLeafPage::GetMaxRowSize(int key_size) {
+  return (PAGE_SIZE - LEAF_PAGE_HEADER_SIZE) / 2 - (key_size + 2 * sizeof(uint32_t));
+}
+
+GenericKey *ClusteredLeafPage::KeyAt(int index) { return reinterpret_cast<GenericKey *>(SlotAt(index)); }
+
+int ClusteredLeafPage::KeyIndex(const GenericKey *key, const KeyManager &KM) {
+  int l = 0, r = GetSize();
+  while (l < r) {
+    int mid = (l + r) / 2;
+    if (KM.CompareKeys(KeyAt(mid), key) < 0) {
+      l = mid + 1;
+    } else {
+      r = mid;
+    }
+  }
+  return l;
+}
+
+void ClusteredLeafPage::GetRow(int index, Row *row, Schema *schema) {
+  ASSERT(index < GetSize(), "Invalid slot.");
+  RowId rid = row->GetRowId();
+  row->DeserializeFrom(data_ + GetRowOffset(index), schema);
+  row->SetRowId(rid);
+}
+
+uint32_t ClusteredLeafPage::GetFreeSpaceRemaining() const { return free_space_pointer_ - GetSize() * GetSlotSize(); }
+
+bool ClusteredLeafPage::Insert(int index, GenericKey *key, const Row &row, Schema *schema) {
+  uint32_t row_size = row.GetSerializedSize(schema);
+  if (GetFreeSpaceRemaining() < row_size + GetSlotSize()) {
+    return false;
+  }
+  free_space_pointer_ -= row_size;
+  row.SerializeTo(data_ + free_space_pointer_, schema);
+  memmove(SlotAt(index + 1), SlotAt(index), (GetSize() - index) * GetSlotSize());
+  memcpy(SlotAt(index), key, GetKeySize());
+  SetRowOffset(index, free_space_pointer_);
+  SetSlotRowSize(index, row_size);
+  IncreaseSize(1);
+  return true;
+}
+
+bool ClusteredLeafPage::Update(int index, const Row &row, Schema *schema) {
+  uint32_t row_size = row.GetSerializedSize(schema);
+  if (GetFreeSpaceRemaining() + GetRowSize(index) < row_size) {
+    return false;
+  }
+  FreeRowSpace(index);
+  free_space_pointer_ -= row_size;
+  row.SerializeTo(data_ + free_space_pointer_, schema);
+  SetRowOffset(index, free_space_pointer_);
+  SetSlotRowSize(index, row_size);
+  return true;
+}
+
+void ClusteredLeafPage::FreeRowSpace(int index) {
+  uint32_t offset = GetRowOffset(index);
+  uint32_t row_size = GetRowSize(index);
+  memmove(data_ + free_space_pointer_ + row_size, data_ + free_space_pointer_, offset - free_space_pointer_);
+  free_space_pointer_ += row_size;
+  for (int i = 0; i < GetSize(); i++) {
+    if (i != index && GetRowOffset(i) < offset) {
+      SetRowOffset(i, GetRowOffset(i) + row_size);
+    }
+  }
+  SetSlotRowSize(index, GetSlotRowSize(index) & DELETE_MASK);
+}
+
+void ClusteredLeafPage::Remove(int index) {
+  FreeRowSpace(index);
+  memmove(SlotAt(index), SlotAt(index + 1), (GetSize() - index - 1) * GetSlotSize());
+  IncreaseSize(-1);
+}
+
+uint32_t ClusteredLeafPage::RemoveDeleted() {
+  uint32_t reclaimed = 0;
+  int size = 0;
+  for (int i = 0; i < GetSize(); i++) {
+    if (IsDeleted(i)) {
+      reclaimed += GetRowSize(i) + GetSlotSize();
+      continue;
+    }
+    if (size != i) {
+      memcpy(SlotAt(size), SlotAt(i), GetSlotSize());
+    }
+    size++;
+  }
+  SetSize(size);
+  Compact();
+  return reclaimed;
+}
+
+void ClusteredLeafPage::CopyLastFrom(GenericKey *key, const char *row, uint32_t slot_row_size) {
+  uint32_t row_size = slot_row_size & ~DELETE_MASK;
+  ASSERT(GetFreeSpaceRemaining() >= row_size + GetSlotSize(), "Not enough space to move the row.");
+  free_space_pointer_ -= row_size;
+  memcpy(data_ + free_space_pointer_, row, row_size);
+  int index = GetSize();
+  memcpy(SlotAt(index), key, GetKeySize());
+  SetRowOffset(index, free_space_pointer_);
+  SetSlotRowSize(index, slot_row_size);
+  IncreaseSize(1);
+}
+
+void ClusteredLeafPage::Compact() {
+  char buf[sizeof(data_)];
+  uint32_t free_space_pointer = sizeof(data_);
+  for (int i = 0; i < GetSize(); i++) {
+    uint32_t row_size = GetRowSize(i);
+    free_space_pointer -= row_size;
+    memcpy(buf + free_space_pointer, data_ + GetRowOffset(i), row_size);
+    SetRowOffset(i, free_space_pointer);
+  }
+  memcpy(data_ + free_space_pointer, buf + free_space_pointer, sizeof(data_) - free_space_pointer);
+  free_space_pointer_ = free_space_pointer;
+}
+
+void ClusteredLeafPage::MoveHalfTo(ClusteredLeafPage *recipient) {
+  int size = GetSize();
+  int mid = size / 2;
+  for (int i = mid; i < size; i++) {
+    recipient->CopyLastFrom(KeyAt(i), data_ + GetRowOffset(i), GetSlotRowSize(i));
+  }
+  SetSize(mid);
+  Compact();
+}
+
+void ClusteredLeafPage::MoveAllTo(ClusteredLeafPage *recipient) {
+  for (int i = 0; i < GetSize(); i++) {
+    recipient->CopyLastFrom(KeyAt(i), data_ + GetRowOffset(i), GetSlotRowSize(i));
+  }
+  SetSize(0);
+  free_space_pointer_ = sizeof(data_);
+}
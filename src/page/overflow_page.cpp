@@ -0,0 +1,10 @@
+#include "page/overflow_page.h"
+
+#include "common/macros.h"
+
+void OverflowPage::Init(page_id_t next_page_id, const char *data, uint32_t size) {
+  ASSERT(size <= SIZE_MAX_DATA, "Overflow data exceeds page size.");
+  memcpy(GetData() + OFFSET_NEXT_PAGE_ID, &next_page_id, sizeof(page_id_t));
+  memcpy(GetData() + OFFSET_DATA_SIZE, &size, sizeof(uint32_t));
+  memcpy(GetData() + SIZE_OVERFLOW_PAGE_HEADER, data, size);
+}
@@ -0,0 +1,245 @@
+#include "page/pax_page.h"
+
+uint32_t PaxPage::GetValueWidth(const Column *column) {
+  if (column->GetType() == TypeId::kTypeChar) {
+    return sizeof(uint32_t) + column->GetLength();
+  }
+  return Type::GetTypeSize(column->GetType());
+}
+
+uint32_t PaxPage::ComputeCapacity(const Schema *schema) {
+  auto page_size_for = [schema](uint32_t capacity) {
+    uint64_t size = SIZE_PAX_PAGE_HEADER + capacity;
+    for (auto column : schema->GetColumns()) {
+      size += GetNullBitmapSize(capacity) + static_cast<uint64_t>(capacity) * GetValueWidth(column);
+    }
+    return size;
+  };
+  uint64_t row_width = 1;
+  for (auto column : schema->GetColumns()) {
+    row_width += GetValueWidth(column);
+  }
+  // start from the estimate without null bitmaps, then shrink until everything fits
+  auto capacity = static_cast<uint32_t>((PAGE_SIZE - SIZE_PAX_PAGE_HEADER) / row_width);
+  while (capacity > 0 && page_size_for(capacity) > PAGE_SIZE) {
+    capacity--;
+  }
+  return capacity;
+}
+
+void PaxPage::Init(page_id_t page_id, page_id_t prev_id, Schema *schema, [[maybe_unused]] LogManager *log_mgr,
+                   [[maybe_unused]] Txn *txn) {
+  memcpy(GetData(), &page_id, sizeof(page_id));
+  SetPrevPageId(prev_id);
+  SetNextPageId(INVALID_PAGE_ID);
+  SetTupleCount(0);
+  uint32_t capacity = ComputeCapacity(schema);
+  ASSERT(capacity > 0, "Tuple is too large for a pax page.");
+  SetCapacity(capacity);
+  memset(GetData() + SIZE_PAX_PAGE_HEADER, 0, PAGE_SIZE - SIZE_PAX_PAGE_HEADER);
+}
+
+uint32_t PaxPage::GetMinipageOffset(Schema *schema, uint32_t column_index) {
+  uint32_t capacity = GetCapacity();
+  uint32_t offset = SIZE_PAX_PAGE_HEADER + capacity;
+  for (uint32_t i = 0; i < column_index; i++) {
+    offset += GetNullBitmapSize(capacity) + capacity * GetValueWidth(schema->GetColumn(i));
+  }
+  return offset;
+}
+
+bool PaxPage::FitsColumns(const Row &row, Schema *schema) {
+  ASSERT(row.GetFieldCount() == schema->GetColumnCount(), "Fields size do not match schema's column size.");
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    auto field = row.GetField(i);
+    if (field->GetTypeId() == TypeId::kTypeChar && !field->IsNull() &&
+        field->GetLength() > schema->GetColumn(i)->GetLength()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void PaxPage::WriteTuple(const Row &row, Schema *schema, uint32_t slot_num) {
+  uint32_t capacity = GetCapacity();
+  uint32_t offset = SIZE_PAX_PAGE_HEADER + capacity;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    uint32_t width = GetValueWidth(schema->GetColumn(i));
+    char *null_bitmap = GetData() + offset;
+    char *value = null_bitmap + GetNullBitmapSize(capacity) + slot_num * width;
+    auto field = row.GetField(i);
+    if (field->IsNull()) {
+      null_bitmap[slot_num / 8] |= static_cast<char>(1 << (slot_num % 8));
+    } else {
+      null_bitmap[slot_num / 8] &= static_cast<char>(~(1 << (slot_num % 8)));
+      field->SerializeTo(value);
+    }
+    offset += GetNullBitmapSize(capacity) + capacity * width;
+  }
+}
+
+bool PaxPage::InsertTuple(Row &row, Schema *schema, [[maybe_unused]] Txn *txn,
+                          [[maybe_unused]] LockManager *lock_manager, [[maybe_unused]] LogManager *log_manager) {
+  if (GetFreeSlotCount() == 0 || !FitsColumns(row, schema)) {
+    return false;
+  }
+  uint32_t i;
+  for (i = 0; i < GetCapacity(); i++) {
+    if (GetSlotState(i) == kSlotEmpty) {
+      break;
+    }
+  }
+  ASSERT(i < GetCapacity(), "Free slot count does not match slot states.");
+  WriteTuple(row, schema, i);
+  SetSlotState(i, kSlotLive);
+  SetTupleCount(GetTupleCount() + 1);
+  row.SetRowId(RowId(GetTablePageId(), i));
+  return true;
+}
+
+bool PaxPage::MarkDelete(const RowId &rid, [[maybe_unused]] Txn *txn, [[maybe_unused]] LockManager *lock_manager,
+                         [[maybe_unused]] LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetCapacity() || GetSlotState(slot_num) != kSlotLive) {
+    return false;
+  }
+  SetSlotState(slot_num, kSlotDeleted);
+  return true;
+}
+
+bool PaxPage::UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn, LockManager *lock_manager,
+                          [[maybe_unused]] LogManager *log_manager) {
+  ASSERT(old_row != nullptr && old_row->GetRowId().Get() != INVALID_ROWID.Get(), "invalid old row.");
+  uint32_t slot_num = old_row->GetRowId().GetSlotNum();
+  if (slot_num >= GetCapacity() || GetSlotState(slot_num) != kSlotLive || !FitsColumns(new_row, schema)) {
+    return false;
+  }
+  // Copy out the old value.
+  GetTuple(old_row, schema, txn, lock_manager);
+  WriteTuple(new_row, schema, slot_num);
+  return true;
+}
+
+void PaxPage::ApplyDelete(const RowId &rid, [[maybe_unused]] Txn *txn, [[maybe_unused]] LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  ASSERT(slot_num < GetCapacity(), "Cannot have more slots than capacity.");
+  if (GetSlotState(slot_num) == kSlotEmpty) {
+    return;
+  }
+  SetSlotState(slot_num, kSlotEmpty);
+  SetTupleCount(GetTupleCount() - 1);
+}
+
+void PaxPage::RollbackDelete(const RowId &rid, [[maybe_unused]] Txn *txn, [[maybe_unused]] LogManager *log_manager) {
+  uint32_t slot_num = rid.GetSlotNum();
+  ASSERT(slot_num < GetCapacity(), "Cannot have more slots than capacity.");
+  if (GetSlotState(slot_num) == kSlotDeleted) {
+    SetSlotState(slot_num, kSlotLive);
+  }
+}
+
+bool PaxPage::GetTuple(Row *row, Schema *schema, [[maybe_unused]] Txn *txn,
+                       [[maybe_unused]] LockManager *lock_manager) {
+  ASSERT(row != nullptr && row->GetRowId().Get() != INVALID_ROWID.Get(), "Invalid row.");
+  ASSERT(row->GetFieldCount() == 0, "Non empty field in row.");
+  uint32_t slot_num = row->GetRowId().GetSlotNum();
+  if (slot_num >= GetCapacity() || GetSlotState(slot_num) != kSlotLive) {
+    return false;
+  }
+  uint32_t capacity = GetCapacity();
+  uint32_t offset = SIZE_PAX_PAGE_HEADER + capacity;
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto column = schema->GetColumn(i);
+    uint32_t width = GetValueWidth(column);
+    char *null_bitmap = GetData() + offset;
+    Field *field;
+    Field::DeserializeFrom(null_bitmap + GetNullBitmapSize(capacity) + slot_num * width, column->GetType(), &field,
+                           null_bitmap[slot_num / 8] & (1 << (slot_num % 8)));
+    row->GetFields().push_back(field);
+    offset += GetNullBitmapSize(capacity) + capacity * width;
+  }
+  return true;
+}
+
+bool PaxPage::GetFirstTupleRid(RowId *first_rid) {
+  for (uint32_t i = 0; i < GetCapacity(); i++) {
+    if (GetSlotState(i) == kSlotLive) {
+      first_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  first_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
+
+bool PaxPage::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
+  ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
+  for (auto i = cur_rid.GetSlotNum() + 1; i < GetCapacity(); i++) {
+    if (GetSlotState(i) == kSlotLive) {
+      next_rid->Set(GetTablePageId(), i);
+      return true;
+    }
+  }
+  next_rid->Set(INVALID_PAGE_ID, 0);
+  return false;
+}
+
+void PaxPage::GetLiveSlots(std::vector<uint32_t> *slots) {
+  for (uint32_t i = 0; i < GetCapacity(); i++) {
+    if (GetSlotState(i) == kSlotLive) {
+      slots->push_back(i);
+    }
+  }
+}
+
+void PaxPage::GetColumn(Schema *schema, uint32_t column_index, const std::vector<uint32_t> &slots,
+                        std::vector<Field> *values) {
+  auto column = schema->GetColumn(column_index);
+  uint32_t width = GetValueWidth(column);
+  char *null_bitmap = GetData() + GetMinipageOffset(schema, column_index);
+  char *minipage = null_bitmap + GetNullBitmapSize(GetCapacity());
+  values->reserve(values->size() + slots.size());
+  for (auto slot_num : slots) {
+    if (null_bitmap[slot_num / 8] & (1 << (slot_num % 8))) {
+      values->emplace_back(column->GetType());
+      continue;
+    }
+    char *value = minipage + slot_num * width;
+    switch (column->GetType()) {
+      case TypeId::kTypeInt:
+        values->emplace_back(TypeId::kTypeInt, MACH_READ_INT32(value));
+        break;
+      case TypeId::kTypeFloat:
+        values->emplace_back(TypeId::kTypeFloat, MACH_READ_FROM(float_t, value));
+        break;
+      case TypeId::kTypeBigInt:
+      case TypeId::kTypeTimestamp:
+        values->emplace_back(column->GetType(), MACH_READ_FROM(int64_t, value));
+        break;
+      case TypeId::kTypeDouble:
+        values->emplace_back(TypeId::kTypeDouble, MACH_READ_FROM(double, value));
+        break;
+      case TypeId::kTypeChar:
+        values->emplace_back(TypeId::kTypeChar, value + sizeof(uint32_t), MACH_READ_UINT32(value), true);
+        break;
+      default:
+        ASSERT(false, "Unsupported column type.");
+    }
+  }
+}
+
+uint32_t PaxPage::Vacuum(Schema *schema, [[maybe_unused]] Txn *txn, [[maybe_unused]] LogManager *log_manager) {
+  uint32_t row_width = 1;
+  for (auto column : schema->GetColumns()) {
+    row_width += GetValueWidth(column);
+  }
+  uint32_t reclaimed = 0;
+  for (uint32_t i = 0; i < GetCapacity(); i++) {
+    if (GetSlotState(i) == kSlotDeleted) {
+      SetSlotState(i, kSlotEmpty);
+      SetTupleCount(GetTupleCount() - 1);
+      reclaimed += row_width;
+    }
+  }
+  return reclaimed;
+}
@@ -1,5 +1,8 @@
 #include "page/table_page.h"
 
+#include <algorithm>
+#include <vector>
+
 void TablePage::Init(page_id_t page_id, page_id_t prev_id, LogManager *log_mgr, Txn *txn) {
   memcpy(GetData(), &page_id, sizeof(page_id));
   SetPrevPageId(prev_id);
@@ -68,11 +71,12 @@ bool TablePage::UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn
   if (slot_num >= GetTupleCount()) {
     return false;
   }
-  uint32_t tuple_size = GetTupleSize(slot_num);
-  // If the tuple is deleted, abort.
-  if (IsDeleted(tuple_size)) {
+  uint32_t tuple_flags = GetTupleSize(slot_num);
+  // If the tuple is deleted or only forwards to the tuple, abort.
+  if (IsDeleted(tuple_flags) || IsForward(tuple_flags)) {
     return false;
   }
+  uint32_t tuple_size = GetTupleLength(tuple_flags);
   // If there is not enough space to update, we need to update via delete followed by an insert (not enough space).
   if (GetFreeSpaceRemaining() + tuple_size < serialized_size) {
     return false;
@@ -87,7 +91,7 @@ bool TablePage::UpdateTuple(Row &new_row, Row *old_row, Schema *schema, Txn *txn
           tuple_offset - free_space_pointer);
   SetFreeSpacePointer(free_space_pointer + tuple_size - serialized_size);
   new_row.SerializeTo(GetData() + tuple_offset + tuple_size - serialized_size, schema);
-  SetTupleSize(slot_num, serialized_size);
+  SetTupleSize(slot_num, (tuple_flags & MOVED_MASK) | serialized_size);
 
   // Update all tuple offsets.
   for (uint32_t i = 0; i < GetTupleCount(); ++i) {
@@ -104,11 +108,8 @@ void TablePage::ApplyDelete(const RowId &rid, Txn *txn, LogManager *log_manager)
   ASSERT(slot_num < GetTupleCount(), "Cannot have more slots than tuples.");
 
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
-  uint32_t tuple_size = GetTupleSize(slot_num);
-  // Check if this is a delete operation, i.e. commit a delete.
-  if (IsDeleted(tuple_size)) {
-    tuple_size = UnsetDeletedFlag(tuple_size);
-  }
+  // Drop the delete mark and the other flags, the slot is emptied anyway.
+  uint32_t tuple_size = GetTupleLength(GetTupleSize(slot_num));
 
   uint32_t free_space_pointer = GetFreeSpacePointer();
   ASSERT(tuple_offset >= free_space_pointer, "Free space appears before tuples.");
@@ -149,10 +150,11 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   }
   // Otherwise get the current tuple size too.
   uint32_t tuple_size = GetTupleSize(slot_num);
-  // If the tuple is deleted, abort the recovery.
-  if (IsDeleted(tuple_size)) {
+  // If the tuple is deleted or stored elsewhere, abort the recovery.
+  if (IsDeleted(tuple_size) || IsForward(tuple_size)) {
     return false;
   }
+  tuple_size = GetTupleLength(tuple_size);
   // At this point, we have at least a shared lock on the RID. Copy the tuple data into our result.
   uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
   uint32_t __attribute__((unused)) read_bytes = row->DeserializeFrom(GetData() + tuple_offset, schema);
@@ -160,10 +162,22 @@ bool TablePage::GetTuple(Row *row, Schema *schema, Txn *txn, LockManager *lock_m
   return true;
 }
 
+char *TablePage::GetTupleData(uint32_t slot_num) {
+  if (slot_num >= GetTupleCount()) {
+    return nullptr;
+  }
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  if (IsDeleted(tuple_size) || IsForward(tuple_size)) {
+    return nullptr;
+  }
+  return GetData() + GetTupleOffsetAtSlot(slot_num);
+}
+
 bool TablePage::GetFirstTupleRid(RowId *first_rid) {
   // Find and return the first valid tuple.
   for (uint32_t i = 0; i < GetTupleCount(); i++) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    // A moved tuple is visited through its forwarding slot.
+    if (!IsDeleted(GetTupleSize(i)) && !IsMoved(GetTupleSize(i))) {
       first_rid->Set(GetTablePageId(), i);
       return true;
     }
@@ -176,7 +190,7 @@ bool TablePage::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
   ASSERT(cur_rid.GetPageId() == GetTablePageId(), "Wrong table!");
   // Find and return the first valid tuple after our current slot number.
   for (auto i = cur_rid.GetSlotNum() + 1; i < GetTupleCount(); i++) {
-    if (!IsDeleted(GetTupleSize(i))) {
+    if (!IsDeleted(GetTupleSize(i)) && !IsMoved(GetTupleSize(i))) {
       next_rid->Set(GetTablePageId(), i);
       return true;
     }
@@ -185,3 +199,120 @@ bool TablePage::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
   next_rid->Set(INVALID_PAGE_ID, 0);
   return false;
 }
+
+uint32_t TablePage::Vacuum([[maybe_unused]] Txn *txn, [[maybe_unused]] LogManager *log_manager) {
+  uint32_t free_space_before = GetFreeSpaceRemaining();
+  // Collect the live tuples, ordered by their position in the page (from the end of the page).
+  std::vector<std::pair<uint32_t, uint32_t>> live_tuples;  // (offset, slot)
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    if (IsDeleted(tuple_size)) {
+      SetTupleSize(i, 0);
+      SetTupleOffsetAtSlot(i, 0);
+    } else {
+      live_tuples.emplace_back(GetTupleOffsetAtSlot(i), i);
+    }
+  }
+  std::sort(live_tuples.begin(), live_tuples.end(), std::greater<>());
+  // Slide every live tuple towards the end of the page, the destination never goes below the source.
+  uint32_t free_space_pointer = PAGE_SIZE;
+  for (auto &tuple : live_tuples) {
+    uint32_t tuple_size = GetTupleLength(GetTupleSize(tuple.second));
+    free_space_pointer -= tuple_size;
+    if (free_space_pointer != tuple.first) {
+      memmove(GetData() + free_space_pointer, GetData() + tuple.first, tuple_size);
+      SetTupleOffsetAtSlot(tuple.second, free_space_pointer);
+    }
+  }
+  SetFreeSpacePointer(free_space_pointer);
+  // Trailing empty slots can be dropped without changing any RowId.
+  uint32_t tuple_count = GetTupleCount();
+  while (tuple_count > 0 && GetTupleSize(tuple_count - 1) == 0) {
+    tuple_count--;
+  }
+  SetTupleCount(tuple_count);
+  return GetFreeSpaceRemaining() - free_space_before;
+}
+
+uint32_t TablePage::ConvertTuples(Schema *from, Schema *to) {
+  uint32_t free_space_before = GetFreeSpaceRemaining();
+  for (uint32_t i = 0; i < GetTupleCount(); i++) {
+    uint32_t tuple_size = GetTupleSize(i);
+    // Empty and forwarding slots hold no tuple, a tuple marked as deleted is converted as well.
+    if (tuple_size == 0 || IsForward(tuple_size)) {
+      continue;
+    }
+    Row row;
+    row.DeserializeFrom(GetData() + GetTupleOffsetAtSlot(i), from);
+    uint32_t new_length = row.GetSerializedSize(to);
+    ASSERT(new_length <= GetTupleLength(tuple_size), "A converted tuple must not grow.");
+    ResizeTuple(i, new_length);
+    row.SerializeTo(GetData() + GetTupleOffsetAtSlot(i), to);
+  }
+  return GetFreeSpaceRemaining() - free_space_before;
+}
+
+bool TablePage::GetForward(const RowId &rid, RowId *target) {
+  uint32_t slot_num = rid.GetSlotNum();
+  if (slot_num >= GetTupleCount() || !IsForward(GetTupleSize(slot_num))) {
+    return false;
+  }
+  *target = RowId(MACH_READ_FROM(int64_t, GetData() + GetTupleOffsetAtSlot(slot_num)));
+  return true;
+}
+
+void TablePage::SetForward(uint32_t slot_num, const RowId &target, Row *old_row, Schema *schema) {
+  uint32_t tuple_size = GetTupleSize(slot_num);
+  ASSERT(!IsDeleted(tuple_size) && !IsForward(tuple_size), "Only a live tuple can be forwarded.");
+  uint32_t __attribute__((unused)) read_bytes =
+      old_row->DeserializeFrom(GetData() + GetTupleOffsetAtSlot(slot_num), schema);
+  ASSERT(GetTupleLength(tuple_size) == read_bytes, "Unexpected behavior in tuple deserialize.");
+  // A serialized row holds at least 8 bytes in any tuple format, so the forwarding slot never grows the tuple.
+  ResizeTuple(slot_num, SIZE_FORWARD);
+  SetTupleSize(slot_num, FORWARD_MASK | SIZE_FORWARD);
+  ResetForward(slot_num, target);
+}
+
+void TablePage::ResetForward(uint32_t slot_num, const RowId &target) {
+  ASSERT(IsForward(GetTupleSize(slot_num)), "Not a forwarding slot.");
+  MACH_WRITE_TO(int64_t, GetData() + GetTupleOffsetAtSlot(slot_num), target.Get());
+}
+
+void TablePage::CopyTupleFrom(TablePage *page, uint32_t slot_num, RowId *rid) {
+  uint32_t tuple_size = page->GetTupleSize(slot_num);
+  uint32_t length = GetTupleLength(tuple_size);
+  ASSERT(GetFreeSpaceRemaining() >= length + SIZE_TUPLE, "Not enough space to copy the tuple.");
+  uint32_t i;
+  for (i = 0; i < GetTupleCount(); i++) {
+    if (GetTupleSize(i) == 0) {
+      break;
+    }
+  }
+  SetFreeSpacePointer(GetFreeSpacePointer() - length);
+  memcpy(GetData() + GetFreeSpacePointer(), page->GetData() + page->GetTupleOffsetAtSlot(slot_num), length);
+  SetTupleOffsetAtSlot(i, GetFreeSpacePointer());
+  SetTupleSize(i, tuple_size);
+  if (i == GetTupleCount()) {
+    SetTupleCount(GetTupleCount() + 1);
+  }
+  rid->Set(GetTablePageId(), i);
+}
+
+void TablePage::ResizeTuple(uint32_t slot_num, uint32_t new_length) {
+  uint32_t tuple_offset = GetTupleOffsetAtSlot(slot_num);
+  uint32_t tuple_size = GetTupleLength(GetTupleSize(slot_num));
+  ASSERT(GetFreeSpaceRemaining() + tuple_size >= new_length, "Not enough space to resize the tuple.");
+  // The end of the tuple stays in place, the tuples below it follow its start.
+  uint32_t free_space_pointer = GetFreeSpacePointer();
+  memmove(GetData() + free_space_pointer + tuple_size - new_length, GetData() + free_space_pointer,
+          tuple_offset - free_space_pointer);
+  SetFreeSpacePointer(free_space_pointer + tuple_size - new_length);
+  for (uint32_t i = 0; i < GetTupleCount(); ++i) {
+    uint32_t tuple_offset_i = GetTupleOffsetAtSlot(i);
+    if (GetTupleSize(i) > 0 && tuple_offset_i <= tuple_offset) {
+      SetTupleOffsetAtSlot(i, tuple_offset_i + tuple_size - new_length);
+    }
+  }
+  uint32_t flags = GetTupleSize(slot_num) - tuple_size;
+  SetTupleSize(slot_num, flags | new_length);
+}
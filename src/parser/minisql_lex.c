@@ -374,8 +374,8 @@ static void yy_fatal_error (yyconst char msg[]  );
 	*yy_cp = '\0'; \
 	(yy_c_buf_p) = yy_cp;
 
-#define YY_NUM_RULES 56
-#define YY_END_OF_BUFFER 57
+#define YY_NUM_RULES 61
+#define YY_END_OF_BUFFER 62
 /* This struct is not used in this scanner,
    but its presence is necessary. */
 struct yy_trans_info
@@ -383,182 +383,221 @@ struct yy_trans_info
 	flex_int32_t yy_verify;
 	flex_int32_t yy_nxt;
 	};
-static yyconst flex_int16_t yy_accept[175] =
+static yyconst flex_int16_t yy_accept[204] =
     {   0,
-       41,   41,   57,   55,   54,   54,   55,   49,   52,   53,
-       47,   46,   41,   55,   41,   48,   50,   42,   51,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,    0,    1,
-        0,    0,   41,   40,   44,   43,   45,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       37,   39,   39,   39,   22,   35,   39,   39,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   34,   39,   39,
-       39,   39,   39,   39,   39,   39,   39,   39,   39,   39,
-       32,   29,   36,   39,   39,   39,   39,   39,   26,   39,
-
-       39,   39,   39,   14,   39,   39,   39,   39,   31,   39,
-       39,   39,   39,    3,   39,   39,   23,   39,   39,   25,
-       38,   39,   11,   39,   39,   13,   39,   39,   39,   39,
-       39,   39,    8,   39,   39,   39,   39,   39,   33,   20,
-       39,   39,   39,   39,   18,   39,   39,   15,   39,   24,
-        9,    2,   39,    6,   39,   39,    5,   39,   39,    4,
-       19,   30,    7,   27,   39,   39,   21,   28,   39,   16,
-       12,   10,   17,    0
+    46,     46,     62,     60,     59,     59,     60,     54,     57,     58,
+    52,     51,     46,     60,     46,     53,     55,     47,     56,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,     44,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,      0,      1,
+     0,      0,     46,     45,     49,     48,     50,     44,     44,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,     44,     44,
+    44,     44,     44,     42,     44,     44,     44,     24,     40,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,     44,     44,
+    44,      0,     44,     39,     44,     44,     44,     44,     44,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,     34,     31,
+
+    41,     44,     44,     44,     44,     44,     28,     44,     44,     44,
+    44,     44,     16,     44,     44,     44,     44,     44,     44,     44,
+    33,     44,     44,     44,     44,     44,      3,     44,     44,     25,
+    44,     44,     27,     43,     44,     11,     44,     44,     15,     44,
+    44,     44,     44,     44,     44,     44,     44,     44,      8,     44,
+    44,     44,     44,     44,     44,     44,     35,     22,     44,     44,
+    44,     44,     20,     44,     44,     44,     17,     44,     44,     26,
+    44,     36,      9,      2,     44,      6,     37,     44,     44,      5,
+    44,     44,      4,     21,     44,     32,      7,     13,     29,     14,
+    44,     44,     23,     30,     44,     44,     18,     12,     10,     44,
+
+    19,     38,      0
     } ;
 
 static yyconst flex_int32_t yy_ec[256] =
     {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    2,    3,
-        2,    2,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    4,    1,    1,    1,    1,    5,    6,
-        7,    8,    1,    9,   10,   11,    1,   12,   12,   12,
-       12,   12,   12,   12,   12,   12,   12,    1,   13,   14,
-       15,   16,    1,    1,   17,   17,   17,   17,   17,   17,
-       17,   17,   17,   17,   17,   17,   17,   17,   17,   17,
-       17,   17,   17,   17,   17,   17,   17,   17,   17,   17,
-        1,   18,    1,    1,   17,    1,   19,   20,   21,   22,
-
-       23,   24,   25,   26,   27,   17,   28,   29,   30,   31,
-       32,   33,   34,   35,   36,   37,   38,   39,   40,   41,
-       42,   17,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1
+     1,      1,      1,      1,      1,      1,      1,      1,      2,      3,
+     2,      2,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      2,      1,      4,      1,      1,      1,      1,      5,      6,
+     7,      8,      1,      9,     10,     11,      1,     12,     12,     12,
+    12,     12,     12,     12,     12,     12,     12,      1,     13,     14,
+    15,     16,      1,      1,     17,     17,     17,     17,     17,     17,
+    17,     17,     17,     17,     17,     17,     17,     17,     17,     17,
+    17,     17,     17,     17,     17,     17,     17,     17,     17,     17,
+     1,     18,      1,      1,     17,      1,     19,     20,     21,     22,
+
+    23,     24,     25,     26,     27,     17,     28,     29,     30,     31,
+    32,     33,     34,     35,     36,     37,     38,     39,     40,     41,
+    42,     43,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1
     } ;
 
-static yyconst flex_int32_t yy_meta[43] =
+static yyconst flex_int32_t yy_meta[44] =
     {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    1,    1,    1,    1,    2,    1,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2,    2,    2,    2,    2,    2,    2,    2,    2,
-        2,    2
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1
     } ;
 
-static yyconst flex_int16_t yy_base[177] =
+static yyconst flex_int16_t yy_base[204] =
     {   0,
-        0,    0,  188,  189,  189,  189,   39,  189,  189,  189,
-      189,  189,   33,  175,   35,  189,   33,  189,  171,    0,
-      154,  161,   24,   32,  142,   23,   29,  159,   30,   35,
-      146,  142,  147,   38,  159,   38,  158,  150,   59,  189,
-      172,  162,   42,  161,  189,  189,  189,    0,  150,  146,
-      151,  139,  145,  130,  137,  133,  141,  131,  130,   50,
-        0,  119,  123,  130,    0,    0,  131,  130,  127,   44,
-      123,  134,  126,  130,   52,  122,  127,    0,  122,  113,
-      117,  127,  126,  121,  110,  121,  122,  110,  116,  115,
-      105,    0,    0,  107,  105,   97,  104,  109,    0,   91,
-
-      101,   95,  109,    0,   96,   88,   90,   93,    0,   96,
-       85,  101,   83,    0,   95,   81,    0,   76,   81,    0,
-        0,   96,    0,   94,   92,    0,   89,   73,   73,   84,
-       85,   84,    0,   69,   82,   85,   80,   75,    0,   78,
-       63,   64,   79,   60,   60,   72,   71,    0,   57,    0,
-        0,    0,   56,    0,   62,   54,    0,   43,   63,    0,
-        0,    0,    0,    0,   60,   59,    0,    0,   52,   42,
-        0,    0,    0,  189,   87,   74
+     0,      0,      0,    314,    314,    314,     43,    314,    314,    314,
+   314,    314,     76,     77,      0,    314,     75,    314,     77,     81,
+    63,     72,     99,    107,     55,     98,    101,     74,     97,    105,
+    93,    100,    109,    120,    125,    114,    129,    123,      0,    314,
+   152,      0,      0,      0,    314,    314,    314,      0,      0,    177,
+   126,    130,    178,    168,    177,    164,    173,    165,    172,    182,
+   174,    175,    186,      0,    167,    173,    182,      0,      0,    185,
+   186,    185,    187,    183,    197,    188,    192,    198,    198,    205,
+   204,      0,    199,      0,    202,    203,    196,    202,    214,    216,
+   213,    217,    205,    218,    221,    211,    219,    220,    212,      0,
+
+     0,    216,    216,    210,    219,    226,      0,    210,    222,    229,
+   219,    235,      0,    224,    218,    219,    223,    217,    229,    230,
+     0,    235,    226,    244,    228,    237,      0,    243,    231,      0,
+   228,    235,      0,      0,    252,      0,    252,    252,      0,    251,
+   239,    238,    240,    253,    241,    257,    258,    239,      0,    246,
+   247,    262,    267,    264,    265,    262,      0,    267,    254,    257,
+   274,    257,    259,    259,    274,    275,      0,    269,    264,      0,
+   278,      0,      0,      0,    266,      0,      0,    274,    268,      0,
+   263,    285,      0,      0,    288,      0,      0,      0,      0,      0,
+   285,    286,      0,      0,    282,    281,    276,      0,      0,    280,
+
+     0,      0,    314
     } ;
 
-static yyconst flex_int16_t yy_def[177] =
+static yyconst flex_int16_t yy_def[204] =
     {   0,
-      174,    1,  174,  174,  174,  174,  175,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  175,  174,
-      175,  174,  174,  174,  174,  174,  174,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,  176,  176,  176,  176,  176,  176,  176,
-      176,  176,  176,    0,  174,  174
+   203,      1,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,     13,    203,    203,    203,    203,    203,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,      7,    203,
+   203,     14,     13,     14,    203,    203,    203,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,      7,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+
+    20,     20,      0
     } ;
 
-static yyconst flex_int16_t yy_nxt[232] =
-    {   0,
-        4,    5,    6,    7,    8,    9,   10,   11,   12,   13,
-       14,   15,   16,   17,   18,   19,   20,    4,   21,   22,
-       23,   24,   25,   26,   20,   20,   27,   28,   20,   20,
-       29,   30,   31,   32,   33,   34,   35,   36,   37,   38,
-       20,   20,   40,   42,   43,   42,   43,   45,   46,   51,
-       54,   58,   42,   43,   55,   52,   41,   59,   53,   60,
-       70,   63,   40,   71,   61,   65,   56,   64,   73,   66,
-       74,   89,   98,   75,  104,   48,   41,  173,  105,  172,
-       99,  171,  170,  169,  168,   90,   91,   39,   39,  167,
-      166,  165,  164,  163,  162,  161,  160,  159,  158,  157,
-
-      156,  155,  154,  153,  152,  151,  150,  149,  148,  147,
-      146,  145,  144,  143,  142,  141,  140,  139,  138,  137,
-      136,  135,  134,  133,  132,  131,  130,  129,  128,  127,
-      126,  125,  124,  123,  122,  121,  120,  119,  118,  117,
-      116,  115,  114,  113,  112,  111,  110,  109,  108,  107,
-      106,  103,  102,  101,  100,   97,   96,   95,   94,   93,
-       92,   88,   87,   86,   85,   84,   83,   82,   81,   80,
-       79,   78,   44,   44,  174,   77,   76,   72,   69,   68,
-       67,   62,   57,   50,   49,   47,   44,  174,    3,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174
+static yyconst flex_int16_t yy_nxt[358] =
+    {   203,
+     4,      5,      6,      7,      8,      9,     10,     11,     12,     13,
+    14,     15,     16,     17,     18,     19,     20,      4,     21,     22,
+    23,     24,     25,     26,     20,     20,     27,     28,     20,     20,
+    29,     30,     31,     32,     33,     34,     35,     36,     37,     38,
+    20,     20,     20,     39,     39,     39,     40,     39,     39,     39,
+    39,     39,     39,     39,     39,     39,     39,     39,     39,     39,
+    41,     39,     39,     39,     39,     39,     39,     39,     39,     39,
+    39,     39,     39,     39,     39,     39,     39,     39,     39,     39,
+    39,     39,     39,     39,     39,     39,     42,     43,     44,     45,
+    46,     47,     48,     50,     51,     60,     65,     49,     52,     49,
+
+    49,     49,     49,     49,     49,     49,     49,     49,     49,     49,
+    49,     49,     49,     49,     49,     49,     49,     49,     49,     49,
+    49,     49,     49,     49,     53,     56,     61,     70,     66,     57,
+    54,     63,     62,     55,     67,     68,     64,     71,     58,     69,
+    72,     59,     73,     75,     77,     74,     78,     80,     81,     79,
+    85,     76,     82,     82,     86,     82,     82,     82,     82,     82,
+    82,     82,     82,     82,     82,     82,     82,     82,     82,     82,
+    82,     82,     82,     82,     82,     82,     82,     82,     82,     82,
+    82,     82,     82,     82,     82,     82,     82,     82,     82,     82,
+    82,     82,     82,     82,     82,     83,     87,     88,     84,     89,
+
+    90,     91,     92,     93,     94,     95,     96,     97,    100,    101,
+   102,    103,    104,    105,    108,    106,    109,    110,    111,    112,
+   113,     98,     99,    107,    114,    115,    117,    118,    119,    120,
+   121,    122,    123,    116,    124,    125,    126,    127,    128,    129,
+   130,    131,    132,    133,    134,    135,    136,    137,    138,    139,
+   140,    141,    142,    143,    144,    145,    146,    147,    148,    149,
+   150,    151,    152,    153,    154,    155,    156,    157,    158,    159,
+   160,    161,    162,    163,    164,    165,    166,    167,    168,    169,
+   170,    171,    172,    173,    174,    175,    176,    177,    178,    179,
+   180,    181,    182,    183,    184,    185,    186,    187,    188,    189,
+
+   190,    191,    192,    193,    194,    195,    196,    197,    198,    199,
+   200,    201,    202,      3,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203
     } ;
 
-static yyconst flex_int16_t yy_chk[232] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    7,   13,   13,   15,   15,   17,   17,   23,
-       24,   26,   43,   43,   24,   23,    7,   26,   23,   27,
-       34,   29,   39,   34,   27,   30,   24,   29,   36,   30,
-       36,   60,   70,   36,   75,  176,   39,  170,   75,  169,
-       70,  166,  165,  159,  158,   60,   60,  175,  175,  156,
-      155,  153,  149,  147,  146,  145,  144,  143,  142,  141,
-
-      140,  138,  137,  136,  135,  134,  132,  131,  130,  129,
-      128,  127,  125,  124,  122,  119,  118,  116,  115,  113,
-      112,  111,  110,  108,  107,  106,  105,  103,  102,  101,
-      100,   98,   97,   96,   95,   94,   91,   90,   89,   88,
-       87,   86,   85,   84,   83,   82,   81,   80,   79,   77,
-       76,   74,   73,   72,   71,   69,   68,   67,   64,   63,
-       62,   59,   58,   57,   56,   55,   54,   53,   52,   51,
-       50,   49,   44,   42,   41,   38,   37,   35,   33,   32,
-       31,   28,   25,   22,   21,   19,   14,    3,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174,  174,  174,  174,  174,  174,  174,  174,  174,  174,
-      174
+static yyconst flex_int16_t yy_chk[358] =
+    {   3,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      1,      1,      1,      1,      1,      1,      1,
+     1,      1,      1,      7,      7,      7,      7,      7,      7,      7,
+     7,      7,      7,      7,      7,      7,      7,      7,      7,      7,
+     7,      7,      7,      7,      7,      7,      7,      7,      7,      7,
+     7,      7,      7,      7,      7,      7,      7,      7,      7,      7,
+     7,      7,      7,      7,      7,      7,     13,     13,     14,     17,
+    17,     19,     20,     21,     22,     25,     28,     20,     22,     20,
+
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     20,     20,     20,     20,     20,     20,
+    20,     20,     20,     20,     23,     24,     26,     31,     29,     24,
+    23,     27,     26,     23,     29,     30,     27,     32,     24,     30,
+    33,     24,     34,     35,     36,     34,     36,     37,     38,     36,
+    51,     35,     41,     41,     52,     41,     41,     41,     41,     41,
+    41,     41,     41,     41,     41,     41,     41,     41,     41,     41,
+    41,     41,     41,     41,     41,     41,     41,     41,     41,     41,
+    41,     41,     41,     41,     41,     41,     41,     41,     41,     41,
+    41,     41,     41,     41,     41,     50,     53,     54,     50,     55,
+
+    56,     57,     58,     59,     60,     61,     62,     63,     65,     66,
+    67,     70,     71,     72,     74,     73,     75,     76,     77,     78,
+    79,     63,     63,     73,     79,     80,     81,     83,     85,     86,
+    87,     88,     89,     80,     90,     91,     92,     93,     94,     95,
+    96,     97,     98,     99,    102,    103,    104,    105,    106,    108,
+   109,    110,    111,    112,    114,    115,    116,    117,    118,    119,
+   120,    122,    123,    124,    125,    126,    128,    129,    131,    132,
+   135,    137,    138,    140,    141,    142,    143,    144,    145,    146,
+   147,    148,    150,    151,    152,    153,    154,    155,    156,    158,
+   159,    160,    161,    162,    163,    164,    165,    166,    168,    169,
+
+   171,    175,    178,    179,    181,    182,    185,    191,    192,    195,
+   196,    197,    200,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203,    203,    203,    203,
+   203,    203,    203,    203,    203,    203,    203
     } ;
 
 /* Table of booleans, true if rule could match eol. */
-static yyconst flex_int32_t yy_rule_can_match_eol[57] =
+static yyconst flex_int32_t yy_rule_can_match_eol[63] =
     {   0,
-1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
+1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 
-    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,     };
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 
+    0, 0,     };
 
 static yy_state_type yy_last_accepting_state;
 static char *yy_last_accepting_cpos;
@@ -578,11 +617,10 @@ char *yytext;
 #line 2 "minisql.l"
     #include <stdio.h>
     #include "parser/parser.h"
-
     #include "parser/minisql_yacc.h"
     int yywrap();
     extern YYSTYPE yylval;
-#line 585 "../../parser/minisql_lex.c"
+#line 624 "../../parser/minisql_lex.c"
 
 #define INITIAL 0
 
@@ -767,7 +805,7 @@ YY_DECL
 #line 15 "minisql.l"
 
 
-#line 770 "../../parser/minisql_lex.c"
+#line 809 "../../parser/minisql_lex.c"
 
 	if ( !(yy_init) )
 		{
@@ -820,13 +858,13 @@ yy_match:
 			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 				{
 				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 175 )
+				if ( yy_current_state >= 204 )
 					yy_c = yy_meta[(unsigned int) yy_c];
 				}
 			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
 			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 189 );
+		while ( yy_base[yy_current_state] != 314 );
 
 yy_find_action:
 		yy_act = yy_accept[yy_current_state];
@@ -963,7 +1001,7 @@ YY_RULE_SETUP
 #line 78 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return SHOW;
+  return VACUUM;
 }
 	YY_BREAK
 case 14:
@@ -971,7 +1009,7 @@ YY_RULE_SETUP
 #line 83 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return USE;
+  return ANALYZE;
 }
 	YY_BREAK
 case 15:
@@ -979,7 +1017,7 @@ YY_RULE_SETUP
 #line 88 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return USING;
+  return SHOW;
 }
 	YY_BREAK
 case 16:
@@ -987,7 +1025,7 @@ YY_RULE_SETUP
 #line 93 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return DATABASE;
+  return USE;
 }
 	YY_BREAK
 case 17:
@@ -995,7 +1033,7 @@ YY_RULE_SETUP
 #line 98 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return DATABASES;
+  return USING;
 }
 	YY_BREAK
 case 18:
@@ -1003,7 +1041,7 @@ YY_RULE_SETUP
 #line 103 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return TABLE;
+  return DATABASE;
 }
 	YY_BREAK
 case 19:
@@ -1011,7 +1049,7 @@ YY_RULE_SETUP
 #line 108 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return TABLES;
+  return DATABASES;
 }
 	YY_BREAK
 case 20:
@@ -1019,7 +1057,7 @@ YY_RULE_SETUP
 #line 113 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return INDEX;
+  return TABLE;
 }
 	YY_BREAK
 case 21:
@@ -1027,7 +1065,7 @@ YY_RULE_SETUP
 #line 118 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return INDEXES;
+  return TABLES;
 }
 	YY_BREAK
 case 22:
@@ -1035,7 +1073,7 @@ YY_RULE_SETUP
 #line 123 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ON;
+  return INDEX;
 }
 	YY_BREAK
 case 23:
@@ -1043,7 +1081,7 @@ YY_RULE_SETUP
 #line 128 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return FROM;
+  return INDEXES;
 }
 	YY_BREAK
 case 24:
@@ -1051,7 +1089,7 @@ YY_RULE_SETUP
 #line 133 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return WHERE;
+  return ON;
 }
 	YY_BREAK
 case 25:
@@ -1059,7 +1097,7 @@ YY_RULE_SETUP
 #line 138 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return INTO;
+  return FROM;
 }
 	YY_BREAK
 case 26:
@@ -1067,7 +1105,7 @@ YY_RULE_SETUP
 #line 143 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return SET;
+  return WHERE;
 }
 	YY_BREAK
 case 27:
@@ -1075,7 +1113,7 @@ YY_RULE_SETUP
 #line 148 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return VALUES;
+  return INTO;
 }
 	YY_BREAK
 case 28:
@@ -1083,7 +1121,7 @@ YY_RULE_SETUP
 #line 153 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return PRIMARY;
+  return SET;
 }
 	YY_BREAK
 case 29:
@@ -1091,7 +1129,7 @@ YY_RULE_SETUP
 #line 158 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return KEY;
+  return VALUES;
 }
 	YY_BREAK
 case 30:
@@ -1099,7 +1137,7 @@ YY_RULE_SETUP
 #line 163 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return UNIQUE;
+  return PRIMARY;
 }
 	YY_BREAK
 case 31:
@@ -1107,7 +1145,7 @@ YY_RULE_SETUP
 #line 168 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return CHAR;
+  return KEY;
 }
 	YY_BREAK
 case 32:
@@ -1115,7 +1153,7 @@ YY_RULE_SETUP
 #line 173 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return INT;
+  return UNIQUE;
 }
 	YY_BREAK
 case 33:
@@ -1123,7 +1161,7 @@ YY_RULE_SETUP
 #line 178 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return FLOAT;
+  return CHAR;
 }
 	YY_BREAK
 case 34:
@@ -1131,7 +1169,7 @@ YY_RULE_SETUP
 #line 183 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return AND;
+  return INT;
 }
 	YY_BREAK
 case 35:
@@ -1139,7 +1177,7 @@ YY_RULE_SETUP
 #line 188 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return OR;
+  return FLOAT;
 }
 	YY_BREAK
 case 36:
@@ -1147,7 +1185,7 @@ YY_RULE_SETUP
 #line 193 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return NOT;
+  return BIGINT;
 }
 	YY_BREAK
 case 37:
@@ -1155,7 +1193,7 @@ YY_RULE_SETUP
 #line 198 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return IS;
+  return DOUBLE;
 }
 	YY_BREAK
 case 38:
@@ -1163,7 +1201,7 @@ YY_RULE_SETUP
 #line 203 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return FLAGNULL;
+  return TIMESTAMP;
 }
 	YY_BREAK
 case 39:
@@ -1171,66 +1209,66 @@ YY_RULE_SETUP
 #line 208 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
-  return IDENTIFIER;
+  return AND;
 }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 214 "minisql.l"
+#line 213 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-  return NUMBER;
+  return OR;
 }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 220 "minisql.l"
+#line 218 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
-  return NUMBER;
+  return NOT;
 }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 226 "minisql.l"
+#line 223 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return EQ;
+  return IS;
 }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 231 "minisql.l"
+#line 228 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return NE;
+  return FLAGNULL;
 }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 236 "minisql.l"
+#line 233 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return LE;
+  yylval.syntax_node = CreateSyntaxNode(kNodeIdentifier, yytext);
+  return IDENTIFIER;
 }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 241 "minisql.l"
+#line 239 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return GE;
+  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+  return NUMBER;
 }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 246 "minisql.l"
+#line 245 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (',');
+  yylval.syntax_node = CreateSyntaxNode(kNodeNumber, yytext);
+  return NUMBER;
 }
 	YY_BREAK
 case 47:
@@ -1238,7 +1276,7 @@ YY_RULE_SETUP
 #line 251 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('*');
+  return EQ;
 }
 	YY_BREAK
 case 48:
@@ -1246,7 +1284,7 @@ YY_RULE_SETUP
 #line 256 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (';');
+  return NE;
 }
 	YY_BREAK
 case 49:
@@ -1254,7 +1292,7 @@ YY_RULE_SETUP
 #line 261 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('\'');
+  return LE;
 }
 	YY_BREAK
 case 50:
@@ -1262,7 +1300,7 @@ YY_RULE_SETUP
 #line 266 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('<');
+  return GE;
 }
 	YY_BREAK
 case 51:
@@ -1270,7 +1308,7 @@ YY_RULE_SETUP
 #line 271 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('>');
+  return (',');
 }
 	YY_BREAK
 case 52:
@@ -1278,7 +1316,7 @@ YY_RULE_SETUP
 #line 276 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return ('(');
+  return ('*');
 }
 	YY_BREAK
 case 53:
@@ -1286,32 +1324,72 @@ YY_RULE_SETUP
 #line 281 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
-  return (')');
+  return (';');
 }
 	YY_BREAK
 case 54:
-/* rule 54 can match eol */
 YY_RULE_SETUP
 #line 286 "minisql.l"
 {
   MinisqlParserMovePos(yylineno, yytext);
+  return ('\'');
 }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
-#line 290 "minisql.l"
+#line 291 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return ('<');
+}
+	YY_BREAK
+case 56:
+YY_RULE_SETUP
+#line 296 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return ('>');
+}
+	YY_BREAK
+case 57:
+YY_RULE_SETUP
+#line 301 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return ('(');
+}
+	YY_BREAK
+case 58:
+YY_RULE_SETUP
+#line 306 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+  return (')');
+}
+	YY_BREAK
+case 59:
+/* rule 59 can match eol */
+YY_RULE_SETUP
+#line 311 "minisql.l"
+{
+  MinisqlParserMovePos(yylineno, yytext);
+}
+	YY_BREAK
+case 60:
+YY_RULE_SETUP
+#line 315 "minisql.l"
 {
   char str[128] = {0};
   sprintf(str, "Unrecognized token [%s] in input sql.", yytext);
   MinisqlParserSetError(str);
 }
 	YY_BREAK
-case 56:
+case 61:
 YY_RULE_SETUP
-#line 296 "minisql.l"
+#line 321 "minisql.l"
 ECHO;
 	YY_BREAK
-#line 1314 "../../parser/minisql_lex.c"
+#line 1393 "../../parser/minisql_lex.c"
 case YY_STATE_EOF(INITIAL):
 	yyterminate();
 
@@ -1603,7 +1681,7 @@ static int yy_get_next_buffer (void)
 		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 			{
 			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 175 )
+			if ( yy_current_state >= 204 )
 				yy_c = yy_meta[(unsigned int) yy_c];
 			}
 		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
@@ -1631,11 +1709,11 @@ static int yy_get_next_buffer (void)
 	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
 		{
 		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 175 )
+		if ( yy_current_state >= 204 )
 			yy_c = yy_meta[(unsigned int) yy_c];
 		}
 	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 174);
+	yy_is_jam = (yy_current_state == 203);
 
 	return yy_is_jam ? 0 : yy_current_state;
 }
@@ -2320,7 +2398,7 @@ void yyfree (void * ptr )
 
 #define YYTABLES_NAME "yytables"
 
-#line 296 "minisql.l"
+#line 321 "minisql.l"
 
 
 int yywrap() {
@@ -171,6 +171,12 @@ const char *GetSyntaxNodeTypeStr(SyntaxNodeType type) {
       return "kNodeTrxCommit";
     case kNodeTrxRollback:
       return "kNodeTrxRollback";
+    case kNodeVacuum:
+      return "kNodeVacuum";
+    case kNodeTableLayout:
+      return "kNodeTableLayout";
+    case kNodeAnalyze:
+      return "kNodeAnalyze";
     default:
       return "error type";
   }
@@ -3,6 +3,11 @@
 //
 #include "planner/planner.h"
 
+#include "planner/expressions/column_value_expression.h"
+#include "planner/expressions/comparison_expression.h"
+#include "planner/expressions/constant_value_expression.h"
+#include "planner/expressions/logic_expression.h"
+
 void Planner::PlanQuery(pSyntaxNode ast) {
   switch (ast->type_) {
     case kNodeSelect: {
@@ -35,6 +40,12 @@ void Planner::PlanQuery(pSyntaxNode ast) {
 }
 AbstractPlanNodeRef Planner::PlanSelect(std::shared_ptr<SelectStatement> statement) {
   auto out_schema = MakeOutputSchema(statement->column_list_);
+  // the rows of a select are only read, so its scan may run in parallel
+  auto seq_scan = [&out_schema, &statement]() {
+    auto scan_plan = make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
+    scan_plan->parallel_ = true;
+    return scan_plan;
+  };
   vector<IndexInfo *> indexes;
   vector<IndexInfo *> available_index;
   context_->GetCatalog()->GetTableIndexes(statement->table_name_, indexes);
@@ -47,12 +58,140 @@ AbstractPlanNodeRef Planner::PlanSelect(std::shared_ptr<SelectStatement> stateme
       }
     }
   }
-  if (available_index.empty() || statement->has_or) {
-    return make_shared<SeqScanPlanNode>(out_schema, statement->table_name_, statement->where_);
+  if (available_index.empty()) {
+    return seq_scan();
+  }
+  // without statistics the index is always used, with them a seq scan takes over once too many rows match
+  TableStatistics *table_stats = nullptr;
+  if (context_->GetCatalog()->GetTableStatistics(statement->table_name_, table_stats) != DB_SUCCESS) {
+    table_stats = nullptr;
+  }
+  auto plan = make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index,
+                                             available_index.size() != statement->column_in_condition_.size(),
+                                             statement->where_);
+  bool folded_all = true;
+  std::vector<AbstractExpressionRef> disjuncts;
+  CollectDisjuncts(statement->where_, &disjuncts);
+  if (disjuncts.size() > 1) {
+    double selectivity = 0;
+    for (const auto &disjunct : disjuncts) {
+      std::vector<IndexKeyRange> key_ranges;
+      FoldKeyRanges(disjunct, available_index, &key_ranges, &folded_all);
+      // a disjunct without a range on an indexed column may match any row
+      if (key_ranges.empty()) {
+        return seq_scan();
+      }
+      if (std::none_of(key_ranges.begin(), key_ranges.end(),
+                       [](const IndexKeyRange &range) { return range.IsEmpty(); })) {
+        if (table_stats != nullptr) {
+          selectivity += EstimateSelectivity(table_stats, key_ranges);
+        }
+        plan->union_ranges_.push_back(std::move(key_ranges));
+      }
+    }
+    if (selectivity > INDEX_SCAN_MAX_SELECTIVITY) {
+      return seq_scan();
+    }
+    plan->need_filter_ = !folded_all;
+    plan->empty_range_ = plan->union_ranges_.empty();
+    return plan;
+  }
+  std::vector<IndexKeyRange> key_ranges;
+  FoldKeyRanges(statement->where_, available_index, &key_ranges, &folded_all);
+  // the row ids of an OR inside the conjunction cannot be intersected, it is left to the filter of a range
+  if (key_ranges.empty() && statement->has_or) {
+    return seq_scan();
+  }
+  if (!key_ranges.empty() && table_stats != nullptr &&
+      EstimateSelectivity(table_stats, key_ranges) > INDEX_SCAN_MAX_SELECTIVITY) {
+    return seq_scan();
+  }
+  if (!key_ranges.empty()) {
+    // the ranges hold every comparison unless something was left out of them
+    plan->need_filter_ = !folded_all;
+    for (const auto &range : key_ranges) {
+      plan->empty_range_ = plan->empty_range_ || range.IsEmpty();
+    }
+    plan->key_ranges_ = std::move(key_ranges);
+  }
+  return plan;
+}
+
+void Planner::CollectDisjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *disjuncts) {
+  if (expr->GetType() == ExpressionType::LogicExpression &&
+      std::dynamic_pointer_cast<LogicExpression>(expr)->logic_type_ == LogicType::Or) {
+    CollectDisjuncts(expr->GetChildAt(0), disjuncts);
+    CollectDisjuncts(expr->GetChildAt(1), disjuncts);
+    return;
+  }
+  disjuncts->push_back(expr);
+}
+
+double Planner::EstimateSelectivity(const TableStatistics *table_stats, const std::vector<IndexKeyRange> &key_ranges) {
+  double selectivity = 1.0;
+  for (const auto &range : key_ranges) {
+    if (range.IsEmpty()) {
+      return 0;
+    }
+    selectivity *= table_stats->EstimateRangeSelectivity(range.column_, range.lower_.get(), range.lower_inclusive_,
+                                                         range.upper_.get(), range.upper_inclusive_);
+  }
+  return selectivity;
+}
+
+void Planner::FoldKeyRanges(const AbstractExpressionRef &expr, const std::vector<IndexInfo *> &indexes,
+                            std::vector<IndexKeyRange> *key_ranges, bool *folded_all) {
+  if (expr->GetType() == ExpressionType::LogicExpression &&
+      std::dynamic_pointer_cast<LogicExpression>(expr)->logic_type_ == LogicType::And) {
+    FoldKeyRanges(expr->GetChildAt(0), indexes, key_ranges, folded_all);
+    FoldKeyRanges(expr->GetChildAt(1), indexes, key_ranges, folded_all);
+    return;
+  }
+  if (expr->GetType() != ExpressionType::ComparisonExpression ||
+      expr->GetChildAt(0)->GetType() != ExpressionType::ColumnExpression ||
+      expr->GetChildAt(1)->GetType() != ExpressionType::ConstantExpression) {
+    *folded_all = false;
+    return;
+  }
+  auto column = std::dynamic_pointer_cast<ColumnValueExpression>(expr->GetChildAt(0))->GetColIdx();
+  const Field &value = std::dynamic_pointer_cast<ConstantValueExpression>(expr->GetChildAt(1))->val_;
+  auto comparison_type = std::dynamic_pointer_cast<ComparisonExpression>(expr)->GetComparisonType();
+  bool is_lower = comparison_type == "=" || comparison_type == ">" || comparison_type == ">=";
+  bool is_upper = comparison_type == "=" || comparison_type == "<" || comparison_type == "<=";
+  bool inclusive = comparison_type == "=" || comparison_type == ">=" || comparison_type == "<=";
+  IndexInfo *index = nullptr;
+  for (auto candidate : indexes) {
+    if (candidate->GetIndexKeySchema()->GetColumn(0)->GetTableInd() == column) {
+      index = candidate;
+    }
+  }
+  // the bound is compared with the keys of the index, so it must fit the key column
+  auto key_column = index == nullptr ? nullptr : index->GetIndexKeySchema()->GetColumn(0);
+  if (key_column == nullptr || value.IsNull() || value.GetTypeId() != key_column->GetType() ||
+      (value.GetTypeId() == TypeId::kTypeChar && value.GetLength() > key_column->GetLength()) ||
+      !(is_lower || is_upper)) {
+    *folded_all = false;
+    return;
+  }
+  auto range = std::find_if(key_ranges->begin(), key_ranges->end(),
+                            [column](const IndexKeyRange &range) { return range.column_ == column; });
+  if (range == key_ranges->end()) {
+    key_ranges->emplace_back();
+    range = key_ranges->end() - 1;
+    range->index_ = index;
+    range->column_ = column;
+  }
+  // keep the tighter of two bounds on the same side
+  if (is_lower && (range->lower_ == nullptr || value.CompareGreaterThan(*range->lower_) == CmpBool::kTrue ||
+                   (value.CompareEquals(*range->lower_) == CmpBool::kTrue && !inclusive))) {
+    range->lower_ = std::make_unique<Field>(value);
+    range->lower_inclusive_ = inclusive;
+  }
+  if (is_upper && (range->upper_ == nullptr || value.CompareLessThan(*range->upper_) == CmpBool::kTrue ||
+                   (value.CompareEquals(*range->upper_) == CmpBool::kTrue && !inclusive))) {
+    range->upper_ = std::make_unique<Field>(value);
+    range->upper_inclusive_ = inclusive;
   }
-  return make_shared<IndexScanPlanNode>(out_schema, statement->table_name_, available_index,
-                                        available_index.size() != statement->column_in_condition_.size(),
-                                        statement->where_);
 }
 
 AbstractPlanNodeRef Planner::PlanInsert(std::shared_ptr<InsertStatement> statement) {
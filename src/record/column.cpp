@@ -12,6 +12,13 @@ Column::Column(std::string column_name, TypeId type, uint32_t index, bool nullab
     case TypeId::kTypeFloat:
       len_ = sizeof(float_t);
       break;
+    case TypeId::kTypeBigInt:
+    case TypeId::kTypeTimestamp:
+      len_ = sizeof(int64_t);
+      break;
+    case TypeId::kTypeDouble:
+      len_ = sizeof(double);
+      break;
     default:
       ASSERT(false, "Unsupported column type.");
   }
@@ -3,24 +3,40 @@
 uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
+  auto format = schema->GetTupleFormat();
   uint32_t offset = 0;
   // rid
-  memcpy(buf + offset, &rid_, sizeof(RowId));
-  offset += sizeof(RowId);
+  if (format == TupleFormat::kV1) {
+    memcpy(buf + offset, &rid_, sizeof(RowId));
+    offset += sizeof(RowId);
+  }
   // null bitmap
-  uint32_t null_size = (fields_.size() + 7) / 8;
-  char null_bitmap[null_size];
-  memset(null_bitmap, 0, null_size);
-  for (uint32_t i = 0; i < fields_.size(); i++) {
-    if (fields_[i]->IsNull()) {
-      null_bitmap[i / 8] |= (1 << (i % 8));
+  char *null_bitmap = nullptr;
+  if (schema->HasNullBitmap()) {
+    uint32_t null_size = (fields_.size() + 7) / 8;
+    null_bitmap = buf + offset;
+    memset(null_bitmap, 0, null_size);
+    for (uint32_t i = 0; i < fields_.size(); i++) {
+      if (fields_[i]->IsNull()) {
+        null_bitmap[i / 8] |= (1 << (i % 8));
+      }
     }
+    offset += null_size;
+  }
+  // fields, the leading fixed-width values go straight to their offsets
+  uint32_t fixed = CountFixedValues(null_bitmap, schema);
+  for (uint32_t i = 0; i < fixed; i++) {
+    ASSERT(null_bitmap != nullptr || !fields_[i]->IsNull(), "Null value in a not null column.");
+    fields_[i]->SerializeTo(buf + offset + schema->GetColumnOffset(i));
+  }
+  offset += schema->GetColumnOffset(fixed);
+  for (uint32_t i = fixed; i < fields_.size(); i++) {
+    ASSERT(null_bitmap != nullptr || !fields_[i]->IsNull(), "Null value in a not null column.");
+    offset += fields_[i]->SerializeTo(buf + offset, format);
   }
-  memcpy(buf + offset, null_bitmap, null_size);
-  offset += null_size;
-  // fields
-  for (uint32_t i = 0; i < fields_.size(); i++) {
-    offset += fields_[i]->SerializeTo(buf + offset);
+  if (format == TupleFormat::kV2 && offset < MIN_COMPACT_TUPLE_SIZE) {
+    memset(buf + offset, 0, MIN_COMPACT_TUPLE_SIZE - offset);
+    offset = MIN_COMPACT_TUPLE_SIZE;
   }
   return offset;
 }
@@ -28,45 +44,96 @@ uint32_t Row::SerializeTo(char *buf, Schema *schema) const {
 uint32_t Row::DeserializeFrom(char *buf, Schema *schema) {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(fields_.empty(), "Non empty field in row.");
-  uint32_t offset = 0;
-  // rid
-  RowId temp=rid_;
-  memcpy(&temp, buf + offset, sizeof(RowId));
-  offset += sizeof(RowId);
-  // null bitmap
-  uint32_t null_size = (schema->GetColumnCount() + 7) / 8;
-  char null_bitmap[null_size];
-  memcpy(null_bitmap, buf + offset, null_size);
-  offset += null_size;
-  // fields
-  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
-    TypeId type = schema->GetColumn(i)->GetType();
-    Field *field;
-    offset += field->DeserializeFrom(buf + offset, type, &field, null_bitmap[i / 8] & (1 << (i % 8)));
+  auto format = schema->GetTupleFormat();
+  // the rid of a v1 tuple is not read, the row keeps its own
+  uint32_t offset = GetHeaderSize(schema);
+  char *null_bitmap = GetNullBitmap(buf, schema);
+  // size of the values: the leading fixed-width values have a fixed size, the others are measured
+  // with a field that holds no memory of its own
+  uint32_t column_count = schema->GetColumnCount();
+  uint32_t fixed = CountFixedValues(null_bitmap, schema);
+  uint32_t values_size = schema->GetColumnOffset(fixed);
+  alignas(Field) char probe[sizeof(Field)];
+  for (uint32_t i = fixed; i < column_count; i++) {
+    values_size += Field::DeserializeInPlace(buf + offset + values_size, schema->GetColumn(i)->GetType(),
+                                             reinterpret_cast<Field *>(probe), IsNullAt(null_bitmap, i), format);
+  }
+  // fields: the values are copied behind the fields, char fields point into the copy
+  char *values = AllocateFlat(column_count, values_size);
+  memcpy(values, buf + offset, values_size);
+  for (uint32_t i = 0; i < column_count; i++) {
+    auto field = reinterpret_cast<Field *>(flat_) + i;
+    values += Field::DeserializeInPlace(values, schema->GetColumn(i)->GetType(), field, IsNullAt(null_bitmap, i),
+                                        format);
     fields_.push_back(field);
   }
+  offset += values_size;
+  if (format == TupleFormat::kV2 && offset < MIN_COMPACT_TUPLE_SIZE) {
+    offset = MIN_COMPACT_TUPLE_SIZE;
+  }
   return offset;
 }
 
 uint32_t Row::GetSerializedSize(Schema *schema) const {
   ASSERT(schema != nullptr, "Invalid schema before serialize.");
   ASSERT(schema->GetColumnCount() == fields_.size(), "Fields size do not match schema's column size.");
-  uint32_t size = sizeof(RowId);
-  uint32_t null_size = (fields_.size() + 7) / 8;
-  size += null_size;
+  auto format = schema->GetTupleFormat();
+  uint32_t size = GetHeaderSize(schema);
   for (auto field : fields_) {
-    size += field->GetSerializedSize();
+    size += field->GetSerializedSize(format);
+  }
+  if (format == TupleFormat::kV2 && size < MIN_COMPACT_TUPLE_SIZE) {
+    size = MIN_COMPACT_TUPLE_SIZE;
   }
   return size;
 }
 
+uint32_t Row::GetHeaderSize(const Schema *schema) {
+  uint32_t size = schema->GetTupleFormat() == TupleFormat::kV1 ? sizeof(RowId) : 0;
+  if (schema->HasNullBitmap()) {
+    size += (schema->GetColumnCount() + 7) / 8;
+  }
+  return size;
+}
+
+char *Row::GetNullBitmap(char *tuple, const Schema *schema) {
+  if (!schema->HasNullBitmap()) {
+    return nullptr;
+  }
+  return schema->GetTupleFormat() == TupleFormat::kV1 ? tuple + sizeof(RowId) : tuple;
+}
+
+uint32_t Row::CountFixedValues(const char *null_bitmap, const Schema *schema) {
+  uint32_t fixed = schema->GetFixedColumnCount();
+  for (uint32_t i = 0; i < fixed; i++) {
+    if (IsNullAt(null_bitmap, i)) {
+      return i;
+    }
+  }
+  return fixed;
+}
+
 void Row::GetKeyFromRow(const Schema *schema, const Schema *key_schema, Row &key_row) {
-  auto columns = key_schema->GetColumns();
-  std::vector<Field> fields;
+  const auto &columns = key_schema->GetColumns();
+  std::vector<const Field *> fields;
+  fields.reserve(columns.size());
   uint32_t idx;
   for (auto column : columns) {
     schema->GetColumnIndex(column->GetName(), idx);
-    fields.emplace_back(*this->GetField(idx));
+    fields.push_back(this->GetField(idx));
+  }
+  Row key(fields);
+  Swap(key_row, key);
+}
+
+char *Row::AllocateFlat(uint32_t field_count, uint32_t data_size) {
+  ASSERT(flat_ == nullptr, "Row already holds flat fields.");
+  size_t size = field_count * sizeof(Field) + data_size;
+  if (size == 0) {
+    return nullptr;
   }
-  key_row = Row(fields);
+  flat_ = arena_ != nullptr ? arena_->Allocate(size) : new char[size];
+  flat_count_ = field_count;
+  fields_.reserve(field_count);
+  return flat_ + field_count * sizeof(Field);
 }
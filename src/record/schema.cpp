@@ -1,5 +1,21 @@
 #include "record/schema.h"
 
+#include <algorithm>
+
+#include "record/types.h"
+
+void Schema::InitLayout() {
+  column_offsets_.assign(1, 0);
+  has_nullable_ = std::any_of(columns_.begin(), columns_.end(), [](Column *column) { return column->IsNullable(); });
+  for (auto column : columns_) {
+    auto type = column->GetType();
+    if (type == TypeId::kTypeChar) {
+      break;
+    }
+    column_offsets_.push_back(column_offsets_.back() + Type::GetTypeSize(type));
+  }
+}
+
 uint32_t Schema::SerializeTo(char *buf) const {
   uint32_t offset = 0;
   // magic number
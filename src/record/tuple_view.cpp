@@ -0,0 +1,62 @@
+#include "record/tuple_view.h"
+
+#include <algorithm>
+
+bool TupleView::Bind(const std::vector<bool> &referenced, Row *row) const {
+  ASSERT(row->GetFieldCount() == 0, "Non empty field in row.");
+  uint32_t column_count = schema_->GetColumnCount();
+  auto format = schema_->GetTupleFormat();
+  char *null_bitmap = Row::GetNullBitmap(data_, schema_);
+  char *values = data_ + Row::GetHeaderSize(schema_);
+  char *value = values;
+  // the values behind the last referenced one are not looked at
+  uint32_t end = column_count;
+  while (end > 0 && !referenced[end - 1]) {
+    end--;
+  }
+  // the leading fixed-width values are at fixed offsets and need not be decoded to find the next one
+  uint32_t fixed = Row::CountFixedValues(null_bitmap, schema_);
+  row->AllocateFlat(column_count, 0);
+  auto fields = reinterpret_cast<Field *>(row->flat_);
+  for (uint32_t i = 0; i < column_count; i++) {
+    auto type = schema_->GetColumn(i)->GetType();
+    if (i >= end || (i < fixed && !referenced[i])) {
+      new (fields + i) Field(type);
+      row->fields_.push_back(fields + i);
+      continue;
+    }
+    if (i <= fixed) {
+      value = values + schema_->GetColumnOffset(i);
+    }
+    // a value before the last referenced one is decoded in any case to find the next one
+    value += Field::DeserializeInPlace(value, type, fields + i, Row::IsNullAt(null_bitmap, i), format);
+    if (!referenced[i]) {
+      fields[i].~Field();
+      new (fields + i) Field(type);
+    } else if (fields[i].IsExternal()) {
+      row->destroy();
+      return false;
+    }
+    row->fields_.push_back(fields + i);
+  }
+  return true;
+}
+
+void TupleView::DecodeColumn(uint32_t column_index, Field *field) const {
+  uint32_t column_count = schema_->GetColumnCount();
+  ASSERT(column_index < column_count, "Invalid column index.");
+  auto format = schema_->GetTupleFormat();
+  char *null_bitmap = Row::GetNullBitmap(data_, schema_);
+  char *values = data_ + Row::GetHeaderSize(schema_);
+  // straight to the value if it has a fixed offset, otherwise skip the values in front of it
+  uint32_t fixed = Row::CountFixedValues(null_bitmap, schema_);
+  uint32_t start = std::min(fixed, column_index);
+  char *value = values + schema_->GetColumnOffset(start);
+  alignas(Field) char probe[sizeof(Field)];
+  for (uint32_t i = start; i < column_index; i++) {
+    value += Field::DeserializeInPlace(value, schema_->GetColumn(i)->GetType(), reinterpret_cast<Field *>(probe),
+                                       Row::IsNullAt(null_bitmap, i), format);
+  }
+  Field::DeserializeInPlace(value, schema_->GetColumn(column_index)->GetType(), field,
+                            Row::IsNullAt(null_bitmap, column_index), format);
+}
@@ -1,5 +1,8 @@
 #include "record/types.h"
 
+#include <cstdio>
+#include <new>
+
 #include "common/macros.h"
 #include "record/field.h"
 
@@ -17,7 +20,8 @@ inline int CompareStrings(const char *str1, int len1, const char *str2, int len2
 
 // ==============================Type=============================
 
-Type *Type::type_singletons_[] = {new Type(TypeId::kTypeInvalid), new TypeInt(), new TypeFloat(), new TypeChar()};
+Type *Type::type_singletons_[] = {new Type(TypeId::kTypeInvalid), new TypeInt(),    new TypeFloat(),    new TypeChar(),
+                                  new TypeBigInt(),                 new TypeDouble(), new TypeTimestamp()};
 
 uint32_t Type::SerializeTo(const Field &field, char *buf) const {
   ASSERT(false, "SerializeTo not implemented.");
@@ -29,6 +33,11 @@ uint32_t Type::DeserializeFrom(char *storage, Field **field, bool is_null) const
   return 0;
 }
 
+uint32_t Type::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  ASSERT(false, "DeserializeInPlace not implemented.");
+  return 0;
+}
+
 uint32_t Type::GetSerializedSize(const Field &field, bool is_null) const {
   ASSERT(false, "GetSerializedSize not implemented.");
   return 0;
@@ -94,6 +103,15 @@ uint32_t TypeInt::DeserializeFrom(char *storage, Field **field, bool is_null) co
   return GetTypeSize(type_id_);
 }
 
+uint32_t TypeInt::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  if (is_null) {
+    new (field) Field(TypeId::kTypeInt);
+    return 0;
+  }
+  new (field) Field(TypeId::kTypeInt, MACH_READ_FROM(int32_t, storage));
+  return GetTypeSize(type_id_);
+}
+
 uint32_t TypeInt::GetSerializedSize(const Field &field, bool is_null) const {
   if (is_null) {
     return 0;
@@ -169,6 +187,15 @@ uint32_t TypeFloat::DeserializeFrom(char *storage, Field **field, bool is_null)
   return GetTypeSize(type_id_);
 }
 
+uint32_t TypeFloat::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  if (is_null) {
+    new (field) Field(TypeId::kTypeFloat);
+    return 0;
+  }
+  new (field) Field(TypeId::kTypeFloat, MACH_READ_FROM(float_t, storage));
+  return GetTypeSize(type_id_);
+}
+
 uint32_t TypeFloat::GetSerializedSize(const Field &field, bool is_null) const {
   if (is_null) {
     return 0;
@@ -228,7 +255,8 @@ CmpBool TypeFloat::CompareGreaterThanEquals(const Field &left, const Field &righ
 uint32_t TypeChar::SerializeTo(const Field &field, char *buf) const {
   if (!field.IsNull()) {
     uint32_t len = GetLength(field);
-    memcpy(buf, &len, sizeof(uint32_t));
+    uint32_t stored_len = field.IsExternal() ? (len | EXTERNAL_FLAG) : len;
+    memcpy(buf, &stored_len, sizeof(uint32_t));
     memcpy(buf + sizeof(uint32_t), field.value_.chars_, len);
     return len + sizeof(uint32_t);
   }
@@ -241,7 +269,23 @@ uint32_t TypeChar::DeserializeFrom(char *storage, Field **field, bool is_null) c
     return 0;
   }
   uint32_t len = MACH_READ_UINT32(storage);
+  bool is_external = (len & EXTERNAL_FLAG) != 0;
+  len &= ~EXTERNAL_FLAG;
   *field = new Field(TypeId::kTypeChar, storage + sizeof(uint32_t), len, true);
+  (*field)->SetExternal(is_external);
+  return len + sizeof(uint32_t);
+}
+
+uint32_t TypeChar::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  if (is_null) {
+    new (field) Field(TypeId::kTypeChar);
+    return 0;
+  }
+  uint32_t len = MACH_READ_UINT32(storage);
+  bool is_external = (len & EXTERNAL_FLAG) != 0;
+  len &= ~EXTERNAL_FLAG;
+  new (field) Field(TypeId::kTypeChar, storage + sizeof(uint32_t), len, false);
+  field->SetExternal(is_external);
   return len + sizeof(uint32_t);
 }
 
@@ -308,3 +352,267 @@ CmpBool TypeChar::CompareGreaterThanEquals(const Field &left, const Field &right
   }
   return GetCmpBool(CompareStrings(left.GetData(), left.GetLength(), right.GetData(), right.GetLength()) >= 0);
 }
+
+// ==============================TypeBigInt=============================
+
+uint32_t TypeBigInt::SerializeTo(const Field &field, char *buf) const {
+  if (!field.IsNull()) {
+    MACH_WRITE_TO(int64_t, buf, field.value_.bigint_);
+    return GetTypeSize(type_id_);
+  }
+  return 0;
+}
+
+uint32_t TypeBigInt::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+  if (is_null) {
+    *field = new Field(type_id_);
+    return 0;
+  }
+  int64_t val = MACH_READ_FROM(int64_t, storage);
+  *field = new Field(type_id_, val);
+  return GetTypeSize(type_id_);
+}
+
+uint32_t TypeBigInt::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  if (is_null) {
+    new (field) Field(type_id_);
+    return 0;
+  }
+  new (field) Field(type_id_, MACH_READ_FROM(int64_t, storage));
+  return GetTypeSize(type_id_);
+}
+
+uint32_t TypeBigInt::GetSerializedSize([[maybe_unused]] const Field &field, bool is_null) const {
+  if (is_null) {
+    return 0;
+  }
+  return GetTypeSize(type_id_);
+}
+
+CmpBool TypeBigInt::CompareEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ == right.value_.bigint_);
+}
+
+CmpBool TypeBigInt::CompareNotEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ != right.value_.bigint_);
+}
+
+CmpBool TypeBigInt::CompareLessThan(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ < right.value_.bigint_);
+}
+
+CmpBool TypeBigInt::CompareLessThanEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ <= right.value_.bigint_);
+}
+
+CmpBool TypeBigInt::CompareGreaterThan(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ > right.value_.bigint_);
+}
+
+CmpBool TypeBigInt::CompareGreaterThanEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.bigint_ >= right.value_.bigint_);
+}
+
+// ==============================TypeDouble=============================
+
+uint32_t TypeDouble::SerializeTo(const Field &field, char *buf) const {
+  if (!field.IsNull()) {
+    MACH_WRITE_TO(double, buf, field.value_.double_);
+    return GetTypeSize(type_id_);
+  }
+  return 0;
+}
+
+uint32_t TypeDouble::DeserializeFrom(char *storage, Field **field, bool is_null) const {
+  if (is_null) {
+    *field = new Field(TypeId::kTypeDouble);
+    return 0;
+  }
+  double val = MACH_READ_FROM(double, storage);
+  *field = new Field(TypeId::kTypeDouble, val);
+  return GetTypeSize(type_id_);
+}
+
+uint32_t TypeDouble::DeserializeInPlace(char *storage, Field *field, bool is_null) const {
+  if (is_null) {
+    new (field) Field(TypeId::kTypeDouble);
+    return 0;
+  }
+  new (field) Field(TypeId::kTypeDouble, MACH_READ_FROM(double, storage));
+  return GetTypeSize(type_id_);
+}
+
+uint32_t TypeDouble::GetSerializedSize([[maybe_unused]] const Field &field, bool is_null) const {
+  if (is_null) {
+    return 0;
+  }
+  return GetTypeSize(type_id_);
+}
+
+CmpBool TypeDouble::CompareEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ == right.value_.double_);
+}
+
+CmpBool TypeDouble::CompareNotEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ != right.value_.double_);
+}
+
+CmpBool TypeDouble::CompareLessThan(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ < right.value_.double_);
+}
+
+CmpBool TypeDouble::CompareLessThanEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ <= right.value_.double_);
+}
+
+CmpBool TypeDouble::CompareGreaterThan(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ > right.value_.double_);
+}
+
+CmpBool TypeDouble::CompareGreaterThanEquals(const Field &left, const Field &right) const {
+  ASSERT(left.CheckComparable(right), "Not comparable.");
+  if (left.IsNull() || right.IsNull()) {
+    return CmpBool::kNull;
+  }
+  return GetCmpBool(left.value_.double_ >= right.value_.double_);
+}
+
+// ==============================TypeTimestamp=============================
+
+namespace {
+constexpr int64_t MICROS_PER_SECOND = 1000000;
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+// days since 1970-01-01 of a date of the proleptic Gregorian calendar
+int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= month <= 2;
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+void CivilFromDays(int64_t days, int64_t *year, int64_t *month, int64_t *day) {
+  days += 719468;
+  int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t day_of_era = days - era * 146097;
+  int64_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  int64_t mp = (5 * day_of_year + 2) / 153;
+  *day = day_of_year - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = year_of_era + era * 400 + (*month <= 2);
+}
+
+bool IsLeapYear(int64_t year) { return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0); }
+}  // namespace
+
+bool TypeTimestamp::Parse(const char *str, int64_t *micros) {
+  int year, month, day, hour = 0, minute = 0, second = 0, consumed = 0;
+  if (sscanf(str, "%4d-%2d-%2d%n", &year, &month, &day, &consumed) != 3) {
+    return false;
+  }
+  const char *rest = str + consumed;
+  int64_t fraction = 0;
+  if (*rest == ' ' || *rest == 'T') {
+    if (sscanf(rest + 1, "%2d:%2d:%2d%n", &hour, &minute, &second, &consumed) != 3) {
+      return false;
+    }
+    rest += 1 + consumed;
+    if (*rest == '.') {
+      // up to six digits of the fraction of the second
+      int digits = 0;
+      for (rest++; *rest >= '0' && *rest <= '9'; rest++, digits++) {
+        if (digits >= 6) {
+          return false;
+        }
+        fraction = fraction * 10 + (*rest - '0');
+      }
+      if (digits == 0) {
+        return false;
+      }
+      for (; digits < 6; digits++) {
+        fraction *= 10;
+      }
+    }
+  }
+  static const int days_in_month[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  if (*rest != '\0' || month < 1 || month > 12 || day < 1 ||
+      day > days_in_month[month - 1] + (month == 2 && IsLeapYear(year)) || hour > 23 || minute > 59 || second > 59 ||
+      hour < 0 || minute < 0 || second < 0) {
+    return false;
+  }
+  int64_t seconds = DaysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+  *micros = seconds * MICROS_PER_SECOND + fraction;
+  return true;
+}
+
+std::string TypeTimestamp::Format(int64_t micros) {
+  int64_t seconds = micros / MICROS_PER_SECOND;
+  int64_t fraction = micros % MICROS_PER_SECOND;
+  if (fraction < 0) {
+    seconds--;
+    fraction += MICROS_PER_SECOND;
+  }
+  int64_t days = seconds / SECONDS_PER_DAY;
+  int64_t time = seconds % SECONDS_PER_DAY;
+  if (time < 0) {
+    days--;
+    time += SECONDS_PER_DAY;
+  }
+  int64_t year, month, day;
+  CivilFromDays(days, &year, &month, &day);
+  char buf[48];
+  int len = snprintf(buf, sizeof(buf), "%04lld-%02lld-%02lld %02lld:%02lld:%02lld", static_cast<long long>(year),
+                     static_cast<long long>(month), static_cast<long long>(day), static_cast<long long>(time / 3600),
+                     static_cast<long long>(time / 60 % 60), static_cast<long long>(time % 60));
+  if (fraction != 0) {
+    snprintf(buf + len, sizeof(buf) - len, ".%06lld", static_cast<long long>(fraction));
+  }
+  return buf;
+}
@@ -0,0 +1,489 @@
+#include "storage/clustered_table_heap.h"
+
+uint32_t ClusteredTableHeap::ComputeKeySize(const Schema *schema, const std::vector<uint32_t> &key_columns,
+                                            KeyEncoding key_encoding) {
+  if (key_columns.empty()) {
+    return 0;
+  }
+  // a row id and a null bitmap in the row encoding, a null byte per column in the normalized one
+  uint32_t key_size = key_encoding == KeyEncoding::kRow ? sizeof(RowId) + (key_columns.size() + 7) / 8
+                                                        : static_cast<uint32_t>(key_columns.size());
+  for (auto column_index : key_columns) {
+    if (column_index >= schema->GetColumnCount()) {
+      return 0;
+    }
+    auto column = schema->GetColumn(column_index);
+    if (column->GetType() == TypeId::kTypeChar) {
+      key_size += sizeof(uint32_t) + column->GetLength();
+    } else {
+      key_size += Type::GetTypeSize(column->GetType());
+    }
+  }
+  return key_size > KeyManager::MAX_KEY_SIZE ? 0 : key_size;
+}
+
+ClusteredTableHeap::ClusteredTableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema,
+                                       const std::vector<uint32_t> &key_columns, Txn *, LogManager *log_manager,
+                                       LockManager *lock_manager)
+    : TableHeap(buffer_pool_manager, schema, log_manager, lock_manager),
+      key_columns_(key_columns),
+      key_schema_(Schema::ShallowCopySchema(schema, key_columns)),
+      key_size_(static_cast<int>(ComputeKeySize(schema, key_columns, KeyEncoding::kNormalized))),
+      processor_(key_schema_, key_size_),
+      internal_max_size_((PAGE_SIZE - InternalPage::INTERNAL_PAGE_HEADER_SIZE) / (key_size_ + sizeof(page_id_t)) - 1),
+      max_row_size_(ClusteredLeafPage::GetMaxRowSize(key_size_)) {
+  ASSERT(key_size_ > 0, "Invalid cluster key.");
+  auto page = buffer_pool_manager_->NewPage(first_page_id_);
+  auto root = reinterpret_cast<ClusteredLeafPage *>(page->GetData());
+  root->Init(first_page_id_, INVALID_PAGE_ID, key_size_);
+  page_free_space_[first_page_id_] = root->GetFreeSpaceRemaining();
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+}
+
+ClusteredTableHeap::ClusteredTableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id,
+                                       Schema *schema, const std::vector<uint32_t> &key_columns,
+                                       LogManager *log_manager, LockManager *lock_manager, KeyEncoding key_encoding)
+    : TableHeap(buffer_pool_manager, schema, log_manager, lock_manager),
+      key_columns_(key_columns),
+      key_schema_(Schema::ShallowCopySchema(schema, key_columns)),
+      key_size_(static_cast<int>(ComputeKeySize(schema, key_columns, key_encoding))),
+      processor_(key_schema_, key_size_, key_encoding),
+      internal_max_size_((PAGE_SIZE - InternalPage::INTERNAL_PAGE_HEADER_SIZE) / (key_size_ + sizeof(page_id_t)) - 1),
+      max_row_size_(ClusteredLeafPage::GetMaxRowSize(key_size_)) {
+  ASSERT(key_size_ > 0, "Invalid cluster key.");
+  first_page_id_ = first_page_id;
+  // fill page_free_space_ with every page of the tree
+  std::vector<page_id_t> pages{first_page_id_};
+  while (!pages.empty()) {
+    auto page_id = pages.back();
+    pages.pop_back();
+    auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    if (page->IsLeafPage()) {
+      page_free_space_[page_id] = reinterpret_cast<ClusteredLeafPage *>(page)->GetFreeSpaceRemaining();
+    } else {
+      page_free_space_[page_id] = 0;
+      auto internal = reinterpret_cast<InternalPage *>(page);
+      for (int i = 0; i < internal->GetSize(); i++) {
+        pages.push_back(internal->ValueAt(i));
+      }
+    }
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+}
+
+void ClusteredTableHeap::SerializeKey(const Row &row, GenericKey *key) {
+  std::vector<Field> fields;
+  fields.reserve(key_columns_.size());
+  for (auto column_index : key_columns_) {
+    fields.emplace_back(*row.GetField(column_index));
+  }
+  processor_.SerializeFromKey(key, Row(fields), key_schema_);
+}
+
+ClusteredLeafPage *ClusteredTableHeap::FindLeaf(const GenericKey *key) {
+  auto page_id = first_page_id_;
+  auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  while (!page->IsLeafPage()) {
+    auto internal = reinterpret_cast<InternalPage *>(page);
+    auto child_page_id = key == nullptr ? internal->ValueAt(0) : internal->Lookup(key, processor_);
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = child_page_id;
+    page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  }
+  return reinterpret_cast<ClusteredLeafPage *>(page);
+}
+
+bool ClusteredTableHeap::ContainsKey(const GenericKey *key) {
+  auto leaf = FindLeaf(key);
+  int index = leaf->KeyIndex(key, processor_);
+  bool found = index < leaf->GetSize() && !leaf->IsDeleted(index) &&
+               processor_.CompareKeys(leaf->KeyAt(index), key) == 0;
+  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+  return found;
+}
+
+bool ClusteredTableHeap::InsertTuple(Row &row, Txn *) {
+  std::vector<Field> fields;
+  for (auto column_index : key_columns_) {
+    fields.emplace_back(*row.GetField(column_index));
+  }
+  if (!processor_.FitsKey(Row(fields), key_schema_)) {
+    return false;
+  }
+  KeyBuffer key_buf;
+  GenericKey *key = key_buf.Get();
+  SerializeKey(row, key);
+  Row stored;
+  if (StoreOverflow(row, stored, max_row_size_) != DB_SUCCESS) {
+    return false;
+  }
+  Row &new_row = stored.GetFieldCount() == 0 ? row : stored;
+  if (new_row.GetSerializedSize(schema_) > max_row_size_ || !InsertStoredTuple(key, new_row)) {
+    FreeOverflow(stored);
+    return false;
+  }
+  row.SetRowId(new_row.GetRowId());
+  inserted_tuples_++;
+  return true;
+}
+
+bool ClusteredTableHeap::InsertStoredTuple(const GenericKey *key, Row &row) {
+  auto leaf = FindLeaf(key);
+  int index = leaf->KeyIndex(key, processor_);
+  if (index < leaf->GetSize() && processor_.CompareKeys(leaf->KeyAt(index), key) == 0) {
+    if (!leaf->IsDeleted(index)) {
+      buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+      return false;
+    }
+    // the key is reused, drop the deleted tuple for good
+    FreeLeafOverflow(leaf, index);
+    leaf->Remove(index);
+  }
+  InsertIntoLeaf(leaf, index, key, row);
+  return true;
+}
+
+void ClusteredTableHeap::InsertIntoLeaf(ClusteredLeafPage *leaf, int index, const GenericKey *key, Row &row) {
+  // the key may point into a page that is modified below
+  KeyBuffer key_copy;
+  memcpy(key_copy.Get(), key, key_size_);
+  while (!leaf->Insert(index, key_copy.Get(), row, schema_)) {
+    if (leaf->IsRootPage()) {
+      leaf = reinterpret_cast<ClusteredLeafPage *>(PushDownRoot(leaf));
+    }
+    page_id_t new_page_id;
+    auto new_leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->NewPage(new_page_id)->GetData());
+    new_leaf->Init(new_page_id, leaf->GetParentPageId(), key_size_);
+    leaf->MoveHalfTo(new_leaf);
+    new_leaf->SetNextPageId(leaf->GetNextPageId());
+    leaf->SetNextPageId(new_page_id);
+    InsertIntoParent(leaf->GetPageId(), new_leaf->KeyAt(0), new_page_id, leaf->GetParentPageId());
+    page_free_space_[leaf->GetPageId()] = leaf->GetFreeSpaceRemaining();
+    page_free_space_[new_page_id] = new_leaf->GetFreeSpaceRemaining();
+    // retry in the half the tuple belongs to, it is split again if still too full
+    if (index > leaf->GetSize()) {
+      index -= leaf->GetSize();
+      buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+      leaf = new_leaf;
+    } else {
+      buffer_pool_manager_->UnpinPage(new_page_id, true);
+    }
+  }
+  row.SetRowId(RowId(leaf->GetPageId(), index));
+  page_free_space_[leaf->GetPageId()] = leaf->GetFreeSpaceRemaining();
+  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), true);
+}
+
+void ClusteredTableHeap::InsertIntoParent(page_id_t left_page_id, GenericKey *key, page_id_t right_page_id,
+                                          page_id_t parent_page_id) {
+  auto parent = reinterpret_cast<InternalPage *>(buffer_pool_manager_->FetchPage(parent_page_id)->GetData());
+  parent->InsertNodeAfter(left_page_id, key, right_page_id);
+  if (parent->GetSize() <= internal_max_size_) {
+    buffer_pool_manager_->UnpinPage(parent_page_id, true);
+    return;
+  }
+  if (parent->IsRootPage()) {
+    parent = reinterpret_cast<InternalPage *>(PushDownRoot(parent));
+  }
+  page_id_t sibling_page_id;
+  auto sibling = reinterpret_cast<InternalPage *>(buffer_pool_manager_->NewPage(sibling_page_id)->GetData());
+  sibling->Init(sibling_page_id, parent->GetParentPageId(), key_size_, internal_max_size_);
+  page_free_space_[sibling_page_id] = 0;
+  parent->MoveHalfTo(sibling, buffer_pool_manager_);
+  InsertIntoParent(parent->GetPageId(), sibling->KeyAt(0), sibling_page_id, parent->GetParentPageId());
+  buffer_pool_manager_->UnpinPage(sibling_page_id, true);
+  buffer_pool_manager_->UnpinPage(parent->GetPageId(), true);
+}
+
+BPlusTreePage *ClusteredTableHeap::PushDownRoot(BPlusTreePage *root) {
+  page_id_t child_page_id;
+  auto child = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->NewPage(child_page_id)->GetData());
+  if (root->IsLeafPage()) {
+    auto child_leaf = reinterpret_cast<ClusteredLeafPage *>(child);
+    child_leaf->Init(child_page_id, first_page_id_, key_size_);
+    reinterpret_cast<ClusteredLeafPage *>(root)->MoveAllTo(child_leaf);
+    page_free_space_[child_page_id] = child_leaf->GetFreeSpaceRemaining();
+  } else {
+    auto root_internal = reinterpret_cast<InternalPage *>(root);
+    auto child_internal = reinterpret_cast<InternalPage *>(child);
+    child_internal->Init(child_page_id, first_page_id_, key_size_, internal_max_size_);
+    root_internal->MoveAllTo(child_internal, root_internal->KeyAt(0), buffer_pool_manager_);
+    page_free_space_[child_page_id] = 0;
+  }
+  auto new_root = reinterpret_cast<InternalPage *>(root);
+  new_root->Init(first_page_id_, INVALID_PAGE_ID, key_size_, internal_max_size_);
+  new_root->SetValueAt(0, child_page_id);
+  new_root->SetSize(1);
+  page_free_space_[first_page_id_] = 0;
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+  return child;
+}
+
+bool ClusteredTableHeap::MarkDelete(const RowId &rid, Txn *) {
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId())->GetData());
+  int index = static_cast<int>(rid.GetSlotNum());
+  if (!leaf->IsLeafPage() || index >= leaf->GetSize() || leaf->IsDeleted(index)) {
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+    return false;
+  }
+  leaf->MarkDelete(index);
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+  deleted_tuples_++;
+  return true;
+}
+
+bool ClusteredTableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *) {
+  std::vector<Field> fields;
+  for (auto column_index : key_columns_) {
+    fields.emplace_back(*row.GetField(column_index));
+  }
+  if (!processor_.FitsKey(Row(fields), key_schema_)) {
+    return false;
+  }
+  KeyBuffer key_buf;
+  GenericKey *key = key_buf.Get();
+  SerializeKey(row, key);
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId())->GetData());
+  int index = static_cast<int>(rid.GetSlotNum());
+  if (!leaf->IsLeafPage() || index >= leaf->GetSize() || leaf->IsDeleted(index)) {
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+    return false;
+  }
+  bool same_key = processor_.CompareKeys(leaf->KeyAt(index), key) == 0;
+  if (!same_key && ContainsKey(key)) {
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+    return false;
+  }
+  Row stored;
+  if (StoreOverflow(row, stored, max_row_size_) != DB_SUCCESS) {
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+    return false;
+  }
+  Row &new_row = stored.GetFieldCount() == 0 ? row : stored;
+  if (new_row.GetSerializedSize(schema_) > max_row_size_) {
+    FreeOverflow(stored);
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+    return false;
+  }
+  Row old_row;
+  leaf->GetRow(index, &old_row, schema_);
+  if (same_key && leaf->Update(index, new_row, schema_)) {
+    page_free_space_[rid.GetPageId()] = leaf->GetFreeSpaceRemaining();
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+    FreeOverflow(old_row);
+    row.SetRowId(rid);
+    return true;
+  }
+  // the tuple moves: within this leaf after a split, or to the position of its new key
+  leaf->Remove(index);
+  FreeOverflow(old_row);
+  if (same_key) {
+    InsertIntoLeaf(leaf, index, key, new_row);
+  } else {
+    page_free_space_[rid.GetPageId()] = leaf->GetFreeSpaceRemaining();
+    buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+    InsertStoredTuple(key, new_row);
+  }
+  row.SetRowId(new_row.GetRowId());
+  return true;
+}
+
+void ClusteredTableHeap::ApplyDelete(const RowId &rid, Txn *) {
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId())->GetData());
+  int index = static_cast<int>(rid.GetSlotNum());
+  ASSERT(index < leaf->GetSize(), "Invalid slot.");
+  FreeLeafOverflow(leaf, index);
+  leaf->Remove(index);
+  page_free_space_[rid.GetPageId()] = leaf->GetFreeSpaceRemaining();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+}
+
+void ClusteredTableHeap::RollbackDelete(const RowId &rid, Txn *) {
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId())->GetData());
+  int index = static_cast<int>(rid.GetSlotNum());
+  ASSERT(index < leaf->GetSize(), "Invalid slot.");
+  leaf->RollbackDelete(index);
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+  deleted_tuples_ = deleted_tuples_ > 0 ? deleted_tuples_ - 1 : 0;
+}
+
+bool ClusteredTableHeap::GetTuple(Row *row, Txn *, const std::vector<bool> *referenced) {
+  auto page = buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId());
+  if (page == nullptr) {
+    return false;
+  }
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(page->GetData());
+  int index = static_cast<int>(row->GetRowId().GetSlotNum());
+  if (!leaf->IsLeafPage() || index >= leaf->GetSize() || leaf->IsDeleted(index)) {
+    buffer_pool_manager_->UnpinPage(row->GetRowId().GetPageId(), false);
+    return false;
+  }
+  leaf->GetRow(index, row, schema_);
+  buffer_pool_manager_->UnpinPage(row->GetRowId().GetPageId(), false);
+  LoadOverflow(*row, referenced);
+  return true;
+}
+
+void ClusteredTableHeap::FreeLeafOverflow(ClusteredLeafPage *leaf, int index) {
+  Row row;
+  leaf->GetRow(index, &row, schema_);
+  FreeOverflow(row);
+}
+
+uint32_t ClusteredTableHeap::Vacuum(Txn *, std::vector<std::pair<RowId, RowId>> *moved_rows) {
+  uint32_t reclaimed = 0;
+  auto leaf = FindLeaf(nullptr);
+  while (true) {
+    auto page_id = leaf->GetPageId();
+    uint32_t live_count = 0;
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      if (leaf->IsDeleted(i)) {
+        FreeLeafOverflow(leaf, i);
+        continue;
+      }
+      if (moved_rows != nullptr && live_count != static_cast<uint32_t>(i)) {
+        moved_rows->emplace_back(RowId(page_id, i), RowId(page_id, live_count));
+      }
+      live_count++;
+    }
+    reclaimed += leaf->RemoveDeleted();
+    page_free_space_[page_id] = leaf->GetFreeSpaceRemaining();
+    auto next_page_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    if (next_page_id == INVALID_PAGE_ID) {
+      break;
+    }
+    leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(next_page_id)->GetData());
+  }
+  return reclaimed;
+}
+
+void ClusteredTableHeap::DeleteSubtree(page_id_t page_id) {
+  auto page = reinterpret_cast<BPlusTreePage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  if (page->IsLeafPage()) {
+    auto leaf = reinterpret_cast<ClusteredLeafPage *>(page);
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      FreeLeafOverflow(leaf, i);
+    }
+  } else {
+    auto internal = reinterpret_cast<InternalPage *>(page);
+    for (int i = 0; i < internal->GetSize(); i++) {
+      DeleteSubtree(internal->ValueAt(i));
+    }
+  }
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  buffer_pool_manager_->DeletePage(page_id);
+  page_free_space_.erase(page_id);
+}
+
+void ClusteredTableHeap::FreeTableHeap() { DeleteSubtree(first_page_id_); }
+
+void ClusteredTableHeap::DeleteTable(page_id_t page_id) {
+  DeleteSubtree(page_id == INVALID_PAGE_ID ? first_page_id_ : page_id);
+}
+
+bool ClusteredTableHeap::GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *) {
+  auto page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    return false;
+  }
+  rows->clear();
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(page->GetData());
+  for (int i = 0; leaf->IsLeafPage() && i < leaf->GetSize(); i++) {
+    if (!leaf->IsDeleted(i)) {
+      rows->emplace_back(RowId(page_id, i));
+      leaf->GetRow(i, &rows->back(), schema_);
+    }
+  }
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  for (auto &row : *rows) {
+    LoadOverflow(row);
+  }
+  return true;
+}
+
+void ClusteredTableHeap::GetPageIds(std::vector<page_id_t> *page_ids) {
+  page_ids->clear();
+  auto leaf = FindLeaf(nullptr);
+  auto page_id = leaf->GetPageId();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  while (page_id != INVALID_PAGE_ID) {
+    page_ids->push_back(page_id);
+    leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    auto next_page_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+bool ClusteredTableHeap::LowerBound(const Row &key_row, RowId *rid) {
+  KeyBuffer key_buf;
+  GenericKey *key = key_buf.Get();
+  processor_.SerializeFromKey(key, key_row, key_schema_);
+  auto leaf = FindLeaf(key);
+  int index = leaf->KeyIndex(key, processor_);
+  while (index < leaf->GetSize() && leaf->IsDeleted(index)) {
+    index++;
+  }
+  auto page_id = leaf->GetPageId();
+  auto next_page_id = leaf->GetNextPageId();
+  bool found = index < leaf->GetSize();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  if (found) {
+    rid->Set(page_id, index);
+    return true;
+  }
+  return next_page_id != INVALID_PAGE_ID && GetFirstTupleRid(next_page_id, rid);
+}
+
+bool ClusteredTableHeap::FindTuple(const Row &row, RowId *rid) {
+  KeyBuffer key_buf;
+  GenericKey *key = key_buf.Get();
+  SerializeKey(row, key);
+  auto leaf = FindLeaf(key);
+  int index = leaf->KeyIndex(key, processor_);
+  bool found = index < leaf->GetSize() && !leaf->IsDeleted(index) &&
+               processor_.CompareKeys(leaf->KeyAt(index), key) == 0;
+  if (found) {
+    rid->Set(leaf->GetPageId(), index);
+  }
+  buffer_pool_manager_->UnpinPage(leaf->GetPageId(), false);
+  return found;
+}
+
+bool ClusteredTableHeap::GetFirstTupleRid(page_id_t page_id, RowId *first_rid) {
+  if (page_id == first_page_id_) {
+    auto leaf = FindLeaf(nullptr);
+    page_id = leaf->GetPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+  }
+  while (page_id != INVALID_PAGE_ID) {
+    auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+    for (int i = 0; i < leaf->GetSize(); i++) {
+      if (!leaf->IsDeleted(i)) {
+        buffer_pool_manager_->UnpinPage(page_id, false);
+        first_rid->Set(page_id, i);
+        return true;
+      }
+    }
+    auto next_page_id = leaf->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+  return false;
+}
+
+bool ClusteredTableHeap::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
+  auto page_id = cur_rid.GetPageId();
+  auto leaf = reinterpret_cast<ClusteredLeafPage *>(buffer_pool_manager_->FetchPage(page_id)->GetData());
+  for (int i = static_cast<int>(cur_rid.GetSlotNum()) + 1; i < leaf->GetSize(); i++) {
+    if (!leaf->IsDeleted(i)) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      next_rid->Set(page_id, i);
+      return true;
+    }
+  }
+  auto next_page_id = leaf->GetNextPageId();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id != INVALID_PAGE_ID && GetFirstTupleRid(next_page_id, next_rid);
+}
@@ -0,0 +1,287 @@
+#include "storage/pax_table_heap.h"
+
+#include <algorithm>
+
+PaxTableHeap::PaxTableHeap(BufferPoolManager *buffer_pool_manager, Schema *schema, Txn *txn,
+                           LogManager *log_manager, LockManager *lock_manager)
+    : TableHeap(buffer_pool_manager, schema, log_manager, lock_manager) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->NewPage(first_page_id_));
+  page->Init(first_page_id_, INVALID_PAGE_ID, schema_, log_manager_, txn);
+  // for pax pages the free space is counted in slots
+  page_free_space_[first_page_id_] = page->GetFreeSlotCount();
+  last_page_id_ = first_page_id_;
+  buffer_pool_manager_->UnpinPage(first_page_id_, true);
+}
+
+PaxTableHeap::PaxTableHeap(BufferPoolManager *buffer_pool_manager, page_id_t first_page_id, Schema *schema,
+                           LogManager *log_manager, LockManager *lock_manager)
+    : TableHeap(buffer_pool_manager, schema, log_manager, lock_manager) {
+  first_page_id_ = first_page_id;
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page_free_space_[page_id] = page->GetFreeSlotCount();
+    last_page_id_ = page_id;
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+bool PaxTableHeap::InsertTuple(Row &row, Txn *txn) {
+  auto page = std::find_if(page_free_space_.begin(), page_free_space_.end(),
+                           [](const auto &pair) { return pair.second > 0; });
+  PaxPage *page_to_insert = nullptr;
+  if (page == page_free_space_.end()) {
+    page_id_t new_page_id;
+    auto new_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->NewPage(new_page_id));
+    if (new_page == nullptr) return false;
+    new_page->Init(new_page_id, last_page_id_, schema_, log_manager_, txn);
+    auto pre_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(last_page_id_));
+    pre_page->WLatch();
+    pre_page->SetNextPageId(new_page_id);
+    pre_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(last_page_id_, true);
+    last_page_id_ = new_page_id;
+    page_to_insert = new_page;
+  } else {
+    page_to_insert = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page->first));
+  }
+  page_to_insert->WLatch();
+  auto inserted = page_to_insert->InsertTuple(row, schema_, txn, lock_manager_, log_manager_);
+  page_free_space_[page_to_insert->GetTablePageId()] = page_to_insert->GetFreeSlotCount();
+  page_to_insert->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page_to_insert->GetTablePageId(), inserted);
+  if (inserted) {
+    inserted_tuples_++;
+  }
+  return inserted;
+}
+
+bool PaxTableHeap::MarkDelete(const RowId &rid, Txn *txn) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  page->WLatch();
+  auto marked = page->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  if (marked) {
+    deleted_tuples_++;
+  }
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), marked);
+  return marked;
+}
+
+bool PaxTableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  page->WLatch();
+  Row old = Row(rid);
+  auto updated = page->UpdateTuple(row, &old, schema_, txn, lock_manager_, log_manager_);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), updated);
+  if (updated) {
+    row.SetRowId(rid);
+  }
+  return updated;
+}
+
+void PaxTableHeap::ApplyDelete(const RowId &rid, Txn *txn) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  assert(page != nullptr);
+  page->WLatch();
+  page->ApplyDelete(rid, txn, log_manager_);
+  page_free_space_[page->GetTablePageId()] = page->GetFreeSlotCount();
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+}
+
+void PaxTableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  assert(page != nullptr);
+  page->WLatch();
+  page->RollbackDelete(rid, txn, log_manager_);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
+  deleted_tuples_ = deleted_tuples_ > 0 ? deleted_tuples_ - 1 : 0;
+}
+
+bool PaxTableHeap::GetTuple(Row *row, Txn *txn, const std::vector<bool> *) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  auto got = page->GetTuple(row, schema_, txn, lock_manager_);
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
+  return got;
+}
+
+uint32_t PaxTableHeap::Vacuum(Txn *txn, std::vector<std::pair<RowId, RowId>> *) {
+  // tuples never move between pax pages, no row id changes
+  uint32_t reclaimed = 0;
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page->WLatch();
+    reclaimed += page->Vacuum(schema_, txn, log_manager_);
+    page_free_space_[page_id] = page->GetFreeSlotCount();
+    page->WUnlatch();
+    auto next_page_id = page->GetNextPageId();
+    if (page->GetTupleCount() == 0 && page_id != first_page_id_) {
+      ReleasePage(page);
+    } else {
+      buffer_pool_manager_->UnpinPage(page_id, true);
+    }
+    page_id = next_page_id;
+  }
+  return reclaimed;
+}
+
+void PaxTableHeap::ReleasePage(PaxPage *page) {
+  auto page_id = page->GetTablePageId();
+  auto next_page_id = page->GetNextPageId();
+  auto pre_page_id = page->GetPrevPageId();
+  if (next_page_id != INVALID_PAGE_ID) {
+    auto next_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    next_page->WLatch();
+    next_page->SetPrevPageId(pre_page_id);
+    next_page->WUnlatch();
+    buffer_pool_manager_->UnpinPage(next_page_id, true);
+  } else {
+    last_page_id_ = pre_page_id;
+  }
+  auto pre_page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(pre_page_id));
+  pre_page->WLatch();
+  pre_page->SetNextPageId(next_page_id);
+  pre_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(pre_page_id, true);
+  page_free_space_.erase(page_id);
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  buffer_pool_manager_->DeletePage(page_id);
+}
+
+void PaxTableHeap::FreeTableHeap() {
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
+
+void PaxTableHeap::DeleteTable(page_id_t page_id) {
+  if (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page->GetNextPageId() != INVALID_PAGE_ID) DeleteTable(page->GetNextPageId());
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+  } else {
+    DeleteTable(first_page_id_);
+  }
+}
+
+bool PaxTableHeap::GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *txn) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  rows->clear();
+  std::vector<uint32_t> slots;
+  page->RLatch();
+  page->GetLiveSlots(&slots);
+  rows->reserve(slots.size());
+  for (auto slot_num : slots) {
+    rows->emplace_back(RowId(page_id, slot_num));
+    page->GetTuple(&rows->back(), schema_, txn, lock_manager_);
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return true;
+}
+
+void PaxTableHeap::GetPageIds(std::vector<page_id_t> *page_ids) {
+  page_ids->clear();
+  page_ids->reserve(page_free_space_.size());
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page_ids->push_back(page_id);
+    page->RLatch();
+    auto next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    page_id = next_page_id;
+  }
+}
+
+bool PaxTableHeap::ScanColumns(page_id_t page_id, const std::vector<uint32_t> &column_ids, ColumnBatch *batch,
+                               page_id_t *next_page_id) {
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  batch->rids_.clear();
+  batch->columns_.clear();
+  batch->columns_.resize(column_ids.size());
+  std::vector<uint32_t> slots;
+  page->RLatch();
+  page->GetLiveSlots(&slots);
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    page->GetColumn(schema_, column_ids[i], slots, &batch->columns_[i]);
+  }
+  *next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  batch->rids_.reserve(slots.size());
+  for (auto slot_num : slots) {
+    batch->rids_.emplace_back(page_id, slot_num);
+  }
+  return true;
+}
+
+bool PaxTableHeap::GetFirstTupleRid(page_id_t page_id, RowId *first_rid) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      DLOG(ERROR) << "Failed to fetch page";
+      return false;
+    }
+    page->RLatch();
+    auto got = page->GetFirstTupleRid(first_rid);
+    auto next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (got) {
+      return true;
+    }
+    page_id = next_page_id;
+  }
+  return false;
+}
+
+bool PaxTableHeap::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
+  // cur_rid may be next_rid itself, e.g. for the iterator, and is overwritten by the page
+  auto page_id = cur_rid.GetPageId();
+  auto page = reinterpret_cast<PaxPage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    DLOG(ERROR) << "Failed to fetch page";
+    return false;
+  }
+  page->RLatch();
+  auto got = page->GetNextTupleRid(cur_rid, next_rid);
+  auto next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return got || GetFirstTupleRid(next_page_id, next_rid);
+}
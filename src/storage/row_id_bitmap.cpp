@@ -0,0 +1,78 @@
+#include "storage/row_id_bitmap.h"
+
+#include <algorithm>
+
+void RowIdBitmap::Add(const RowId &rid) {
+  auto &words = pages_[rid.GetPageId()];
+  uint32_t word = rid.GetSlotNum() / WORD_BITS;
+  if (word >= words.size()) {
+    words.resize(word + 1, 0);
+  }
+  words[word] |= uint64_t{1} << (rid.GetSlotNum() % WORD_BITS);
+}
+
+bool RowIdBitmap::Contains(const RowId &rid) const {
+  auto page = pages_.find(rid.GetPageId());
+  if (page == pages_.end()) {
+    return false;
+  }
+  uint32_t word = rid.GetSlotNum() / WORD_BITS;
+  return word < page->second.size() && (page->second[word] >> (rid.GetSlotNum() % WORD_BITS) & 1) != 0;
+}
+
+void RowIdBitmap::Intersect(const RowIdBitmap &other) {
+  for (auto page = pages_.begin(); page != pages_.end();) {
+    auto other_page = other.pages_.find(page->first);
+    if (other_page == other.pages_.end()) {
+      page = pages_.erase(page);
+      continue;
+    }
+    auto &words = page->second;
+    const auto &other_words = other_page->second;
+    words.resize(std::min(words.size(), other_words.size()));
+    bool any = false;
+    for (size_t i = 0; i < words.size(); i++) {
+      words[i] &= other_words[i];
+      any = any || words[i] != 0;
+    }
+    page = any ? std::next(page) : pages_.erase(page);
+  }
+}
+
+void RowIdBitmap::Union(const RowIdBitmap &other) {
+  for (const auto &other_page : other.pages_) {
+    auto &words = pages_[other_page.first];
+    if (words.size() < other_page.second.size()) {
+      words.resize(other_page.second.size(), 0);
+    }
+    for (size_t i = 0; i < other_page.second.size(); i++) {
+      words[i] |= other_page.second[i];
+    }
+  }
+}
+
+size_t RowIdBitmap::GetSize() const {
+  size_t size = 0;
+  for (const auto &page : pages_) {
+    for (auto word : page.second) {
+      size += __builtin_popcountll(word);
+    }
+  }
+  return size;
+}
+
+bool RowIdBitmap::PopPage(page_id_t *page_id, std::vector<uint32_t> *slots) {
+  if (pages_.empty()) {
+    return false;
+  }
+  auto page = pages_.begin();
+  *page_id = page->first;
+  slots->clear();
+  for (size_t i = 0; i < page->second.size(); i++) {
+    for (auto word = page->second[i]; word != 0; word &= word - 1) {
+      slots->push_back(i * WORD_BITS + __builtin_ctzll(word));
+    }
+  }
+  pages_.erase(page);
+  return true;
+}
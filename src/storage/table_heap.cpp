@@ -1,8 +1,32 @@
 #include "storage/table_heap.h"
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
 
 bool TableHeap::InsertTuple(Row &row, Txn *txn) {
+  Row stored;
+  if (StoreOverflow(row, stored) != DB_SUCCESS) {
+    return false;
+  }
+  if (stored.GetFieldCount() == 0) {
+    if (!InsertStoredTuple(row, txn)) {
+      return false;
+    }
+    inserted_tuples_++;
+    return true;
+  }
+  if (!InsertStoredTuple(stored, txn)) {
+    FreeOverflow(stored);
+    return false;
+  }
+  row.SetRowId(stored.GetRowId());
+  inserted_tuples_++;
+  return true;
+}
+
+bool TableHeap::InsertStoredTuple(Row &row, Txn *txn, bool moved) {
   auto row_size = row.GetSerializedSize(schema_);
   //DLOG(INFO) << "Row size: " << row_size;
   if (row_size >= PAGE_SIZE) {
@@ -19,11 +43,19 @@ bool TableHeap::InsertTuple(Row &row, Txn *txn) {
     page_id_t new_page_id;
     auto new_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->NewPage(new_page_id));
     if (new_page == nullptr) return false;
-    // setup the new page
-    new_page->Init(new_page_id, page_free_space_.rbegin()->first, log_manager_, txn);
-    // link to the previous page
+    // Page ids of freed overflow pages are reused, so the largest page id is not always the last page:
+    // follow the chain from it to the end.
     auto pre_page_id = page_free_space_.rbegin()->first;
     auto pre_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(pre_page_id));
+    while (pre_page->GetNextPageId() != INVALID_PAGE_ID) {
+      auto next_page_id = pre_page->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(pre_page_id, false);
+      pre_page_id = next_page_id;
+      pre_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(pre_page_id));
+    }
+    // setup the new page
+    new_page->Init(new_page_id, pre_page_id, log_manager_, txn);
+    // link to the previous page
     pre_page->WLatch();
     pre_page->SetNextPageId(new_page_id);
     pre_page->WUnlatch();
@@ -40,11 +72,23 @@ bool TableHeap::InsertTuple(Row &row, Txn *txn) {
     //DLOG(ERROR) << "InsertTuple Failed";
     return false;
   }
+  if (moved) {
+    page_to_insert->SetMoved(row.GetRowId().GetSlotNum());
+  }
   page_to_insert->WUnlatch();
   // Update the free space of the page.
   page_free_space_[page_to_insert->GetTablePageId()] = page_to_insert->GetFreeSpaceRemaining();
   //DLOG(INFO) << "Free space remaining: " << page_to_insert->GetFreeSpaceRemaining();
   buffer_pool_manager_->UnpinPage(page_to_insert->GetPageId(), true);
+  if (page == page_free_space_.end()) {
+    // the zone map of a new page covers all its tuples from the start
+    std::scoped_lock<std::mutex> lock(zone_map_latch_);
+    zone_maps_[page_to_insert->GetTablePageId()] = ZoneMap(schema_);
+  }
+  // a moved tuple is scanned through the forwarding slot of its home page, it counts for that page
+  if (!moved) {
+    UpdateZoneMap(row.GetRowId().GetPageId(), row);
+  }
   return true;
 }
 
@@ -57,44 +101,92 @@ bool TableHeap::MarkDelete(const RowId &rid, Txn *txn) {
   }
   // Otherwise, mark the tuple as deleted.
   page->WLatch();
-  page->MarkDelete(rid, txn, lock_manager_, log_manager_);
+  if (page->MarkDelete(rid, txn, lock_manager_, log_manager_)) {
+    deleted_tuples_++;
+  }
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
   return true;
 }
 
 bool TableHeap::UpdateTuple(Row &row, const RowId &rid, Txn *txn) {
-  auto row_size = row.GetSerializedSize(schema_);
+  Row stored;
+  if (StoreOverflow(row, stored) != DB_SUCCESS) {
+    return false;
+  }
+  Row &new_row = stored.GetFieldCount() == 0 ? row : stored;
+  auto row_size = new_row.GetSerializedSize(schema_);
   if (row_size >= PAGE_SIZE) {
     //DLOG(ERROR) << "The tuple is too large to insert.";
+    FreeOverflow(stored);
+    return false;
+  }
+  // A forwarded tuple is updated where it is stored now.
+  RowId tuple_rid = rid;
+  GetForward(rid, &tuple_rid);
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(tuple_rid.GetPageId()));
+  if (page == nullptr) {
+    FreeOverflow(stored);
     return false;
   }
-  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
-  if (page == nullptr) return false;
   page->WLatch();
-  Row old = Row(rid);
-  auto updated = page->UpdateTuple(row, &old, schema_, txn, lock_manager_, log_manager_);
+  Row old = Row(tuple_rid);
+  auto updated = page->UpdateTuple(new_row, &old, schema_, txn, lock_manager_, log_manager_);
+  auto slot_num = tuple_rid.GetSlotNum();
+  auto live = slot_num < page->GetTupleCount() && !TablePage::IsDeleted(page->GetTupleSize(slot_num));
   page_free_space_[page->GetTablePageId()] = page->GetFreeSpaceRemaining();
   page->WUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), updated);
   if (updated) {
+    // the old values are not referenced any more
+    FreeOverflow(old);
+    UpdateZoneMap(rid.GetPageId(), new_row);
+    row.SetRowId(rid);
     return true;
   }
-  // Delete the old tuple.
-  if (!MarkDelete(rid, txn)) {
+  // The new tuple does not fit into the page, store it in another page and leave a forwarding slot
+  // behind, so the row id of the tuple does not change.
+  if (!live || !InsertStoredTuple(new_row, txn, true)) {
+    FreeOverflow(stored);
     return false;
   }
-  ApplyDelete(rid, txn);  // [TODO] rollback delete
-  // Insert the new tuple.
-  return InsertTuple(row, txn);
+  auto home_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  assert(home_page != nullptr);
+  home_page->WLatch();
+  Row old_row;
+  if (tuple_rid == rid) {
+    home_page->SetForward(rid.GetSlotNum(), new_row.GetRowId(), &old_row, schema_);
+    page_free_space_[rid.GetPageId()] = home_page->GetFreeSpaceRemaining();
+  } else {
+    home_page->ResetForward(rid.GetSlotNum(), new_row.GetRowId());
+  }
+  home_page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), true);
+  if (tuple_rid == rid) {
+    FreeOverflow(old_row);
+  } else {
+    // the previous location is not referenced any more
+    ApplyDelete(tuple_rid, txn);
+  }
+  UpdateZoneMap(rid.GetPageId(), new_row);
+  row.SetRowId(rid);
+  return true;
 }
 
 void TableHeap::ApplyDelete(const RowId &rid, Txn *txn) {
+  RowId target;
+  if (GetForward(rid, &target)) {
+    // The forwarding slot keeps the page alive if the tuple is stored in the same page.
+    ApplyDelete(target, txn);
+  }
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
   assert(page != nullptr);
   // Apply the delete.
   page->WLatch();
+  if (rid.GetSlotNum() < page->GetTupleCount()) {
+    FreeOverflow(page, rid.GetSlotNum());
+  }
   page->ApplyDelete(rid, txn, log_manager_);
   page_free_space_[page->GetTablePageId()] = page->GetFreeSpaceRemaining();
   page->WUnlatch();
@@ -116,8 +208,12 @@ void TableHeap::ApplyDelete(const RowId &rid, Txn *txn) {
       pre_page->WUnlatch();
       buffer_pool_manager_->UnpinPage(pre_page_id, true);
     }
-    buffer_pool_manager_->DeletePage(page->GetTablePageId());
-    page_free_space_.erase(page->GetTablePageId());
+    auto page_id = page->GetTablePageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_free_space_.erase(page_id);
+    std::scoped_lock<std::mutex> lock(zone_map_latch_);
+    zone_maps_.erase(page_id);
   } else
     buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
@@ -130,10 +226,11 @@ void TableHeap::RollbackDelete(const RowId &rid, Txn *txn) {
   page->WLatch();
   page->RollbackDelete(rid, txn, log_manager_);
   page->WUnlatch();
+  deleted_tuples_ = deleted_tuples_ > 0 ? deleted_tuples_ - 1 : 0;
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), true);
 }
 
-bool TableHeap::GetTuple(Row *row, Txn *txn) {
+bool TableHeap::GetTuple(Row *row, Txn *txn, const std::vector<bool> *referenced) {
   // Find the page which contains the tuple.
   auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(row->GetRowId().GetPageId()));
   // If the page could not be found, then abort the recovery.
@@ -142,15 +239,179 @@ bool TableHeap::GetTuple(Row *row, Txn *txn) {
   }
   // Otherwise, get the tuple from the page.
   page->RLatch();
-  page->GetTuple(row, schema_, txn, lock_manager_);
+  RowId rid = row->GetRowId();
+  RowId target;
+  auto forward = page->GetForward(rid, &target) && !TablePage::IsDeleted(page->GetTupleSize(rid.GetSlotNum()));
+  if (!forward) {
+    page->GetTuple(row, schema_, txn, lock_manager_);
+  }
   page->RUnlatch();
   buffer_pool_manager_->UnpinPage(page->GetTablePageId(), false);
+  if (forward) {
+    // follow the forwarding slot, the row keeps the row id it was asked with
+    row->SetRowId(target);
+    GetTuple(row, txn, referenced);
+    row->SetRowId(rid);
+    return true;
+  }
+  LoadOverflow(*row, referenced);
   return true;
 }
 
+bool TableHeap::GetForward(const RowId &rid, RowId *target) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  auto forward = page->GetForward(rid, target);
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+  return forward;
+}
+
+uint32_t TableHeap::UpgradeTupleFormat([[maybe_unused]] Txn *txn) {
+  ASSERT(schema_->GetTupleFormat() == TupleFormat::kV1, "The tuples are not in the v1 format.");
+  // the old tuples are read with a copy of the schema which keeps the v1 format
+  std::vector<uint32_t> column_indexes(schema_->GetColumnCount());
+  std::iota(column_indexes.begin(), column_indexes.end(), 0);
+  std::unique_ptr<Schema> old_schema(Schema::ShallowCopySchema(schema_, column_indexes));
+  schema_->SetTupleFormat(TupleFormat::kV2);
+  uint32_t reclaimed = 0;
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page->WLatch();
+    reclaimed += page->ConvertTuples(old_schema.get(), schema_);
+    page_free_space_[page_id] = page->GetFreeSpaceRemaining();
+    page->WUnlatch();
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_id = next_page_id;
+  }
+  return reclaimed;
+}
+
+uint32_t TableHeap::Vacuum(Txn *txn, std::vector<std::pair<RowId, RowId>> *moved_rows) {
+  uint32_t reclaimed = 0;
+  // Tuples move between pages, the zone maps are built again when a scan needs them.
+  {
+    std::scoped_lock<std::mutex> lock(zone_map_latch_);
+    zone_maps_.clear();
+  }
+  // tuples of the deleted forwarding slots, removed once every page is compacted
+  std::vector<RowId> forwarded;
+  // Compact every page in place.
+  auto page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page->WLatch();
+    for (uint32_t i = 0; i < page->GetTupleCount(); i++) {
+      if (page->GetTupleSize(i) & TablePage::DELETE_MASK) {
+        RowId target;
+        if (page->GetForward(RowId(page_id, i), &target)) {
+          forwarded.push_back(target);
+        }
+        FreeOverflow(page, i);
+      }
+    }
+    reclaimed += page->Vacuum(txn, log_manager_);
+    page_free_space_[page_id] = page->GetFreeSpaceRemaining();
+    page->WUnlatch();
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_id = next_page_id;
+  }
+  for (auto &rid : forwarded) {
+    ApplyDelete(rid, txn);
+  }
+  // Merge the next page into the current one as long as all of its tuples fit.
+  // new location of every moved tuple, their forwarding slots are updated afterwards
+  std::unordered_map<int64_t, RowId> relocated;
+  page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    auto next_page_id = page->GetNextPageId();
+    if (next_page_id == INVALID_PAGE_ID) {
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      break;
+    }
+    auto next_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(next_page_id));
+    assert(next_page != nullptr);
+    // After compaction the tuple area of the next page only holds live tuples.
+    uint32_t live_count = 0;
+    for (uint32_t i = 0; i < next_page->GetTupleCount(); i++) {
+      if (!TablePage::IsDeleted(next_page->GetTupleSize(i))) live_count++;
+    }
+    uint32_t required = PAGE_SIZE - next_page->GetFreeSpacePointer() + live_count * TablePage::SIZE_TUPLE;
+    if (required > page->GetFreeSpaceRemaining()) {
+      buffer_pool_manager_->UnpinPage(next_page_id, false);
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+      continue;
+    }
+    page->WLatch();
+    next_page->WLatch();
+    for (uint32_t i = 0; i < next_page->GetTupleCount(); i++) {
+      if (TablePage::IsDeleted(next_page->GetTupleSize(i))) continue;
+      RowId new_rid;
+      page->CopyTupleFrom(next_page, i, &new_rid);
+      if (TablePage::IsMoved(next_page->GetTupleSize(i))) {
+        relocated.emplace(RowId(next_page_id, i).Get(), new_rid);
+      } else if (moved_rows != nullptr) {
+        moved_rows->emplace_back(RowId(next_page_id, i), new_rid);
+      }
+    }
+    // unlink the next page
+    auto after_page_id = next_page->GetNextPageId();
+    page->SetNextPageId(after_page_id);
+    next_page->WUnlatch();
+    page->WUnlatch();
+    if (after_page_id != INVALID_PAGE_ID) {
+      auto after_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(after_page_id));
+      after_page->WLatch();
+      after_page->SetPrevPageId(page_id);
+      after_page->WUnlatch();
+      buffer_pool_manager_->UnpinPage(after_page_id, true);
+    }
+    page_free_space_[page_id] = page->GetFreeSpaceRemaining();
+    page_free_space_.erase(next_page_id);
+    buffer_pool_manager_->UnpinPage(next_page_id, false);
+    buffer_pool_manager_->DeletePage(next_page_id);
+    // stay on this page, it may absorb the following one as well
+    buffer_pool_manager_->UnpinPage(page_id, true);
+  }
+  if (relocated.empty()) {
+    return reclaimed;
+  }
+  page_id = first_page_id_;
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    page->WLatch();
+    for (uint32_t i = 0; i < page->GetTupleCount(); i++) {
+      RowId target;
+      if (page->GetForward(RowId(page_id, i), &target) && relocated.count(target.Get()) > 0) {
+        page->ResetForward(i, relocated[target.Get()]);
+      }
+    }
+    page->WUnlatch();
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    page_id = next_page_id;
+  }
+  return reclaimed;
+}
+
 void TableHeap::DeleteTable(page_id_t page_id) {
   if (page_id != INVALID_PAGE_ID) {
     auto temp_table_page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));  // 删除table_heap
+    for (uint32_t i = 0; i < temp_table_page->GetTupleCount(); i++) {
+      FreeOverflow(temp_table_page, i);
+    }
     if (temp_table_page->GetNextPageId() != INVALID_PAGE_ID) DeleteTable(temp_table_page->GetNextPageId());
     buffer_pool_manager_->UnpinPage(page_id, false);
     buffer_pool_manager_->DeletePage(page_id);
@@ -159,6 +420,388 @@ void TableHeap::DeleteTable(page_id_t page_id) {
   }
 }
 
-TableIterator TableHeap::Begin(Txn *txn) { return TableIterator(this, RowId{0}, txn); }
+dberr_t TableHeap::StoreOverflow(const Row &row, Row &stored, uint32_t max_row_size) {
+  uint32_t field_count = row.GetFieldCount();
+  if (!schema_->HasNullBitmap()) {
+    for (uint32_t i = 0; i < field_count; i++) {
+      if (row.GetField(i)->IsNull()) {
+        return DB_FAILED;
+      }
+    }
+  }
+  std::vector<bool> external(field_count, false);
+  uint32_t external_count = 0;
+  uint32_t row_size = row.GetSerializedSize(schema_);
+  auto move_out = [&](uint32_t i) {
+    external[i] = true;
+    external_count++;
+    row_size -= row.GetField(i)->GetLength() - OVERFLOW_POINTER_SIZE;
+  };
+  for (uint32_t i = 0; i < field_count; i++) {
+    auto field = row.GetField(i);
+    if (field->GetTypeId() == kTypeChar && !field->IsNull() && field->GetLength() > VARCHAR_INLINE_MAX_LEN) {
+      move_out(i);
+    }
+  }
+  // move out the longest values until the row fits
+  while (row_size > max_row_size) {
+    uint32_t longest = field_count;
+    for (uint32_t i = 0; i < field_count; i++) {
+      auto field = row.GetField(i);
+      if (external[i] || field->GetTypeId() != kTypeChar || field->IsNull() ||
+          field->GetLength() <= OVERFLOW_POINTER_SIZE) {
+        continue;
+      }
+      if (longest == field_count || field->GetLength() > row.GetField(longest)->GetLength()) {
+        longest = i;
+      }
+    }
+    if (longest == field_count) break;
+    move_out(longest);
+  }
+  if (external_count == 0) {
+    return DB_SUCCESS;
+  }
+  // the values kept in the row are not copied until the stored row is built
+  std::vector<const Field *> fields;
+  fields.reserve(field_count);
+  std::vector<Field> pointers;
+  pointers.reserve(external_count);
+  for (uint32_t i = 0; i < field_count; i++) {
+    auto field = row.GetField(i);
+    if (!external[i]) {
+      fields.push_back(field);
+      continue;
+    }
+    // in-row pointer: first overflow page id | value length
+    char pointer[OVERFLOW_POINTER_SIZE];
+    page_id_t first_page_id = WriteOverflowChain(field->GetData(), field->GetLength());
+    MACH_WRITE_TO(page_id_t, pointer, first_page_id);
+    MACH_WRITE_UINT32(pointer + sizeof(page_id_t), field->GetLength());
+    pointers.emplace_back(kTypeChar, pointer, OVERFLOW_POINTER_SIZE, true);
+    pointers.back().SetExternal(true);
+    fields.push_back(&pointers.back());
+    if (first_page_id == INVALID_PAGE_ID) {
+      FreeOverflow(Row(fields));
+      return DB_FAILED;
+    }
+  }
+  Row stored_row(fields);
+  Swap(stored, stored_row);
+  stored.SetRowId(row.GetRowId());
+  return DB_SUCCESS;
+}
+
+void TableHeap::LoadOverflow(Row &row, const std::vector<bool> *referenced) {
+  auto &fields = row.GetFields();
+  for (uint32_t i = 0; i < fields.size(); i++) {
+    auto field = fields[i];
+    if (!field->IsExternal() || (referenced != nullptr && !(*referenced)[i])) continue;
+    auto page_id = MACH_READ_FROM(page_id_t, field->GetData());
+    auto len = MACH_READ_UINT32(field->GetData() + sizeof(page_id_t));
+    std::unique_ptr<char[]> value(new char[len]);
+    uint32_t offset = 0;
+    while (page_id != INVALID_PAGE_ID) {
+      auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id));
+      assert(page != nullptr);
+      memcpy(value.get() + offset, page->GetValueData(), page->GetDataSize());
+      offset += page->GetDataSize();
+      auto next_page_id = page->GetNextPageId();
+      buffer_pool_manager_->UnpinPage(page_id, false);
+      page_id = next_page_id;
+    }
+    ASSERT(offset == len, "Overflow chain does not match the value length.");
+    Field loaded(kTypeChar, value.get(), len, true);
+    *field = loaded;
+  }
+}
+
+void TableHeap::FreeOverflow(TablePage *page, uint32_t slot_num) {
+  uint32_t tuple_size = page->GetTupleSize(slot_num);
+  // a forwarding slot does not hold the values
+  if (TablePage::IsForward(tuple_size) || TablePage::GetTupleLength(tuple_size) == 0) return;
+  Row row;
+  row.DeserializeFrom(page->GetData() + page->GetTupleOffsetAtSlot(slot_num), schema_);
+  FreeOverflow(row);
+}
+
+void TableHeap::FreeOverflow(const Row &row) {
+  for (uint32_t i = 0; i < row.GetFieldCount(); i++) {
+    auto field = row.GetField(i);
+    if (field->IsExternal()) {
+      FreeOverflowChain(MACH_READ_FROM(page_id_t, field->GetData()));
+    }
+  }
+}
+
+page_id_t TableHeap::WriteOverflowChain(const char *data, uint32_t len) {
+  // write from the tail so that every page knows its successor
+  page_id_t next_page_id = INVALID_PAGE_ID;
+  uint32_t page_count = (len + OverflowPage::SIZE_MAX_DATA - 1) / OverflowPage::SIZE_MAX_DATA;
+  for (uint32_t i = page_count; i > 0; i--) {
+    page_id_t page_id;
+    auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->NewPage(page_id));
+    if (page == nullptr) {
+      FreeOverflowChain(next_page_id);
+      return INVALID_PAGE_ID;
+    }
+    uint32_t offset = (i - 1) * OverflowPage::SIZE_MAX_DATA;
+    page->Init(next_page_id, data + offset, std::min<uint32_t>(OverflowPage::SIZE_MAX_DATA, len - offset));
+    buffer_pool_manager_->UnpinPage(page_id, true);
+    next_page_id = page_id;
+  }
+  return next_page_id;
+}
+
+void TableHeap::FreeOverflowChain(page_id_t page_id) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<OverflowPage *>(buffer_pool_manager_->FetchPage(page_id));
+    assert(page != nullptr);
+    auto next_page_id = page->GetNextPageId();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    buffer_pool_manager_->DeletePage(page_id);
+    page_id = next_page_id;
+  }
+}
+
+bool TableHeap::GetFirstTupleRid(page_id_t page_id, RowId *first_rid) {
+  while (page_id != INVALID_PAGE_ID) {
+    auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+    if (page == nullptr) {
+      DLOG(ERROR) << "Failed to fetch page";
+      return false;
+    }
+    page->RLatch();
+    auto got = page->GetFirstTupleRid(first_rid);
+    auto next_page_id = page->GetNextPageId();
+    page->RUnlatch();
+    buffer_pool_manager_->UnpinPage(page_id, false);
+    if (got) {
+      return true;
+    }
+    page_id = next_page_id;
+  }
+  return false;
+}
+
+bool TableHeap::GetNextTupleRid(const RowId &cur_rid, RowId *next_rid) {
+  // cur_rid may be next_rid itself, e.g. for the iterator, and is overwritten by the page
+  auto page_id = cur_rid.GetPageId();
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    DLOG(ERROR) << "Failed to fetch page";
+    return false;
+  }
+  page->RLatch();
+  auto got = page->GetNextTupleRid(cur_rid, next_rid);
+  auto next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return got || GetFirstTupleRid(next_page_id, next_rid);
+}
+
+bool TableHeap::GetPageTuples(page_id_t page_id, std::vector<Row> *rows, Txn *txn) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  rows->clear();
+  // positions of the forwarding slots, followed once the page is released
+  std::vector<size_t> forwarded;
+  page->RLatch();
+  rows->reserve(page->GetTupleCount());
+  RowId rid;
+  for (auto got = page->GetFirstTupleRid(&rid); got; got = page->GetNextTupleRid(rid, &rid)) {
+    rows->emplace_back(rid);
+    if (!page->GetTuple(&rows->back(), schema_, txn, lock_manager_)) {
+      forwarded.push_back(rows->size() - 1);
+    }
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  size_t next_forwarded = 0;
+  for (size_t i = 0; i < rows->size(); i++) {
+    if (next_forwarded < forwarded.size() && forwarded[next_forwarded] == i) {
+      next_forwarded++;
+      GetTuple(&(*rows)[i], txn);
+    } else {
+      LoadOverflow((*rows)[i]);
+    }
+  }
+  return true;
+}
+
+void TableHeap::GetPageIds(std::vector<page_id_t> *page_ids) {
+  page_ids->clear();
+  page_ids->reserve(page_free_space_.size());
+  for (auto page_id = first_page_id_; page_id != INVALID_PAGE_ID; page_id = GetNextPageId(page_id)) {
+    page_ids->push_back(page_id);
+  }
+}
+
+bool TableHeap::VisitPage(page_id_t page_id, const TupleVisitor &visit, Txn *txn, page_id_t *next_page_id,
+                          const std::vector<bool> *referenced) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  RowId rid;
+  for (auto got = page->GetFirstTupleRid(&rid); got; got = page->GetNextTupleRid(rid, &rid)) {
+    auto data = page->GetTupleData(rid.GetSlotNum());
+    if (data != nullptr && visit(TupleView(data, schema_, rid))) {
+      continue;
+    }
+    // the page stays pinned, the latch is released while the tuple is read like the iterator does
+    page->RUnlatch();
+    VisitCopy(rid, visit, txn, referenced);
+    page->RLatch();
+  }
+  if (next_page_id != nullptr) {
+    *next_page_id = page->GetNextPageId();
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return true;
+}
+
+bool TableHeap::VisitTuple(const RowId &rid, const TupleVisitor &visit, Txn *txn,
+                           const std::vector<bool> *referenced) {
+  if (GetLayout() != TableLayout::kRow) {
+    return VisitCopy(rid, visit, txn, referenced);
+  }
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(rid.GetPageId()));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  auto data = page->GetTupleData(rid.GetSlotNum());
+  bool visited = data != nullptr && visit(TupleView(data, schema_, rid));
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(rid.GetPageId(), false);
+  return visited || VisitCopy(rid, visit, txn, referenced);
+}
+
+bool TableHeap::VisitSlots(page_id_t page_id, const std::vector<uint32_t> &slots, const TupleVisitor &visit,
+                           Txn *txn, const std::vector<bool> *referenced) {
+  if (GetLayout() != TableLayout::kRow) {
+    for (auto slot : slots) {
+      VisitCopy(RowId(page_id, slot), visit, txn, referenced);
+    }
+    return true;
+  }
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return false;
+  }
+  page->RLatch();
+  for (auto slot : slots) {
+    auto data = page->GetTupleData(slot);
+    if (data != nullptr && visit(TupleView(data, schema_, RowId(page_id, slot)))) {
+      continue;
+    }
+    // a forwarded tuple or one turned down by the visitor is read like VisitPage does
+    page->RUnlatch();
+    VisitCopy(RowId(page_id, slot), visit, txn, referenced);
+    page->RLatch();
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return true;
+}
+
+bool TableHeap::VisitCopy(const RowId &rid, const TupleVisitor &visit, Txn *txn,
+                          const std::vector<bool> *referenced) {
+  Row row(rid);
+  GetTuple(&row, txn, referenced);
+  if (row.GetFieldCount() == 0) {
+    return false;
+  }
+  std::vector<char> data(row.GetSerializedSize(schema_));
+  row.SerializeTo(data.data(), schema_);
+  visit(TupleView(data.data(), schema_, rid));
+  return true;
+}
+
+bool TableHeap::PageMayMatch(page_id_t page_id, const std::vector<ZonePredicate> &predicates, Txn *txn) {
+  auto may_match = [&predicates](const ZoneMap &zone_map) {
+    return std::all_of(predicates.begin(), predicates.end(),
+                       [&zone_map](const ZonePredicate &predicate) { return zone_map.MayMatch(predicate); });
+  };
+  {
+    std::scoped_lock<std::mutex> lock(zone_map_latch_);
+    auto zone_map = zone_maps_.find(page_id);
+    if (zone_map != zone_maps_.end()) {
+      return may_match(zone_map->second);
+    }
+  }
+  // Build the zone map in a single pass over the page, without holding zone_map_latch_ while the page is read.
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  if (page == nullptr) {
+    return true;
+  }
+  ZoneMap zone_map(schema_);
+  std::vector<RowId> forwarded;
+  page->RLatch();
+  RowId rid;
+  for (auto got = page->GetFirstTupleRid(&rid); got; got = page->GetNextTupleRid(rid, &rid)) {
+    auto data = page->GetTupleData(rid.GetSlotNum());
+    if (data != nullptr) {
+      zone_map.Update(TupleView(data, schema_, rid));
+    } else {
+      forwarded.push_back(rid);
+    }
+  }
+  // Published before the page latch is released, so every later write to the page widens it. The forwarded
+  // tuples are read without the latch, the zone map matches everything until they are added.
+  zone_map.SetPartial(!forwarded.empty());
+  bool matches = may_match(zone_map);
+  bool published;
+  {
+    std::scoped_lock<std::mutex> lock(zone_map_latch_);
+    published = zone_maps_.emplace(page_id, std::move(zone_map)).second;
+  }
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  if (!published || forwarded.empty()) {
+    return matches;
+  }
+  for (auto &forward_rid : forwarded) {
+    Row row(forward_rid);
+    GetTuple(&row, txn);
+    if (row.GetFieldCount() > 0) {
+      UpdateZoneMap(page_id, row);
+    }
+  }
+  std::scoped_lock<std::mutex> lock(zone_map_latch_);
+  auto published_map = zone_maps_.find(page_id);
+  if (published_map == zone_maps_.end()) {
+    return true;
+  }
+  published_map->second.SetPartial(false);
+  return may_match(published_map->second);
+}
+
+page_id_t TableHeap::GetNextPageId(page_id_t page_id) {
+  auto page = reinterpret_cast<TablePage *>(buffer_pool_manager_->FetchPage(page_id));
+  assert(page != nullptr);
+  page->RLatch();
+  auto next_page_id = page->GetNextPageId();
+  page->RUnlatch();
+  buffer_pool_manager_->UnpinPage(page_id, false);
+  return next_page_id;
+}
+
+void TableHeap::UpdateZoneMap(page_id_t page_id, const Row &row) {
+  std::scoped_lock<std::mutex> lock(zone_map_latch_);
+  auto zone_map = zone_maps_.find(page_id);
+  if (zone_map != zone_maps_.end()) {
+    zone_map->second.Update(row);
+  }
+}
+
+TableIterator TableHeap::Begin(Txn *txn, const std::vector<bool> *referenced) {
+  return TableIterator(this, RowId{0}, txn, referenced);
+}
 
 TableIterator TableHeap::End() { return TableIterator(this, RowId{-1}, nullptr); }
@@ -0,0 +1,113 @@
+#include "storage/zone_map.h"
+
+ZoneMap::ZoneMap(const Schema *schema) : columns_(schema->GetColumnCount()) {
+  for (uint32_t i = 0; i < schema->GetColumnCount(); i++) {
+    auto type = schema->GetColumn(i)->GetType();
+    columns_[i].type_ = type;
+    columns_[i].tracked_ = type != TypeId::kTypeChar;
+  }
+}
+
+void ZoneMap::Update(const Row &row) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    auto field = row.GetField(i);
+    if (columns_[i].tracked_ && !field->IsNull()) {
+      Widen(&columns_[i], *field);
+    }
+  }
+}
+
+void ZoneMap::Update(const TupleView &tuple) {
+  alignas(Field) char buf[sizeof(Field)];
+  auto field = reinterpret_cast<Field *>(buf);
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    if (!columns_[i].tracked_) {
+      continue;
+    }
+    tuple.DecodeColumn(i, field);
+    if (!field->IsNull()) {
+      Widen(&columns_[i], *field);
+    }
+    field->~Field();
+  }
+}
+
+bool ZoneMap::MayMatch(const ZonePredicate &predicate) const {
+  auto &range = columns_[predicate.column_];
+  auto &value = *predicate.value_;
+  auto &comparison = predicate.comparison_;
+  if (partial_ || !range.tracked_ || value.IsNull() || !IsRangeComparison(comparison) ||
+      range.type_ != value.GetTypeId()) {
+    return true;
+  }
+  // comparisons with null are never true
+  if (!range.has_values_) {
+    return false;
+  }
+  auto bound = ToBound(value);
+  int min_cmp = Compare(range, range.min_, bound);
+  int max_cmp = Compare(range, range.max_, bound);
+  if (comparison == "=") {
+    return min_cmp <= 0 && max_cmp >= 0;
+  }
+  if (comparison == "<>") {
+    return min_cmp != 0 || max_cmp != 0;
+  }
+  if (comparison == "<") {
+    return min_cmp < 0;
+  }
+  if (comparison == "<=") {
+    return min_cmp <= 0;
+  }
+  if (comparison == ">") {
+    return max_cmp > 0;
+  }
+  return max_cmp >= 0;
+}
+
+bool ZoneMap::IsRangeComparison(const std::string &comparison) {
+  return comparison == "=" || comparison == "<>" || comparison == "<" || comparison == "<=" || comparison == ">" ||
+         comparison == ">=";
+}
+
+void ZoneMap::Widen(ColumnRange *range, const Field &field) {
+  auto bound = ToBound(field);
+  if (!range->has_values_) {
+    range->min_ = bound;
+    range->max_ = bound;
+    range->has_values_ = true;
+    return;
+  }
+  if (Compare(*range, range->min_, bound) > 0) {
+    range->min_ = bound;
+  }
+  if (Compare(*range, range->max_, bound) < 0) {
+    range->max_ = bound;
+  }
+}
+
+int ZoneMap::Compare(const ColumnRange &range, const Bound &lhs, const Bound &rhs) {
+  if (range.type_ == TypeId::kTypeFloat || range.type_ == TypeId::kTypeDouble) {
+    return TypeKernel<TypeId::kTypeDouble>::Compare(lhs.real_, rhs.real_);
+  }
+  return TypeKernel<TypeId::kTypeBigInt>::Compare(lhs.integer_, rhs.integer_);
+}
+
+ZoneMap::Bound ZoneMap::ToBound(const Field &field) {
+  Bound bound{};
+  switch (field.type_id_) {
+    case TypeId::kTypeInt:
+      bound.integer_ = field.value_.integer_;
+      break;
+    case TypeId::kTypeFloat:
+      bound.real_ = field.value_.float_;
+      break;
+    case TypeId::kTypeDouble:
+      bound.real_ = field.value_.double_;
+      break;
+    default:
+      bound.integer_ = field.value_.bigint_;
+      break;
+  }
+  return bound;
+}
@@ -1,5 +1,9 @@
 #include "catalog/catalog.h"
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "utils/utils.h"
@@ -68,6 +72,174 @@ TEST(CatalogTest, CatalogTableTest) {
   delete db_02;
 }
 
+TEST(CatalogTest, CatalogPaxTableTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("balance", TypeId::kTypeFloat, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("account", schema.get(), &txn, table_info, TableLayout::kPax));
+  ASSERT_EQ(TableLayout::kPax, table_info->GetTableHeap()->GetLayout());
+  for (int i = 0; i < 1000; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeFloat, i * 1.5f)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  delete db_01;
+  /** Reopen, the table keeps its layout */
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("account", table_info));
+  ASSERT_EQ(TableLayout::kPax, table_info->GetLayout());
+  ASSERT_EQ(TableLayout::kPax, table_info->GetTableHeap()->GetLayout());
+  int count = 0;
+  for (auto it = table_info->GetTableHeap()->Begin(&txn); it != table_info->GetTableHeap()->End(); ++it, ++count) {
+    auto row = *it;
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(1)->CompareEquals(Field(TypeId::kTypeFloat, count * 1.5f)));
+  }
+  ASSERT_EQ(1000, count);
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogClusteredTableTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("balance", TypeId::kTypeFloat, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, true)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_FAILED, catalog_01->CreateTable("account", schema.get(), &txn, table_info, TableLayout::kClustered));
+  ASSERT_EQ(DB_SUCCESS,
+            catalog_01->CreateTable("account", schema.get(), &txn, table_info, TableLayout::kClustered, {1}));
+  ASSERT_EQ(TableLayout::kClustered, table_info->GetTableHeap()->GetLayout());
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_FAILED, catalog_01->CreateIndex("account", "index-1", {"balance"}, &txn, index_info, "bptree"));
+  for (int i = 999; i >= 0; i--) {
+    std::vector<Field> fields{Field(TypeId::kTypeFloat, i * 1.5f), Field(TypeId::kTypeInt, i)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  delete db_01;
+  /** Reopen, the table keeps its layout and key */
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTable("account", table_info));
+  ASSERT_EQ(TableLayout::kClustered, table_info->GetLayout());
+  auto clustered_heap = static_cast<ClusteredTableHeap *>(table_info->GetTableHeap());
+  ASSERT_EQ(std::vector<uint32_t>{1}, clustered_heap->GetKeyColumns());
+  int count = 0;
+  for (auto it = clustered_heap->Begin(&txn); it != clustered_heap->End(); ++it, ++count) {
+    auto row = *it;
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(1)->CompareEquals(Field(TypeId::kTypeInt, count)));
+  }
+  ASSERT_EQ(1000, count);
+  // the tuples are read leaf by leaf in key order
+  std::vector<page_id_t> leaf_ids;
+  clustered_heap->GetPageIds(&leaf_ids);
+  ASSERT_GT(leaf_ids.size(), 1);
+  count = 0;
+  std::vector<Row> leaf_rows;
+  for (auto leaf_id : leaf_ids) {
+    ASSERT_TRUE(clustered_heap->GetPageTuples(leaf_id, &leaf_rows, &txn));
+    for (auto &row : leaf_rows) {
+      ASSERT_EQ(CmpBool::kTrue, row.GetField(1)->CompareEquals(Field(TypeId::kTypeInt, count++)));
+    }
+  }
+  ASSERT_EQ(1000, count);
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogAnalyzeTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, false, false),
+                                   new Column("name", TypeId::kTypeChar, 16, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  TableStatistics *table_stats = nullptr;
+  ASSERT_EQ(DB_NOT_EXIST, catalog_01->GetTableStatistics("table-1", table_stats));
+  // enough rows for ANALYZE to sample the pages
+  const int row_count = 30000;
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_count; i++) {
+    std::string name = "name-" + std::to_string(i);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeInt, i % 10)};
+    if (i % 4 == 0) {
+      fields.emplace_back(TypeId::kTypeChar);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true);
+    }
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+    rids.push_back(row.GetRowId());
+  }
+  ASSERT_GT(table_info->GetTableHeap()->GetPageCount(), STATS_SAMPLE_PAGES);
+  ASSERT_EQ(DB_SUCCESS, catalog_01->AnalyzeTable("table-1", &txn, table_stats));
+  ASSERT_EQ(table_info->GetTableHeap()->GetPageCount(), table_stats->GetPageCount());
+  EXPECT_NEAR(row_count, table_stats->GetRowCount(), row_count * 0.05);
+  EXPECT_NEAR(row_count, table_stats->GetColumnStatistics(0).GetDistinctCount(), row_count * 0.05);
+  EXPECT_EQ(10, table_stats->GetColumnStatistics(1).GetDistinctCount());
+  EXPECT_NEAR(0.25, table_stats->GetColumnStatistics(2).GetNullFraction(), 0.01);
+  auto &bounds = table_stats->GetColumnStatistics(0).GetHistogramBounds();
+  ASSERT_EQ(STATS_HISTOGRAM_BUCKETS + 1, bounds.size());
+  for (size_t i = 1; i < bounds.size(); i++) {
+    ASSERT_EQ(CmpBool::kTrue, bounds[i - 1].CompareLessThanEquals(bounds[i]));
+  }
+  EXPECT_NEAR(0.5, table_stats->EstimateSelectivity(0, "<", Field(TypeId::kTypeInt, row_count / 2)), 0.05);
+  EXPECT_NEAR(0.25, table_stats->EstimateSelectivity(0, ">=", Field(TypeId::kTypeInt, row_count / 4 * 3)), 0.05);
+  EXPECT_NEAR(1.0 / row_count, table_stats->EstimateSelectivity(0, "=", Field(TypeId::kTypeInt, 42)), 1e-4);
+  EXPECT_EQ(0, table_stats->EstimateSelectivity(0, "=", Field(TypeId::kTypeInt, -1)));
+  EXPECT_NEAR(0.1, table_stats->EstimateSelectivity(1, "=", Field(TypeId::kTypeInt, 3)), 0.02);
+  Field empty_name(TypeId::kTypeChar, const_cast<char *>(""), 0, true);
+  EXPECT_NEAR(0.75, table_stats->EstimateSelectivity(2, ">=", empty_name), 0.01);
+  Field quarter(TypeId::kTypeInt, row_count / 4), half(TypeId::kTypeInt, row_count / 2);
+  EXPECT_NEAR(0.25, table_stats->EstimateRangeSelectivity(0, &quarter, true, &half, false), 0.05);
+  EXPECT_NEAR(0.5, table_stats->EstimateRangeSelectivity(0, nullptr, false, &half, false), 0.05);
+  EXPECT_EQ(0, table_stats->EstimateRangeSelectivity(0, &half, true, &quarter, true));
+  // the modifications since ANALYZE are counted by the table heap
+  auto analyzed_rows = table_stats->GetRowCount();
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(table_info->GetTableHeap()->MarkDelete(rids[i], &txn));
+  }
+  table_info->GetTableHeap()->RollbackDelete(rids[0], &txn);
+  ASSERT_EQ(DB_SUCCESS, catalog_01->GetTableStatistics("table-1", table_stats));
+  ASSERT_EQ(analyzed_rows - 99, table_stats->GetRowCount());
+  delete db_01;
+  /** Reopen, the statistics are kept */
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetTableStatistics("table-1", table_stats));
+  ASSERT_EQ(analyzed_rows - 99, table_stats->GetRowCount());
+  ASSERT_EQ(10, table_stats->GetColumnStatistics(1).GetDistinctCount());
+  ASSERT_EQ(STATS_HISTOGRAM_BUCKETS + 1, table_stats->GetColumnStatistics(0).GetHistogramBounds().size());
+  EXPECT_NEAR(0.5, table_stats->EstimateSelectivity(0, "<", Field(TypeId::kTypeInt, row_count / 2)), 0.05);
+  /** The pages of a pax table are sampled as well */
+  std::vector<Column *> pax_columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                       new Column("grp", TypeId::kTypeInt, 1, false, false)};
+  auto pax_schema = std::make_shared<Schema>(pax_columns);
+  ASSERT_EQ(DB_SUCCESS, catalog_02->CreateTable("table-2", pax_schema.get(), &txn, table_info, TableLayout::kPax));
+  int pax_rows = 0;
+  for (; table_info->GetTableHeap()->GetPageCount() <= 2 * STATS_SAMPLE_PAGES; pax_rows++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, pax_rows), Field(TypeId::kTypeInt, pax_rows % 10)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  std::vector<page_id_t> pax_page_ids;
+  table_info->GetTableHeap()->GetPageIds(&pax_page_ids);
+  ASSERT_EQ(table_info->GetTableHeap()->GetPageCount(), pax_page_ids.size());
+  ASSERT_EQ(DB_SUCCESS, catalog_02->AnalyzeTable("table-2", &txn, table_stats));
+  EXPECT_NEAR(pax_rows, table_stats->GetRowCount(), pax_rows * 0.05);
+  EXPECT_EQ(10, table_stats->GetColumnStatistics(1).GetDistinctCount());
+  EXPECT_NEAR(0.5, table_stats->EstimateSelectivity(0, "<", Field(TypeId::kTypeInt, pax_rows / 2)), 0.05);
+  delete db_02;
+}
+
 TEST(CatalogTest, CatalogIndexTest) {
   /** Stage 1: Testing simple operation */
   auto db_01 = new DBStorageEngine(db_file_name, true);
@@ -126,4 +298,214 @@ TEST(CatalogTest, CatalogIndexTest) {
     ASSERT_EQ(rid.Get(), ret_02[i].Get());
   }
   delete db_02;
-}
\ No newline at end of file
+}
+// the index type is kept in the index metadata, an empty B-link tree is reopened as one
+TEST(CatalogTest, CatalogLinkedIndexTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_FAILED, catalog_01->CreateIndex("table-1", "index-hash", {"id"}, &txn, index_info, "hash"));
+  ASSERT_NE(DB_SUCCESS, catalog_01->GetIndex("table-1", "index-hash", index_info));
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-id", {"id"}, &txn, index_info, "blinktree"));
+  ASSERT_EQ("blinktree", index_info->GetIndexType());
+  ASSERT_TRUE(dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex())->IsLinked());
+  delete db_01;
+
+  auto db_02 = new DBStorageEngine(db_file_name, false);
+  auto &catalog_02 = db_02->catalog_mgr_;
+  ASSERT_EQ(DB_SUCCESS, catalog_02->GetIndex("table-1", "index-id", index_info));
+  ASSERT_EQ("blinktree", index_info->GetIndexType());
+  auto index = dynamic_cast<BPlusTreeIndex *>(index_info->GetIndex());
+  ASSERT_TRUE(index->IsLinked());
+  // enough keys to split the leaves and the root
+  const int key_count = 5000;
+  for (int i = 0; i < key_count; i++) {
+    int id = (i * 7919) % key_count;
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id)};
+    Row key(fields);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(key, RowId(id, 0), &txn));
+  }
+  std::vector<Field> lower_fields{Field(TypeId::kTypeInt, 100)};
+  Row lower(lower_fields);
+  auto range = index->ScanRange(&lower, true, nullptr, false);
+  RowId rid;
+  for (int id = 100; id < key_count; id++) {
+    ASSERT_TRUE(range.Next(&rid));
+    ASSERT_EQ(id, rid.GetPageId());
+  }
+  ASSERT_FALSE(range.Next(&rid));
+  delete db_02;
+}
+
+TEST(CatalogTest, CatalogIndexBuildTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, false, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  const int row_count = 20000;
+  std::vector<RowId> rids(row_count);
+  for (int i = 0; i < row_count; i++) {
+    // the ids are not inserted in order
+    int id = (i * 7919) % row_count;
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeInt, id % 10)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+    rids[id] = row.GetRowId();
+  }
+  // the existing rows are put into the index when it is created, the first row of a key wins
+  IndexInfo *index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-id", {"id"}, &txn, index_info, "bptree"));
+  IndexInfo *grp_index_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-grp", {"grp"}, &txn, grp_index_info, "bptree"));
+  std::vector<RowId> result;
+  for (int id = 0; id < row_count; id++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id)};
+    result.clear();
+    ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(Row(fields), result, &txn));
+    ASSERT_EQ(rids[id].Get(), result[0].Get());
+  }
+  for (int grp = 0; grp < 10; grp++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, grp)};
+    result.clear();
+    ASSERT_EQ(DB_SUCCESS, grp_index_info->GetIndex()->ScanKey(Row(fields), result, &txn));
+    ASSERT_EQ(1, result.size());
+  }
+  std::vector<Field> fields{Field(TypeId::kTypeInt, 0)};
+  result.clear();
+  ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(Row(fields), result, &txn, ">="));
+  ASSERT_EQ(row_count, result.size());
+  delete db_01;
+}
+
+TEST(CatalogTest, ParallelIndexBuildTest) {
+  auto db_01 = new DBStorageEngine(db_file_name, true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("grp", TypeId::kTypeInt, 1, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  const int row_count = 30000;
+  const int group_count = 100;
+  auto insert = [&](TableInfo *info, int id, int grp, const std::string &name) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeInt, grp),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    Row row(fields);
+    EXPECT_TRUE(info->GetTableHeap()->InsertTuple(row, &txn));
+    return row.GetRowId();
+  };
+  // the pages of a scratch table are freed later, so table-1 reuses their ids for pages at the end of its chain
+  TableInfo *scratch_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("scratch", schema.get(), &txn, scratch_info));
+  for (int i = 0; scratch_info->GetTableHeap()->GetPageCount() < 2 * PARALLEL_SCAN_MORSEL_PAGES; i++) {
+    insert(scratch_info, i, group_count, "scratch-" + std::to_string(i));
+  }
+  // the first page of table-1 holds no group, the first row of every group is behind the scratch pages
+  for (int i = 0; table_info->GetTableHeap()->GetPageCount() == 1; i++) {
+    insert(table_info, -1 - i, group_count, "lead-" + std::to_string(i));
+  }
+  std::vector<RowId> rids(row_count);
+  std::vector<RowId> first_rids(group_count);
+  for (int i = 0; i < row_count; i++) {
+    int id = (i * 7919) % row_count;
+    std::string name = "name-" + std::to_string(id);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id), Field(TypeId::kTypeInt, id % group_count),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+    rids[id] = row.GetRowId();
+    // the first rows hold every group once
+    if (i < group_count) {
+      first_rids[id % group_count] = row.GetRowId();
+    }
+  }
+  scratch_info->GetTableHeap()->FreeTableHeap();
+  ASSERT_EQ(DB_SUCCESS, catalog_01->DropTable("scratch"));
+  // a second row of every group, on pages with smaller ids than the first rows
+  auto page_count = table_info->GetTableHeap()->GetPageCount();
+  for (int i = 0; table_info->GetTableHeap()->GetPageCount() < page_count + PARALLEL_SCAN_MORSEL_PAGES; i++) {
+    insert(table_info, row_count + i, i % group_count, "late-" + std::to_string(i));
+  }
+  std::vector<page_id_t> page_ids;
+  table_info->GetTableHeap()->GetPageIds(&page_ids);
+  ASSERT_FALSE(std::is_sorted(page_ids.begin(), page_ids.end()));
+  ASSERT_GE(table_info->GetTableHeap()->GetPageCount(), PARALLEL_SCAN_MIN_PAGES);
+  std::vector<RowId> result;
+  for (uint32_t workers : {1, 2, 4, 8}) {
+    auto suffix = std::to_string(workers);
+    IndexInfo *index_info = nullptr;
+    IndexInfo *grp_index_info = nullptr;
+    ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-name-" + suffix, {"name", "id"}, &txn,
+                                                  index_info, "bptree", workers));
+    ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-grp-" + suffix, {"grp"}, &txn, grp_index_info,
+                                                  "bptree", workers));
+    for (int id = 0; id < row_count; id++) {
+      std::string name = "name-" + std::to_string(id);
+      std::vector<Field> fields{Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), false),
+                                Field(TypeId::kTypeInt, id)};
+      result.clear();
+      ASSERT_EQ(DB_SUCCESS, index_info->GetIndex()->ScanKey(Row(fields), result, &txn));
+      ASSERT_EQ(rids[id].Get(), result[0].Get());
+    }
+    // the first row of a key wins, whichever thread extracted it
+    for (int grp = 0; grp < group_count; grp++) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, grp)};
+      result.clear();
+      ASSERT_EQ(DB_SUCCESS, grp_index_info->GetIndex()->ScanKey(Row(fields), result, &txn));
+      ASSERT_EQ(1, result.size());
+      ASSERT_EQ(first_rids[grp].Get(), result[0].Get());
+    }
+  }
+  delete db_01;
+}
+
+/**
+ * Not a pass or fail test, prints the time CreateIndex takes to build an index on a large row table by worker
+ * count, from 1 up to the hardware concurrency. Run it with --gtest_also_run_disabled_tests
+ * --gtest_filter='*Benchmark*'.
+ */
+TEST(CatalogTest, DISABLED_ParallelIndexBuildBenchmark) {
+  auto db_01 = new DBStorageEngine("catalog_benchmark.db", true);
+  auto &catalog_01 = db_01->catalog_mgr_;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 32, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  Txn txn;
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, catalog_01->CreateTable("table-1", schema.get(), &txn, table_info));
+  const int row_count = 200000;
+  for (int i = 0; i < row_count; i++) {
+    int id = (i * 7919) % row_count;
+    std::string name = "name-" + std::to_string(id);
+    std::vector<Field> fields{Field(TypeId::kTypeInt, id),
+                              Field(TypeId::kTypeChar, const_cast<char *>(name.c_str()), name.size(), true)};
+    Row row(fields);
+    ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, &txn));
+  }
+  uint32_t max_workers = std::max(8U, std::thread::hardware_concurrency());
+  double serial_ms = 0;
+  for (uint32_t workers = 1; workers <= max_workers; workers *= 2) {
+    IndexInfo *index_info = nullptr;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(DB_SUCCESS, catalog_01->CreateIndex("table-1", "index-" + std::to_string(workers), {"name", "id"}, &txn,
+                                                  index_info, "bptree", workers));
+    double build_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (workers == 1) {
+      serial_ms = build_ms;
+    }
+    LOG(INFO) << "Index build of " << table_info->GetTableHeap()->GetPageCount() << " pages with " << workers
+              << " worker(s): " << build_ms << " ms, speedup " << serial_ms / build_ms;
+  }
+  delete db_01;
+}
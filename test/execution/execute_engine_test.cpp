@@ -0,0 +1,85 @@
+#include "executor/execute_engine.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "parser/minisql_lex.h"
+#include "parser/parser.h"
+int yyparse(void);
+}
+
+/** Parse one statement the way the shell does and run it on the engine. */
+static dberr_t ExecuteSql(ExecuteEngine *engine, const std::string &sql) {
+  YY_BUFFER_STATE bp = yy_scan_string(sql.c_str());
+  yy_switch_to_buffer(bp);
+  MinisqlParserInit();
+  yyparse();
+  dberr_t result = MinisqlParserGetError() ? DB_FAILED : engine->Execute(MinisqlGetParserRootNode());
+  MinisqlParserFinish();
+  yy_delete_buffer(bp);
+  yylex_destroy();
+  return result;
+}
+
+class ExecuteEngineTest : public ::testing::Test {
+ public:
+  /** Keep the result tables of the statements out of the test log. */
+  void SetUp() override { cout_buf_ = std::cout.rdbuf(sink_.rdbuf()); }
+
+  void TearDown() override {
+    ExecuteSql(&engine_, "drop database engine_test;");
+    std::cout.rdbuf(cout_buf_);
+  }
+
+ protected:
+  std::stringstream sink_;
+  std::streambuf *cout_buf_{nullptr};
+  ExecuteEngine engine_;
+};
+
+// a plain SELECT on a table larger than PARALLEL_SCAN_MIN_PAGES is split across the scan workers of the engine
+TEST_F(ExecuteEngineTest, ParallelSelectTest) {
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "create database engine_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "use engine_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "create table t(id int, name char(128));"));
+  const std::string name(100, 'x');
+  const int row_count = 40 * PARALLEL_SCAN_MIN_PAGES;
+  for (int i = 0; i < row_count; i++) {
+    ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "insert into t values(" + std::to_string(i) + ", \"" + name + "\");"));
+  }
+
+  engine_.SetScanWorkers(1);
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "select * from t where id >= 0;"));
+  ASSERT_EQ(0, engine_.GetParallelScans());
+  engine_.SetScanWorkers(4);
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "select * from t where id >= 0;"));
+  ASSERT_EQ(1, engine_.GetParallelScans());
+  // the parallel scan returns every row
+  ASSERT_NE(std::string::npos, sink_.str().rfind(std::to_string(row_count) + " row in set"));
+  // an update scans serially, its rows are modified while they are read
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "update t set id = 0 where id = 1;"));
+  ASSERT_EQ(1, engine_.GetParallelScans());
+}
+
+// CREATE INDEX from SQL builds the index from page ranges with the scan workers of the engine
+TEST_F(ExecuteEngineTest, ParallelCreateIndexTest) {
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "create database engine_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "use engine_test;"));
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "create table t(id int unique, name char(128));"));
+  const std::string name(100, 'x');
+  const int row_count = 40 * PARALLEL_SCAN_MIN_PAGES;
+  for (int i = 0; i < row_count; i++) {
+    ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "insert into t values(" + std::to_string(i) + ", \"" + name + "\");"));
+  }
+  engine_.SetScanWorkers(4);
+  ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "create index t_id on t(id);"));
+  for (int i = 0; i < row_count; i += 97) {
+    sink_.str("");
+    ASSERT_EQ(DB_SUCCESS, ExecuteSql(&engine_, "select id from t where id = " + std::to_string(i) + ";"));
+    ASSERT_NE(std::string::npos, sink_.str().find("\n1 row in set"));
+  }
+}
@@ -1,12 +1,28 @@
 //
 // Created by njz on 2023/1/26.
 //
+#include <algorithm>
+
+#include "executor/executors/seq_scan_executor.h"
 #include "executor/plans/delete_plan.h"
+#include "executor/plans/index_scan_plan.h"
 #include "executor/plans/insert_plan.h"
 #include "executor/plans/seq_scan_plan.h"
 #include "executor/plans/update_plan.h"
 #include "executor/plans/values_plan.h"
 #include "executor_test_util.h"  // NOLINT
+#include "planner/expressions/logic_expression.h"
+#include "planner/planner.h"
+
+/** @return the ids in the first column of the rows, ascending, the rows of an index scan come in page order */
+static std::vector<int> SortedIds(const std::vector<Row> &rows) {
+  std::vector<int> ids;
+  for (const auto &row : rows) {
+    ids.push_back(std::stoi(row.GetField(0)->toString()));
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
 
 // SELECT id FROM table-1 WHERE id < 500
 TEST_F(ExecutorTest, SimpleSeqScanTest) {
@@ -31,6 +47,354 @@ TEST_F(ExecutorTest, SimpleSeqScanTest) {
   }
 }
 
+// SELECT id, name FROM table-1 WHERE id < 5000, with one and with several scan threads
+TEST_F(ExecutorTest, ParallelSeqScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  TableHeap *table_heap = table_info->GetTableHeap();
+  for (int i = 1000; table_heap->GetPageCount() < 2 * PARALLEL_SCAN_MIN_PAGES; i++) {
+    std::string name = "name-" + std::to_string(i);
+    Fields fields{Field(kTypeInt, i), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                  Field(kTypeFloat, 1.0f * i)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  const Schema *schema = table_info->GetSchema();
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_b = MakeColumnValueExpression(*schema, 0, "name");
+  auto const5000 = MakeConstantValueExpression(Field(kTypeInt, 5000));
+  auto predicate = MakeComparisonExpression(col_a, const5000, "<");
+  auto out_schema = MakeOutputSchema({{"id", col_a}, {"name", col_b}});
+  auto plan = make_shared<SeqScanPlanNode>(out_schema, table_info->GetTableName(), predicate);
+  plan->parallel_ = true;
+
+  GetExecutorContext()->SetScanWorkers(1);
+  std::vector<Row> serial_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &serial_set, GetTxn(), GetExecutorContext());
+  GetExecutorContext()->SetScanWorkers(4);
+  std::vector<Row> parallel_set{};
+  GetExecutionEngine()->ExecutePlan(plan, &parallel_set, GetTxn(), GetExecutorContext());
+
+  // pages are never reused here, so both scans return the rows in the same order
+  ASSERT_EQ(5000, serial_set.size());
+  ASSERT_EQ(serial_set.size(), parallel_set.size());
+  for (size_t i = 0; i < serial_set.size(); i++) {
+    ASSERT_TRUE(serial_set[i].GetField(0)->CompareEquals(*parallel_set[i].GetField(0)));
+    ASSERT_TRUE(serial_set[i].GetField(1)->CompareEquals(*parallel_set[i].GetField(1)));
+    Row stored(parallel_set[i].GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&stored, GetTxn()));
+    ASSERT_TRUE(stored.GetField(0)->CompareEquals(*parallel_set[i].GetField(0)));
+  }
+
+  // a scan stopped after a few rows leaves its workers waiting on the morsel window, they are joined on destruction
+  {
+    SeqScanExecutor executor(GetExecutorContext(), plan.get());
+    executor.Init();
+    Row row;
+    RowId rid;
+    for (size_t i = 0; i < 10; i++) {
+      ASSERT_TRUE(executor.Next(&row, &rid));
+      ASSERT_TRUE(serial_set[i].GetField(0)->CompareEquals(*row.GetField(0)));
+    }
+  }
+}
+
+// SELECT dept, id FROM clustered WHERE dept >= 3 AND dept < 5, the key is (dept, id)
+TEST_F(ExecutorTest, ClusteredRangeSeqScanTest) {
+  std::vector<Column *> columns = {new Column("dept", TypeId::kTypeInt, 0, false, true),
+                                   new Column("id", TypeId::kTypeInt, 1, false, true)};
+  auto table_schema = std::make_unique<Schema>(columns);
+  TableInfo *table_info = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateTable("clustered", table_schema.get(), GetTxn(),
+                                                                        table_info, TableLayout::kClustered, {0, 1}));
+  for (int dept = 9; dept >= 0; dept--) {
+    for (int id = 0; id < 100; id++) {
+      Fields fields{Field(kTypeInt, dept), Field(kTypeInt, id)};
+      Row row(fields);
+      ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(row, GetTxn()));
+    }
+  }
+  const Schema *schema = table_info->GetSchema();
+  auto col_dept = MakeColumnValueExpression(*schema, 0, "dept");
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto predicate = std::make_shared<LogicExpression>(
+      MakeComparisonExpression(col_dept, MakeConstantValueExpression(Field(kTypeInt, 3)), ">="),
+      MakeComparisonExpression(col_dept, MakeConstantValueExpression(Field(kTypeInt, 5)), "<"), LogicType::And);
+  auto out_schema = MakeOutputSchema({{"dept", col_dept}, {"id", col_id}});
+  auto plan = std::make_shared<SeqScanPlanNode>(out_schema, table_info->GetTableName(), predicate);
+  std::vector<Row> result_set;
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  // the rows come in key order
+  ASSERT_EQ(200, result_set.size());
+  for (size_t i = 0; i < result_set.size(); i++) {
+    ASSERT_TRUE(result_set[i].GetField(0)->CompareEquals(Field(kTypeInt, 3 + static_cast<int>(i) / 100)));
+    ASSERT_TRUE(result_set[i].GetField(1)->CompareEquals(Field(kTypeInt, static_cast<int>(i) % 100)));
+  }
+}
+
+// SELECT id FROM table-1 WHERE id >= 990, and WHERE id <> 7, through an index on id
+TEST_F(ExecutorTest, RangeIndexScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto out_schema = MakeOutputSchema({{"id", col_id}});
+
+  auto predicate = MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, 990)), ">=");
+  auto plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(),
+                                                  std::vector<IndexInfo *>{index_info}, false, predicate);
+  std::vector<Row> result_set;
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  std::vector<int> expected{990, 991, 992, 993, 994, 995, 996, 997, 998, 999};
+  ASSERT_EQ(expected, SortedIds(result_set));
+
+  predicate = MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, 7)), "<>");
+  plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(),
+                                             std::vector<IndexInfo *>{index_info}, false, predicate);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(999, result_set.size());
+  for (const auto &row : result_set) {
+    ASSERT_FALSE(row.GetField(0)->CompareEquals(Field(kTypeInt, 7)));
+  }
+
+  // a null key is neither less nor greater than 0, WHERE account <> 0 leaves the row out
+  std::string name = "null-account";
+  Fields null_fields{Field(kTypeInt, 1000), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                     Field(kTypeFloat)};
+  Row null_row(null_fields);
+  ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(null_row, GetTxn()));
+  std::vector<std::string> account_keys{"account"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-2", account_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  auto col_account = MakeColumnValueExpression(*schema, 0, "account");
+  for (const char *comparison_type : {"<>", "<"}) {
+    predicate = MakeComparisonExpression(col_account, MakeConstantValueExpression(Field(kTypeFloat, 0.f)),
+                                         comparison_type);
+    plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(),
+                                               std::vector<IndexInfo *>{index_info}, false, predicate);
+    result_set.clear();
+    GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+    size_t expected_count = 0;
+    for (auto it = table_info->GetTableHeap()->Begin(GetTxn()); it != table_info->GetTableHeap()->End(); ++it) {
+      auto account = (*it).GetField(2);
+      auto matches = std::string(comparison_type) == "<>" ? account->CompareNotEquals(Field(kTypeFloat, 0.f))
+                                                          : account->CompareLessThan(Field(kTypeFloat, 0.f));
+      expected_count += !account->IsNull() && matches == CmpBool::kTrue;
+    }
+    ASSERT_EQ(expected_count, result_set.size());
+    for (const auto &row : result_set) {
+      ASSERT_FALSE(row.GetField(0)->CompareEquals(Field(kTypeInt, 1000)));
+    }
+  }
+}
+
+// SELECT id FROM table-1 WHERE id > 10 AND id <= 20 AND id >= 15, folded into one key range
+TEST_F(ExecutorTest, FoldedRangeIndexScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto col_account = MakeColumnValueExpression(*schema, 0, "account");
+  auto out_schema = MakeOutputSchema({{"id", col_id}});
+  auto compare = [&](const char *comparison_type, int value) {
+    return MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, value)), comparison_type);
+  };
+  auto conjunction = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs) {
+    return std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+  };
+  std::vector<IndexInfo *> indexes{index_info};
+  auto plan_of = [&](const AbstractExpressionRef &predicate) {
+    auto plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(), indexes, true, predicate);
+    bool folded_all = true;
+    Planner::FoldKeyRanges(predicate, indexes, &plan->key_ranges_, &folded_all);
+    plan->need_filter_ = !folded_all;
+    plan->empty_range_ = plan->key_ranges_[0].IsEmpty();
+    return plan;
+  };
+
+  auto plan = plan_of(conjunction(conjunction(compare(">", 10), compare("<=", 20)), compare(">=", 15)));
+  ASSERT_EQ(1, plan->key_ranges_.size());
+  ASSERT_FALSE(plan->need_filter_);
+  ASSERT_TRUE(plan->key_ranges_[0].lower_->CompareEquals(Field(kTypeInt, 15)));
+  ASSERT_TRUE(plan->key_ranges_[0].lower_inclusive_);
+  ASSERT_TRUE(plan->key_ranges_[0].upper_->CompareEquals(Field(kTypeInt, 20)));
+  ASSERT_TRUE(plan->key_ranges_[0].upper_inclusive_);
+  std::vector<Row> result_set;
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  std::vector<int> expected{15, 16, 17, 18, 19, 20};
+  ASSERT_EQ(expected, SortedIds(result_set));
+
+  // a comparison on a column without an index is left to the filter
+  auto account_predicate =
+      MakeComparisonExpression(col_account, MakeConstantValueExpression(Field(kTypeFloat, 1000.0f)), "<");
+  plan = plan_of(conjunction(conjunction(compare(">=", 100), compare("<", 110)), account_predicate));
+  ASSERT_TRUE(plan->need_filter_);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(10, result_set.size());
+
+  // contradictory bounds leave an empty range
+  plan = plan_of(conjunction(compare(">", 20), compare("<", 10)));
+  ASSERT_TRUE(plan->empty_range_);
+  plan = plan_of(conjunction(compare(">=", 20), compare("<", 20)));
+  ASSERT_TRUE(plan->empty_range_);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_TRUE(result_set.empty());
+  plan = plan_of(conjunction(compare("=", 20), compare("<=", 20)));
+  ASSERT_FALSE(plan->empty_range_);
+
+  // a range without a lower bound starts behind the null keys, it needs no filter to leave them out
+  std::string name = "null-account";
+  Fields null_fields{Field(kTypeInt, 1000), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                     Field(kTypeFloat)};
+  Row null_row(null_fields);
+  ASSERT_TRUE(table_info->GetTableHeap()->InsertTuple(null_row, GetTxn()));
+  std::vector<std::string> account_keys{"account"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-2", account_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  indexes = {index_info};
+  auto compare_account = [&](const char *comparison_type, float value) {
+    return MakeComparisonExpression(col_account, MakeConstantValueExpression(Field(kTypeFloat, value)),
+                                    comparison_type);
+  };
+  plan = plan_of(conjunction(compare_account("<", 10.f), compare_account("<=", 500.f)));
+  ASSERT_FALSE(plan->need_filter_);
+  ASSERT_EQ(nullptr, plan->key_ranges_[0].lower_);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  size_t expected_count = 0;
+  for (auto it = table_info->GetTableHeap()->Begin(GetTxn()); it != table_info->GetTableHeap()->End(); ++it) {
+    expected_count += (*it).GetField(2)->CompareLessThan(Field(kTypeFloat, 10.f)) == CmpBool::kTrue;
+  }
+  ASSERT_EQ(expected_count, result_set.size());
+  for (const auto &row : result_set) {
+    ASSERT_FALSE(row.GetField(0)->CompareEquals(Field(kTypeInt, 1000)));
+  }
+}
+
+// SELECT id FROM table-1 WHERE id = 900 OR id = 5 OR id >= 10 AND id < 13 OR id = 11, through index union
+TEST_F(ExecutorTest, UnionIndexScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto out_schema = MakeOutputSchema({{"id", col_id}});
+  auto compare = [&](const char *comparison_type, int value) {
+    return MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, value)), comparison_type);
+  };
+  auto logic = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs, LogicType logic_type) {
+    return std::make_shared<LogicExpression>(lhs, rhs, logic_type);
+  };
+  auto predicate = logic(logic(logic(compare("=", 900), compare("=", 5), LogicType::Or),
+                               logic(compare(">=", 10), compare("<", 13), LogicType::And), LogicType::Or),
+                         compare("=", 11), LogicType::Or);
+  std::vector<IndexInfo *> indexes{index_info};
+  std::vector<AbstractExpressionRef> disjuncts;
+  Planner::CollectDisjuncts(predicate, &disjuncts);
+  ASSERT_EQ(4, disjuncts.size());
+  auto plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(), indexes, true, predicate);
+  bool folded_all = true;
+  for (const auto &disjunct : disjuncts) {
+    plan->union_ranges_.emplace_back();
+    Planner::FoldKeyRanges(disjunct, indexes, &plan->union_ranges_.back(), &folded_all);
+  }
+  ASSERT_TRUE(folded_all);
+  plan->need_filter_ = false;
+  std::vector<Row> result_set;
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  // id 11 is in two disjuncts but returned once
+  std::vector<int> expected{5, 10, 11, 12, 900};
+  ASSERT_EQ(expected, SortedIds(result_set));
+}
+
+// the planner leaves an index once the statistics of the table say too many rows fall into its ranges
+TEST_F(ExecutorTest, IndexRangeSelectivityTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  TableStatistics *table_stats = nullptr;
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->AnalyzeTable("table-1", GetTxn(), table_stats));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto compare = [&](const char *comparison_type, int value) {
+    return MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, value)), comparison_type);
+  };
+  auto conjunction = [](AbstractExpressionRef lhs, AbstractExpressionRef rhs) {
+    return std::make_shared<LogicExpression>(lhs, rhs, LogicType::And);
+  };
+  std::vector<IndexInfo *> indexes{index_info};
+  auto estimate = [&](const AbstractExpressionRef &predicate) {
+    std::vector<IndexKeyRange> key_ranges;
+    bool folded_all = true;
+    Planner::FoldKeyRanges(predicate, indexes, &key_ranges, &folded_all);
+    return Planner::EstimateSelectivity(table_stats, key_ranges);
+  };
+  auto narrow = estimate(conjunction(compare(">=", 100), compare("<", 150)));
+  auto wide = estimate(compare("<", 500));
+  EXPECT_NEAR(0.05, narrow, 0.03);
+  EXPECT_NEAR(0.5, wide, 0.05);
+  EXPECT_NEAR(0.001, estimate(compare("=", 42)), 0.001);
+  EXPECT_EQ(0, estimate(conjunction(compare(">", 20), compare("<", 10))));
+  ASSERT_LE(narrow, INDEX_SCAN_MAX_SELECTIVITY);
+  ASSERT_GT(wide, INDEX_SCAN_MAX_SELECTIVITY);
+}
+
+// SELECT id FROM table-1 WHERE id >= 100, over more row ids than a bitmap batch holds
+TEST_F(ExecutorTest, BitmapIndexScanTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  TableHeap *table_heap = table_info->GetTableHeap();
+  const int row_count = 1000 + 2 * INDEX_SCAN_BATCH_ROWS;
+  for (int i = 1000; i < row_count; i++) {
+    std::string name = "name-" + std::to_string(i);
+    Fields fields{Field(kTypeInt, i), Field(kTypeChar, const_cast<char *>(name.c_str()), name.size(), true),
+                  Field(kTypeFloat, 1.0f * i)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  IndexInfo *index_info = nullptr;
+  std::vector<std::string> index_keys{"id"};
+  ASSERT_EQ(DB_SUCCESS, GetExecutorContext()->GetCatalog()->CreateIndex("table-1", "index-1", index_keys, GetTxn(),
+                                                                        index_info, "bptree"));
+  const Schema *schema = table_info->GetSchema();
+  auto col_id = MakeColumnValueExpression(*schema, 0, "id");
+  auto out_schema = MakeOutputSchema({{"id", col_id}});
+  auto predicate = MakeComparisonExpression(col_id, MakeConstantValueExpression(Field(kTypeInt, 100)), ">=");
+  auto plan = std::make_shared<IndexScanPlanNode>(out_schema, table_info->GetTableName(),
+                                                  std::vector<IndexInfo *>{index_info}, false, predicate);
+  std::vector<Row> result_set;
+  GetExecutionEngine()->ExecutePlan(plan, &result_set, GetTxn(), GetExecutorContext());
+  // the rows of a batch come in page order, every row once
+  ASSERT_EQ(row_count - 100, result_set.size());
+  std::vector<bool> seen(row_count, false);
+  for (const auto &row : result_set) {
+    int id = std::stoi(row.GetField(0)->toString());
+    ASSERT_LE(100, id);
+    ASSERT_FALSE(seen[id]);
+    seen[id] = true;
+    Row stored(row.GetRowId());
+    ASSERT_TRUE(table_heap->GetTuple(&stored, GetTxn()));
+    ASSERT_TRUE(stored.GetField(0)->CompareEquals(*row.GetField(0)));
+  }
+}
+
 // DELETE FROM table-1 WHERE id == 50;
 TEST_F(ExecutorTest, SimpleDeleteTest) {
   // Construct query plan
@@ -112,6 +476,44 @@ TEST_F(ExecutorTest, SimpleRawInsertTest) {
   ASSERT_TRUE(result_set[0].GetField(2)->CompareEquals(Field(kTypeFloat, static_cast<float>(2.33))));
 }
 
+// INSERT INTO table-1 VALUES (null, "aaa", 2.33); UPDATE table-1 SET id = null where id = 500; id is not null
+TEST_F(ExecutorTest, NotNullTest) {
+  TableInfo *table_info;
+  GetExecutorContext()->GetCatalog()->GetTable("table-1", table_info);
+  const Schema *schema = table_info->GetSchema();
+  ASSERT_FALSE(schema->GetColumn(0)->IsNullable());
+  auto const1 = MakeConstantValueExpression(Field(kTypeInt));
+  auto const2 = MakeConstantValueExpression(Field(kTypeChar, const_cast<char *>("aaa"), 3, false));
+  auto const3 = MakeConstantValueExpression(Field(kTypeFloat, static_cast<float>(2.33)));
+  std::vector<std::vector<AbstractExpressionRef>> raw_values{{const1, const2, const3}};
+  auto value_plan = std::make_shared<ValuesPlanNode>(nullptr, raw_values);
+  auto insert_plan = std::make_shared<InsertPlanNode>(nullptr, value_plan, "table-1");
+  std::vector<Row> result_set{};
+  GetExecutionEngine()->ExecutePlan(insert_plan, &result_set, GetTxn(), GetExecutorContext());
+  auto all_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), nullptr);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(all_plan, &result_set, GetTxn(), GetExecutorContext());
+  auto row_count = result_set.size();
+  for (const auto &row : result_set) {
+    ASSERT_FALSE(row.GetField(0)->IsNull());
+  }
+
+  auto col_a = MakeColumnValueExpression(*schema, 0, "id");
+  auto predicate = MakeComparisonExpression(col_a, MakeConstantValueExpression(Field(kTypeInt, 500)), "=");
+  auto scan_plan = make_shared<SeqScanPlanNode>(schema, table_info->GetTableName(), predicate);
+  std::unordered_map<uint32_t, AbstractExpressionRef> update_attrs{};
+  update_attrs.emplace(static_cast<uint32_t>(0), MakeConstantValueExpression(Field(kTypeInt)));
+  auto update_plan = std::make_shared<UpdatePlanNode>(schema, scan_plan, "table-1", update_attrs);
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(update_plan, &result_set, GetTxn(), GetExecutorContext());
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(scan_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(1, result_set.size());
+  result_set.clear();
+  GetExecutionEngine()->ExecutePlan(all_plan, &result_set, GetTxn(), GetExecutorContext());
+  ASSERT_EQ(row_count, result_set.size());
+}
+
 // UPDATE table-1 SET name = "minisql" where id = 500;
 TEST_F(ExecutorTest, SimpleUpdateTest) {
   // Construct a sequential scan of the table
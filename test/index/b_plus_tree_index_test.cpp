@@ -83,4 +83,143 @@ TEST(BPlusTreeTests, BPlusTreeIndexSimpleTest) {
   delete index;
   delete bpm_;
   delete disk_mgr_;
-}
\ No newline at end of file
+}
+TEST(BPlusTreeTests, BPlusTreeIndexWideKeyTest) {
+  remove(db_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  page_id_t id;
+  if (bpm_->IsPageFree(CATALOG_META_PAGE_ID)) {
+    if (bpm_->NewPage(id) == nullptr || id != CATALOG_META_PAGE_ID) {
+      throw logic_error("Failed to allocate catalog meta page.");
+    }
+  }
+  if (bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
+    if (bpm_->NewPage(id) == nullptr || id != INDEX_ROOTS_PAGE_ID) {
+      throw logic_error("Failed to allocate header page.");
+    }
+  }
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeBigInt, 0, false, false),
+                                   new Column("created", TypeId::kTypeTimestamp, 1, false, false),
+                                   new Column("amount", TypeId::kTypeDouble, 2, true, false)};
+  std::vector<uint32_t> index_key_map{0, 1};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new BPlusTreeIndex(0, index_schema, 32, bpm_);
+  // ids beyond 32 bits, inserted out of order
+  const int n = 2000;
+  auto key_of = [](int i) {
+    std::vector<Field> fields{Field(TypeId::kTypeBigInt, (int64_t{1} << 40) - 3 * n / 2 + (i * 7919) % n * 3),
+                              Field(TypeId::kTypeTimestamp, int64_t{-86400000000} + i)};
+    return fields;
+  };
+  for (int i = 0; i < n; i++) {
+    auto fields = key_of(i);
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(1000, i), nullptr));
+  }
+  std::vector<RowId> ret;
+  for (int i = 0; i < n; i += 7) {
+    auto fields = key_of(i);
+    ret.clear();
+    ASSERT_EQ(DB_SUCCESS, index->ScanKey(Row(fields), ret, nullptr));
+    ASSERT_EQ(1, ret.size());
+    ASSERT_EQ(RowId(1000, i), ret[0]);
+  }
+  // the iterator returns the entries in the order of the 64-bit ids
+  int64_t last = INT64_MIN;
+  uint32_t count = 0;
+  for (auto iter = index->GetBeginIterator(); iter != index->GetEndIterator(); ++iter, count++) {
+    auto current = std::stoll(key_of((*iter).second.GetSlotNum())[0].toString());
+    ASSERT_LT(last, current);
+    last = current;
+  }
+  ASSERT_EQ(n, count);
+  index->Destroy();
+  delete index_schema;
+  delete index;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(BPlusTreeTests, BPlusTreeIndexRangeScanTest) {
+  remove(db_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  page_id_t id;
+  if (bpm_->IsPageFree(CATALOG_META_PAGE_ID)) {
+    if (bpm_->NewPage(id) == nullptr || id != CATALOG_META_PAGE_ID) {
+      throw logic_error("Failed to allocate catalog meta page.");
+    }
+  }
+  if (bpm_->IsPageFree(INDEX_ROOTS_PAGE_ID)) {
+    if (bpm_->NewPage(id) == nullptr || id != INDEX_ROOTS_PAGE_ID) {
+      throw logic_error("Failed to allocate header page.");
+    }
+  }
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  std::vector<uint32_t> index_key_map{0};
+  const TableSchema table_schema(columns);
+  auto *index_schema = Schema::ShallowCopySchema(&table_schema, index_key_map);
+  auto *index = new BPlusTreeIndex(0, index_schema, 16, bpm_);
+  // even keys only, so the bounds fall both on and between keys
+  const int n = 5000;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, (i * 7919) % n * 2)};
+    ASSERT_EQ(DB_SUCCESS, index->InsertEntry(Row(fields), RowId(1000, (i * 7919) % n), nullptr));
+  }
+  auto key_of = [](int key) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, key)};
+    return Row(fields);
+  };
+  auto scan = [&](const Row *lower, bool lower_inclusive, const Row *upper, bool upper_inclusive) {
+    std::vector<uint32_t> slots;
+    auto range = index->ScanRange(lower, lower_inclusive, upper, upper_inclusive);
+    RowId rid;
+    while (range.Next(&rid)) {
+      slots.push_back(rid.GetSlotNum());
+    }
+    // the end of the range is sticky
+    EXPECT_FALSE(range.Next(&rid));
+    return slots;
+  };
+  auto expect = [](uint32_t first, uint32_t last) {
+    std::vector<uint32_t> slots;
+    for (uint32_t slot = first; slot <= last; slot++) {
+      slots.push_back(slot);
+    }
+    return slots;
+  };
+  Row k100 = key_of(100), k2000 = key_of(2000), k101 = key_of(101), k1999 = key_of(1999);
+  ASSERT_EQ(expect(50, 1000), scan(&k100, true, &k2000, true));
+  ASSERT_EQ(expect(51, 999), scan(&k100, false, &k2000, false));
+  ASSERT_EQ(expect(51, 999), scan(&k101, true, &k1999, true));
+  ASSERT_EQ(expect(51, 999), scan(&k101, false, &k1999, false));
+  ASSERT_EQ(expect(0, 49), scan(nullptr, false, &k100, false));
+  ASSERT_EQ(expect(1001, n - 1), scan(&k2000, false, nullptr, false));
+  ASSERT_EQ(n, scan(nullptr, false, nullptr, false).size());
+  ASSERT_TRUE(scan(&k2000, true, &k100, true).empty());
+  ASSERT_TRUE(scan(&k101, true, &k101, true).empty());
+  // a consumer may stop early, the entries are read lazily
+  auto range = index->ScanRange(&k100, true, nullptr, false);
+  RowId rid;
+  for (uint32_t slot = 50; slot < 60; slot++) {
+    ASSERT_TRUE(range.Next(&rid));
+    ASSERT_EQ(slot, rid.GetSlotNum());
+  }
+  // ScanKey is built on the range scans
+  std::vector<RowId> ret;
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(k100, ret, nullptr, "<="));
+  ASSERT_EQ(51, ret.size());
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(k100, ret, nullptr, ">"));
+  ASSERT_EQ(n - 51, ret.size());
+  ret.clear();
+  ASSERT_EQ(DB_SUCCESS, index->ScanKey(k100, ret, nullptr, "<>"));
+  ASSERT_EQ(n - 1, ret.size());
+  ASSERT_EQ(ret.end(), std::find(ret.begin(), ret.end(), RowId(1000, 50)));
+  index->Destroy();
+  delete index_schema;
+  delete index;
+  delete bpm_;
+  delete disk_mgr_;
+}
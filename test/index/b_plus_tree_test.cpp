@@ -1,8 +1,15 @@
 #include "index/b_plus_tree.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "index/comparator.h"
+#include "index/key_sorter.h"
 #include "utils/tree_file_mgr.h"
 #include "utils/utils.h"
 
@@ -74,4 +81,572 @@ TEST(BPlusTreeTests, SampleTest) {
     free(key);
   }
   delete table_schema;
-}
\ No newline at end of file
+}
+
+TEST(BPlusTreeTests, PageLayoutTest) {
+  DBStorageEngine engine("bp_tree_layout_test.db");
+  std::vector<Column *> columns = {
+      new Column("int", TypeId::kTypeInt, 0, false, false),
+  };
+  Schema *table_schema = new Schema(columns);
+  // keys of 8 bytes are searched in lanes, keys of 16 bytes by binary search
+  KeyManager word_km(table_schema, 8);
+  KeyManager wide_km(table_schema, 16);
+  ASSERT_TRUE(word_km.IsWordKey());
+  const int n = 3000;
+  std::vector<int> ints;
+  for (int i = 0; i < n; i++) {
+    ints.push_back((i - n / 2) * 7);
+  }
+  ShuffleArray(ints);
+  struct Case {
+    KeyManager *km;
+    IndexPageLayout first_layout;
+    IndexPageLayout second_layout;
+  };
+  // the last case reopens a tree of the pair layout with the column layout, the pages are then mixed
+  std::vector<Case> cases{{&word_km, IndexPageLayout::kPairs, IndexPageLayout::kPairs},
+                          {&word_km, IndexPageLayout::kColumns, IndexPageLayout::kColumns},
+                          {&wide_km, IndexPageLayout::kColumns, IndexPageLayout::kColumns},
+                          {&word_km, IndexPageLayout::kPairs, IndexPageLayout::kColumns}};
+  for (size_t c = 0; c < cases.size(); c++) {
+    auto &km = *cases[c].km;
+    std::vector<GenericKey *> keys;
+    for (int i = 0; i < n; i++) {
+      keys.push_back(km.InitKey());
+      std::vector<Field> fields{Field(TypeId::kTypeInt, ints[i])};
+      km.SerializeFromKey(keys.back(), Row(fields), table_schema);
+    }
+    {
+      BPlusTree tree(c, engine.bpm_, km, 16, 16, cases[c].first_layout);
+      for (int i = 0; i < n / 2; i++) {
+        ASSERT_TRUE(tree.Insert(keys[i], RowId(ints[i])));
+      }
+    }
+    BPlusTree tree(c, engine.bpm_, km, 16, 16, cases[c].second_layout);
+    for (int i = n / 2; i < n; i++) {
+      ASSERT_TRUE(tree.Insert(keys[i], RowId(ints[i])));
+    }
+    ASSERT_TRUE(tree.Check());
+    std::vector<RowId> result;
+    for (int i = 0; i < n; i++) {
+      result.clear();
+      ASSERT_TRUE(tree.GetValue(keys[i], result));
+      ASSERT_EQ(ints[i], result[0].Get());
+    }
+    for (int i = 0; i < n; i += 2) {
+      tree.Remove(keys[i]);
+    }
+    for (int i = 0; i < n; i++) {
+      result.clear();
+      ASSERT_EQ(i % 2 == 1, tree.GetValue(keys[i], result));
+    }
+    // the keys come out in order
+    int count = 0;
+    int64_t last = INT64_MIN;
+    for (auto iter = tree.Begin(); iter != tree.End(); ++iter) {
+      int64_t value = (*iter).second.Get();
+      ASSERT_LT(last, value);
+      last = value;
+      count++;
+    }
+    ASSERT_EQ(n / 2, count);
+    ASSERT_TRUE(tree.Check());
+    for (auto key : keys) {
+      free(key);
+    }
+  }
+  delete table_schema;
+}
+
+/**
+ * The pair layout, searched by binary search, and the column layout, searched in lanes, find the same
+ * position in a leaf and the same child in an internal page, at every fanout.
+ */
+TEST(BPlusTreeTests, PageSearchTest) {
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  alignas(8) static char page[PAGE_SIZE];
+  int max_fanout = (PAGE_SIZE - BPlusTreeLeafPage::LEAF_PAGE_HEADER_SIZE) / (km.GetKeySize() + sizeof(RowId));
+  for (int fanout : {8, 32, 64, 128, max_fanout}) {
+    for (auto layout : {IndexPageLayout::kPairs, IndexPageLayout::kColumns}) {
+      // the keys of both pages are 0, 2, 4, ..., the probes fall on, between and beyond them
+      auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(page);
+      leaf->Init(1, INVALID_PAGE_ID, km.GetKeySize(), fanout, layout);
+      for (int i = 0; i < fanout; i++) {
+        KeyBuffer key;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, 2 * i)};
+        km.SerializeFromKey(key.Get(), Row(fields), &table_schema);
+        leaf->Insert(key.Get(), RowId(i), km);
+      }
+      for (int value = -1; value <= 2 * fanout; value++) {
+        KeyBuffer probe;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+        km.SerializeFromKey(probe.Get(), Row(fields), &table_schema);
+        ASSERT_EQ(std::max(0, std::min(fanout, (value + 1) / 2)), leaf->KeyIndex(probe.Get(), km))
+            << "fanout " << fanout << ", probe " << value;
+      }
+      auto internal = reinterpret_cast<BPlusTreeInternalPage *>(page);
+      internal->Init(1, INVALID_PAGE_ID, km.GetKeySize(), fanout, layout);
+      for (int i = 0; i < fanout; i++) {
+        KeyBuffer key;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, 2 * i)};
+        km.SerializeFromKey(key.Get(), Row(fields), &table_schema);
+        if (i == 0) {
+          internal->SetValueAt(0, 0);
+          internal->SetSize(1);
+        } else {
+          internal->InsertNodeAfter(i - 1, key.Get(), i);
+        }
+      }
+      for (int value = -1; value <= 2 * fanout; value++) {
+        KeyBuffer probe;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, value)};
+        km.SerializeFromKey(probe.Get(), Row(fields), &table_schema);
+        ASSERT_EQ(std::max(0, std::min(fanout - 1, value / 2)), internal->Lookup(probe.Get(), km))
+            << "fanout " << fanout << ", probe " << value;
+      }
+    }
+  }
+}
+
+/**
+ * Not a pass or fail test, prints the lookups per second in a leaf and an internal page by fanout,
+ * for the pair layout searched by binary search and the column layout searched in lanes.
+ * Run it with --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'.
+ */
+TEST(BPlusTreeTests, DISABLED_PageSearchBenchmark) {
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int probes = 200000;
+  std::mt19937 rng(3);
+  alignas(8) static char page[PAGE_SIZE];
+  int max_fanout = (PAGE_SIZE - BPlusTreeLeafPage::LEAF_PAGE_HEADER_SIZE) / (km.GetKeySize() + sizeof(RowId));
+  for (int fanout : {8, 32, 64, 128, max_fanout}) {
+    std::uniform_int_distribution<int32_t> values(-1, 2 * fanout);
+    std::vector<KeyBuffer> probe_keys(1024);
+    for (auto &probe_key : probe_keys) {
+      std::vector<Field> fields{Field(TypeId::kTypeInt, values(rng))};
+      km.SerializeFromKey(probe_key.Get(), Row(fields), &table_schema);
+    }
+    int64_t sums[2][2] = {{0, 0}, {0, 0}};
+    double rates[2][2];
+    for (auto layout : {IndexPageLayout::kPairs, IndexPageLayout::kColumns}) {
+      int l = static_cast<int>(layout);
+      auto leaf = reinterpret_cast<BPlusTreeLeafPage *>(page);
+      leaf->Init(1, INVALID_PAGE_ID, km.GetKeySize(), fanout, layout);
+      for (int i = 0; i < fanout; i++) {
+        KeyBuffer key;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, 2 * i)};
+        km.SerializeFromKey(key.Get(), Row(fields), &table_schema);
+        leaf->Insert(key.Get(), RowId(i), km);
+      }
+      auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < probes; i++) {
+        sums[0][l] += leaf->KeyIndex(probe_keys[i % probe_keys.size()].Get(), km);
+      }
+      rates[0][l] = probes / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      auto internal = reinterpret_cast<BPlusTreeInternalPage *>(page);
+      internal->Init(1, INVALID_PAGE_ID, km.GetKeySize(), fanout, layout);
+      for (int i = 0; i < fanout; i++) {
+        KeyBuffer key;
+        std::vector<Field> fields{Field(TypeId::kTypeInt, 2 * i)};
+        km.SerializeFromKey(key.Get(), Row(fields), &table_schema);
+        if (i == 0) {
+          internal->SetValueAt(0, 0);
+          internal->SetSize(1);
+        } else {
+          internal->InsertNodeAfter(i - 1, key.Get(), i);
+        }
+      }
+      start = std::chrono::steady_clock::now();
+      for (int i = 0; i < probes; i++) {
+        sums[1][l] += internal->Lookup(probe_keys[i % probe_keys.size()].Get(), km);
+      }
+      rates[1][l] = probes / std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    ASSERT_EQ(sums[0][0], sums[0][1]);
+    ASSERT_EQ(sums[1][0], sums[1][1]);
+    LOG(INFO) << "Fanout " << fanout << ": leaf " << rates[0][0] / 1e6 << " / " << rates[0][1] / 1e6
+              << " M lookups/s, internal " << rates[1][0] / 1e6 << " / " << rates[1][1] / 1e6
+              << " M lookups/s (pairs / columns)";
+  }
+}
+
+/**
+ * Thread t of threads owns the keys i with i % threads == t. It inserts and looks up its keys in a random order,
+ * removes every other key again and scans the keys of all threads from time to time.
+ * @return the number of operations of all threads
+ */
+static int64_t RunConcurrentWork(BPlusTree *tree, std::vector<KeyBuffer> &keys, int threads,
+                                 std::atomic<int> *errors) {
+  const int n = static_cast<int>(keys.size());
+  std::atomic<int64_t> operations{0};
+  auto work = [&](int t) {
+    std::vector<int> own;
+    for (int i = t; i < n; i += threads) {
+      own.push_back(i);
+    }
+    std::shuffle(own.begin(), own.end(), std::mt19937(t));
+    std::vector<RowId> result;
+    int64_t done = 0;
+    for (size_t i = 0; i < own.size(); i++) {
+      if (!tree->Insert(keys[own[i]].Get(), RowId(own[i]))) {
+        (*errors)++;
+      }
+      result.clear();
+      if (!tree->GetValue(keys[own[i]].Get(), result) || result[0].Get() != own[i]) {
+        (*errors)++;
+      }
+      done += 2;
+      if (i % 2 == 1) {
+        tree->Remove(keys[own[i - 1]].Get());
+        done++;
+      }
+      if (i % 8 == 0) {
+        // the scan sees the keys of all threads in order
+        int64_t last = -1;
+        int count = 0;
+        for (auto iter = tree->Begin(keys[own[i]].Get()); iter != tree->End() && count < 64; ++iter, count++) {
+          if ((*iter).second.Get() <= last) {
+            (*errors)++;
+          }
+          last = (*iter).second.Get();
+        }
+        done++;
+      }
+    }
+    operations += done;
+  };
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; t++) {
+    workers.emplace_back(work, t);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return operations.load();
+}
+
+/**
+ * Threads insert, remove, look up and scan keys of their own in one tree with a small fanout, so pages
+ * split and merge all the time, for a latch crabbing and for a linked tree.
+ */
+TEST(BPlusTreeTests, ConcurrentTest) {
+  DBStorageEngine engine("bp_tree_concurrent_test.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 20000;
+  std::vector<KeyBuffer> keys(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+  }
+  for (int kind = 0; kind < 12; kind++) {
+    bool linked = kind >= 6;
+    int threads = 1 << (kind % 6);
+    BPlusTree tree(kind, engine.bpm_, km, 16, 16, IndexPageLayout::kColumns, linked);
+    std::atomic<int> errors{0};
+    RunConcurrentWork(&tree, keys, threads, &errors);
+    ASSERT_EQ(0, errors.load());
+    ASSERT_TRUE(tree.Check());
+    // a key is left unless its thread removed it
+    std::vector<bool> expected(n);
+    for (int t = 0; t < threads; t++) {
+      std::vector<int> own;
+      for (int i = t; i < n; i += threads) {
+        own.push_back(i);
+      }
+      std::shuffle(own.begin(), own.end(), std::mt19937(t));
+      for (size_t i = 0; i < own.size(); i++) {
+        expected[own[i]] = i % 2 == 1 || i + 1 == own.size();
+      }
+    }
+    std::vector<RowId> result;
+    for (int i = 0; i < n; i++) {
+      ASSERT_EQ(expected[i], tree.GetValue(keys[i].Get(), result));
+    }
+    int count = 0;
+    int64_t last = -1;
+    for (auto iter = tree.Begin(); iter != tree.End(); ++iter, count++) {
+      ASSERT_TRUE(expected[(*iter).second.Get()]);
+      ASSERT_LT(last, (*iter).second.Get());
+      last = (*iter).second.Get();
+    }
+    ASSERT_EQ(std::count(expected.begin(), expected.end(), true), count);
+    ASSERT_TRUE(tree.Check());
+  }
+}
+
+/**
+ * Not a pass or fail test, prints the operations per second of the workload of ConcurrentTest by thread count,
+ * for a latch crabbing and for a linked tree. Run it with --gtest_also_run_disabled_tests
+ * --gtest_filter='*Benchmark*'.
+ */
+TEST(BPlusTreeTests, DISABLED_ConcurrentBenchmark) {
+  DBStorageEngine engine("bp_tree_concurrent_benchmark.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 50000;
+  std::vector<KeyBuffer> keys(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+  }
+  for (int kind = 0; kind < 12; kind++) {
+    bool linked = kind >= 6;
+    int threads = 1 << (kind % 6);
+    BPlusTree tree(kind, engine.bpm_, km, 16, 16, IndexPageLayout::kColumns, linked);
+    std::atomic<int> errors{0};
+    auto start = std::chrono::steady_clock::now();
+    int64_t operations = RunConcurrentWork(&tree, keys, threads, &errors);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(0, errors.load());
+    LOG(INFO) << (linked ? "Linked" : "Crabbing") << ", threads " << threads << ": " << operations / seconds / 1e3
+              << " K operations/s";
+  }
+}
+
+/**
+ * Half of threads insert increasing keys, the way ids are inserted, the other half look up the keys inserted
+ * so far. All inserts go to the rightmost leaf.
+ * @return the number of lookups of the readers
+ */
+static int64_t RunIncreasingKeyWork(BPlusTree *tree, std::vector<KeyBuffer> &keys, int threads,
+                                    std::atomic<int> *errors) {
+  const int n = static_cast<int>(keys.size());
+  std::atomic<int> next{0};
+  std::vector<std::atomic<bool>> inserted(n);
+  std::atomic<int> writing{threads / 2};
+  std::atomic<int64_t> lookups{0};
+  auto write = [&]() {
+    for (int i = next++; i < n; i = next++) {
+      if (!tree->Insert(keys[i].Get(), RowId(i))) {
+        (*errors)++;
+      }
+      inserted[i] = true;
+    }
+    writing--;
+  };
+  auto read = [&](int t) {
+    std::mt19937 random(t);
+    std::vector<RowId> result;
+    int64_t done = 0;
+    while (writing > 0) {
+      int bound = std::min(next.load(), n);
+      if (bound == 0) {
+        continue;
+      }
+      int i = random() % bound;
+      bool expected = inserted[i];
+      result.clear();
+      bool found = tree->GetValue(keys[i].Get(), result);
+      if ((expected && !found) || (found && result[0].Get() != i)) {
+        (*errors)++;
+      }
+      done++;
+    }
+    lookups += done;
+  };
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads / 2; t++) {
+    workers.emplace_back(write);
+    workers.emplace_back(read, t);
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  return lookups.load();
+}
+
+/**
+ * Writers insert increasing keys while readers look up the keys inserted so far, for a latch crabbing and
+ * for a linked tree. The linked tree is opened again as it is stored.
+ */
+TEST(BPlusTreeTests, IncreasingKeyTest) {
+  DBStorageEngine engine("bp_tree_increasing_test.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 20000;
+  std::vector<KeyBuffer> keys(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+  }
+  for (int kind = 0; kind < 8; kind++) {
+    bool linked = kind >= 4;
+    int threads = 2 << (kind % 4);
+    BPlusTree tree(kind, engine.bpm_, km, 16, 16, IndexPageLayout::kColumns, linked);
+    std::atomic<int> errors{0};
+    RunIncreasingKeyWork(&tree, keys, threads, &errors);
+    ASSERT_EQ(0, errors.load());
+    ASSERT_TRUE(tree.Check());
+    BPlusTree stored(kind, engine.bpm_, km, 16, 16);
+    std::vector<RowId> result;
+    for (int i = 0; i < n; i++) {
+      ASSERT_TRUE(stored.GetValue(keys[i].Get(), result));
+      ASSERT_EQ(i, result.back().Get());
+    }
+    int count = 0;
+    for (auto iter = stored.Begin(); iter != stored.End(); ++iter, count++) {
+      ASSERT_EQ(count, (*iter).second.Get());
+    }
+    ASSERT_EQ(n, count);
+    ASSERT_TRUE(stored.Check());
+  }
+}
+
+/**
+ * Not a pass or fail test, prints the lookups and inserts per second of the workload of IncreasingKeyTest by
+ * thread count, for a latch crabbing and for a linked tree. Run it with --gtest_also_run_disabled_tests
+ * --gtest_filter='*Benchmark*'.
+ */
+TEST(BPlusTreeTests, DISABLED_IncreasingKeyBenchmark) {
+  DBStorageEngine engine("bp_tree_increasing_benchmark.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 50000;
+  std::vector<KeyBuffer> keys(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+  }
+  for (int kind = 0; kind < 8; kind++) {
+    bool linked = kind >= 4;
+    int threads = 2 << (kind % 4);
+    BPlusTree tree(kind, engine.bpm_, km, 16, 16, IndexPageLayout::kColumns, linked);
+    std::atomic<int> errors{0};
+    auto start = std::chrono::steady_clock::now();
+    int64_t lookups = RunIncreasingKeyWork(&tree, keys, threads, &errors);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    ASSERT_EQ(0, errors.load());
+    LOG(INFO) << (linked ? "Linked" : "Crabbing") << ", threads " << threads << ": " << lookups / seconds / 1e3
+              << " K lookups/s, " << n / seconds / 1e3 << " K inserts/s";
+  }
+}
+
+/**
+ * Trees of both kinds are bulk loaded with different fill factors and then changed by inserts and removes.
+ */
+TEST(BPlusTreeTests, BulkLoadTest) {
+  DBStorageEngine engine("bp_tree_bulk_load_test.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 100000;
+  std::vector<KeyBuffer> keys(n);
+  std::vector<int> order(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(0));
+  index_id_t index_id = 0;
+  for (bool linked : {false, true}) {
+    for (double fill_factor : {0.5, 0.7, 1.0}) {
+      BPlusTree tree(index_id++, engine.bpm_, km, UNDEFINED_SIZE, UNDEFINED_SIZE, IndexPageLayout::kColumns, linked);
+      // every third key is added twice, the second entry is left out
+      KeySorter sorter(km, 64 * 1024);
+      for (int i : order) {
+        ASSERT_EQ(DB_SUCCESS, sorter.Add(keys[i].Get(), RowId(i)));
+      }
+      for (int i = 0; i < n; i += 3) {
+        ASSERT_EQ(DB_SUCCESS, sorter.Add(keys[i].Get(), RowId(-1)));
+      }
+      auto next = [&sorter](GenericKey *key, RowId *value) { return sorter.Next(key, value); };
+      ASSERT_TRUE(tree.BulkLoad(next, fill_factor));
+      ASSERT_TRUE(tree.Check());
+      ASSERT_FALSE(tree.BulkLoad(next));
+      std::vector<RowId> result;
+      for (int i = 0; i < n; i++) {
+        ASSERT_TRUE(tree.GetValue(keys[i].Get(), result));
+        ASSERT_EQ(i, result.back().Get());
+      }
+      // the pages are full up to the fill factor, they still split and merge
+      for (int i = 0; i < n; i += 2) {
+        tree.Remove(keys[order[i]].Get());
+      }
+      for (int i = 0; i < n; i += 4) {
+        ASSERT_TRUE(tree.Insert(keys[order[i]].Get(), RowId(order[i])));
+      }
+      int count = 0;
+      int64_t last = -1;
+      for (auto iter = tree.Begin(); iter != tree.End(); ++iter, count++) {
+        ASSERT_LT(last, (*iter).second.Get());
+        last = (*iter).second.Get();
+      }
+      ASSERT_EQ(n / 2 + n / 4, count);
+      ASSERT_TRUE(tree.Check());
+    }
+  }
+  // small pages give levels whose last page is below the min size
+  for (int size : {1, 2, 3, 17, 18, 100}) {
+    BPlusTree tree(index_id++, engine.bpm_, km, 4, 4);
+    int i = 0;
+    ASSERT_TRUE(tree.BulkLoad([&](GenericKey *key, RowId *value) {
+      if (i == size) {
+        return false;
+      }
+      memcpy(key, keys[i].Get(), km.GetKeySize());
+      *value = RowId(i++);
+      return true;
+    }));
+    for (int j = 0; j < size; j++) {
+      tree.Remove(keys[j].Get());
+      ASSERT_TRUE(tree.Check());
+    }
+    ASSERT_TRUE(tree.IsEmpty());
+  }
+}
+
+/**
+ * Not a pass or fail test, prints the time of inserting shuffled keys one by one and of sorting and bulk
+ * loading them, for both kinds of trees and different fill factors. Run it with
+ * --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'.
+ */
+TEST(BPlusTreeTests, DISABLED_BulkLoadBenchmark) {
+  DBStorageEngine engine("bp_tree_bulk_load_benchmark.db");
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 100000;
+  std::vector<KeyBuffer> keys(n);
+  std::vector<int> order(n);
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, i)};
+    km.SerializeFromKey(keys[i].Get(), Row(fields), &table_schema);
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(0));
+  index_id_t index_id = 0;
+  {
+    BPlusTree tree(index_id++, engine.bpm_, km);
+    auto start = std::chrono::steady_clock::now();
+    for (int i : order) {
+      ASSERT_TRUE(tree.Insert(keys[i].Get(), RowId(i)));
+    }
+    LOG(INFO) << "Insert one by one: " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+              << " s";
+  }
+  for (bool linked : {false, true}) {
+    for (double fill_factor : {0.5, 0.7, 1.0}) {
+      BPlusTree tree(index_id++, engine.bpm_, km, UNDEFINED_SIZE, UNDEFINED_SIZE, IndexPageLayout::kColumns, linked);
+      auto start = std::chrono::steady_clock::now();
+      KeySorter sorter(km, INDEX_SORT_MEMORY);
+      for (int i : order) {
+        ASSERT_EQ(DB_SUCCESS, sorter.Add(keys[i].Get(), RowId(i)));
+      }
+      auto next = [&sorter](GenericKey *key, RowId *value) { return sorter.Next(key, value); };
+      ASSERT_TRUE(tree.BulkLoad(next, fill_factor));
+      LOG(INFO) << (linked ? "Linked" : "Crabbing") << ", fill factor " << fill_factor << ", sort and bulk load: "
+                << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s";
+    }
+  }
+}
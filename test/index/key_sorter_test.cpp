@@ -0,0 +1,59 @@
+#include "index/key_sorter.h"
+
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+TEST(KeySorterTest, SpillAndMergeTest) {
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  const int n = 50000;
+  std::vector<int> values(n);
+  for (int i = 0; i < n; i++) {
+    values[i] = i / 2;
+  }
+  std::shuffle(values.begin(), values.end(), std::mt19937(0));
+  // a run holds about 1000 entries of 16 bytes
+  KeySorter sorter(km, 16000);
+  KeyBuffer key;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields{Field(TypeId::kTypeInt, values[i])};
+    km.SerializeFromKey(key.Get(), Row(fields), &table_schema);
+    ASSERT_EQ(DB_SUCCESS, sorter.Add(key.Get(), RowId(i)));
+  }
+  ASSERT_LT(40, sorter.GetSpilledRunCount());
+  // equal keys come in the order they were added
+  KeyBuffer last_key;
+  RowId row_id;
+  int64_t last_row_id = -1;
+  int count = 0;
+  for (; sorter.Next(key.Get(), &row_id); count++) {
+    KeyBuffer expected;
+    std::vector<Field> fields{Field(TypeId::kTypeInt, count / 2)};
+    km.SerializeFromKey(expected.Get(), Row(fields), &table_schema);
+    ASSERT_EQ(0, km.CompareKeys(expected.Get(), key.Get()));
+    ASSERT_EQ(count / 2, values[row_id.Get()]);
+    if (count % 2 == 1) {
+      ASSERT_EQ(0, km.CompareKeys(last_key.Get(), key.Get()));
+      ASSERT_LT(last_row_id, row_id.Get());
+    }
+    memcpy(last_key.Get(), key.Get(), km.GetKeySize());
+    last_row_id = row_id.Get();
+  }
+  ASSERT_EQ(n, count);
+  ASSERT_FALSE(sorter.Next(key.Get(), &row_id));
+  ASSERT_FALSE(sorter.IsFailed());
+}
+
+TEST(KeySorterTest, EmptyTest) {
+  std::vector<Column *> columns = {new Column("int", TypeId::kTypeInt, 0, false, false)};
+  Schema table_schema(columns);
+  KeyManager km(&table_schema, 8);
+  KeySorter sorter(km);
+  KeyBuffer key;
+  RowId row_id;
+  ASSERT_FALSE(sorter.Next(key.Get(), &row_id));
+  ASSERT_EQ(0, sorter.GetSpilledRunCount());
+}
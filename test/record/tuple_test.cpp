@@ -1,11 +1,13 @@
 #include <cstring>
 
+#include "common/arena.h"
 #include "common/instance.h"
 #include "gtest/gtest.h"
 #include "page/table_page.h"
 #include "record/field.h"
 #include "record/row.h"
 #include "record/schema.h"
+#include "record/tuple_view.h"
 
 char *chars[] = {const_cast<char *>(""), const_cast<char *>("hello"), const_cast<char *>("world!"),
                  const_cast<char *>("\0")};
@@ -100,4 +102,194 @@ TEST(TupleTest, RowTest) {
   }
   ASSERT_TRUE(table_page.MarkDelete(row.GetRowId(), nullptr, nullptr, nullptr));
   table_page.ApplyDelete(row.GetRowId(), nullptr, nullptr);
-}
\ No newline at end of file
+}
+TEST(TupleTest, FlatRowTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, chars[2], strlen(chars[2]), false), Field(TypeId::kTypeFloat)};
+  auto schema = std::make_shared<Schema>(columns);
+  Row row(fields);
+  char buffer[PAGE_SIZE];
+  auto size = row.SerializeTo(buffer, schema.get());
+  ASSERT_EQ(size, row.GetSerializedSize(schema.get()));
+  Arena arena;
+  for (int round = 0; round < 2; round++) {
+    arena.Reset();
+    {
+      // the values are copied, the row does not depend on the buffer it is read from
+      Row flat(RowId(), &arena);
+      ASSERT_EQ(size, flat.DeserializeFrom(buffer, schema.get()));
+      ASSERT_LT(0, arena.GetAllocatedBytes());
+      memset(buffer + size - strlen(chars[2]), 'x', strlen(chars[2]));
+      Row copy(flat);
+      memcpy(buffer + size - strlen(chars[2]), chars[2], strlen(chars[2]));
+      for (uint32_t i = 0; i < fields.size(); i++) {
+        ASSERT_EQ(fields[i].IsNull(), copy.GetField(i)->IsNull());
+        if (!fields[i].IsNull()) {
+          ASSERT_EQ(CmpBool::kTrue, copy.GetField(i)->CompareEquals(fields[i]));
+        }
+      }
+      // a field copied out of a flat row owns its data
+      Field name(*flat.GetField(1));
+      ASSERT_NE(flat.GetField(1)->GetData(), name.GetData());
+      ASSERT_EQ(CmpBool::kTrue, name.CompareEquals(fields[1]));
+      // fields appended later and fields replaced with owned data are released with the row
+      copy.GetFields().push_back(new Field(TypeId::kTypeChar, chars[1], strlen(chars[1]), true));
+      Field replaced(TypeId::kTypeChar, chars[1], strlen(chars[1]), true);
+      *copy.GetField(1) = replaced;
+      ASSERT_EQ(CmpBool::kTrue, copy.GetField(1)->CompareEquals(char_fields[1]));
+      // rows exchange their buffers
+      Row other(RowId(1, 2));
+      Swap(other, copy);
+      ASSERT_EQ(4, other.GetFieldCount());
+      ASSERT_EQ(0, copy.GetFieldCount());
+      ASSERT_EQ(RowId(1, 2), copy.GetRowId());
+      ASSERT_EQ(CmpBool::kTrue, other.GetField(0)->CompareEquals(fields[0]));
+    }
+  }
+}
+
+TEST(TupleTest, FixedWidthTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 1, true, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 2, true, false),
+                                   new Column("age", TypeId::kTypeInt, 3, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  ASSERT_FALSE(schema->IsFixedWidth());
+  ASSERT_EQ(2, schema->GetFixedColumnCount());
+  ASSERT_EQ(4, schema->GetColumnOffset(1));
+  ASSERT_EQ(8, schema->GetFixedSize());
+  std::vector<Column *> fixed_columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                         new Column("account", TypeId::kTypeFloat, 1, true, false)};
+  ASSERT_TRUE(Schema(fixed_columns).IsFixedWidth());
+  // every combination of null values
+  for (int nulls = 0; nulls < 16; nulls++) {
+    std::vector<Field> fields;
+    fields.emplace_back(nulls & 1 ? Field(TypeId::kTypeInt) : Field(TypeId::kTypeInt, 7));
+    fields.emplace_back(nulls & 2 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, 1.5f));
+    fields.emplace_back(nulls & 4 ? Field(TypeId::kTypeChar)
+                                  : Field(TypeId::kTypeChar, chars[1], strlen(chars[1]), false));
+    fields.emplace_back(nulls & 8 ? Field(TypeId::kTypeInt) : Field(TypeId::kTypeInt, -3));
+    Row row(fields);
+    char buffer[PAGE_SIZE];
+    auto size = row.SerializeTo(buffer, schema.get());
+    ASSERT_EQ(size, row.GetSerializedSize(schema.get()));
+    Row read;
+    ASSERT_EQ(size, read.DeserializeFrom(buffer, schema.get()));
+    TupleView view(buffer, schema.get(), RowId());
+    for (uint32_t i = 0; i < fields.size(); i++) {
+      alignas(Field) char memory[sizeof(Field)];
+      auto column = reinterpret_cast<Field *>(memory);
+      view.DecodeColumn(i, column);
+      for (auto field : {read.GetField(i), column}) {
+        ASSERT_EQ(fields[i].IsNull(), field->IsNull());
+        if (!fields[i].IsNull()) {
+          ASSERT_EQ(CmpBool::kTrue, field->CompareEquals(fields[i]));
+        }
+      }
+      column->~Field();
+    }
+  }
+}
+
+TEST(TupleTest, CompactFormatTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 512, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  Schema v1(columns);
+  auto v2 = std::unique_ptr<Schema>(Schema::DeepCopySchema(&v1));
+  v2->SetTupleFormat(TupleFormat::kV2);
+  ASSERT_TRUE(v2->HasNullBitmap());
+  std::string long_name(300, 'x');
+  for (uint32_t len : {0U, 5U, 63U, 64U, 300U}) {
+    for (bool is_null : {false, true}) {
+      std::vector<Field> fields;
+      fields.emplace_back(TypeId::kTypeInt, 42);
+      if (is_null) {
+        fields.emplace_back(TypeId::kTypeChar);
+      } else {
+        fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(long_name.data()), len, false);
+      }
+      fields.emplace_back(TypeId::kTypeFloat, -1.5f);
+      fields[1].SetExternal(len == 5);
+      Row row(fields);
+      char buffer[PAGE_SIZE];
+      auto size = row.SerializeTo(buffer, v2.get());
+      ASSERT_EQ(size, row.GetSerializedSize(v2.get()));
+      // no rid, a varint length of one byte up to 63 characters and of two bytes up to 8191
+      ASSERT_EQ(row.GetSerializedSize(&v1) - sizeof(RowId) - (is_null ? 0 : len < 64 ? 3 : 2), size);
+      Row read;
+      ASSERT_EQ(size, read.DeserializeFrom(buffer, v2.get()));
+      for (uint32_t i = 0; i < fields.size(); i++) {
+        ASSERT_EQ(fields[i].IsNull(), read.GetField(i)->IsNull());
+        if (!fields[i].IsNull()) {
+          ASSERT_EQ(CmpBool::kTrue, read.GetField(i)->CompareEquals(fields[i]));
+          ASSERT_EQ(fields[i].IsExternal(), read.GetField(i)->IsExternal());
+        }
+      }
+      TupleView view(buffer, v2.get(), RowId());
+      alignas(Field) char memory[sizeof(Field)];
+      auto account = reinterpret_cast<Field *>(memory);
+      view.DecodeColumn(2, account);
+      ASSERT_EQ(CmpBool::kTrue, account->CompareEquals(fields[2]));
+      account->~Field();
+    }
+  }
+  // no null bitmap if no column can be null, short tuples are padded
+  std::vector<Column *> not_null_columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema not_null(not_null_columns);
+  not_null.SetTupleFormat(TupleFormat::kV2);
+  ASSERT_FALSE(not_null.HasNullBitmap());
+  std::vector<Field> fields;
+  fields.emplace_back(TypeId::kTypeInt, 7);
+  Row row(fields);
+  char buffer[PAGE_SIZE];
+  ASSERT_EQ(sizeof(RowId), row.SerializeTo(buffer, &not_null));
+  ASSERT_EQ(7, MACH_READ_INT32(buffer));
+  Row read;
+  ASSERT_EQ(sizeof(RowId), read.DeserializeFrom(buffer, &not_null));
+  ASSERT_EQ(CmpBool::kTrue, read.GetField(0)->CompareEquals(fields[0]));
+}
+
+TEST(TupleTest, MoveTest) {
+  static_assert(std::is_nothrow_move_constructible<Field>::value && std::is_nothrow_move_assignable<Field>::value);
+  static_assert(std::is_nothrow_move_constructible<Row>::value && std::is_nothrow_move_assignable<Row>::value);
+  // a moved field takes over the data, the source is left null
+  Field owned(TypeId::kTypeChar, chars[1], strlen(chars[1]), true);
+  auto data = owned.GetData();
+  Field moved(std::move(owned));
+  ASSERT_EQ(data, moved.GetData());
+  ASSERT_TRUE(owned.IsNull());
+  Field assigned(TypeId::kTypeInt, 1);
+  assigned = std::move(moved);
+  ASSERT_EQ(data, assigned.GetData());
+  // copy assignment copies the data and leaves the source as it is
+  Field copied(TypeId::kTypeInt, 1);
+  copied = assigned;
+  ASSERT_NE(data, copied.GetData());
+  ASSERT_EQ(data, assigned.GetData());
+  ASSERT_EQ(CmpBool::kTrue, copied.CompareEquals(char_fields[1]));
+  // a moved row keeps its flat buffer, the source is left empty and can be filled again
+  std::vector<Field> fields = {Field(TypeId::kTypeInt, 188),
+                               Field(TypeId::kTypeChar, chars[2], strlen(chars[2]), false), Field(TypeId::kTypeFloat)};
+  Row row(fields);
+  row.SetRowId(RowId(1, 2));
+  auto name = row.GetField(1);
+  std::vector<Row> rows;
+  rows.push_back(std::move(row));
+  ASSERT_EQ(0, row.GetFieldCount());
+  ASSERT_EQ(name, rows[0].GetField(1));
+  ASSERT_EQ(RowId(1, 2), rows[0].GetRowId());
+  row = Row(fields);
+  ASSERT_EQ(3, row.GetFieldCount());
+  // growing the vector moves the rows instead of copying them
+  for (int i = 0; i < 100; i++) {
+    rows.emplace_back(fields);
+  }
+  ASSERT_EQ(name, rows[0].GetField(1));
+  rows[1] = std::move(rows[0]);
+  ASSERT_EQ(name, rows[1].GetField(1));
+  ASSERT_EQ(CmpBool::kTrue, rows[1].GetField(1)->CompareEquals(fields[1]));
+}
@@ -0,0 +1,351 @@
+#include "record/type_kernels.h"
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "index/generic_key.h"
+#include "record/field.h"
+#include "record/row.h"
+#include "record/schema.h"
+
+namespace {
+
+// the comparison of keys before the kernels: both keys are deserialized into rows
+int CompareKeysByRows(const GenericKey *lhs, const GenericKey *rhs, const KeyManager &km, Schema *key_schema) {
+  Row lhs_key(INVALID_ROWID);
+  Row rhs_key(INVALID_ROWID);
+  km.DeserializeToKey(lhs, lhs_key, key_schema);
+  km.DeserializeToKey(rhs, rhs_key, key_schema);
+  for (uint32_t i = 0; i < key_schema->GetColumnCount(); i++) {
+    // null sorts first in normalized keys, it is neither less nor greater in keys of the row encoding
+    bool lhs_null = lhs_key.GetField(i)->IsNull(), rhs_null = rhs_key.GetField(i)->IsNull();
+    if (km.GetEncoding() == KeyEncoding::kNormalized && (lhs_null || rhs_null)) {
+      if (lhs_null != rhs_null) {
+        return lhs_null ? -1 : 1;
+      }
+      continue;
+    }
+    auto type = Type::GetInstance(key_schema->GetColumn(i)->GetType());
+    if (type->CompareLessThan(*lhs_key.GetField(i), *rhs_key.GetField(i)) == CmpBool::kTrue) {
+      return -1;
+    }
+    if (type->CompareGreaterThan(*lhs_key.GetField(i), *rhs_key.GetField(i)) == CmpBool::kTrue) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+template <typename Func>
+double MeasureMillis(Func &&func) {
+  auto start = std::chrono::steady_clock::now();
+  func();
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int Sign(int value) { return (value > 0) - (value < 0); }
+
+}  // namespace
+
+TEST(TypeKernelsTest, FieldCompareTest) {
+  std::mt19937 rng(17);
+  std::uniform_int_distribution<int32_t> ints(-50, 50);
+  std::uniform_int_distribution<int> lens(0, 6);
+  for (int i = 0; i < 1000; i++) {
+    Field a(TypeId::kTypeInt, ints(rng)), b(TypeId::kTypeInt, ints(rng));
+    Field c(TypeId::kTypeFloat, ints(rng) / 4.0f), d(TypeId::kTypeFloat, ints(rng) / 4.0f);
+    std::string s(lens(rng), 'a'), t(lens(rng), 'a');
+    if (!s.empty()) s.back() = 'a' + ints(rng) % 3 + 3;
+    Field e(TypeId::kTypeChar, const_cast<char *>(s.data()), s.size(), false);
+    Field f(TypeId::kTypeChar, const_cast<char *>(t.data()), t.size(), false);
+    for (auto pair : {std::make_pair(&a, &b), std::make_pair(&c, &d), std::make_pair(&e, &f)}) {
+      auto type = Type::GetInstance(pair.first->GetTypeId());
+      EXPECT_EQ(type->CompareLessThan(*pair.first, *pair.second), pair.first->CompareLessThan(*pair.second));
+      EXPECT_EQ(type->CompareEquals(*pair.first, *pair.second), pair.first->CompareEquals(*pair.second));
+      EXPECT_EQ(type->CompareGreaterThanEquals(*pair.first, *pair.second),
+                pair.first->CompareGreaterThanEquals(*pair.second));
+    }
+  }
+  Field null_int(TypeId::kTypeInt), one(TypeId::kTypeInt, 1);
+  EXPECT_EQ(CmpBool::kNull, null_int.CompareEquals(one));
+  EXPECT_EQ(CmpBool::kNull, one.CompareNotEquals(null_int));
+}
+
+TEST(TypeKernelsTest, KeyCompareTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, true, false),
+                                   new Column("name", TypeId::kTypeChar, 8, 1, true, false),
+                                   new Column("score", TypeId::kTypeFloat, 2, true, false)};
+  Schema schema(columns);
+  std::vector<Column *> single_columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema single_schema(single_columns);
+  for (auto encoding : {KeyEncoding::kRow, KeyEncoding::kNormalized}) {
+    KeyManager km(&schema, 64, encoding);
+    KeyManager single_km(&single_schema, 16, encoding);
+    std::mt19937 rng(33);
+    std::uniform_int_distribution<int32_t> ints(0, 5);
+    std::vector<GenericKey *> keys, single_keys;
+    std::vector<std::string> names{"", "a", "ab", "b"};
+    for (int i = 0; i < 200; i++) {
+      std::vector<Field> fields;
+      fields.emplace_back(TypeId::kTypeInt, ints(rng));
+      auto &name = names[ints(rng) % names.size()];
+      if (ints(rng) == 0) {
+        fields.emplace_back(TypeId::kTypeChar);
+      } else {
+        fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(name.data()), name.size(), true);
+      }
+      fields.emplace_back(TypeId::kTypeFloat, ints(rng) * 0.5f);
+      keys.push_back(km.InitKey());
+      km.SerializeFromKey(keys.back(), Row(fields), &schema);
+      std::vector<Field> single_fields;
+      single_fields.emplace_back(fields[0]);
+      single_keys.push_back(single_km.InitKey());
+      single_km.SerializeFromKey(single_keys.back(), Row(single_fields), &single_schema);
+    }
+    KeyManager copy(km);
+    for (auto lhs : keys) {
+      for (auto rhs : keys) {
+        ASSERT_EQ(CompareKeysByRows(lhs, rhs, km, &schema), Sign(copy.CompareKeys(lhs, rhs)));
+      }
+    }
+    for (auto lhs : single_keys) {
+      for (auto rhs : single_keys) {
+        ASSERT_EQ(CompareKeysByRows(lhs, rhs, single_km, &single_schema), Sign(single_km.CompareKeys(lhs, rhs)));
+      }
+    }
+    for (auto key : keys) free(key);
+    for (auto key : single_keys) free(key);
+  }
+}
+
+TEST(TypeKernelsTest, NormalizedKeyTest) {
+  std::vector<Column *> columns = {new Column("i", TypeId::kTypeInt, 0, true, false),
+                                   new Column("f", TypeId::kTypeFloat, 1, true, false),
+                                   new Column("b", TypeId::kTypeBigInt, 2, true, false),
+                                   new Column("d", TypeId::kTypeDouble, 3, true, false),
+                                   new Column("s", TypeId::kTypeChar, 4, 4, true, false)};
+  Schema schema(columns);
+  ASSERT_EQ(5 + 5 + 9 + 9 + 9, KeyManager::GetNormalizedSize(&schema));
+  KeyManager km(&schema, 64);
+  ASSERT_EQ(KeyEncoding::kNormalized, km.GetEncoding());
+  // extreme values, signed zeros and strings which are prefixes of each other or hold zero bytes
+  std::vector<int32_t> ints{INT32_MIN, -1, 0, 1, INT32_MAX};
+  std::vector<float> floats{-INFINITY, -1.5f, -0.0f, 0.0f, 1e-30f, 2.5f, INFINITY};
+  std::vector<int64_t> bigints{INT64_MIN, -(int64_t{1} << 40), 0, int64_t{1} << 40, INT64_MAX};
+  std::vector<double> doubles{-1e300, -0.0, 0.0, 1e-300, 1e300};
+  std::vector<std::string> names{"", std::string(1, '\0'), "a", std::string("a\0", 2), "ab", "\xff"};
+  std::mt19937 rng(21);
+  std::vector<GenericKey *> keys;
+  std::vector<Row> rows;
+  for (int i = 0; i < 300; i++) {
+    std::vector<Field> fields;
+    // a pick past the end of the values is a null
+    auto add = [&fields, &rng](TypeId type, const auto &values) {
+      size_t k = rng() % (values.size() + 1);
+      k < values.size() ? fields.emplace_back(type, values[k]) : fields.emplace_back(type);
+    };
+    add(TypeId::kTypeInt, ints);
+    add(TypeId::kTypeFloat, floats);
+    add(TypeId::kTypeBigInt, bigints);
+    add(TypeId::kTypeDouble, doubles);
+    size_t k = rng() % (names.size() + 1);
+    if (k < names.size()) {
+      fields.emplace_back(TypeId::kTypeChar, const_cast<char *>(names[k].data()), names[k].size(), true);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar);
+    }
+    rows.emplace_back(fields);
+    keys.push_back(km.InitKey());
+    km.SerializeFromKey(keys.back(), rows.back(), &schema);
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    // decoding gives the values back
+    Row decoded(INVALID_ROWID);
+    km.DeserializeToKey(keys[i], decoded, &schema);
+    for (uint32_t j = 0; j < schema.GetColumnCount(); j++) {
+      auto expected = rows[i].GetField(j);
+      ASSERT_EQ(expected->IsNull(), decoded.GetField(j)->IsNull());
+      if (!expected->IsNull()) {
+        ASSERT_EQ(CmpBool::kTrue, expected->CompareEquals(*decoded.GetField(j)));
+      }
+    }
+    for (size_t j = 0; j < keys.size(); j++) {
+      ASSERT_EQ(CompareKeysByRows(keys[i], keys[j], km, &schema), Sign(km.CompareKeys(keys[i], keys[j])));
+    }
+  }
+  // -0 and 0 are the same key
+  std::vector<Field> negative_zero, zero;
+  for (auto fields : {&negative_zero, &zero}) {
+    fields->emplace_back(TypeId::kTypeInt, 0);
+    fields->emplace_back(TypeId::kTypeFloat, fields == &zero ? 0.0f : -0.0f);
+    fields->emplace_back(TypeId::kTypeBigInt, int64_t{0});
+    fields->emplace_back(TypeId::kTypeDouble, fields == &zero ? 0.0 : -0.0);
+    fields->emplace_back(TypeId::kTypeChar);
+  }
+  KeyBuffer lhs, rhs;
+  km.SerializeFromKey(lhs.Get(), Row(negative_zero), &schema);
+  km.SerializeFromKey(rhs.Get(), Row(zero), &schema);
+  ASSERT_EQ(0, km.CompareKeys(lhs.Get(), rhs.Get()));
+  // a value longer than its column does not fit
+  std::string too_long = "abcde";
+  zero.back() = Field(TypeId::kTypeChar, const_cast<char *>(too_long.data()), too_long.size(), true);
+  ASSERT_FALSE(km.FitsKey(Row(zero), &schema));
+  for (auto key : keys) free(key);
+}
+
+TEST(TypeKernelsTest, WideTypesTest) {
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeBigInt, 0, false, false),
+                                   new Column("amount", TypeId::kTypeDouble, 1, true, false),
+                                   new Column("created", TypeId::kTypeTimestamp, 2, true, false),
+                                   new Column("name", TypeId::kTypeChar, 8, 3, true, false)};
+  Schema schema(columns);
+  ASSERT_EQ(3, schema.GetFixedColumnCount());
+  ASSERT_EQ(24, schema.GetFixedSize());
+  int64_t created;
+  ASSERT_TRUE(TypeTimestamp::Parse("2024-02-29 13:45:07.25", &created));
+  std::vector<Field> fields;
+  fields.emplace_back(TypeId::kTypeBigInt, int64_t{-(int64_t{1} << 53)});
+  fields.emplace_back(TypeId::kTypeDouble, 0.1 + 0.2);
+  fields.emplace_back(TypeId::kTypeTimestamp, created);
+  fields.emplace_back(TypeId::kTypeChar, const_cast<char *>("abc"), 3, true);
+  for (auto format : {TupleFormat::kV1, TupleFormat::kV2}) {
+    schema.SetTupleFormat(format);
+    Row row(fields);
+    char buffer[PAGE_SIZE];
+    auto size = row.SerializeTo(buffer, &schema);
+    ASSERT_EQ(size, row.GetSerializedSize(&schema));
+    Row read;
+    ASSERT_EQ(size, read.DeserializeFrom(buffer, &schema));
+    for (uint32_t i = 0; i < fields.size(); i++) {
+      ASSERT_EQ(fields[i].GetTypeId(), read.GetField(i)->GetTypeId());
+      ASSERT_EQ(CmpBool::kTrue, read.GetField(i)->CompareEquals(fields[i]));
+    }
+  }
+  ASSERT_EQ("-9007199254740992", fields[0].toString());
+  ASSERT_EQ("2024-02-29 13:45:07.250000", fields[2].toString());
+  // the comparisons of the kernels and of the types agree
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<int64_t> ints(-3, 3);
+  for (int i = 0; i < 200; i++) {
+    Field a(TypeId::kTypeBigInt, ints(rng) << 40), b(TypeId::kTypeBigInt, ints(rng) << 40);
+    Field c(TypeId::kTypeDouble, ints(rng) * 1e300), d(TypeId::kTypeDouble, ints(rng) * 1e300);
+    Field e(TypeId::kTypeTimestamp, ints(rng)), f(TypeId::kTypeTimestamp, ints(rng));
+    for (auto pair : {std::make_pair(&a, &b), std::make_pair(&c, &d), std::make_pair(&e, &f)}) {
+      auto type = Type::GetInstance(pair.first->GetTypeId());
+      EXPECT_EQ(type->CompareLessThan(*pair.first, *pair.second), pair.first->CompareLessThan(*pair.second));
+      EXPECT_EQ(type->CompareEquals(*pair.first, *pair.second), pair.first->CompareEquals(*pair.second));
+    }
+  }
+  // keys of 64-bit values are compared serialized
+  std::vector<Column *> key_columns = {new Column("id", TypeId::kTypeBigInt, 0, false, false),
+                                       new Column("created", TypeId::kTypeTimestamp, 1, false, false)};
+  Schema key_schema(key_columns);
+  KeyManager km(&key_schema, 32);
+  std::vector<GenericKey *> keys;
+  for (int i = 0; i < 50; i++) {
+    std::vector<Field> key_fields;
+    key_fields.emplace_back(TypeId::kTypeBigInt, ints(rng) << 33);
+    key_fields.emplace_back(TypeId::kTypeTimestamp, ints(rng));
+    keys.push_back(km.InitKey());
+    km.SerializeFromKey(keys.back(), Row(key_fields), &key_schema);
+  }
+  for (auto lhs : keys) {
+    for (auto rhs : keys) {
+      ASSERT_EQ(CompareKeysByRows(lhs, rhs, km, &key_schema), Sign(km.CompareKeys(lhs, rhs)));
+    }
+  }
+  for (auto key : keys) free(key);
+}
+
+TEST(TypeKernelsTest, TimestampTest) {
+  int64_t micros;
+  ASSERT_TRUE(TypeTimestamp::Parse("1970-01-01", &micros));
+  ASSERT_EQ(0, micros);
+  ASSERT_TRUE(TypeTimestamp::Parse("1969-12-31 23:59:59.999999", &micros));
+  ASSERT_EQ(-1, micros);
+  ASSERT_EQ("1969-12-31 23:59:59.999999", TypeTimestamp::Format(micros));
+  ASSERT_TRUE(TypeTimestamp::Parse("2000-03-01 00:00:01", &micros));
+  ASSERT_EQ(951868801000000, micros);
+  ASSERT_EQ("2000-03-01 00:00:01", TypeTimestamp::Format(micros));
+  for (auto invalid : {"", "2023-02-29", "2024-13-01", "2024-01-01 24:00:00", "2024-01-01 10:00", "2024-01-01x",
+                       "2024-01-01 10:00:00.1234567", "2024-01-01 10:00:00."}) {
+    EXPECT_FALSE(TypeTimestamp::Parse(invalid, &micros)) << invalid;
+  }
+  // formatting and parsing are inverse over several centuries
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int64_t> values(-(int64_t{1} << 55), int64_t{1} << 55);
+  for (int i = 0; i < 1000; i++) {
+    int64_t value = values(rng), parsed;
+    ASSERT_TRUE(TypeTimestamp::Parse(TypeTimestamp::Format(value).c_str(), &parsed));
+    ASSERT_EQ(value, parsed);
+  }
+}
+
+/**
+ * Not a pass or fail test, prints the comparisons per second through the virtual calls of Type::GetInstance
+ * and through the kernels. Run it with --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'.
+ */
+TEST(TypeKernelsTest, DISABLED_CompareBenchmark) {
+  const int n = 2000, rounds = 500;
+  const double compares = static_cast<double>(n) * rounds;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int32_t> ints(0, 1 << 20);
+  std::vector<Field> values;
+  for (int i = 0; i < n; i++) {
+    values.emplace_back(TypeId::kTypeInt, ints(rng));
+  }
+  auto type = Type::GetInstance(TypeId::kTypeInt);
+  uint64_t virtual_less = 0, kernel_less = 0;
+  double virtual_ms = MeasureMillis([&] {
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < n; i++) {
+        virtual_less += type->CompareLessThan(values[i], values[(i * 7 + r) % n]) == CmpBool::kTrue;
+      }
+    }
+  });
+  double kernel_ms = MeasureMillis([&] {
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < n; i++) {
+        kernel_less += values[i].CompareLessThan(values[(i * 7 + r) % n]) == CmpBool::kTrue;
+      }
+    }
+  });
+  ASSERT_EQ(virtual_less, kernel_less);
+  LOG(INFO) << "Field compare: virtual " << compares / virtual_ms / 1e3 << " M/s, kernel "
+            << compares / kernel_ms / 1e3 << " M/s";
+
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false)};
+  Schema key_schema(columns);
+  KeyManager km(&key_schema, 16);
+  std::vector<GenericKey *> keys;
+  for (int i = 0; i < n; i++) {
+    std::vector<Field> fields;
+    fields.emplace_back(values[i]);
+    keys.push_back(km.InitKey());
+    km.SerializeFromKey(keys.back(), Row(fields), &key_schema);
+  }
+  int64_t row_sum = 0, kernel_sum = 0;
+  double row_ms = MeasureMillis([&] {
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < n; i++) {
+        row_sum += CompareKeysByRows(keys[i], keys[(i * 7 + r) % n], km, &key_schema);
+      }
+    }
+  });
+  double key_ms = MeasureMillis([&] {
+    for (int r = 0; r < rounds; r++) {
+      for (int i = 0; i < n; i++) {
+        kernel_sum += Sign(km.CompareKeys(keys[i], keys[(i * 7 + r) % n]));
+      }
+    }
+  });
+  ASSERT_EQ(row_sum, kernel_sum);
+  LOG(INFO) << "Key compare: deserialized rows " << compares / row_ms / 1e3 << " M/s, normalized keys "
+            << compares / key_ms / 1e3 << " M/s";
+  for (auto key : keys) free(key);
+}
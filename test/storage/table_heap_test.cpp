@@ -1,5 +1,8 @@
 #include "storage/table_heap.h"
 
+#include <algorithm>
+#include <random>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -7,6 +10,9 @@
 #include "gtest/gtest.h"
 #include "record/field.h"
 #include "record/schema.h"
+#include "storage/clustered_table_heap.h"
+#include "storage/pax_table_heap.h"
+#include "storage/row_id_bitmap.h"
 #include "utils/utils.h"
 
 static string db_file_name = "table_heap_test.db";
@@ -64,3 +70,767 @@ TEST(TableHeapTest, TableHeapSampleTest) {
   delete disk_mgr_;
   delete table_heap;
 }
+
+TEST(TableHeapTest, VacuumTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 2000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::unordered_map<int64_t, int32_t> row_ids;
+  char characters[32];
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, 32);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 32, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    row_ids.emplace(row.GetRowId().Get(), i);
+  }
+  // delete three quarters of the rows
+  for (auto it = row_ids.begin(); it != row_ids.end();) {
+    if (it->second % 4 != 0) {
+      ASSERT_TRUE(table_heap->MarkDelete(RowId(it->first), nullptr));
+      it = row_ids.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto pages_before = table_heap->GetPageCount();
+  std::vector<std::pair<RowId, RowId>> moved_rows;
+  ASSERT_GT(table_heap->Vacuum(nullptr, &moved_rows), 0);
+  ASSERT_LT(table_heap->GetPageCount(), pages_before);
+  ASSERT_FALSE(moved_rows.empty());
+  for (auto &moved : moved_rows) {
+    auto id = row_ids.find(moved.first.Get());
+    ASSERT_NE(row_ids.end(), id);
+    row_ids.emplace(moved.second.Get(), id->second);
+    row_ids.erase(id);
+  }
+  // every live row is still reachable, through the iterator and its (new) rid
+  size_t count = 0;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+    auto row = *it;
+    ASSERT_NE(row_ids.end(), row_ids.find(row.GetRowId().Get()));
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, row_ids[row.GetRowId().Get()])));
+    count++;
+  }
+  ASSERT_EQ(row_nums / 4, count);
+  // the reclaimed space is reused by the following inserts
+  auto pages_after = table_heap->GetPageCount();
+  for (int i = 0; i < 100; i++) {
+    Fields fields{Field(TypeId::kTypeInt, row_nums + i), Field(TypeId::kTypeChar, characters, 32, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  ASSERT_EQ(pages_after, table_heap->GetPageCount());
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, OverflowTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 200;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("doc", TypeId::kTypeChar, 3 * PAGE_SIZE, 1, true, false),
+                                   new Column("note", TypeId::kTypeChar, 1024, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::unordered_map<int64_t, Fields *> row_values;
+  char characters[3 * PAGE_SIZE];
+  for (int i = 0; i < row_nums; i++) {
+    // values from a few bytes up to rows larger than a page
+    int32_t doc_len = RandomUtils::RandomInt(0, 3 * PAGE_SIZE - 1);
+    int32_t note_len = RandomUtils::RandomInt(0, 1023);
+    RandomUtils::RandomString(characters, doc_len);
+    Fields *fields = new Fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, doc_len, true),
+                                Field(TypeId::kTypeChar, characters, note_len, true)};
+    Row row(*fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    row_values.emplace(row.GetRowId().Get(), fields);
+  }
+  // update half of the rows, switching between inline and overflow values
+  std::unordered_map<int64_t, Fields *> updated_values;
+  for (auto &row_kv : row_values) {
+    if (RandomUtils::RandomInt(0, 1) == 0) {
+      updated_values.emplace(row_kv);
+      continue;
+    }
+    int32_t doc_len = RandomUtils::RandomInt(0, 3 * PAGE_SIZE - 1);
+    RandomUtils::RandomString(characters, doc_len);
+    Fields *fields = new Fields{Field(row_kv.second->at(0)),
+                                Field(TypeId::kTypeChar, characters, doc_len, true), Field(row_kv.second->at(2))};
+    Row row(*fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, RowId(row_kv.first), nullptr));
+    updated_values.emplace(row.GetRowId().Get(), fields);
+    delete row_kv.second;
+  }
+  row_values.swap(updated_values);
+  ASSERT_EQ(row_nums, row_values.size());
+  for (auto row_kv : row_values) {
+    Row row(RowId(row_kv.first));
+    table_heap->GetTuple(&row, nullptr);
+    ASSERT_EQ(schema.get()->GetColumnCount(), row.GetFields().size());
+    for (size_t j = 0; j < schema.get()->GetColumnCount(); j++) {
+      ASSERT_FALSE(row.GetField(j)->IsExternal());
+      ASSERT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(row_kv.second->at(j)));
+    }
+  }
+  // only the values of the referenced columns are read from the overflow pages
+  std::vector<bool> referenced{true, false, true};
+  size_t external = 0;
+  for (auto it = table_heap->Begin(nullptr, &referenced); it != table_heap->End(); it++) {
+    auto row = *it;
+    auto &values = *row_values.at(row.GetRowId().Get());
+    external += row.GetField(1)->IsExternal();
+    ASSERT_FALSE(row.GetField(2)->IsExternal());
+    ASSERT_EQ(CmpBool::kTrue, row.GetField(2)->CompareEquals(values[2]));
+  }
+  ASSERT_GT(external, 0);
+  // deleting the rows gives the overflow pages back
+  for (auto row_kv : row_values) {
+    ASSERT_TRUE(table_heap->MarkDelete(RowId(row_kv.first), nullptr));
+    delete row_kv.second;
+  }
+  table_heap->Vacuum(nullptr);
+  ASSERT_EQ(1, table_heap->GetPageCount());
+  for (page_id_t page_id = 0; page_id < 2 * row_nums * 3; page_id++) {
+    ASSERT_EQ(page_id != table_heap->GetFirstPageId(), bpm_->IsPageFree(page_id));
+  }
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, ForwardingTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 1000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 512, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::unordered_map<int64_t, std::pair<int32_t, std::string>> row_values;
+  char characters[512];
+  auto update = [&](int64_t rid, uint32_t len) {
+    RandomUtils::RandomString(characters, len);
+    auto &value = row_values[rid];
+    Fields fields{Field(TypeId::kTypeInt, value.first), Field(TypeId::kTypeChar, characters, len, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, RowId(rid), nullptr));
+    // the row id survives the update even if the tuple has to leave its page
+    ASSERT_EQ(rid, row.GetRowId().Get());
+    value.second = std::string(characters, len);
+  };
+  auto check = [&]() {
+    size_t count = 0;
+    for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+      auto row = *it;
+      auto value = row_values.find(row.GetRowId().Get());
+      ASSERT_NE(row_values.end(), value);
+      ASSERT_EQ(CmpBool::kTrue, row.GetField(0)->CompareEquals(Field(TypeId::kTypeInt, value->second.first)));
+      ASSERT_EQ(value->second.second, std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+      count++;
+    }
+    // moved tuples are only visited through their forwarding slots
+    ASSERT_EQ(row_values.size(), count);
+  };
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, 16);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 16, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    row_values.emplace(row.GetRowId().Get(), std::make_pair(i, std::string(characters, 16)));
+  }
+  std::vector<int64_t> rids;
+  for (auto &row_kv : row_values) {
+    rids.push_back(row_kv.first);
+  }
+  // grow every other row, most of them do not fit into their full pages any more
+  for (size_t i = 0; i < rids.size(); i += 2) {
+    update(rids[i], 400);
+  }
+  check();
+  // grow again, move back to a small value or update a forwarded tuple in place
+  for (size_t i = 0; i < rids.size(); i += 2) {
+    update(rids[i], i % 3 == 0 ? 500 : (i % 3 == 1 ? 8 : 400));
+  }
+  check();
+  // delete a quarter of the rows, forwarded or not
+  for (size_t i = 0; i < rids.size(); i += 4) {
+    ASSERT_TRUE(table_heap->MarkDelete(RowId(rids[i]), nullptr));
+    ASSERT_TRUE(table_heap->MarkDelete(RowId(rids[i + 1]), nullptr));
+    row_values.erase(rids[i]);
+    row_values.erase(rids[i + 1]);
+  }
+  std::vector<std::pair<RowId, RowId>> moved_rows;
+  table_heap->Vacuum(nullptr, &moved_rows);
+  for (auto &moved : moved_rows) {
+    auto value = row_values.find(moved.first.Get());
+    ASSERT_NE(row_values.end(), value);
+    auto moved_value = value->second;
+    row_values.erase(value);
+    row_values.emplace(moved.second.Get(), moved_value);
+  }
+  check();
+  // deleting the remaining rows frees the moved tuples as well
+  for (auto &row_kv : row_values) {
+    ASSERT_TRUE(table_heap->MarkDelete(RowId(row_kv.first), nullptr));
+  }
+  row_values.clear();
+  table_heap->Vacuum(nullptr);
+  ASSERT_EQ(1, table_heap->GetPageCount());
+  check();
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, ZoneMapTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 5000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[64];
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, 32);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 32, true),
+                  i % 7 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, i * 0.5f)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+  }
+  Field low(TypeId::kTypeInt, 1000), high(TypeId::kTypeInt, 1200), account(TypeId::kTypeFloat, 2000.f);
+  std::vector<ZonePredicate> predicates{{0, ">=", &low}, {0, "<", &high}, {2, "<>", &account}};
+  auto matches = [&](const Row &row) {
+    auto id = row.GetField(0);
+    return id->CompareGreaterThanEquals(low) == CmpBool::kTrue && id->CompareLessThan(high) == CmpBool::kTrue;
+  };
+  // the zone maps are exact after inserts, a page is skipped iff none of its tuples matches
+  auto check = [&]() {
+    std::vector<page_id_t> page_ids;
+    table_heap->GetPageIds(&page_ids);
+    size_t skipped = 0;
+    std::vector<Row> rows;
+    for (auto page_id : page_ids) {
+      ASSERT_TRUE(table_heap->GetPageTuples(page_id, &rows, nullptr));
+      bool any = std::any_of(rows.begin(), rows.end(), matches);
+      ASSERT_EQ(any, table_heap->PageMayMatch(page_id, predicates, nullptr));
+      skipped += !any;
+    }
+    ASSERT_GT(skipped, page_ids.size() / 2);
+    // a scan skipping pages finds the same tuples as a full scan
+    size_t expected = 0, found = 0;
+    for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+      expected += matches(*it);
+    }
+    for (auto page_id = table_heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;
+         page_id = table_heap->GetNextPageId(page_id)) {
+      if (table_heap->PageMayMatch(page_id, predicates, nullptr)) {
+        ASSERT_TRUE(table_heap->GetPageTuples(page_id, &rows, nullptr));
+        found += std::count_if(rows.begin(), rows.end(), matches);
+      }
+    }
+    ASSERT_EQ(200, expected);
+    ASSERT_EQ(expected, found);
+  };
+  check();
+  // an updated tuple widens the zone map of its page
+  Fields fields{Field(TypeId::kTypeInt, 1100), Field(TypeId::kTypeChar, characters, 32, true),
+                Field(TypeId::kTypeFloat, 1.f)};
+  Row row(fields);
+  auto first = table_heap->Begin(nullptr);
+  auto first_rid = first.GetRowId();
+  ASSERT_FALSE(table_heap->PageMayMatch(first_rid.GetPageId(), predicates, nullptr));
+  ASSERT_TRUE(table_heap->UpdateTuple(row, first_rid, nullptr));
+  ASSERT_TRUE(table_heap->PageMayMatch(first_rid.GetPageId(), predicates, nullptr));
+  ASSERT_TRUE(table_heap->MarkDelete(first_rid, nullptr));
+  table_heap->ApplyDelete(first_rid, nullptr);
+  // the zone maps of a reopened table are built on demand
+  auto first_page_id = table_heap->GetFirstPageId();
+  delete table_heap;
+  table_heap = TableHeap::Create(bpm_, first_page_id, schema.get(), nullptr, nullptr);
+  check();
+  // so are they after a vacuum
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+    if (it.GetRowId().GetSlotNum() % 3 == 0) {
+      ASSERT_TRUE(table_heap->MarkDelete(it.GetRowId(), nullptr));
+    }
+  }
+  table_heap->Vacuum(nullptr);
+  std::vector<page_id_t> page_ids;
+  table_heap->GetPageIds(&page_ids);
+  std::vector<Row> rows;
+  for (auto page_id : page_ids) {
+    ASSERT_TRUE(table_heap->GetPageTuples(page_id, &rows, nullptr));
+    ASSERT_EQ(std::any_of(rows.begin(), rows.end(), matches),
+              table_heap->PageMayMatch(page_id, predicates, nullptr));
+  }
+  // a tuple grown out of its full page is counted for its home page through the forwarding slot
+  auto grown_rid = table_heap->Begin(nullptr).GetRowId();
+  RandomUtils::RandomString(characters, 63);
+  Fields grown_fields{Field(TypeId::kTypeInt, 1100), Field(TypeId::kTypeChar, characters, 63, true),
+                      Field(TypeId::kTypeFloat, 1.f)};
+  Row grown(grown_fields);
+  // fill the space left by the vacuum with tuples smaller than the growth
+  for (int i = 0; i < row_nums; i++) {
+    Fields filler_fields{Field(TypeId::kTypeInt, 0), Field(TypeId::kTypeChar, characters, 1, true),
+                         Field(TypeId::kTypeFloat)};
+    Row filler(filler_fields);
+    ASSERT_TRUE(table_heap->InsertTuple(filler, nullptr));
+  }
+  ASSERT_TRUE(table_heap->UpdateTuple(grown, grown_rid, nullptr));
+  first_page_id = table_heap->GetFirstPageId();
+  delete table_heap;
+  table_heap = TableHeap::Create(bpm_, first_page_id, schema.get(), nullptr, nullptr);
+  ASSERT_TRUE(table_heap->PageMayMatch(grown_rid.GetPageId(), predicates, nullptr));
+  ASSERT_TRUE(table_heap->PageMayMatch(grown_rid.GetPageId(), predicates, nullptr));
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, TupleViewTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 1000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, VARCHAR_INLINE_MAX_LEN * 2, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::unordered_map<int64_t, std::string> names;
+  std::vector<char> characters(VARCHAR_INLINE_MAX_LEN * 2);
+  for (int i = 0; i < row_nums; i++) {
+    // every tenth name is stored in overflow pages
+    uint32_t len = i % 10 == 0 ? VARCHAR_INLINE_MAX_LEN * 2 : 16;
+    RandomUtils::RandomString(characters.data(), len);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters.data(), len, true),
+                  Field(TypeId::kTypeFloat, i * 0.5f)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    names.emplace(row.GetRowId().Get(), std::string(characters.data(), len));
+  }
+  // grow some tuples so they are forwarded to other pages
+  std::vector<int64_t> rids;
+  for (auto &name : names) {
+    rids.push_back(name.first);
+  }
+  for (size_t i = 0; i < rids.size(); i += 7) {
+    Row old_row(RowId(rids[i]));
+    table_heap->GetTuple(&old_row, nullptr);
+    RandomUtils::RandomString(characters.data(), 400);
+    Fields fields;
+    fields.emplace_back(*old_row.GetField(0));
+    fields.emplace_back(TypeId::kTypeChar, characters.data(), 400, true);
+    fields.emplace_back(*old_row.GetField(2));
+    Row row(fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, RowId(rids[i]), nullptr));
+    names[rids[i]] = std::string(characters.data(), 400);
+  }
+  Arena arena;
+  std::vector<bool> name_only{false, true, false};
+  size_t visited = 0, declined = 0;
+  TableHeap::TupleVisitor visit = [&](const TupleView &view) {
+    arena.Reset();
+    Row row(view.GetRowId(), &arena);
+    if (!view.Bind(name_only, &row)) {
+      // a name in overflow pages is read with the tuple, the visitor is called again on a copy
+      declined++;
+      return false;
+    }
+    EXPECT_EQ(3, row.GetFieldCount());
+    EXPECT_TRUE(row.GetField(0)->IsNull());
+    EXPECT_TRUE(row.GetField(2)->IsNull());
+    EXPECT_EQ(names[view.GetRowId().Get()], std::string(row.GetField(1)->GetData(), row.GetField(1)->GetLength()));
+    visited++;
+    return true;
+  };
+  size_t external = std::count_if(names.begin(), names.end(),
+                                  [](const auto &name) { return name.second.size() > VARCHAR_INLINE_MAX_LEN; });
+  ASSERT_LT(0, external);
+  for (auto page_id = table_heap->GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    ASSERT_TRUE(table_heap->VisitPage(page_id, visit, nullptr, &page_id));
+  }
+  ASSERT_EQ(names.size(), visited);
+  ASSERT_EQ(external, declined);
+  visited = 0;
+  for (auto rid : rids) {
+    ASSERT_TRUE(table_heap->VisitTuple(RowId(rid), visit, nullptr));
+  }
+  ASSERT_EQ(names.size(), visited);
+  ASSERT_TRUE(table_heap->MarkDelete(RowId(rids[0]), nullptr));
+  table_heap->ApplyDelete(RowId(rids[0]), nullptr);
+  ASSERT_FALSE(table_heap->VisitTuple(RowId(rids[0]), visit, nullptr));
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, BitmapScanTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 1000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 512, 1, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  char characters[512];
+  std::vector<RowId> rids;
+  for (int i = 0; i < row_nums; i++) {
+    RandomUtils::RandomString(characters, 32);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 32, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    rids.push_back(row.GetRowId());
+  }
+  // forward some tuples to other pages and delete others
+  for (int i = 0; i < row_nums; i += 5) {
+    RandomUtils::RandomString(characters, 400);
+    Fields fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, 400, true)};
+    Row row(fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, rids[i], nullptr));
+  }
+  for (int i = 1; i < row_nums; i += 10) {
+    ASSERT_TRUE(table_heap->MarkDelete(rids[i], nullptr));
+    table_heap->ApplyDelete(rids[i], nullptr);
+  }
+  RowIdBitmap every_second;
+  RowIdBitmap every_third;
+  // added out of order, the set keeps each row id once
+  for (int i = row_nums - 1; i >= 0; i--) {
+    if (i % 2 == 0) {
+      every_second.Add(rids[i]);
+      every_second.Add(rids[i]);
+    }
+    if (i % 3 == 0) {
+      every_third.Add(rids[i]);
+    }
+  }
+  ASSERT_EQ(row_nums / 2, every_second.GetSize());
+  RowIdBitmap every_sixth = every_second;
+  every_sixth.Intersect(every_third);
+  RowIdBitmap united = every_second;
+  united.Union(every_third);
+  for (int i = 0; i < row_nums; i++) {
+    ASSERT_EQ(i % 6 == 0, every_sixth.Contains(rids[i]));
+    ASSERT_EQ(i % 2 == 0 || i % 3 == 0, united.Contains(rids[i]));
+  }
+  // the pages come in order, every page is visited once for all of its row ids
+  std::vector<int> visited;
+  page_id_t page_id;
+  page_id_t last_page_id = INVALID_PAGE_ID;
+  std::vector<uint32_t> slots;
+  Arena arena;
+  std::vector<bool> id_only{true, false};
+  TableHeap::TupleVisitor collect = [&](const TupleView &view) {
+    arena.Reset();
+    Row row(view.GetRowId(), &arena);
+    if (!view.Bind(id_only, &row)) {
+      return false;
+    }
+    visited.push_back(std::stoi(row.GetField(0)->toString()));
+    EXPECT_EQ(rids[visited.back()], view.GetRowId());
+    return true;
+  };
+  size_t page_count = 0;
+  while (united.PopPage(&page_id, &slots)) {
+    ASSERT_LT(last_page_id, page_id);
+    ASSERT_TRUE(std::is_sorted(slots.begin(), slots.end()));
+    ASSERT_TRUE(table_heap->VisitSlots(page_id, slots, collect, nullptr));
+    last_page_id = page_id;
+    page_count++;
+  }
+  ASSERT_TRUE(united.IsEmpty());
+  ASSERT_LE(page_count, table_heap->GetPageCount());
+  // forwarded tuples are visited through their row ids, deleted ones are skipped
+  std::sort(visited.begin(), visited.end());
+  std::vector<int> expected;
+  for (int i = 0; i < row_nums; i++) {
+    if ((i % 2 == 0 || i % 3 == 0) && i % 10 != 1) {
+      expected.push_back(i);
+    }
+  }
+  ASSERT_EQ(expected, visited);
+  delete bpm_;
+  delete disk_mgr_;
+  delete table_heap;
+}
+
+TEST(TableHeapTest, UpgradeTupleFormatTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 2000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, VARCHAR_INLINE_MAX_LEN * 2, 1, true, false),
+                                   new Column("account", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  ASSERT_EQ(TupleFormat::kV1, schema->GetTupleFormat());
+  TableHeap *table_heap = TableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  std::unordered_map<int64_t, std::string> names;
+  std::vector<char> characters(VARCHAR_INLINE_MAX_LEN * 2);
+  auto insert = [&](int i) {
+    // every tenth name is stored in overflow pages, every seventh one is null
+    uint32_t len = i % 10 == 0 ? VARCHAR_INLINE_MAX_LEN * 2 : 16;
+    RandomUtils::RandomString(characters.data(), len);
+    Fields fields;
+    fields.emplace_back(TypeId::kTypeInt, i);
+    if (i % 7 == 0) {
+      fields.emplace_back(TypeId::kTypeChar);
+    } else {
+      fields.emplace_back(TypeId::kTypeChar, characters.data(), len, true);
+    }
+    fields.emplace_back(TypeId::kTypeFloat, i * 0.5f);
+    Row row(fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    names.emplace(row.GetRowId().Get(), i % 7 == 0 ? "" : std::string(characters.data(), len));
+  };
+  for (int i = 0; i < row_nums; i++) {
+    insert(i);
+  }
+  std::vector<int64_t> rids;
+  for (auto &name : names) {
+    rids.push_back(name.first);
+  }
+  // forwarded tuples, deleted tuples and tuples marked as deleted are converted in place as well
+  for (size_t i = 0; i < rids.size(); i += 11) {
+    RandomUtils::RandomString(characters.data(), 300);
+    Fields fields;
+    fields.emplace_back(TypeId::kTypeInt, 1);
+    fields.emplace_back(TypeId::kTypeChar, characters.data(), 300, true);
+    fields.emplace_back(TypeId::kTypeFloat, 1.0f);
+    Row row(fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, RowId(rids[i]), nullptr));
+    names[rids[i]] = std::string(characters.data(), 300);
+  }
+  std::vector<int64_t> marked;
+  for (size_t i = 5; i < rids.size(); i += 13) {
+    ASSERT_TRUE(table_heap->MarkDelete(RowId(rids[i]), nullptr));
+    if (i % 2 == 0) {
+      table_heap->ApplyDelete(RowId(rids[i]), nullptr);
+      names.erase(rids[i]);
+    } else {
+      marked.push_back(rids[i]);
+    }
+  }
+  auto check = [&]() {
+    size_t count = 0;
+    for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); it++) {
+      Row row(*it);
+      auto &name = names.at(it.GetRowId().Get());
+      auto field = row.GetField(1);
+      ASSERT_EQ(name.empty(), field->IsNull());
+      ASSERT_EQ(name, field->IsNull() ? "" : std::string(field->GetData(), field->GetLength()));
+      count++;
+    }
+    ASSERT_EQ(names.size() - marked.size(), count);
+  };
+  check();
+  auto page_count = table_heap->GetPageCount();
+  ASSERT_LT(0, table_heap->UpgradeTupleFormat(nullptr));
+  ASSERT_EQ(TupleFormat::kV2, schema->GetTupleFormat());
+  check();
+  for (auto rid : marked) {
+    table_heap->RollbackDelete(RowId(rid), nullptr);
+  }
+  marked.clear();
+  check();
+  // the space given back by the smaller tuples is used by new ones
+  for (int i = row_nums; i < row_nums + 200; i++) {
+    insert(i);
+  }
+  ASSERT_EQ(page_count, table_heap->GetPageCount());
+  check();
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, PaxLayoutTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 5000;
+  std::vector<Column *> columns = {new Column("id", TypeId::kTypeInt, 0, false, false),
+                                   new Column("name", TypeId::kTypeChar, 64, 1, true, false),
+                                   new Column("balance", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = PaxTableHeap::Create(bpm_, schema.get(), nullptr, nullptr, nullptr);
+  ASSERT_EQ(TableLayout::kPax, table_heap->GetLayout());
+  std::unordered_map<int64_t, Fields *> row_values;
+  for (int i = 0; i < row_nums; i++) {
+    int32_t len = RandomUtils::RandomInt(0, 64);
+    char *characters = new char[len];
+    RandomUtils::RandomString(characters, len);
+    Fields *fields = new Fields{Field(TypeId::kTypeInt, i), Field(TypeId::kTypeChar, characters, len, true),
+                                i % 7 == 0 ? Field(TypeId::kTypeFloat) : Field(TypeId::kTypeFloat, i * 0.5f)};
+    Row row(*fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    row_values.emplace(row.GetRowId().Get(), fields);
+    delete[] characters;
+  }
+  // values longer than the declared length do not fit into the minipage
+  char long_value[65] = {0};
+  Fields too_long{Field(TypeId::kTypeInt, -1), Field(TypeId::kTypeChar, long_value, 65, true),
+                  Field(TypeId::kTypeFloat, 0.f)};
+  Row too_long_row(too_long);
+  ASSERT_FALSE(table_heap->InsertTuple(too_long_row, nullptr));
+  // full rows through the iterator
+  int scanned = 0;
+  for (auto it = table_heap->Begin(nullptr); it != table_heap->End(); ++it, ++scanned) {
+    auto row = *it;
+    auto expected = row_values.at(row.GetRowId().Get());
+    for (size_t j = 0; j < schema->GetColumnCount(); j++) {
+      ASSERT_EQ(expected->at(j).IsNull(), row.GetField(j)->IsNull());
+      if (!expected->at(j).IsNull()) {
+        ASSERT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(expected->at(j)));
+      }
+    }
+  }
+  ASSERT_EQ(row_nums, scanned);
+  // update and delete in place
+  int deleted = 0;
+  for (auto &row_kv : row_values) {
+    if (row_kv.first % 3 == 0) {
+      ASSERT_TRUE(table_heap->MarkDelete(RowId(row_kv.first), nullptr));
+      ASSERT_FALSE(table_heap->MarkDelete(RowId(row_kv.first), nullptr));
+      deleted++;
+      continue;
+    }
+    Fields *fields = new Fields{Field(row_kv.second->at(0)), Field(row_kv.second->at(1)),
+                                Field(TypeId::kTypeFloat, 1.f)};
+    Row row(*fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, RowId(row_kv.first), nullptr));
+    ASSERT_EQ(row_kv.first, row.GetRowId().Get());
+    delete row_kv.second;
+    row_kv.second = fields;
+  }
+  ASSERT_GT(table_heap->Vacuum(nullptr), 0);
+  // decode the balance column only
+  auto pax_heap = static_cast<PaxTableHeap *>(table_heap);
+  ColumnBatch batch;
+  scanned = 0;
+  page_id_t page_id = pax_heap->GetFirstPageId();
+  while (page_id != INVALID_PAGE_ID) {
+    ASSERT_TRUE(pax_heap->ScanColumns(page_id, {2}, &batch, &page_id));
+    ASSERT_EQ(1, batch.columns_.size());
+    ASSERT_EQ(batch.rids_.size(), batch.columns_[0].size());
+    for (size_t i = 0; i < batch.rids_.size(); i++, scanned++) {
+      ASSERT_NE(0, batch.rids_[i].Get() % 3);
+      ASSERT_EQ(CmpBool::kTrue, batch.columns_[0][i].CompareEquals(Field(TypeId::kTypeFloat, 1.f)));
+    }
+  }
+  ASSERT_EQ(row_nums - deleted, scanned);
+  for (auto row_kv : row_values) {
+    delete row_kv.second;
+  }
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}
+
+TEST(TableHeapTest, ClusteredLayoutTest) {
+  remove(db_file_name.c_str());
+  auto disk_mgr_ = new DiskManager(db_file_name);
+  auto bpm_ = new BufferPoolManager(DEFAULT_BUFFER_POOL_SIZE, disk_mgr_);
+  const int row_nums = 5000;
+  std::vector<Column *> columns = {new Column("name", TypeId::kTypeChar, 64, 0, true, false),
+                                   new Column("id", TypeId::kTypeInt, 1, false, true),
+                                   new Column("balance", TypeId::kTypeFloat, 2, true, false)};
+  auto schema = std::make_shared<Schema>(columns);
+  TableHeap *table_heap = ClusteredTableHeap::Create(bpm_, schema.get(), {1}, nullptr, nullptr, nullptr);
+  ASSERT_EQ(TableLayout::kClustered, table_heap->GetLayout());
+  auto clustered_heap = static_cast<ClusteredTableHeap *>(table_heap);
+  // keys are inserted in random order
+  std::vector<int> ids(row_nums);
+  for (int i = 0; i < row_nums; i++) {
+    ids[i] = i;
+  }
+  std::shuffle(ids.begin(), ids.end(), std::mt19937(0));
+  std::map<int, Fields *> row_values;
+  for (auto id : ids) {
+    int32_t len = RandomUtils::RandomInt(0, 64);
+    char *characters = new char[len];
+    RandomUtils::RandomString(characters, len);
+    Fields *fields = new Fields{Field(TypeId::kTypeChar, characters, len, true), Field(TypeId::kTypeInt, id),
+                                Field(TypeId::kTypeFloat, id * 0.5f)};
+    Row row(*fields);
+    ASSERT_TRUE(table_heap->InsertTuple(row, nullptr));
+    row_values.emplace(id, fields);
+    delete[] characters;
+  }
+  Fields duplicate{Field(TypeId::kTypeChar), Field(TypeId::kTypeInt, ids[0]), Field(TypeId::kTypeFloat, 0.f)};
+  Row duplicate_row(duplicate);
+  ASSERT_FALSE(table_heap->InsertTuple(duplicate_row, nullptr));
+  // a full scan returns the rows in key order
+  auto check_scan = [&](TableHeap *heap) {
+    auto expected = row_values.begin();
+    for (auto it = heap->Begin(nullptr); it != heap->End(); ++it, ++expected) {
+      ASSERT_NE(row_values.end(), expected);
+      auto row = *it;
+      for (size_t j = 0; j < schema->GetColumnCount(); j++) {
+        ASSERT_EQ(CmpBool::kTrue, row.GetField(j)->CompareEquals(expected->second->at(j)));
+      }
+    }
+    ASSERT_EQ(row_values.end(), expected);
+  };
+  check_scan(table_heap);
+  // a range scan starts with one descent
+  Fields key{Field(TypeId::kTypeInt, 1234)};
+  RowId rid;
+  ASSERT_TRUE(clustered_heap->LowerBound(Row(key), &rid));
+  Row found(rid);
+  ASSERT_TRUE(table_heap->GetTuple(&found, nullptr));
+  ASSERT_EQ(CmpBool::kTrue, found.GetField(1)->CompareEquals(key[0]));
+  Fields past_end{Field(TypeId::kTypeInt, row_nums)};
+  ASSERT_FALSE(clustered_heap->LowerBound(Row(past_end), &rid));
+  // delete a third of the rows, move some to a new key, grow the others
+  char long_name[64];
+  memset(long_name, 'x', sizeof(long_name));
+  for (int id = 0; id < row_nums; id++) {
+    auto fields = row_values.at(id);
+    Row old_row(*fields);
+    ASSERT_TRUE(clustered_heap->FindTuple(old_row, &rid));
+    if (id % 3 == 0) {
+      ASSERT_TRUE(table_heap->MarkDelete(rid, nullptr));
+      row_values.erase(id);
+      delete fields;
+      continue;
+    }
+    int new_id = id % 5 == 1 ? id + row_nums : id;
+    Fields *new_fields = new Fields{Field(TypeId::kTypeChar, long_name, sizeof(long_name), true),
+                                    Field(TypeId::kTypeInt, new_id), Field(fields->at(2))};
+    Row row(*new_fields);
+    ASSERT_TRUE(table_heap->UpdateTuple(row, rid, nullptr));
+    row_values.erase(id);
+    row_values.emplace(new_id, new_fields);
+    delete fields;
+  }
+  ASSERT_GT(table_heap->Vacuum(nullptr), 0);
+  check_scan(table_heap);
+  // reopen the tree from its root page
+  TableHeap *reopened =
+      ClusteredTableHeap::Create(bpm_, table_heap->GetFirstPageId(), schema.get(), {1}, nullptr, nullptr);
+  ASSERT_EQ(table_heap->GetPageCount(), reopened->GetPageCount());
+  check_scan(reopened);
+  for (auto row_kv : row_values) {
+    delete row_kv.second;
+  }
+  delete reopened;
+  delete table_heap;
+  delete bpm_;
+  delete disk_mgr_;
+}